@@ -0,0 +1,200 @@
+#include "Bench_Common.h"
+
+#include <iostream>
+
+using namespace DropMath;
+
+// Measures the error of each approximated kernel against a double precision reference next to its throughput.
+//
+//   Bench_Accuracy                 dense sampling, 4M inputs per range
+//   Bench_Accuracy --exhaustive    every float of every range (slow, minutes)
+//   Bench_Accuracy --inputs 1000   inputs per range when sampling
+//
+// ULP errors are relative to the float nearest to the reference, so a correctly rounded kernel scores <= 0.5.
+// Inputs are spaced evenly in ULPs, so most of a range around zero is tiny values. Sin and Tan wrap their input by adding
+// pi, which keeps the absolute error small but has no relative bound near zero; the [0.01, ...] rows show the error
+// away from it. Max abs matters near the zeros of Sin/Cos/Tan where one ULP of the input is many ULPs of the output.
+
+namespace
+{
+    const int g_ThroughputSize = 1024;
+
+    struct Report
+    {
+        const char*       kernel;
+        const char*       range;
+        Bench::ErrorStats error;
+        double            nsPerOp;
+    };
+
+    void PrintHeader()
+    {
+        std::printf("%-22s %-18s %10s %12s %10s %12s %14s %9s\n", "Kernel", "Range", "Inputs", "Max ULP", "Mean ULP", "Max abs",
+                    "Worst input", "ns/op");
+    }
+
+    void Print(const Report& r)
+    {
+        std::printf("%-22s %-18s %10lld %12.4g %10.3g %12.3g %14.7g %9.3f\n", r.kernel, r.range, r.error.count, r.error.maxUlp,
+                    r.error.MeanUlp(), r.error.maxAbs, r.error.worst, r.nsPerOp);
+    }
+
+    // Throughput of fn over a fixed array of inputs taken from [lo, hi].
+    template <typename Fn>
+    double Throughput(float lo, float hi, Fn fn)
+    {
+        std::vector<float> inputs;
+        Bench::SweepFloats(lo, hi, g_ThroughputSize, [&](float x) { inputs.push_back(x); });
+
+        Bench::Kernel kernel = Bench::Measure(
+            "",
+            [&](long long n)
+            {
+                float  acc  = 0.0f;
+                size_t size = inputs.size();
+                for (long long i = 0; i < n; ++i)
+                    acc += fn(inputs[(size_t) i % size]);
+                Bench::Escape(&acc);
+            },
+            15);
+        return Bench::Median(kernel.samples);
+    }
+
+    // Characterize a scalar float kernel against a double reference over [lo, hi].
+    template <typename Fn, typename Ref>
+    Report Scalar(const char* kernel, const char* range, float lo, float hi, long long inputs, Fn fn, Ref reference)
+    {
+        Report r;
+        r.kernel = kernel;
+        r.range  = range;
+        Bench::SweepFloats(lo, hi, inputs, [&](float x) { r.error.Add(x, fn(x), reference((double) x)); });
+        r.nsPerOp = Throughput(lo, hi, fn);
+        return r;
+    }
+
+    // Length error of Normalize in ULPs of 1, over vectors with components in [lo, hi].
+    template <typename V, int N>
+    Report Normalize(const char* kernel, const char* range, float lo, float hi, long long inputs)
+    {
+        Report r;
+        r.kernel = kernel;
+        r.range  = range;
+
+        unsigned int seed = 12345;
+        auto         next = [&]()
+        {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * (float) (seed >> 8) * (1.0f / 16777216.0f);
+        };
+
+        std::vector<V> vectors;
+        for (long long i = 0; i < inputs; ++i)
+        {
+            V v;
+            for (int c = 0; c < N; ++c)
+                v[c] = next();
+            V n = v;
+            n.Normalize();
+
+            double lengthSquared = 0.0;
+            double original      = 0.0;
+            for (int c = 0; c < N; ++c)
+            {
+                lengthSquared += (double) n[c] * (double) n[c];
+                original += (double) v[c] * (double) v[c];
+            }
+            if (original > (double) F::EPSILON * (double) F::EPSILON)
+                r.error.Add(v[0], (float) std::sqrt(lengthSquared), 1.0);
+            if ((int) vectors.size() < g_ThroughputSize)
+                vectors.push_back(v);
+        }
+
+        Bench::Kernel timing = Bench::Measure(
+            "",
+            [&](long long n)
+            {
+                V acc;
+                for (long long i = 0; i < n; ++i)
+                {
+                    V v = vectors[(size_t) i % vectors.size()];
+                    v.Normalize();
+                    acc = acc + v;
+                }
+                Bench::Escape(&acc);
+            },
+            15);
+        r.nsPerOp = Bench::Median(timing.samples);
+        return r;
+    }
+
+    // Smallest uniform scale s for which TryInverse still accepts s * rotation. IsZero(det) rejects
+    // well conditioned matrices once det = s^n drops below F::EPSILON.
+    template <typename Mat>
+    float SmallestInvertibleScale(Mat (*build)(float))
+    {
+        float smallest = 1.0f;
+        for (float s = 1.0f; s > 1e-6f; s *= 0.99f)
+        {
+            Mat out;
+            if (!Mat::TryInverse(build(s), out))
+                break;
+            smallest = s;
+        }
+        return smallest;
+    }
+
+    Mat3x3 ScaledRotation3(float s)
+    {
+        float c = 0.8f * s, n = 0.6f * s;
+        return Mat3x3(Vec3(c, -n, 0.0f), Vec3(n, c, 0.0f), Vec3(0.0f, 0.0f, s));
+    }
+
+    Mat4x4 ScaledRotation4(float s)
+    {
+        float c = 0.8f * s, n = 0.6f * s;
+        return Mat4x4(Vec4(c, -n, 0.0f, 0.0f), Vec4(n, c, 0.0f, 0.0f), Vec4(0.0f, 0.0f, s, 0.0f), Vec4(0.0f, 0.0f, 0.0f, s));
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long long inputs = 4 << 20;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--exhaustive")
+            inputs = 0;
+        else if (arg == "--inputs" && i + 1 < argc)
+            inputs = std::max(1LL, std::atoll(argv[++i]));
+        else
+        {
+            std::cerr << "Unknown argument " << arg << "\n";
+            return 2;
+        }
+    }
+    long long vectorInputs = inputs > 0 ? inputs : 1LL << 26;
+
+    PrintHeader();
+
+    Print(Scalar("Sin", "[-pi, pi]", -F::PI, F::PI, inputs, [](float x) { return Sin(x); }, [](double x) { return std::sin(x); }));
+    Print(Scalar("Sin", "[0.01, pi]", 0.01f, F::PI, inputs, [](float x) { return Sin(x); }, [](double x) { return std::sin(x); }));
+    Print(Scalar("Sin", "[-100, 100]", -100.0f, 100.0f, inputs, [](float x) { return Sin(x); }, [](double x) { return std::sin(x); }));
+    Print(Scalar("Cos", "[-pi, pi]", -F::PI, F::PI, inputs, [](float x) { return Cos(x); }, [](double x) { return std::cos(x); }));
+    Print(Scalar("Cos", "[-100, 100]", -100.0f, 100.0f, inputs, [](float x) { return Cos(x); }, [](double x) { return std::cos(x); }));
+    Print(Scalar("Tan", "[0.01, 1.5]", 0.01f, 1.5f, inputs, [](float x) { return Tan(x); }, [](double x) { return std::tan(x); }));
+    Print(Scalar("Tan", "[-1.5, 1.5]", -1.5f, 1.5f, inputs, [](float x) { return Tan(x); }, [](double x) { return std::tan(x); }));
+    Print(Scalar("Sqrt", "[0, FLT_MAX]", 0.0f, FLT_MAX, inputs, [](float x) { return Sqrt(x); }, [](double x) { return std::sqrt(x); }));
+    Print(Scalar("FloatToHalf (trip)", "[-65504, 65504]", -65504.0f, 65504.0f, inputs,
+                 [](float x) { return HalfToFloat(FloatToHalf(x)); }, [](double x) { return x; }));
+
+    Print(Normalize<Vec2, 2>("Vec2::Normalize", "[-1000, 1000]^2", -1000.0f, 1000.0f, vectorInputs));
+    Print(Normalize<Vec3, 3>("Vec3::Normalize", "[-1000, 1000]^3", -1000.0f, 1000.0f, vectorInputs));
+    Print(Normalize<Vec4, 4>("Vec4::Normalize", "[-1000, 1000]^4", -1000.0f, 1000.0f, vectorInputs));
+    Print(Normalize<Vec3, 3>("Vec3::Normalize", "[-1e-3, 1e-3]^3", -1e-3f, 1e-3f, vectorInputs));
+
+    std::printf("\nIsZero threshold F::EPSILON = %g\n", F::EPSILON);
+    std::printf("Smallest scale s where TryInverse accepts s * rotation: Mat3x3 %.4g, Mat4x4 %.4g\n",
+                SmallestInvertibleScale<Mat3x3>(ScaledRotation3), SmallestInvertibleScale<Mat4x4>(ScaledRotation4));
+
+    return 0;
+}
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <DropMath.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <unistd.h>
+#endif // _MSC_VER
+
+// Shared helpers of the benchmark mains: timing, baseline files, the statistics used to compare two runs
+// and ULP error measurement.
+namespace Bench
+{
+    // Timings of one kernel, in nanoseconds per operation, one entry per sample.
+    struct Kernel
+    {
+        std::string         name;
+        std::vector<double> samples;
+    };
+
+    // Result of a Mann-Whitney U test of b against a.
+    struct RankTest
+    {
+        double u;        // U statistic of b.
+        double z;        // Normal approximation of u, positive when b tends to be greater.
+        double pGreater; // One sided p-value of "b is greater than a".
+        double pLess;    // One sided p-value of "b is less than a".
+    };
+
+    // Make the compiler believe p is read so the work producing it can't be removed.
+#ifdef _MSC_VER
+    inline void Escape(const void* p)
+    {
+        static const void* volatile sink;
+        sink = p;
+        _ReadWriteBarrier();
+    }
+#else
+    inline void Escape(const void* p) { asm volatile("" : : "g"(p) : "memory"); }
+#endif // _MSC_VER
+
+    // Time fn(iterations) samples times. iterations is doubled during warm up until one sample takes at least minSampleMs.
+    template <typename Fn>
+    inline Kernel Measure(const char* name, Fn fn, int samples = 30, double minSampleMs = 2.0)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        long long iterations = 1;
+        for (;;)
+        {
+            Clock::time_point start = Clock::now();
+            fn(iterations);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (ms >= minSampleMs || iterations >= (1LL << 40))
+                break;
+            iterations *= 2;
+        }
+
+        Kernel kernel;
+        kernel.name = name;
+        kernel.samples.reserve(samples);
+        for (int s = 0; s < samples; ++s)
+        {
+            Clock::time_point start = Clock::now();
+            fn(iterations);
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            kernel.samples.push_back(ns / (double) iterations);
+        }
+        return kernel;
+    }
+
+    inline double Median(std::vector<double> values)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        size_t n = values.size();
+        return (n & 1) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+    }
+
+    // Two sample Mann-Whitney U test with tie correction and the normal approximation,
+    // fine for the 20+ samples per kernel the benchmarks take.
+    inline RankTest MannWhitney(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        struct Entry
+        {
+            double value;
+            bool   fromB;
+        };
+
+        std::vector<Entry> all;
+        all.reserve(a.size() + b.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            all.push_back({a[i], false});
+        for (size_t i = 0; i < b.size(); ++i)
+            all.push_back({b[i], true});
+        std::sort(all.begin(), all.end(), [](const Entry& x, const Entry& y) { return x.value < y.value; });
+
+        double rankSumB = 0.0;
+        double tieSum   = 0.0;
+        for (size_t i = 0; i < all.size();)
+        {
+            size_t j = i;
+            while (j < all.size() && all[j].value == all[i].value)
+                ++j;
+            double rank = 0.5 * (double) (i + 1 + j); // Average of ranks i + 1 ... j.
+            for (size_t k = i; k < j; ++k)
+                if (all[k].fromB)
+                    rankSumB += rank;
+            double t = (double) (j - i);
+            tieSum += t * t * t - t;
+            i = j;
+        }
+
+        double na = (double) a.size();
+        double nb = (double) b.size();
+        double n  = na + nb;
+
+        RankTest result;
+        result.u          = rankSumB - nb * (nb + 1.0) * 0.5;
+        double mean       = na * nb * 0.5;
+        double variance   = n > 1.0 ? na * nb / 12.0 * ((n + 1.0) - tieSum / (n * (n - 1.0))) : 0.0;
+        if (variance <= 0.0)
+        {
+            result.z        = 0.0;
+            result.pGreater = 1.0;
+            result.pLess    = 1.0;
+            return result;
+        }
+
+        double sd       = std::sqrt(variance);
+        result.z        = (result.u - mean) / sd;
+        // Continuity correction of 0.5 toward the mean for each one sided test.
+        result.pGreater = 0.5 * std::erfc((result.u - mean - 0.5) / sd / std::sqrt(2.0));
+        result.pLess    = 0.5 * std::erfc((mean - result.u - 0.5) / sd / std::sqrt(2.0));
+        return result;
+    }
+
+    // Spacing between x and the next float away from zero.
+    inline double UlpOf(float x)
+    {
+        x = std::fabs(x);
+        if (!(x < FLT_MAX))
+            return std::ldexp(1.0, 104); // Spacing at FLT_MAX, also used for infinity.
+        return (double) std::nextafter(x, FLT_MAX) - (double) x;
+    }
+
+    // Error of value in ULPs of the float nearest to reference. NaN only matches NaN, infinity only matches itself.
+    inline double UlpError(float value, double reference)
+    {
+        if (std::isnan(value) || std::isnan(reference))
+            return std::isnan(value) && std::isnan(reference) ? 0.0 : HUGE_VAL;
+        if (std::isinf(value))
+            return value == (float) reference ? 0.0 : HUGE_VAL;
+        return std::fabs((double) value - reference) / UlpOf((float) reference);
+    }
+
+    // Accumulated error of one kernel over a sweep.
+    struct ErrorStats
+    {
+        long long count  = 0;
+        double    maxUlp = 0.0;
+        double    sumUlp = 0.0;
+        double    maxAbs = 0.0;
+        float     worst  = 0.0f; // Input with the largest ULP error.
+
+        void Add(float input, float value, double reference)
+        {
+            double ulp = UlpError(value, reference);
+            double abs = std::fabs((double) value - reference);
+            ++count;
+            sumUlp += ulp;
+            if (ulp > maxUlp)
+            {
+                maxUlp = ulp;
+                worst  = input;
+            }
+            if (abs > maxAbs)
+                maxAbs = abs;
+        }
+
+        double MeanUlp() const { return count ? sumUlp / (double) count : 0.0; }
+    };
+
+    // Map a float to an unsigned key with the same order, so consecutive keys are consecutive floats.
+    inline unsigned int FloatKey(float x)
+    {
+        unsigned int bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+    }
+
+    inline float KeyFloat(unsigned int key)
+    {
+        unsigned int bits = (key & 0x80000000u) ? key & 0x7FFFFFFFu : ~key;
+        float        x;
+        std::memcpy(&x, &bits, sizeof(x));
+        return x;
+    }
+
+    // Call fn(x) for every float in [lo, hi], or for maxInputs evenly spaced ones (in ULPs) if the range holds more.
+    // Return the number of inputs visited.
+    template <typename Fn>
+    inline long long SweepFloats(float lo, float hi, long long maxInputs, Fn fn)
+    {
+        unsigned long long first = FloatKey(lo);
+        unsigned long long last  = FloatKey(hi);
+        unsigned long long total = last - first + 1;
+        unsigned long long step  = maxInputs > 0 && total > (unsigned long long) maxInputs ? total / (unsigned long long) maxInputs : 1;
+
+        long long visited = 0;
+        for (unsigned long long key = first; key <= last; key += step, ++visited)
+            fn(KeyFloat((unsigned int) key));
+        return visited;
+    }
+
+    // Host name, used to keep one baseline per machine.
+    inline std::string MachineName()
+    {
+#ifdef _MSC_VER
+        const char* name = std::getenv("COMPUTERNAME");
+        return name ? name : "unknown";
+#else
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) != 0 || name[0] == '\0')
+            return "unknown";
+        return name;
+#endif // _MSC_VER
+    }
+
+    inline std::string CompilerName()
+    {
+        char text[128];
+#if defined(_MSC_VER)
+        std::snprintf(text, sizeof(text), "MSVC %d", _MSC_VER);
+#elif defined(__clang__)
+        std::snprintf(text, sizeof(text), "Clang %s", __clang_version__);
+#elif defined(__GNUC__)
+        std::snprintf(text, sizeof(text), "GCC %s", __VERSION__);
+#else
+        std::snprintf(text, sizeof(text), "unknown");
+#endif
+        return text;
+    }
+
+    inline void WriteJsonString(FILE* file, const std::string& text)
+    {
+        std::fputc('"', file);
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] == '"' || text[i] == '\\')
+                std::fputc('\\', file);
+            std::fputc(text[i], file);
+        }
+        std::fputc('"', file);
+    }
+
+    // Write kernels as a baseline JSON file. Return false if the file can't be written.
+    inline bool WriteBaseline(const char* path, const std::vector<Kernel>& kernels)
+    {
+        FILE* file = std::fopen(path, "w");
+        if (!file)
+            return false;
+
+        std::fprintf(file, "{\n  \"machine\": ");
+        WriteJsonString(file, MachineName());
+        std::fprintf(file, ",\n  \"compiler\": ");
+        WriteJsonString(file, CompilerName());
+        std::fprintf(file, ",\n  \"kernels\": [\n");
+        for (size_t k = 0; k < kernels.size(); ++k)
+        {
+            std::fprintf(file, "    {\"name\": ");
+            WriteJsonString(file, kernels[k].name);
+            std::fprintf(file, ", \"samples\": [");
+            for (size_t s = 0; s < kernels[k].samples.size(); ++s)
+                std::fprintf(file, "%s%.9g", s ? ", " : "", kernels[k].samples[s]);
+            std::fprintf(file, "]}%s\n", k + 1 < kernels.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    namespace Internal
+    {
+        inline const char* SkipSpace(const char* p)
+        {
+            while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+                ++p;
+            return p;
+        }
+
+        // Parse the JSON string at p into out. Return the position after it, or nullptr.
+        inline const char* ParseString(const char* p, std::string& out)
+        {
+            p = SkipSpace(p);
+            if (*p != '"')
+                return nullptr;
+            out.clear();
+            for (++p; *p && *p != '"'; ++p)
+            {
+                if (*p == '\\' && p[1])
+                    ++p;
+                out.push_back(*p);
+            }
+            return *p == '"' ? p + 1 : nullptr;
+        }
+
+        // Find "key": and return the position of its value, or nullptr.
+        inline const char* FindKey(const char* p, const char* key)
+        {
+            std::string quoted = std::string("\"") + key + "\"";
+            p                  = std::strstr(p, quoted.c_str());
+            if (!p)
+                return nullptr;
+            p = SkipSpace(p + quoted.size());
+            return *p == ':' ? p + 1 : nullptr;
+        }
+    } // namespace Internal
+
+    // Read a baseline written by WriteBaseline. machine receives the machine name stored in it.
+    // Return false if the file is missing or malformed.
+    inline bool ReadBaseline(const char* path, std::vector<Kernel>& kernels, std::string* machine = nullptr)
+    {
+        FILE* file = std::fopen(path, "rb");
+        if (!file)
+            return false;
+        std::string text;
+        char        buffer[4096];
+        size_t      read;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+            text.append(buffer, read);
+        std::fclose(file);
+
+        const char* p = Internal::FindKey(text.c_str(), "machine");
+        std::string name;
+        if (p && machine && Internal::ParseString(p, name))
+            *machine = name;
+
+        p = Internal::FindKey(text.c_str(), "kernels");
+        if (!p)
+            return false;
+
+        kernels.clear();
+        while ((p = Internal::FindKey(p, "name")) != nullptr)
+        {
+            Kernel kernel;
+            if (!(p = Internal::ParseString(p, kernel.name)))
+                return false;
+            if (!(p = Internal::FindKey(p, "samples")))
+                return false;
+            p = Internal::SkipSpace(p);
+            if (*p++ != '[')
+                return false;
+            for (;;)
+            {
+                p = Internal::SkipSpace(p);
+                if (*p == ']')
+                    break;
+                char*  end;
+                double value = std::strtod(p, &end);
+                if (end == p)
+                    return false;
+                kernel.samples.push_back(value);
+                p = Internal::SkipSpace(end);
+                if (*p == ',')
+                    ++p;
+            }
+            kernels.push_back(kernel);
+        }
+        return true;
+    }
+
+    enum VERDICT
+    {
+        VERDICT_SAME,
+        VERDICT_SLOWER,
+        VERDICT_FASTER,
+        VERDICT_NEW
+    };
+
+    // Compare one kernel with its baseline. A kernel is slower (or faster) only if its median moved by more
+    // than threshold (0.05 = 5%) and the rank test says the shift is significant at alpha.
+    inline VERDICT Judge(const Kernel& baseline, const Kernel& current, double threshold, double alpha)
+    {
+        double   base   = Median(baseline.samples);
+        double   now    = Median(current.samples);
+        RankTest test   = MannWhitney(baseline.samples, current.samples);
+        double   change = base > 0.0 ? now / base - 1.0 : 0.0;
+        if (change > threshold && test.pGreater < alpha)
+            return VERDICT_SLOWER;
+        if (change < -threshold && test.pLess < alpha)
+            return VERDICT_FASTER;
+        return VERDICT_SAME;
+    }
+
+    // Print a comparison table of current against baseline and return the number of kernels that got slower.
+    inline int Compare(const std::vector<Kernel>& baseline, const std::vector<Kernel>& current, double threshold, double alpha, FILE* out)
+    {
+        static const char* verdictNames[] = {"same", "SLOWER", "faster", "new"};
+
+        int regressions = 0;
+        std::fprintf(out, "%-36s %12s %12s %9s %10s  %s\n", "Kernel", "Base ns/op", "Now ns/op", "Change", "p", "Verdict");
+        for (size_t i = 0; i < current.size(); ++i)
+        {
+            const Kernel* base = nullptr;
+            for (size_t j = 0; j < baseline.size() && !base; ++j)
+                if (baseline[j].name == current[i].name)
+                    base = &baseline[j];
+
+            double now = Median(current[i].samples);
+            if (!base)
+            {
+                std::fprintf(out, "%-36s %12s %12.3f %9s %10s  %s\n", current[i].name.c_str(), "-", now, "-", "-", verdictNames[VERDICT_NEW]);
+                continue;
+            }
+
+            double   before  = Median(base->samples);
+            RankTest test    = MannWhitney(base->samples, current[i].samples);
+            VERDICT  verdict = Judge(*base, current[i], threshold, alpha);
+            double   p       = now >= before ? test.pGreater : test.pLess;
+            if (verdict == VERDICT_SLOWER)
+                ++regressions;
+            std::fprintf(out, "%-36s %12.3f %12.3f %+8.1f%% %10.2g  %s\n", current[i].name.c_str(), before, now,
+                         before > 0.0 ? (now / before - 1.0) * 100.0 : 0.0, p, verdictNames[verdict]);
+        }
+        return regressions;
+    }
+} // namespace Bench
@@ -0,0 +1,705 @@
+#include "Bench_Common.h"
+
+#include <ext/geom/DM_PointCloud.h>
+#include <ext/mat/DM_MatX.h>
+#include <ext/sim/DM_Particles.h>
+#include <ext/sim/DM_Skinning.h>
+#include <ext/sort/DM_RadixSort.h>
+#include <ext/spatial/DM_HashGrid.h>
+#include <ext/spatial/DM_KDTree.h>
+#include <ext/spatial/DM_SweepAndPrune.h>
+
+#include <iostream>
+
+using namespace DropMath;
+
+// Times the public kernels and compares them with the baseline of this machine.
+//
+//   Bench_Regression                  compare with Baseline_<machine>.json, create it on the first run
+//   Bench_Regression --save           overwrite the baseline with this run
+//   Bench_Regression --baseline path  use another baseline file
+//   Bench_Regression --threshold 10   percent the median must move before a change counts (default 10, run to run noise is ~5%)
+//   Bench_Regression --alpha 0.01     significance level of the Mann-Whitney test (default 0.01)
+//   Bench_Regression --samples 30     samples per kernel (default 30)
+//
+// Exit code is 1 if any kernel got slower, so a build script can gate on it.
+
+namespace
+{
+    const int g_DataSize = 256; // Power of two, inputs are indexed with i & (g_DataSize - 1).
+    const int g_DataMask = g_DataSize - 1;
+
+    struct BenchData
+    {
+        std::vector<float>             floats;
+        std::vector<Vec3>              vec3s;
+        std::vector<Vec4>              vec4s;
+        std::vector<Mat3x3>            mat3s;
+        std::vector<Mat4x4>            mat4s;
+        std::vector<Mat3x4>            mat34s;
+        std::vector<Mat<double, 6, 6>> mat6s;
+        std::vector<unsigned short>    halfs;
+        std::vector<short>             octs;
+    };
+
+    BenchData MakeData()
+    {
+        BenchData data;
+        for (int i = 0; i < g_DataSize; ++i)
+        {
+            float a = (float) i * 0.37f - 40.0f;
+            float b = (float) (i * 7 % 31) * 0.11f + 0.5f;
+            data.floats.push_back(a * 0.05f);
+            data.vec3s.push_back(Vec3(a, b, 1.0f - a * b));
+            data.vec4s.push_back(Vec4(a, b, -b, 2.0f));
+            data.mat3s.push_back(Mat3x3(Vec3(b, a, 0.0f), Vec3(0.0f, b, a), Vec3(a, 0.0f, b)));
+            data.mat4s.push_back(Mat4x4(Vec4(b, a, 0.0f, 1.0f), Vec4(0.0f, b, a, 0.0f), Vec4(a, 0.0f, b, 2.0f), Vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+            data.mat34s.push_back(Mat3x4(data.mat4s.back()));
+
+            // Diagonally dominant, like an inertia tensor.
+            Mat<double, 6, 6> m6 = Mat<double, 6, 6>::Identity() * (4.0 + b);
+            for (int r = 0; r < 6; ++r)
+                for (int c = 0; c < 6; ++c)
+                    m6[r][c] += 0.01 * a * ((r + 2 * c) % 5 - 2);
+            data.mat6s.push_back(m6);
+        }
+        data.halfs.resize(g_DataSize * 4);
+        data.octs.resize(g_DataSize * 2);
+        return data;
+    }
+
+    std::vector<Bench::Kernel> RunKernels(BenchData& data, int samples)
+    {
+        std::vector<Bench::Kernel> kernels;
+
+        kernels.push_back(Bench::Measure(
+            "Mat4x4::operator*(Mat4x4)",
+            [&](long long n)
+            {
+                Mat4x4 acc = Mat4x4::Identity();
+                for (long long i = 0; i < n; ++i)
+                    acc = data.mat4s[i & g_DataMask] * data.mat4s[(i + 1) & g_DataMask];
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat3x4::operator*(Mat3x4)",
+            [&](long long n)
+            {
+                Mat3x4 acc = Mat3x4::Identity();
+                for (long long i = 0; i < n; ++i)
+                    acc = data.mat34s[i & g_DataMask] * data.mat34s[(i + 1) & g_DataMask];
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat4x4::operator*(Vec4)",
+            [&](long long n)
+            {
+                Vec4 acc;
+                for (long long i = 0; i < n; ++i)
+                    acc = acc + data.mat4s[i & g_DataMask] * data.vec4s[i & g_DataMask];
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat4x4::TryInverse",
+            [&](long long n)
+            {
+                Mat4x4 out;
+                int    ok = 0;
+                for (long long i = 0; i < n; ++i)
+                    ok += Mat4x4::TryInverse(data.mat4s[i & g_DataMask], out);
+                Bench::Escape(&out);
+                Bench::Escape(&ok);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat3x4::TryInverse",
+            [&](long long n)
+            {
+                Mat3x4 out;
+                int    ok = 0;
+                for (long long i = 0; i < n; ++i)
+                    ok += Mat3x4::TryInverse(data.mat34s[i & g_DataMask], out);
+                Bench::Escape(&out);
+                Bench::Escape(&ok);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat<double, 6, 6>::operator*",
+            [&](long long n)
+            {
+                Mat<double, 6, 6> acc = Mat<double, 6, 6>::Identity();
+                for (long long i = 0; i < n; ++i)
+                    acc = data.mat6s[i & g_DataMask] * data.mat6s[(i + 1) & g_DataMask];
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "TryInverse(Mat<double, 6, 6>)",
+            [&](long long n)
+            {
+                Mat<double, 6, 6> out;
+                int               ok = 0;
+                for (long long i = 0; i < n; ++i)
+                    ok += TryInverse(data.mat6s[i & g_DataMask], out);
+                Bench::Escape(&out);
+                Bench::Escape(&ok);
+            },
+            samples));
+
+        // A 120 dimensional system, the size of a constraint solver block. Diagonally dominant, so it never fails.
+        MatX system(120, 120), product;
+        for (size_t i = 0; i < system.Rows(); ++i)
+            for (size_t j = 0; j < system.Cols(); ++j)
+                system(i, j) = (float) ((i * 7 + j * 3) % 11) * 0.1f - 0.5f + (i == j ? 20.0f : 0.0f);
+        kernels.push_back(Bench::Measure(
+            "Multiply(MatX) (120 x 120)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; ++i)
+                    Multiply(system, system, product);
+                Bench::Escape(product.Row(0));
+            },
+            samples));
+
+        LUDecomposition lu;
+        kernels.push_back(Bench::Measure(
+            "LUDecomposition::Factor (120 x 120)",
+            [&](long long n)
+            {
+                int ok = 0;
+                for (long long i = 0; i < n; ++i)
+                    ok += lu.Factor(system);
+                Bench::Escape(&ok);
+            },
+            samples));
+
+        std::vector<Vec3> translations(g_DataSize), scales(g_DataSize);
+        std::vector<Quat> rotations(g_DataSize);
+        kernels.push_back(Bench::Measure(
+            "Decompose (per matrix)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    Decompose(data.mat4s.data(), g_DataSize, translations.data(), rotations.data(), scales.data());
+                Bench::Escape(rotations.data());
+            },
+            samples));
+
+        std::vector<Mat3x3> svdU(g_DataSize), svdV(g_DataSize);
+        std::vector<Vec3>   sigmas(g_DataSize);
+        kernels.push_back(Bench::Measure(
+            "SVD (per Mat3x3)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    SVD(data.mat3s.data(), g_DataSize, svdU.data(), sigmas.data(), svdV.data());
+                Bench::Escape(sigmas.data());
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "PolarDecomposition (per Mat3x3)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    PolarDecomposition(data.mat3s.data(), g_DataSize, svdU.data(), svdV.data());
+                Bench::Escape(svdU.data());
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat4x4::Determinant",
+            [&](long long n)
+            {
+                float acc = 0.0f;
+                for (long long i = 0; i < n; ++i)
+                    acc += data.mat4s[i & g_DataMask].Determinant();
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat3x3::operator*(Mat3x3)",
+            [&](long long n)
+            {
+                Mat3x3 acc;
+                for (long long i = 0; i < n; ++i)
+                    acc = data.mat3s[i & g_DataMask] * data.mat3s[(i + 1) & g_DataMask];
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat3x3::TryInverse",
+            [&](long long n)
+            {
+                Mat3x3 out;
+                int    ok = 0;
+                for (long long i = 0; i < n; ++i)
+                    ok += Mat3x3::TryInverse(data.mat3s[i & g_DataMask], out);
+                Bench::Escape(&out);
+                Bench::Escape(&ok);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Vec4::Normalize",
+            [&](long long n)
+            {
+                Vec4 acc;
+                for (long long i = 0; i < n; ++i)
+                {
+                    Vec4 v = data.vec4s[i & g_DataMask];
+                    v.Normalize();
+                    acc = acc + v;
+                }
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Vec3::Normalize",
+            [&](long long n)
+            {
+                Vec3 acc;
+                for (long long i = 0; i < n; ++i)
+                {
+                    Vec3 v = data.vec3s[i & g_DataMask];
+                    v.Normalize();
+                    acc = acc + v;
+                }
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Vec3::Cross",
+            [&](long long n)
+            {
+                Vec3 acc;
+                for (long long i = 0; i < n; ++i)
+                    acc = acc + Vec3::Cross(data.vec3s[i & g_DataMask], data.vec3s[(i + 3) & g_DataMask]);
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        std::vector<IVec3> cells(g_DataSize);
+        kernels.push_back(Bench::Measure(
+            "WorldToCell (per position)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    WorldToCell(data.vec3s.data(), g_DataSize, Vec3(-50.0f, -50.0f, -50.0f), 0.5f, cells.data());
+                Bench::Escape(cells.data());
+            },
+            samples));
+
+        std::vector<unsigned int> codes(g_DataSize);
+        AABB                      codeBounds = AABB::FromPoints(data.vec3s.data(), g_DataSize);
+        kernels.push_back(Bench::Measure(
+            "MortonCodes (per point)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    MortonCodes(data.vec3s.data(), g_DataSize, codeBounds, codes.data());
+                Bench::Escape(codes.data());
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "HilbertCodes (per point)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += g_DataSize)
+                    HilbertCodes(data.vec3s.data(), g_DataSize, codeBounds, codes.data());
+                Bench::Escape(codes.data());
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "ComputePointStats (per point)",
+            [&](long long n)
+            {
+                PointStats stats;
+                for (long long i = 0; i < n; i += g_DataSize)
+                    stats = ComputePointStats(data.vec3s.data(), g_DataSize);
+                Bench::Escape(&stats);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "FitOBB (per point)",
+            [&](long long n)
+            {
+                OBB box;
+                for (long long i = 0; i < n; i += g_DataSize)
+                    box = FitOBB(data.vec3s.data(), g_DataSize);
+                Bench::Escape(&box);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Sin",
+            [&](long long n)
+            {
+                float acc = 0.0f;
+                for (long long i = 0; i < n; ++i)
+                    acc += Sin(data.floats[i & g_DataMask]);
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Cos",
+            [&](long long n)
+            {
+                float acc = 0.0f;
+                for (long long i = 0; i < n; ++i)
+                    acc += Cos(data.floats[i & g_DataMask]);
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Tan",
+            [&](long long n)
+            {
+                float acc = 0.0f;
+                for (long long i = 0; i < n; ++i)
+                    acc += Tan(data.floats[i & g_DataMask]);
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "SinCos (per 4 angles)",
+            [&](long long n)
+            {
+                float4 acc = _mm_setzero_ps();
+                for (long long i = 0; i < n; ++i)
+                {
+                    float4 sin, cos;
+                    SinCos(_mm_loadu_ps(&data.floats[(i * 4) & (g_DataMask - 3)]), sin, cos);
+                    acc = _mm_add_ps(acc, _mm_add_ps(sin, cos));
+                }
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Mat4x4::TRS",
+            [&](long long n)
+            {
+                Vec4 acc;
+                for (long long i = 0; i < n; ++i)
+                {
+                    const Vec3& v = data.vec3s[i & g_DataMask];
+                    Mat4x4      m = Mat4x4::TRS(v, Vec3(v.y, v.z, v.x), Vec3(v.y, v.y, v.y));
+                    acc           = acc + m[0] + m[2];
+                }
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "Sqrt",
+            [&](long long n)
+            {
+                float acc = 0.0f;
+                for (long long i = 0; i < n; ++i)
+                    acc += Sqrt(Abs(data.floats[i & g_DataMask]));
+                Bench::Escape(&acc);
+            },
+            samples));
+
+        // Batch kernels process the whole array per iteration and report per element.
+        kernels.push_back(Bench::Measure(
+            "PackHalf (per Vec4)",
+            [&](long long n)
+            {
+                unsigned short* dst = data.halfs.data();
+                for (long long i = 0; i < n; i += g_DataSize)
+                    PackHalf(data.vec4s.data(), dst, g_DataSize);
+                Bench::Escape(dst);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "EncodeOct16 (per normal)",
+            [&](long long n)
+            {
+                short* dst = data.octs.data();
+                for (long long i = 0; i < n; i += g_DataSize)
+                    EncodeOct16(data.vec3s.data(), dst, g_DataSize);
+                Bench::Escape(dst);
+            },
+            samples));
+
+        kernels.push_back(Bench::Measure(
+            "IntersectRayTriangle4 (per 4 rays)",
+            [&](long long n)
+            {
+                const Vec3* v = data.vec3s.data();
+                int         hits = 0;
+                float4      t, u, w;
+                for (long long i = 0; i < n; ++i)
+                {
+                    const Vec3* r = v + ((i * 4) & (g_DataMask - 7));
+                    hits += IntersectRayTriangle4(Vec3x4::Load(r), Vec3x4::Load(r + 4), v[i & g_DataMask], v[(i + 1) & g_DataMask],
+                                                  v[(i + 2) & g_DataMask], _mm_set1_ps(100.0f), t, u, w);
+                }
+                Bench::Escape(&hits);
+                Bench::Escape(&t);
+            },
+            samples));
+
+        // 4096 points in a 16 cell cube, about one per cell like a crowd.
+        std::vector<Vec3> crowd(4096);
+        for (size_t i = 0; i < crowd.size(); ++i)
+            crowd[i] = Vec3((float) (i * 37 % 1601) * 0.01f, (float) (i * 53 % 1597) * 0.01f, (float) (i * 97 % 1607) * 0.01f);
+        HashGrid grid;
+        grid.Build(crowd.data(), crowd.size(), 1.0f);
+        kernels.push_back(Bench::Measure(
+            "HashGrid::QueryRadius",
+            [&](long long n)
+            {
+                unsigned int found = 0;
+                for (long long i = 0; i < n; ++i)
+                    grid.QueryRadius(crowd[i & 4095], 1.0f, [&](unsigned int, float) { ++found; });
+                Bench::Escape(&found);
+            },
+            samples));
+
+        KDTree tree;
+        tree.Build(crowd.data(), crowd.size());
+        kernels.push_back(Bench::Measure(
+            "KDTree::QueryKNearest (k = 8)",
+            [&](long long n)
+            {
+                unsigned int indices[8];
+                float        distances[8];
+                size_t       found = 0;
+                for (long long i = 0; i < n; ++i)
+                    found += tree.QueryKNearest(crowd[i & 4095], 8, indices, distances);
+                Bench::Escape(&found);
+                Bench::Escape(distances);
+            },
+            samples));
+
+        // Unit boxes around the crowd, unchanged between updates like a resting scene.
+        std::vector<AABB> boxes(crowd.size());
+        for (size_t i = 0; i < crowd.size(); ++i)
+            boxes[i] = AABB(crowd[i] - Vec3(0.5f, 0.5f, 0.5f), crowd[i] + Vec3(0.5f, 0.5f, 0.5f));
+        SweepAndPrune broadphase;
+        kernels.push_back(Bench::Measure(
+            "SweepAndPrune::Update (per body)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) boxes.size())
+                    broadphase.Update(boxes.data(), boxes.size());
+                Bench::Escape(&broadphase);
+            },
+            samples));
+
+        // Depths of 65536 instances with their index, sorted back to front every frame. Radix sort time doesn't
+        // depend on the input order, so sorting the already sorted keys again measures the same work.
+        std::vector<float>        depths(65536);
+        std::vector<unsigned int> instances(depths.size());
+        for (size_t i = 0; i < depths.size(); ++i)
+        {
+            depths[i]    = (float) ((i * 2654435761u) >> 12) * 0.001f;
+            instances[i] = (unsigned int) i;
+        }
+        RadixSorter sorter;
+        kernels.push_back(Bench::Measure(
+            "RadixSorter::Sort (per float key with index)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) depths.size())
+                    sorter.Sort(depths.data(), instances.data(), depths.size());
+                Bench::Escape(instances.data());
+            },
+            samples));
+
+        std::vector<float> particles(6 * crowd.size());
+        ParticleStreams    streams;
+        streams.x     = particles.data();
+        streams.y     = streams.x + crowd.size();
+        streams.z     = streams.y + crowd.size();
+        streams.vx    = streams.z + crowd.size();
+        streams.vy    = streams.vx + crowd.size();
+        streams.vz    = streams.vy + crowd.size();
+        streams.count = crowd.size();
+        for (size_t i = 0; i < crowd.size(); ++i)
+        {
+            streams.x[i] = crowd[i].x;
+            streams.y[i] = crowd[i].y;
+            streams.z[i] = crowd[i].z;
+        }
+        ParticleAttractor attractor(Vec3(8.0f, 8.0f, 8.0f), 1.0f, 0.5f);
+        ParticleForces    forces;
+        forces.gravity        = Vec3(0.0f, -9.81f, 0.0f);
+        forces.drag           = 0.1f;
+        forces.attractors     = &attractor;
+        forces.attractorCount = 1;
+        kernels.push_back(Bench::Measure(
+            "IntegrateParticles (per particle)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) crowd.size())
+                    IntegrateParticles(streams, forces, 1e-4f, PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER);
+                Bench::Escape(streams.x);
+            },
+            samples));
+
+        // The crowd as a mesh of 64 joints, 4 influences per vertex.
+        std::vector<DualQuat> palette(64);
+        for (size_t i = 0; i < palette.size(); ++i)
+            palette[i] = DualQuat::FromRotationTranslation(Quat::FromEuler(Vec3(0.01f * i, 0.02f * i, -0.03f * i)), crowd[i]);
+        std::vector<unsigned short> joints(4 * crowd.size());
+        std::vector<float>          weights(4 * crowd.size(), 0.25f);
+        std::vector<float>          skinned(3 * crowd.size());
+        for (size_t i = 0; i < joints.size(); ++i)
+            joints[i] = (unsigned short) ((i * 5 + i / 4) & 63);
+        SkinningStreams mesh;
+        mesh.x       = streams.x;
+        mesh.y       = streams.y;
+        mesh.z       = streams.z;
+        mesh.joints  = joints.data();
+        mesh.weights = weights.data();
+        mesh.outX    = skinned.data();
+        mesh.outY    = mesh.outX + crowd.size();
+        mesh.outZ    = mesh.outY + crowd.size();
+        mesh.count   = crowd.size();
+        kernels.push_back(Bench::Measure(
+            "SkinDualQuat (per vertex)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) crowd.size())
+                    SkinDualQuat(palette.data(), palette.size(), mesh);
+                Bench::Escape(mesh.outX);
+            },
+            samples));
+
+        // A clip of 1024 bones with 32 linear rotation keys each, played forward a little every call.
+        std::vector<float>          keyTimes(32);
+        std::vector<Quat>           keyRotations(32 * 1024);
+        std::vector<KeyTrack<Quat>> clip(1024);
+        std::vector<unsigned int>   cursors(clip.size(), 0);
+        std::vector<float>          pose(4 * clip.size());
+        for (size_t k = 0; k < keyTimes.size(); ++k)
+            keyTimes[k] = (float) k / 30.0f;
+        for (size_t i = 0; i < keyRotations.size(); ++i)
+            keyRotations[i] = Quat::FromEuler(crowd[i & 4095] * 0.1f);
+        for (size_t i = 0; i < clip.size(); ++i)
+            clip[i] = KeyTrack<Quat>(keyTimes.data(), &keyRotations[32 * i], keyTimes.size(), KEY_INTERPOLATION_LINEAR);
+        float clipTime = 0.0f;
+        kernels.push_back(Bench::Measure(
+            "SampleTracks (per rotation track)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) clip.size())
+                {
+                    clipTime = clipTime < 1.0f ? clipTime + 0.004f : 0.0f;
+                    SampleTracks(clip.data(), clip.size(), clipTime, cursors.data(), &pose[0], &pose[clip.size()], &pose[2 * clip.size()],
+                                 &pose[3 * clip.size()]);
+                }
+                Bench::Escape(pose.data());
+            },
+            samples));
+
+        CubicCurve<Vec3>   curve = CubicCurve<Vec3>::Bezier(crowd[0], crowd[1], crowd[2], crowd[3]);
+        std::vector<float> curveT(4096);
+        std::vector<Vec3>  curvePoints(curveT.size() + 1);
+        for (size_t i = 0; i < curveT.size(); ++i)
+            curveT[i] = (float) ((i * 2654435761u) & 4095) / 4096.0f;
+        kernels.push_back(Bench::Measure(
+            "CubicCurve::Evaluate (per point)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) curveT.size())
+                    curve.Evaluate(curveT.data(), curveT.size(), curvePoints.data());
+                Bench::Escape(curvePoints.data());
+            },
+            samples));
+        kernels.push_back(Bench::Measure(
+            "CubicCurve::SampleUniform (per point)",
+            [&](long long n)
+            {
+                for (long long i = 0; i < n; i += (long long) curveT.size())
+                    curve.SampleUniform(curveT.size(), curvePoints.data());
+                Bench::Escape(curvePoints.data());
+            },
+            samples));
+
+        return kernels;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string baselinePath = "Baseline_" + Bench::MachineName() + ".json";
+    bool        save         = false;
+    double      threshold    = 0.10;
+    double      alpha        = 0.01;
+    int         samples      = 30;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg   = argv[i];
+        bool        value = i + 1 < argc;
+        if (arg == "--save")
+            save = true;
+        else if (arg == "--baseline" && value)
+            baselinePath = argv[++i];
+        else if (arg == "--threshold" && value)
+            threshold = std::atof(argv[++i]) / 100.0;
+        else if (arg == "--alpha" && value)
+            alpha = std::atof(argv[++i]);
+        else if (arg == "--samples" && value)
+            samples = std::max(5, std::atoi(argv[++i]));
+        else
+        {
+            std::cerr << "Unknown argument " << arg << "\n";
+            return 2;
+        }
+    }
+
+    BenchData                  data    = MakeData();
+    std::vector<Bench::Kernel> current = RunKernels(data, samples);
+
+    std::vector<Bench::Kernel> baseline;
+    std::string                machine;
+    if (save || !Bench::ReadBaseline(baselinePath.c_str(), baseline, &machine))
+    {
+        if (!Bench::WriteBaseline(baselinePath.c_str(), current))
+        {
+            std::cerr << "Can't write " << baselinePath << "\n";
+            return 2;
+        }
+        std::cout << "[Bench Regression] Baseline saved to " << baselinePath << "\n";
+        return 0;
+    }
+
+    if (machine != Bench::MachineName())
+        std::cout << "Warning: baseline was recorded on " << machine << ", timings may not be comparable.\n";
+
+    int regressions = Bench::Compare(baseline, current, threshold, alpha, stdout);
+    if (regressions)
+    {
+        std::cout << "[Bench Regression] " << regressions << " kernel(s) got slower.\n";
+        return 1;
+    }
+
+    std::cout << "[Bench Regression] No regression.\n";
+    return 0;
+}
@@ -3,9 +3,29 @@
 #include "ext/utils/DM_Utils.h"
 
 #include "ext/mat/DM_Mat4x4.h"
+#include "ext/mat/DM_Mat3x4.h"
 #include "ext/mat/DM_Mat3x3.h"
 #include "ext/mat/DM_Mat2x2.h"
+#include "ext/mat/DM_MatN.h"
+
+#include "ext/quat/DM_Quat.h"
+#include "ext/quat/DM_DualQuat.h"
+#include "ext/mat/DM_Transform.h"
+#include "ext/mat/DM_SVD3.h"
+
+#include "ext/anim/DM_Animation.h"
 
 #include "ext/vec/DM_Vec4.h"
 #include "ext/vec/DM_Vec3.h"
 #include "ext/vec/DM_Vec2.h"
+#include "ext/vec/DM_Vec3x4.h"
+#include "ext/vec/DM_VecN.h"
+#include "ext/vec/DM_IVec.h"
+
+#include "ext/pack/DM_Pack.h"
+#include "ext/pack/DM_NormalPack.h"
+
+#include "ext/geom/DM_AABB.h"
+#include "ext/geom/DM_Intersect.h"
+#include "ext/geom/DM_Spline.h"
+#include "ext/geom/DM_Morton.h"
@@ -2,7 +2,24 @@
 
 #include <smmintrin.h>
 
+// F16C half-float conversion instructions. GCC and Clang only provide them with -mf16c, MSVC doesn't define __F16C__
+// but allows them with any AVX2 target (every AVX2 CPU has them).
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define DM_F16C
+#include <immintrin.h>
+#endif // defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+
+// BMI2 bit deposit and extract instructions (pdep, pext). GCC and Clang only provide them with -mbmi2, MSVC with any
+// AVX2 target. Note that they are microcoded and slow before AMD Zen 3.
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#define DM_BMI2
+#include <immintrin.h>
+#endif // defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+
 using float4 = __m128;
 using double2 = __m128d;
+using int4 = __m128i;
 
 #include <cassert>
+
+#include "DM_Profile.h"
@@ -7,4 +7,45 @@ namespace DropMath
         MATRIX_ALLIGNMENT_ROW_MAJOR,
         MATRIX_ALLIGNMENT_COLUMN_MAJOR
     };
-} // namespace DropMath
\ No newline at end of file
+
+    // Element type of an array stored in an array file.
+    enum ARRAY_TYPE
+    {
+        ARRAY_TYPE_FLOAT,
+        ARRAY_TYPE_VEC2,
+        ARRAY_TYPE_VEC3,
+        ARRAY_TYPE_VEC4,
+        ARRAY_TYPE_MAT3X3,
+        ARRAY_TYPE_MAT4X4
+    };
+
+    // Memory layout of a vector array. AoS is x y z x y z ..., SoA is x x x ... y y y ... z z z ...
+    enum ARRAY_LAYOUT
+    {
+        ARRAY_LAYOUT_AOS,
+        ARRAY_LAYOUT_SOA
+    };
+
+    // Precision of the floats of an array.
+    enum ARRAY_PRECISION
+    {
+        ARRAY_PRECISION_F32,
+        ARRAY_PRECISION_F16
+    };
+
+    // Time integration scheme of IntegrateParticles.
+    enum PARTICLE_INTEGRATOR
+    {
+        PARTICLE_INTEGRATOR_EULER,               // x += v dt, v += a dt. First order, drifts and gains energy.
+        PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER, // v += a dt, x += v dt. Symplectic, stable for orbits and springs.
+        PARTICLE_INTEGRATOR_VERLET               // Velocity Verlet. Second order, evaluates the forces twice per step.
+    };
+
+    // Interpolation between the keys of a KeyTrack.
+    enum KEY_INTERPOLATION
+    {
+        KEY_INTERPOLATION_STEP,   // Hold each key until the next one.
+        KEY_INTERPOLATION_LINEAR, // Lerp, nlerp for rotations.
+        KEY_INTERPOLATION_CUBIC   // Catmull-Rom through the keys, tangents from the neighbor keys and their times.
+    };
+} // namespace DropMath
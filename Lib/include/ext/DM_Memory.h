@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include "DM_Common.h"
+#include "DM_Constant.h"
+
+namespace DropMath
+{
+    DM_CONSTEXPR size_t CACHE_LINE_SIZE = 64;
+
+    // Allocate size bytes aligned to alignment (a power of two). Return nullptr on failure. Free with AlignedFree.
+    inline void* AlignedAlloc(size_t size, size_t alignment = CACHE_LINE_SIZE) { return _mm_malloc(size ? size : 1, alignment); }
+
+    inline void AlignedFree(void* p) { _mm_free(p); }
+
+    // Growable array with cache line aligned storage, for node and SoA buffers whose alignment std::vector doesn't
+    // guarantee before C++17. T must be trivially copyable, elements are left uninitialized by Resize.
+    template <typename T>
+    class AlignedArray
+    {
+    public:
+        AlignedArray() : m_Data(nullptr), m_Size(0), m_Capacity(0) { }
+        explicit AlignedArray(size_t size) : m_Data(nullptr), m_Size(0), m_Capacity(0) { Resize(size); }
+        ~AlignedArray() { AlignedFree(m_Data); }
+
+        AlignedArray(const AlignedArray& other) : m_Data(nullptr), m_Size(0), m_Capacity(0)
+        {
+            Resize(other.m_Size);
+            if (m_Size)
+                std::memcpy(m_Data, other.m_Data, m_Size * sizeof(T));
+        }
+        AlignedArray& operator=(const AlignedArray& other)
+        {
+            if (this != &other)
+            {
+                Resize(other.m_Size);
+                if (m_Size)
+                    std::memcpy(m_Data, other.m_Data, m_Size * sizeof(T));
+            }
+            return *this;
+        }
+        AlignedArray(AlignedArray&& other) noexcept : m_Data(other.m_Data), m_Size(other.m_Size), m_Capacity(other.m_Capacity)
+        {
+            other.m_Data     = nullptr;
+            other.m_Size     = 0;
+            other.m_Capacity = 0;
+        }
+        AlignedArray& operator=(AlignedArray&& other) noexcept
+        {
+            if (this != &other)
+            {
+                AlignedFree(m_Data);
+                m_Data           = other.m_Data;
+                m_Size           = other.m_Size;
+                m_Capacity       = other.m_Capacity;
+                other.m_Data     = nullptr;
+                other.m_Size     = 0;
+                other.m_Capacity = 0;
+            }
+            return *this;
+        }
+
+        T&       operator[](size_t i) { return m_Data[i]; }
+        const T& operator[](size_t i) const { return m_Data[i]; }
+
+        T*       Data() { return m_Data; }
+        const T* Data() const { return m_Data; }
+        size_t   Size() const { return m_Size; }
+        bool     Empty() const { return m_Size == 0; }
+
+        // Change the size, keeping the first min(size, Size()) elements.
+        void Resize(size_t size)
+        {
+            Reserve(size);
+            m_Size = size;
+        }
+
+        void Reserve(size_t capacity)
+        {
+            if (capacity <= m_Capacity)
+                return;
+            T* data = (T*) AlignedAlloc(capacity * sizeof(T));
+            assert(data && "AlignedArray allocation failed");
+            if (m_Size)
+                std::memcpy(data, m_Data, m_Size * sizeof(T));
+            AlignedFree(m_Data);
+            m_Data     = data;
+            m_Capacity = capacity;
+        }
+
+        void PushBack(const T& value)
+        {
+            T copy = value; // value may live in the storage Reserve frees.
+            if (m_Size == m_Capacity)
+                Reserve(m_Capacity ? m_Capacity * 2 : 16);
+            m_Data[m_Size++] = copy;
+        }
+
+        void Clear() { m_Size = 0; }
+
+    private:
+        T*     m_Data;
+        size_t m_Size;
+        size_t m_Capacity;
+    };
+} // namespace DropMath
@@ -0,0 +1,315 @@
+#pragma once
+
+// Opt-in instrumentation. Define DM_PROFILE (or build the Profile configuration) and every instrumented operation
+// records calls, processed elements, TSC cycles and failures into per-thread counters. Without DM_PROFILE the macros
+// below expand to nothing.
+//
+// Not instrumented: constexpr helpers (Floor, Sin, ...) because a timer can't live in a constexpr function, and
+// operations that are only a few instructions (operator+, Dot, LengthSquared, Sqrt, ...) because the timer would cost
+// more than the operation. Cycles are inclusive: a kernel that calls another instrumented kernel counts its time too.
+// Small operations built on other instrumented ones (Normalize, matrix products) use uninstrumented internals instead,
+// so one call is counted once.
+
+// X(id, name) list of every instrumented operation.
+#define DM_PROFILE_OPS(X)                                       \
+    X(VEC2_LENGTH, "Vec2::Length")                              \
+    X(VEC2_NORMALIZE, "Vec2::Normalize")                        \
+    X(VEC3_LENGTH, "Vec3::Length")                              \
+    X(VEC3_NORMALIZE, "Vec3::Normalize")                        \
+    X(VEC4_LENGTH, "Vec4::Length")                              \
+    X(VEC4_NORMALIZE, "Vec4::Normalize")                        \
+    X(MAT2X2_MUL_VEC, "Mat2x2::operator*(Vec2)")                \
+    X(MAT2X2_MUL_MAT, "Mat2x2::operator*(Mat2x2)")              \
+    X(MAT2X2_DETERMINANT, "Mat2x2::Determinant")                \
+    X(MAT2X2_TRANSPOSE, "Mat2x2::Transpose")                    \
+    X(MAT2X2_TRY_INVERSE, "Mat2x2::TryInverse")                 \
+    X(MAT3X3_MUL_VEC, "Mat3x3::operator*(Vec3)")                \
+    X(MAT3X3_MUL_MAT, "Mat3x3::operator*(Mat3x3)")              \
+    X(MAT3X3_DETERMINANT, "Mat3x3::Determinant")                \
+    X(MAT3X3_TRANSPOSE, "Mat3x3::Transpose")                    \
+    X(MAT3X3_TRY_INVERSE, "Mat3x3::TryInverse")                 \
+    X(MAT4X4_MUL_VEC, "Mat4x4::operator*(Vec4)")                \
+    X(MAT4X4_MUL_MAT, "Mat4x4::operator*(Mat4x4)")              \
+    X(MAT4X4_DETERMINANT, "Mat4x4::Determinant")                \
+    X(MAT4X4_TRANSPOSE, "Mat4x4::Transpose")                    \
+    X(MAT4X4_TRY_INVERSE, "Mat4x4::TryInverse")                 \
+    X(MAT3X4_MUL_MAT, "Mat3x4::operator*(Mat3x4)")              \
+    X(MAT3X4_TRY_INVERSE, "Mat3x4::TryInverse")                 \
+    X(DECOMPOSE, "Decompose")                                   \
+    X(TAN, "Tan")                                               \
+    X(PACK_HALF, "PackHalf")                                    \
+    X(UNPACK_HALF, "UnpackHalf")                                \
+    X(PACK_SNORM16, "PackSnorm16")                              \
+    X(UNPACK_SNORM16, "UnpackSnorm16")                          \
+    X(PACK_UNORM8, "PackUnorm8")                                \
+    X(UNPACK_UNORM8, "UnpackUnorm8")                            \
+    X(ENCODE_OCT, "EncodeOct16/EncodeOct8")                     \
+    X(DECODE_OCT, "DecodeOct16/DecodeOct8")                     \
+    X(ENCODE_QTANGENT, "EncodeQTangent")                        \
+    X(DECODE_QTANGENT, "DecodeQTangent")                        \
+    X(ARRAY_FILE_WRITE, "ArrayFileWriter::Write")               \
+    X(BVH_BUILD, "BVH::Build")                                  \
+    X(BVH_RAYCAST, "BVH::Raycast")                              \
+    X(BVH_QUERY_AABB, "BVH::QueryAABB")                         \
+    X(BVH_QUERY_SPHERE, "BVH::QuerySphere")                     \
+    X(INTERSECT_RAY_TRIANGLE, "IntersectRayTriangle4")          \
+    X(INTERSECT_RAY_AABB, "IntersectRayAABB4")                  \
+    X(HASH_GRID_BUILD, "HashGrid::Build")                       \
+    X(HASH_GRID_UPDATE, "HashGrid::Update")                     \
+    X(HASH_GRID_QUERY_RADIUS, "HashGrid::QueryRadius")          \
+    X(HASH_GRID_KNEAREST, "HashGrid::QueryKNearest")            \
+    X(KD_TREE_BUILD, "KDTree::Build")                           \
+    X(KD_TREE_KNEAREST, "KDTree::QueryKNearest")                \
+    X(KD_TREE_QUERY_RADIUS, "KDTree::QueryRadius")              \
+    X(INTEGRATE_PARTICLES, "IntegrateParticles")                \
+    X(SWEEP_AND_PRUNE_UPDATE, "SweepAndPrune::Update")          \
+    X(SKIN_DUAL_QUAT, "SkinDualQuat")                           \
+    X(SAMPLE_TRACKS, "SampleTracks")                            \
+    X(CURVE_EVALUATE, "CubicCurve::Evaluate")                   \
+    X(CURVE_SAMPLE_UNIFORM, "CubicCurve::SampleUniform")        \
+    X(CURVE_FLATTEN, "CubicCurve::Flatten")                     \
+    X(ARC_LENGTH_BUILD, "ArcLengthTable::Build")                \
+    X(ARC_LENGTH_PARAMETERS, "ArcLengthTable::Parameters")      \
+    X(WORLD_TO_CELL, "WorldToCell")                             \
+    X(MORTON_CODES, "MortonCodes")                              \
+    X(HILBERT_CODES, "HilbertCodes")                            \
+    X(RADIX_SORT, "RadixSorter::Sort")                          \
+    X(RADIX_SORT_ORDER, "RadixSorter::SortOrder")               \
+    X(MATX_MUL, "Multiply(MatX)")                               \
+    X(MATX_LU, "LUDecomposition::Factor")                       \
+    X(MATX_CHOLESKY, "CholeskyDecomposition::Factor")           \
+    X(MATX_LU_SOLVE, "LUDecomposition::Solve")                  \
+    X(MATX_CHOLESKY_SOLVE, "CholeskyDecomposition::Solve")      \
+    X(MATX_TRIANGULAR_SOLVE, "SolveLower/SolveUpper(MatX)")     \
+    X(SYMMETRIC_EIGEN, "SymmetricEigen")                        \
+    X(SVD3, "SVD")                                              \
+    X(POLAR_DECOMPOSITION, "PolarDecomposition")                \
+    X(POINT_STATS, "ComputePointStats")                         \
+    X(FIT_OBB, "FitOBB")
+
+#ifdef DM_PROFILE
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif // _MSC_VER
+
+#define DM_PROFILE_ENUM(id, name) PROFILE_OP_##id,
+#define DM_PROFILE_NAME(id, name) name,
+#define DM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define DM_PROFILE_CONCAT(a, b) DM_PROFILE_CONCAT_IMPL(a, b)
+
+// Time the rest of the enclosing scope as one call of op that processed elements items.
+#define DM_PROFILE_SCOPE(op, elements) DropMath::ProfileScope DM_PROFILE_CONCAT(dmProfileScope, __LINE__)(DropMath::op, (unsigned long long) (elements))
+// Count one failure of op (e.g. a TryInverse on a singular matrix).
+#define DM_PROFILE_FAILURE(op) DropMath::ProfileInternal::AddFailure(DropMath::op)
+
+namespace DropMath
+{
+    enum PROFILE_OP
+    {
+        DM_PROFILE_OPS(DM_PROFILE_ENUM)
+        PROFILE_OP_COUNT
+    };
+
+    struct ProfileCounter
+    {
+        unsigned long long calls;
+        unsigned long long elements;
+        unsigned long long cycles;
+        unsigned long long failures;
+    };
+
+    namespace ProfileInternal
+    {
+        typedef std::atomic<unsigned long long> Counter;
+
+        struct ThreadCounters;
+
+        struct Registry
+        {
+            std::mutex                   mutex;
+            std::vector<ThreadCounters*> threads;
+            ProfileCounter               retired[PROFILE_OP_COUNT] = {}; // Totals of threads that already exited.
+        };
+
+        inline Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        // Counters of one thread. Only the owner thread writes them so a relaxed load + store is enough,
+        // no locked instruction on the hot path. The atomics only make the reads of ProfileReport well defined.
+        struct ThreadCounters
+        {
+            Counter calls[PROFILE_OP_COUNT];
+            Counter elements[PROFILE_OP_COUNT];
+            Counter cycles[PROFILE_OP_COUNT];
+            Counter failures[PROFILE_OP_COUNT];
+
+            ThreadCounters()
+            {
+                for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+                {
+                    calls[i].store(0, std::memory_order_relaxed);
+                    elements[i].store(0, std::memory_order_relaxed);
+                    cycles[i].store(0, std::memory_order_relaxed);
+                    failures[i].store(0, std::memory_order_relaxed);
+                }
+
+                Registry&                   registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.threads.push_back(this);
+            }
+
+            ~ThreadCounters()
+            {
+                Registry&                   registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+                {
+                    registry.retired[i].calls += calls[i].load(std::memory_order_relaxed);
+                    registry.retired[i].elements += elements[i].load(std::memory_order_relaxed);
+                    registry.retired[i].cycles += cycles[i].load(std::memory_order_relaxed);
+                    registry.retired[i].failures += failures[i].load(std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < registry.threads.size(); ++i)
+                {
+                    if (registry.threads[i] == this)
+                    {
+                        registry.threads[i] = registry.threads.back();
+                        registry.threads.pop_back();
+                        break;
+                    }
+                }
+            }
+        };
+
+        inline ThreadCounters& GetThreadCounters()
+        {
+            static thread_local ThreadCounters counters;
+            return counters;
+        }
+
+        inline void Add(Counter& counter, unsigned long long value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        inline void AddFailure(PROFILE_OP op)
+        {
+            Add(GetThreadCounters().failures[op], 1);
+        }
+    } // namespace ProfileInternal
+
+    struct ProfileScope
+    {
+        ProfileScope(PROFILE_OP op, unsigned long long elements) : m_Op(op), m_Elements(elements), m_Start(__rdtsc()) { }
+        ~ProfileScope()
+        {
+            unsigned long long                end      = __rdtsc();
+            ProfileInternal::ThreadCounters& counters = ProfileInternal::GetThreadCounters();
+            ProfileInternal::Add(counters.calls[m_Op], 1);
+            ProfileInternal::Add(counters.elements[m_Op], m_Elements);
+            ProfileInternal::Add(counters.cycles[m_Op], end - m_Start);
+        }
+
+        ProfileScope(const ProfileScope&)            = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+        PROFILE_OP         m_Op;
+        unsigned long long m_Elements;
+        unsigned long long m_Start;
+    };
+
+    // Return the display name of op.
+    inline const char* ProfileOpName(PROFILE_OP op)
+    {
+        static const char* names[PROFILE_OP_COUNT] = {DM_PROFILE_OPS(DM_PROFILE_NAME)};
+        assert(op >= 0 && op < PROFILE_OP_COUNT);
+        return names[op];
+    }
+
+    // Sum the counters of every thread (alive or exited) into out[PROFILE_OP_COUNT].
+    inline void ProfileReport(ProfileCounter* out)
+    {
+        ProfileInternal::Registry&  registry = ProfileInternal::GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+        {
+            out[i] = registry.retired[i];
+            for (size_t t = 0; t < registry.threads.size(); ++t)
+            {
+                const ProfileInternal::ThreadCounters* c = registry.threads[t];
+                out[i].calls += c->calls[i].load(std::memory_order_relaxed);
+                out[i].elements += c->elements[i].load(std::memory_order_relaxed);
+                out[i].cycles += c->cycles[i].load(std::memory_order_relaxed);
+                out[i].failures += c->failures[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Zero every counter. Call it between frames, counts of operations running concurrently may be lost.
+    inline void ProfileReset()
+    {
+        ProfileInternal::Registry&  registry = ProfileInternal::GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+        {
+            registry.retired[i] = ProfileCounter();
+            for (size_t t = 0; t < registry.threads.size(); ++t)
+            {
+                ProfileInternal::ThreadCounters* c = registry.threads[t];
+                c->calls[i].store(0, std::memory_order_relaxed);
+                c->elements[i].store(0, std::memory_order_relaxed);
+                c->cycles[i].store(0, std::memory_order_relaxed);
+                c->failures[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Print every operation that was called, most cycles first.
+    inline void ProfilePrint(FILE* out)
+    {
+        ProfileCounter counters[PROFILE_OP_COUNT];
+        ProfileReport(counters);
+
+        int order[PROFILE_OP_COUNT];
+        for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+            order[i] = i;
+        for (int i = 1; i < PROFILE_OP_COUNT; ++i)
+        {
+            int key = order[i];
+            int j   = i - 1;
+            for (; j >= 0 && counters[order[j]].cycles < counters[key].cycles; --j)
+                order[j + 1] = order[j];
+            order[j + 1] = key;
+        }
+
+        std::fprintf(out, "%-32s %14s %14s %16s %12s %10s\n", "Operation", "Calls", "Elements", "Cycles", "Cycles/Elem", "Failures");
+        for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+        {
+            const ProfileCounter& c = counters[order[i]];
+            if (c.calls == 0)
+                continue;
+            double perElement = c.elements ? (double) c.cycles / (double) c.elements : 0.0;
+            std::fprintf(out, "%-32s %14llu %14llu %16llu %12.2f %10llu\n", ProfileOpName((PROFILE_OP) order[i]), c.calls, c.elements,
+                         c.cycles, perElement, c.failures);
+        }
+    }
+} // namespace DropMath
+
+#else
+
+#define DM_PROFILE_SCOPE(op, elements) ((void) 0)
+#define DM_PROFILE_FAILURE(op) ((void) 0)
+
+#endif // DM_PROFILE
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../DM_Enum.h"
+#include "../quat/DM_Quat.h"
+
+namespace DropMath
+{
+    // Keys of one animation channel, owned by the caller: a position or scale (T = Vec3) or a rotation (T = Quat)
+    // at each of count ascending times. Sampling clamps to the first and last key.
+    template <typename T>
+    struct KeyTrack
+    {
+        KeyTrack() : times(nullptr), values(nullptr), count(0), interpolation(KEY_INTERPOLATION_LINEAR) { }
+        KeyTrack(const float* times, const T* values, size_t count, KEY_INTERPOLATION interpolation)
+            : times(times), values(values), count(count), interpolation(interpolation) { }
+
+        const float*      times;
+        const T*          values;
+        size_t            count;
+        KEY_INTERPOLATION interpolation;
+    };
+
+    // Sample track at time. cursor is the key the previous sample of this track landed on (start at 0), it is
+    // updated so that playing forward or backward costs O(1) per sample; jumps fall back to a binary search.
+    inline Vec3 SampleTrack(const KeyTrack<Vec3>& track, float time, unsigned int& cursor);
+
+    // Sample track at time, see above. The result is normalized.
+    inline Quat SampleTrack(const KeyTrack<Quat>& track, float time, unsigned int& cursor);
+
+    // Sample count tracks at the same time into SoA streams, with one cursor per track. The segments are found
+    // per track, then the keys of 4 tracks are gathered into SSE registers and blended together.
+    inline void SampleTracks(const KeyTrack<Vec3>* tracks, size_t count, float time, unsigned int* cursors, float* outX, float* outY,
+                             float* outZ);
+
+    // Sample count rotation tracks at the same time into SoA streams, see above. The results are normalized.
+    inline void SampleTracks(const KeyTrack<Quat>* tracks, size_t count, float time, unsigned int* cursors, float* outX, float* outY,
+                             float* outZ, float* outW);
+} // namespace DropMath
+
+#include "DM_Animation.inl"
@@ -0,0 +1,274 @@
+namespace DropMath
+{
+    namespace
+    {
+        // A sample of a track is weights[0] * prev + weights[1] * a + weights[2] * b + weights[3] * next, with
+        // a and b the keys around the time and prev, next their neighbors (only weighted for cubic tracks).
+        struct KeyBlend
+        {
+            unsigned int keys[4];
+            float        weights[4];
+        };
+
+        // Return the key k of the segment [times[k], times[k + 1]) holding time, clamped to [0, count - 2]. The search
+        // starts at cursor and looks at its neighbors before falling back to a binary search. count >= 2.
+        inline unsigned int KeyFind(const float* times, unsigned int count, float time, unsigned int cursor)
+        {
+            unsigned int last = count - 2;
+            unsigned int k    = Min(cursor, last);
+            unsigned int lo, hi;
+            if (times[k] <= time)
+            {
+                if (k == last || time < times[k + 1])
+                    return k;
+                if (k + 1 == last || time < times[k + 2])
+                    return k + 1;
+                lo = k + 2;
+                hi = last;
+            }
+            else
+            {
+                if (k <= 1)
+                    return 0;
+                if (times[k - 1] <= time)
+                    return k - 1;
+                lo = 0;
+                hi = k - 2;
+            }
+
+            // Last key of [lo, hi] at or before time, lo when there is none.
+            while (lo < hi)
+            {
+                unsigned int mid = lo + (hi - lo + 1) / 2;
+                if (times[mid] <= time)
+                    lo = mid;
+                else
+                    hi = mid - 1;
+            }
+            return lo;
+        }
+
+        template <typename T>
+        inline KeyBlend KeyWeights(const KeyTrack<T>& track, float time, unsigned int& cursor)
+        {
+            assert(track.count > 0 && "Can't sample a track without keys.");
+            KeyBlend blend = { { 0, 0, 0, 0 }, { 0.0f, 1.0f, 0.0f, 0.0f } };
+            if (track.count == 1)
+                return blend;
+
+            unsigned int k = KeyFind(track.times, (unsigned int) track.count, time, cursor);
+            cursor         = k;
+
+            float t0 = track.times[k], t1 = track.times[k + 1], dt = t1 - t0;
+            float u  = dt > 0.0f ? Clamp((time - t0) / dt, 0.0f, 1.0f) : 1.0f;
+
+            blend.keys[0] = blend.keys[1] = k;
+            blend.keys[2] = blend.keys[3] = k + 1;
+            if (track.interpolation == KEY_INTERPOLATION_STEP)
+            {
+                blend.weights[1] = u < 1.0f ? 1.0f : 0.0f;
+                blend.weights[2] = 1.0f - blend.weights[1];
+            }
+            else if (track.interpolation == KEY_INTERPOLATION_LINEAR || dt <= 0.0f)
+            {
+                blend.weights[1] = 1.0f - u;
+                blend.weights[2] = u;
+            }
+            else
+            {
+                // Hermite basis with the Catmull-Rom tangents (b - prev) / (t1 - tPrev) and (next - a) / (tNext - t0),
+                // one sided at the ends of the track, expanded into weights of the 4 keys.
+                unsigned int prev = k > 0 ? k - 1 : k;
+                unsigned int next = k + 2 < track.count ? k + 2 : k + 1;
+                float        u2 = u * u, u3 = u2 * u;
+                float        h00 = 2.0f * u3 - 3.0f * u2 + 1.0f, h10 = u3 - 2.0f * u2 + u;
+                float        h01 = 3.0f * u2 - 2.0f * u3, h11 = u3 - u2;
+                float        ca = h10 * dt / (t1 - track.times[prev]);
+                float        cb = h11 * dt / (track.times[next] - t0);
+
+                blend.keys[0]    = prev;
+                blend.keys[3]    = next;
+                blend.weights[0] = -ca;
+                blend.weights[1] = h00 - cb;
+                blend.weights[2] = h01 + ca;
+                blend.weights[3] = cb;
+            }
+            return blend;
+        }
+
+        // Fill lanes [0, n) with the blends of tracks, the other lanes repeat lane 0. Return whether a lane is cubic.
+        template <typename T>
+        inline bool KeyWeights4(const KeyTrack<T>* tracks, size_t n, float time, unsigned int* cursors, const T* values[4],
+                                unsigned int keys[4][4], float4 weights[4])
+        {
+            alignas(16) float w[4][4];
+            bool              cubic = false;
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                if (lane < n)
+                {
+                    KeyBlend blend = KeyWeights(tracks[lane], time, cursors[lane]);
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        keys[j][lane] = blend.keys[j];
+                        w[j][lane]    = blend.weights[j];
+                    }
+                    values[lane] = tracks[lane].values;
+                    cubic |= tracks[lane].interpolation == KEY_INTERPOLATION_CUBIC;
+                    continue;
+                }
+                for (int j = 0; j < 4; ++j)
+                {
+                    keys[j][lane] = keys[j][0];
+                    w[j][lane]    = w[j][0];
+                }
+                values[lane] = values[0];
+            }
+            for (int j = 0; j < 4; ++j)
+                weights[j] = _mm_load_ps(w[j]);
+            return cubic;
+        }
+
+        inline Vec3x4 KeyGather(const Vec3* const values[4], const unsigned int keys[4])
+        {
+            Vec3 v[4] = { values[0][keys[0]], values[1][keys[1]], values[2][keys[2]], values[3][keys[3]] };
+            return Vec3x4::Load(v);
+        }
+
+        // Gather 4 quaternions and transpose them, q[c] holds component c of the 4 lanes.
+        inline void KeyGather(const Quat* const values[4], const unsigned int keys[4], float4 q[4])
+        {
+            q[0] = values[0][keys[0]].v;
+            q[1] = values[1][keys[1]].v;
+            q[2] = values[2][keys[2]].v;
+            q[3] = values[3][keys[3]].v;
+            _MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+        }
+
+        // Sign bit of every lane where the SoA quaternions a and b are on opposite hemispheres.
+        inline float4 KeyFlip(const float4 a[4], const float4 b[4])
+        {
+            float4 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])),
+                                    _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3])));
+            return _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+        }
+
+        inline Vec3x4 SampleTracks4(const KeyTrack<Vec3>* tracks, size_t n, float time, unsigned int* cursors)
+        {
+            const Vec3*  values[4];
+            unsigned int keys[4][4];
+            float4       w[4];
+            bool         cubic  = KeyWeights4(tracks, n, time, cursors, values, keys, w);
+            Vec3x4       result = KeyGather(values, keys[1]) * w[1] + KeyGather(values, keys[2]) * w[2];
+            if (cubic)
+                result = result + KeyGather(values, keys[0]) * w[0] + KeyGather(values, keys[3]) * w[3];
+            return result;
+        }
+
+        inline void SampleTracks4(const KeyTrack<Quat>* tracks, size_t n, float time, unsigned int* cursors, float4 result[4])
+        {
+            const Quat*  values[4];
+            unsigned int keys[4][4];
+            float4       w[4];
+            bool         cubic = KeyWeights4(tracks, n, time, cursors, values, keys, w);
+
+            // Rather than flipping keys onto the hemisphere of a, flip the sign of their weights.
+            float4 a[4], b[4];
+            KeyGather(values, keys[1], a);
+            KeyGather(values, keys[2], b);
+            float4 flipB = KeyFlip(a, b);
+            float4 wb    = _mm_xor_ps(w[2], flipB);
+            for (int c = 0; c < 4; ++c)
+                result[c] = _mm_add_ps(_mm_mul_ps(a[c], w[1]), _mm_mul_ps(b[c], wb));
+
+            if (cubic)
+            {
+                float4 prev[4], next[4];
+                KeyGather(values, keys[0], prev);
+                KeyGather(values, keys[3], next);
+                float4 wp = _mm_xor_ps(w[0], KeyFlip(a, prev));
+                float4 wn = _mm_xor_ps(w[3], _mm_xor_ps(flipB, KeyFlip(b, next)));
+                for (int c = 0; c < 4; ++c)
+                    result[c] = _mm_add_ps(result[c], _mm_add_ps(_mm_mul_ps(prev[c], wp), _mm_mul_ps(next[c], wn)));
+            }
+
+            float4 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(result[0], result[0]), _mm_mul_ps(result[1], result[1])),
+                                     _mm_add_ps(_mm_mul_ps(result[2], result[2]), _mm_mul_ps(result[3], result[3])));
+            float4 inv  = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len2));
+            for (int c = 0; c < 4; ++c)
+                result[c] = _mm_mul_ps(result[c], inv);
+        }
+    } // anonymous namespace
+
+    inline Vec3 SampleTrack(const KeyTrack<Vec3>& track, float time, unsigned int& cursor)
+    {
+        KeyBlend    blend = KeyWeights(track, time, cursor);
+        const Vec3* v     = track.values;
+        return v[blend.keys[0]] * blend.weights[0] + v[blend.keys[1]] * blend.weights[1] + v[blend.keys[2]] * blend.weights[2] +
+               v[blend.keys[3]] * blend.weights[3];
+    }
+
+    inline Quat SampleTrack(const KeyTrack<Quat>& track, float time, unsigned int& cursor)
+    {
+        KeyBlend    blend = KeyWeights(track, time, cursor);
+        const Quat& a     = track.values[blend.keys[1]];
+        const Quat& b     = track.values[blend.keys[2]];
+        const Quat& prev  = track.values[blend.keys[0]];
+        const Quat& next  = track.values[blend.keys[3]];
+        float       signB = Quat::Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+        float       signP = Quat::Dot(a, prev) < 0.0f ? -1.0f : 1.0f;
+        float       signN = Quat::Dot(b, next) < 0.0f ? -signB : signB;
+        Quat        q     = prev * (signP * blend.weights[0]) + a * blend.weights[1] + b * (signB * blend.weights[2]) +
+                   next * (signN * blend.weights[3]);
+        return q.Normalized();
+    }
+
+    inline void SampleTracks(const KeyTrack<Vec3>* tracks, size_t count, float time, unsigned int* cursors, float* outX, float* outY,
+                             float* outZ)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SAMPLE_TRACKS, count);
+        for (size_t i = 0; i < count; i += 4)
+        {
+            Vec3x4 v = SampleTracks4(tracks + i, Min<size_t>(count - i, 4), time, cursors + i);
+            if (i + 4 <= count)
+            {
+                v.StoreSoA(outX + i, outY + i, outZ + i);
+                continue;
+            }
+
+            for (size_t j = 0; i + j < count; ++j)
+            {
+                Vec3 tail   = v.Get((int) j);
+                outX[i + j] = tail.x;
+                outY[i + j] = tail.y;
+                outZ[i + j] = tail.z;
+            }
+        }
+    }
+
+    inline void SampleTracks(const KeyTrack<Quat>* tracks, size_t count, float time, unsigned int* cursors, float* outX, float* outY,
+                             float* outZ, float* outW)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SAMPLE_TRACKS, count);
+        float* out[4] = { outX, outY, outZ, outW };
+        for (size_t i = 0; i < count; i += 4)
+        {
+            float4 q[4];
+            SampleTracks4(tracks + i, Min<size_t>(count - i, 4), time, cursors + i, q);
+            if (i + 4 <= count)
+            {
+                for (int c = 0; c < 4; ++c)
+                    _mm_storeu_ps(out[c] + i, q[c]);
+                continue;
+            }
+
+            alignas(16) float tail[4];
+            for (int c = 0; c < 4; ++c)
+            {
+                _mm_store_ps(tail, q[c]);
+                for (size_t j = 0; i + j < count; ++j)
+                    out[c][i + j] = tail[j];
+            }
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../vec/DM_Vec3.h"
+
+namespace DropMath
+{
+    // Axis aligned bounding box. The default box is empty (min = +inf, max = -inf) so growing it works without a special case.
+    struct AABB
+    {
+        Vec3 min;
+        Vec3 max;
+
+        AABB() : min(DM_INFINITY_F, DM_INFINITY_F, DM_INFINITY_F), max(-DM_INFINITY_F, -DM_INFINITY_F, -DM_INFINITY_F) { }
+        AABB(const Vec3& min, const Vec3& max) : min(min), max(max) { }
+
+        // Return true if the box contains no point (min > max on some axis).
+        bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+        Vec3 Center() const { return (min + max) * 0.5f; }
+        Vec3 Extent() const { return max - min; }
+
+        // Surface area, the cost metric of the SAH builders. 0 for an empty box.
+        float SurfaceArea() const;
+
+        // Grow the box to contain p.
+        void Expand(const Vec3& p);
+        // Grow the box to contain b.
+        void Expand(const AABB& b);
+
+        bool Contains(const Vec3& p) const;
+        bool Overlaps(const AABB& b) const;
+
+        // Return the smallest box containing a and b.
+        static AABB Union(const AABB& a, const AABB& b);
+
+        // Return the box of count points. Empty if count is 0.
+        static AABB FromPoints(const Vec3* points, size_t count);
+    };
+} // namespace DropMath
+
+#include "DM_AABB.inl"
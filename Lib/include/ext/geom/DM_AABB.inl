@@ -0,0 +1,47 @@
+namespace DropMath
+{
+    inline float AABB::SurfaceArea() const
+    {
+        if (IsEmpty())
+            return 0.0f;
+        Vec3 e = Extent();
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    inline void AABB::Expand(const Vec3& p)
+    {
+        min = Vec3(Min(min.x, p.x), Min(min.y, p.y), Min(min.z, p.z));
+        max = Vec3(Max(max.x, p.x), Max(max.y, p.y), Max(max.z, p.z));
+    }
+
+    inline void AABB::Expand(const AABB& b)
+    {
+        min = Vec3(Min(min.x, b.min.x), Min(min.y, b.min.y), Min(min.z, b.min.z));
+        max = Vec3(Max(max.x, b.max.x), Max(max.y, b.max.y), Max(max.z, b.max.z));
+    }
+
+    inline bool AABB::Contains(const Vec3& p) const
+    {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z;
+    }
+
+    inline bool AABB::Overlaps(const AABB& b) const
+    {
+        return min.x <= b.max.x && max.x >= b.min.x && min.y <= b.max.y && max.y >= b.min.y && min.z <= b.max.z && max.z >= b.min.z;
+    }
+
+    inline AABB AABB::Union(const AABB& a, const AABB& b)
+    {
+        AABB result = a;
+        result.Expand(b);
+        return result;
+    }
+
+    inline AABB AABB::FromPoints(const Vec3* points, size_t count)
+    {
+        AABB result;
+        for (size_t i = 0; i < count; ++i)
+            result.Expand(points[i]);
+        return result;
+    }
+} // namespace DropMath
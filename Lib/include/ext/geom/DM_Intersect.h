@@ -0,0 +1,36 @@
+#pragma once
+
+#include "DM_AABB.h"
+#include "../vec/DM_Vec3x4.h"
+
+// Batch intersection kernels. Every function tests 4 ray/primitive pairs per call, one per SSE lane, and returns
+// a 4 bit hit mask (bit i set = lane i hit). Outputs of lanes that missed are unspecified.
+//
+// The Vec3x4 versions pair lane i of the rays with lane i of the primitives. The overloads taking a single ray or
+// a single primitive broadcast it, which gives the two packet shapes: 4 rays against 1 primitive (coherent rays,
+// lightmap texels) and 1 ray against 4 primitives (BVH leaves stored SoA).
+namespace DropMath
+{
+    // Moller-Trumbore ray/triangle test, double sided. A lane hits if 0 <= t <= tMax, u >= 0, v >= 0 and u + v <= 1.
+    // The hit point is origin + t * direction = (1 - u - v) * v0 + u * v1 + v * v2.
+    inline int IntersectRayTriangle4(const Vec3x4& origin, const Vec3x4& direction, const Vec3x4& v0, const Vec3x4& v1,
+                                     const Vec3x4& v2, float4 tMax, float4& t, float4& u, float4& v);
+    // 4 rays against one triangle.
+    inline int IntersectRayTriangle4(const Vec3x4& origin, const Vec3x4& direction, const Vec3& v0, const Vec3& v1, const Vec3& v2,
+                                     float4 tMax, float4& t, float4& u, float4& v);
+    // One ray against 4 triangles.
+    inline int IntersectRayTriangle4(const Vec3& origin, const Vec3& direction, const Vec3x4& v0, const Vec3x4& v1, const Vec3x4& v2,
+                                     float tMax, float4& t, float4& u, float4& v);
+
+    // Slab ray/box test. invDirection is 1 / direction per component (infinity for a zero component).
+    // A lane hits if the ray enters the box at some 0 <= t <= tMax; tEnter gets max(entry distance, 0).
+    inline int IntersectRayAABB4(const Vec3x4& origin, const Vec3x4& invDirection, const Vec3x4& boxMin, const Vec3x4& boxMax,
+                                 float4 tMax, float4& tEnter);
+    // 4 rays against one box.
+    inline int IntersectRayAABB4(const Vec3x4& origin, const Vec3x4& invDirection, const AABB& box, float4 tMax, float4& tEnter);
+    // One ray against 4 boxes.
+    inline int IntersectRayAABB4(const Vec3& origin, const Vec3& invDirection, const Vec3x4& boxMin, const Vec3x4& boxMax,
+                                 float tMax, float4& tEnter);
+} // namespace DropMath
+
+#include "DM_Intersect.inl"
@@ -0,0 +1,83 @@
+namespace DropMath
+{
+    namespace
+    {
+        // The kernels without instrumentation, which BVH::Raycast runs for every node it visits.
+        inline int RayTriangle4(const Vec3x4& origin, const Vec3x4& direction, const Vec3x4& v0, const Vec3x4& v1, const Vec3x4& v2,
+                                float4 tMax, float4& t, float4& u, float4& v)
+        {
+            const float4 zero = _mm_setzero_ps();
+            const float4 one  = _mm_set1_ps(1.0f);
+
+            Vec3x4 e1  = v1 - v0;
+            Vec3x4 e2  = v2 - v0;
+            Vec3x4 p   = Vec3x4::Cross(direction, e2);
+            float4 det = Vec3x4::Dot(e1, p);
+            // det == 0: ray parallel to the triangle plane (or degenerate triangle). The division below then gives
+            // inf or NaN, which the mask discards.
+            float4 inv = _mm_div_ps(one, det);
+
+            Vec3x4 s = origin - v0;
+            u        = _mm_mul_ps(Vec3x4::Dot(s, p), inv);
+            Vec3x4 q = Vec3x4::Cross(s, e1);
+            v        = _mm_mul_ps(Vec3x4::Dot(direction, q), inv);
+            t        = _mm_mul_ps(Vec3x4::Dot(e2, q), inv);
+
+            float4 mask = _mm_cmpneq_ps(det, zero);
+            mask        = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+            mask        = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+            mask        = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, tMax)));
+            return _mm_movemask_ps(mask);
+        }
+
+        inline int RayAABB4(const Vec3x4& origin, const Vec3x4& invDirection, const Vec3x4& boxMin, const Vec3x4& boxMax, float4 tMax,
+                            float4& tEnter)
+        {
+            Vec3x4 t1 = Vec3x4(_mm_mul_ps(_mm_sub_ps(boxMin.x, origin.x), invDirection.x), _mm_mul_ps(_mm_sub_ps(boxMin.y, origin.y), invDirection.y),
+                               _mm_mul_ps(_mm_sub_ps(boxMin.z, origin.z), invDirection.z));
+            Vec3x4 t2 = Vec3x4(_mm_mul_ps(_mm_sub_ps(boxMax.x, origin.x), invDirection.x), _mm_mul_ps(_mm_sub_ps(boxMax.y, origin.y), invDirection.y),
+                               _mm_mul_ps(_mm_sub_ps(boxMax.z, origin.z), invDirection.z));
+
+            tEnter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1.x, t2.x), _mm_min_ps(t1.y, t2.y)), _mm_max_ps(_mm_min_ps(t1.z, t2.z), _mm_setzero_ps()));
+            float4 tExit = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1.x, t2.x), _mm_max_ps(t1.y, t2.y)), _mm_min_ps(_mm_max_ps(t1.z, t2.z), tMax));
+            return _mm_movemask_ps(_mm_cmple_ps(tEnter, tExit));
+        }
+    } // anonymous namespace
+
+    inline int IntersectRayTriangle4(const Vec3x4& origin, const Vec3x4& direction, const Vec3x4& v0, const Vec3x4& v1,
+                                     const Vec3x4& v2, float4 tMax, float4& t, float4& u, float4& v)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_INTERSECT_RAY_TRIANGLE, 4);
+        return RayTriangle4(origin, direction, v0, v1, v2, tMax, t, u, v);
+    }
+
+    inline int IntersectRayTriangle4(const Vec3x4& origin, const Vec3x4& direction, const Vec3& v0, const Vec3& v1, const Vec3& v2,
+                                     float4 tMax, float4& t, float4& u, float4& v)
+    {
+        return IntersectRayTriangle4(origin, direction, Vec3x4(v0), Vec3x4(v1), Vec3x4(v2), tMax, t, u, v);
+    }
+
+    inline int IntersectRayTriangle4(const Vec3& origin, const Vec3& direction, const Vec3x4& v0, const Vec3x4& v1, const Vec3x4& v2,
+                                     float tMax, float4& t, float4& u, float4& v)
+    {
+        return IntersectRayTriangle4(Vec3x4(origin), Vec3x4(direction), v0, v1, v2, _mm_set1_ps(tMax), t, u, v);
+    }
+
+    inline int IntersectRayAABB4(const Vec3x4& origin, const Vec3x4& invDirection, const Vec3x4& boxMin, const Vec3x4& boxMax,
+                                 float4 tMax, float4& tEnter)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_INTERSECT_RAY_AABB, 4);
+        return RayAABB4(origin, invDirection, boxMin, boxMax, tMax, tEnter);
+    }
+
+    inline int IntersectRayAABB4(const Vec3x4& origin, const Vec3x4& invDirection, const AABB& box, float4 tMax, float4& tEnter)
+    {
+        return IntersectRayAABB4(origin, invDirection, Vec3x4(box.min), Vec3x4(box.max), tMax, tEnter);
+    }
+
+    inline int IntersectRayAABB4(const Vec3& origin, const Vec3& invDirection, const Vec3x4& boxMin, const Vec3x4& boxMax,
+                                 float tMax, float4& tEnter)
+    {
+        return IntersectRayAABB4(Vec3x4(origin), Vec3x4(invDirection), boxMin, boxMax, _mm_set1_ps(tMax), tEnter);
+    }
+} // namespace DropMath
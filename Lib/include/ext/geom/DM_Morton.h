@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../vec/DM_Vec3x4.h"
+#include "DM_AABB.h"
+
+namespace DropMath
+{
+    // Morton (Z-order) codes interleave the bits of the coordinates, so points close in space mostly get close codes
+    // and sorting by code gives a cache friendly order. The scalar versions use pdep / pext when DM_BMI2 is defined,
+    // the int4 versions encode 4 coordinates per SSE register with shifts and masks.
+
+    // Interleave the low 16 bits of x and y: bit i of x goes to bit 2i of the code, bit i of y to bit 2i + 1.
+    inline unsigned int MortonEncode2D(unsigned int x, unsigned int y);
+    inline void         MortonDecode2D(unsigned int code, unsigned int& x, unsigned int& y);
+
+    // Interleave the low 10 bits of x, y and z into a 30 bit code: bit i of x goes to bit 3i, y to 3i + 1, z to 3i + 2.
+    inline unsigned int MortonEncode3D(unsigned int x, unsigned int y, unsigned int z);
+    inline void         MortonDecode3D(unsigned int code, unsigned int& x, unsigned int& y, unsigned int& z);
+
+    // Same as MortonEncode3D with the low 21 bits, into a 63 bit code.
+    inline unsigned long long MortonEncode3D64(unsigned int x, unsigned int y, unsigned int z);
+    inline void               MortonDecode3D64(unsigned long long code, unsigned int& x, unsigned int& y, unsigned int& z);
+
+    // 4 lanes at once, same bits as the scalar versions.
+    inline int4 MortonEncode2D(int4 x, int4 y);
+    inline void MortonDecode2D(int4 code, int4& x, int4& y);
+    inline int4 MortonEncode3D(int4 x, int4 y, int4 z);
+    inline void MortonDecode3D(int4 code, int4& x, int4& y, int4& z);
+
+    // Index along the 3D Hilbert curve through the 2^10 cells per axis given by the low 10 bits of x, y and z (Skilling's
+    // transpose form, 30 bits). Unlike Z-order, consecutive indices are always neighbor cells, at about 6 times the
+    // cost of the Morton code.
+    inline unsigned int HilbertEncode3D(unsigned int x, unsigned int y, unsigned int z);
+    inline void         HilbertDecode3D(unsigned int code, unsigned int& x, unsigned int& y, unsigned int& z);
+
+    // 4 lanes at once, branchless.
+    inline int4 HilbertEncode3D(int4 x, int4 y, int4 z);
+    inline void HilbertDecode3D(int4 code, int4& x, int4& y, int4& z);
+
+    // Quantize each point to the 2^10 cells per axis of bounds (points outside are clamped to it) and write its 30 bit
+    // Morton code, 4 points per SSE register.
+    inline void MortonCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned int* codes);
+
+    // Same with 2^21 cells per axis and 63 bit codes.
+    inline void MortonCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned long long* codes);
+
+    // Same as the 30 bit MortonCodes with Hilbert indices.
+    inline void HilbertCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned int* codes);
+} // namespace DropMath
+
+#include "DM_Morton.inl"
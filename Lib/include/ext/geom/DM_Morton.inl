@@ -0,0 +1,366 @@
+namespace DropMath
+{
+    namespace
+    {
+        // Spread the low 16 bits of x to the even bits.
+        inline unsigned int MortonPart1By1(unsigned int x)
+        {
+            x &= 0x0000FFFFu;
+            x = (x | (x << 8)) & 0x00FF00FFu;
+            x = (x | (x << 4)) & 0x0F0F0F0Fu;
+            x = (x | (x << 2)) & 0x33333333u;
+            x = (x | (x << 1)) & 0x55555555u;
+            return x;
+        }
+
+        inline unsigned int MortonCompact1By1(unsigned int x)
+        {
+            x &= 0x55555555u;
+            x = (x ^ (x >> 1)) & 0x33333333u;
+            x = (x ^ (x >> 2)) & 0x0F0F0F0Fu;
+            x = (x ^ (x >> 4)) & 0x00FF00FFu;
+            x = (x ^ (x >> 8)) & 0x0000FFFFu;
+            return x;
+        }
+
+        // Spread the low 10 bits of x to every third bit.
+        inline unsigned int MortonPart1By2(unsigned int x)
+        {
+            x &= 0x000003FFu;
+            x = (x | (x << 16)) & 0x030000FFu;
+            x = (x | (x << 8)) & 0x0300F00Fu;
+            x = (x | (x << 4)) & 0x030C30C3u;
+            x = (x | (x << 2)) & 0x09249249u;
+            return x;
+        }
+
+        inline unsigned int MortonCompact1By2(unsigned int x)
+        {
+            x &= 0x09249249u;
+            x = (x ^ (x >> 2)) & 0x030C30C3u;
+            x = (x ^ (x >> 4)) & 0x0300F00Fu;
+            x = (x ^ (x >> 8)) & 0xFF0000FFu;
+            x = (x ^ (x >> 16)) & 0x000003FFu;
+            return x;
+        }
+
+        // Spread the low 21 bits of x to every third bit.
+        inline unsigned long long MortonPart1By2(unsigned long long x)
+        {
+            x &= 0x1FFFFFull;
+            x = (x | (x << 32)) & 0x1F00000000FFFFull;
+            x = (x | (x << 16)) & 0x1F0000FF0000FFull;
+            x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+            x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+            x = (x | (x << 2)) & 0x1249249249249249ull;
+            return x;
+        }
+
+        inline unsigned long long MortonCompact1By2(unsigned long long x)
+        {
+            x &= 0x1249249249249249ull;
+            x = (x ^ (x >> 2)) & 0x10C30C30C30C30C3ull;
+            x = (x ^ (x >> 4)) & 0x100F00F00F00F00Full;
+            x = (x ^ (x >> 8)) & 0x1F0000FF0000FFull;
+            x = (x ^ (x >> 16)) & 0x1F00000000FFFFull;
+            x = (x ^ (x >> 32)) & 0x1FFFFFull;
+            return x;
+        }
+
+        // (x | x << bits) & mask and (x ^ x >> bits) & mask on 4 lanes.
+        template <int Bits>
+        inline int4 MortonSpread(int4 x, int mask) { return _mm_and_si128(_mm_or_si128(x, _mm_slli_epi32(x, Bits)), _mm_set1_epi32(mask)); }
+        template <int Bits>
+        inline int4 MortonGather(int4 x, int mask) { return _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi32(x, Bits)), _mm_set1_epi32(mask)); }
+
+        inline int4 MortonPart1By1(int4 x)
+        {
+            x = _mm_and_si128(x, _mm_set1_epi32(0x0000FFFF));
+            x = MortonSpread<8>(x, 0x00FF00FF);
+            x = MortonSpread<4>(x, 0x0F0F0F0F);
+            x = MortonSpread<2>(x, 0x33333333);
+            return MortonSpread<1>(x, 0x55555555);
+        }
+
+        inline int4 MortonCompact1By1(int4 x)
+        {
+            x = _mm_and_si128(x, _mm_set1_epi32(0x55555555));
+            x = MortonGather<1>(x, 0x33333333);
+            x = MortonGather<2>(x, 0x0F0F0F0F);
+            x = MortonGather<4>(x, 0x00FF00FF);
+            return MortonGather<8>(x, 0x0000FFFF);
+        }
+
+        inline int4 MortonPart1By2(int4 x)
+        {
+            x = _mm_and_si128(x, _mm_set1_epi32(0x000003FF));
+            x = MortonSpread<16>(x, 0x030000FF);
+            x = MortonSpread<8>(x, 0x0300F00F);
+            x = MortonSpread<4>(x, 0x030C30C3);
+            return MortonSpread<2>(x, 0x09249249);
+        }
+
+        inline int4 MortonCompact1By2(int4 x)
+        {
+            x = _mm_and_si128(x, _mm_set1_epi32(0x09249249));
+            x = MortonGather<2>(x, 0x030C30C3);
+            x = MortonGather<4>(x, 0x0300F00F);
+            x = MortonGather<8>(x, (int) 0xFF0000FFu);
+            return MortonGather<16>(x, 0x000003FF);
+        }
+
+        // The if / else step of Skilling's transform on 4 lanes for an axis a other than 0: where bit q of a is set,
+        // invert the low bits of x0, otherwise exchange the low bits of x0 and a. For axis 0 itself only the
+        // inversion remains, see HilbertInvert.
+        inline void HilbertStep(int4& x0, int4& a, int4 q, int4 low)
+        {
+            int4 set = _mm_cmpeq_epi32(_mm_and_si128(a, q), q);
+            int4 t   = _mm_andnot_si128(set, _mm_and_si128(_mm_xor_si128(x0, a), low));
+            x0       = _mm_xor_si128(x0, _mm_or_si128(_mm_and_si128(set, low), t));
+            a        = _mm_xor_si128(a, t);
+        }
+
+        inline int4 HilbertInvert(int4 x0, int4 q, int4 low)
+        {
+            return _mm_xor_si128(x0, _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(x0, q), q), low));
+        }
+
+        // Quantize points [0, 4) to cells [0, maxCell] of each axis.
+        inline void MortonQuantize(const Vec3* points, const Vec3x4& min, const Vec3x4& scale, float4 maxCell, int4 q[3])
+        {
+            Vec3x4 p    = Vec3x4::Load(points) - min;
+            float4 zero = _mm_setzero_ps();
+            q[0]        = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(p.x, scale.x), zero), maxCell));
+            q[1]        = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(p.y, scale.y), zero), maxCell));
+            q[2]        = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(p.z, scale.z), zero), maxCell));
+        }
+
+        // Call encode(q, first, n) with the cells of points [first, first + n), n <= 4, on 2^bits cells per axis.
+        template <typename Fn>
+        inline void MortonForEach4(const Vec3* points, size_t count, const AABB& bounds, int bits, Fn encode)
+        {
+            float  cells  = (float) (1 << bits);
+            Vec3   extent = bounds.Extent();
+            Vec3x4 min(bounds.min);
+            Vec3x4 scale(Vec3(extent.x > 0.0f ? cells / extent.x : 0.0f, extent.y > 0.0f ? cells / extent.y : 0.0f,
+                              extent.z > 0.0f ? cells / extent.z : 0.0f));
+            float4 maxCell = _mm_set1_ps(cells - 1.0f);
+
+            int4   q[3];
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                MortonQuantize(points + i, min, scale, maxCell, q);
+                encode(q, i, 4);
+            }
+            if (i == count)
+                return;
+
+            // Fewer than 4 left: run them through a padded copy so the tail uses the same math.
+            Vec3 tail[4];
+            for (size_t j = 0; i + j < count; ++j)
+                tail[j] = points[i + j];
+            MortonQuantize(tail, min, scale, maxCell, q);
+            encode(q, i, count - i);
+        }
+
+        // Store lanes [0, n) of v to dst.
+        inline void MortonStore(int4 v, unsigned int* dst, size_t n)
+        {
+            if (n == 4)
+            {
+                _mm_storeu_si128(reinterpret_cast<int4*>(dst), v);
+                return;
+            }
+            alignas(16) unsigned int lanes[4];
+            _mm_store_si128(reinterpret_cast<int4*>(lanes), v);
+            for (size_t j = 0; j < n; ++j)
+                dst[j] = lanes[j];
+        }
+    } // anonymous namespace
+
+    inline unsigned int MortonEncode2D(unsigned int x, unsigned int y)
+    {
+#ifdef DM_BMI2
+        return _pdep_u32(x, 0x55555555u) | _pdep_u32(y, 0xAAAAAAAAu);
+#else
+        return MortonPart1By1(x) | (MortonPart1By1(y) << 1);
+#endif // DM_BMI2
+    }
+
+    inline void MortonDecode2D(unsigned int code, unsigned int& x, unsigned int& y)
+    {
+#ifdef DM_BMI2
+        x = _pext_u32(code, 0x55555555u);
+        y = _pext_u32(code, 0xAAAAAAAAu);
+#else
+        x = MortonCompact1By1(code);
+        y = MortonCompact1By1(code >> 1);
+#endif // DM_BMI2
+    }
+
+    inline unsigned int MortonEncode3D(unsigned int x, unsigned int y, unsigned int z)
+    {
+#ifdef DM_BMI2
+        return _pdep_u32(x, 0x09249249u) | _pdep_u32(y, 0x12492492u) | _pdep_u32(z, 0x24924924u);
+#else
+        return MortonPart1By2(x) | (MortonPart1By2(y) << 1) | (MortonPart1By2(z) << 2);
+#endif // DM_BMI2
+    }
+
+    inline void MortonDecode3D(unsigned int code, unsigned int& x, unsigned int& y, unsigned int& z)
+    {
+#ifdef DM_BMI2
+        x = _pext_u32(code, 0x09249249u);
+        y = _pext_u32(code, 0x12492492u);
+        z = _pext_u32(code, 0x24924924u);
+#else
+        x = MortonCompact1By2(code);
+        y = MortonCompact1By2(code >> 1);
+        z = MortonCompact1By2(code >> 2);
+#endif // DM_BMI2
+    }
+
+    inline unsigned long long MortonEncode3D64(unsigned int x, unsigned int y, unsigned int z)
+    {
+#ifdef DM_BMI2
+        return _pdep_u64(x, 0x1249249249249249ull) | _pdep_u64(y, 0x2492492492492492ull) | _pdep_u64(z, 0x4924924924924924ull);
+#else
+        return MortonPart1By2((unsigned long long) x) | (MortonPart1By2((unsigned long long) y) << 1) |
+               (MortonPart1By2((unsigned long long) z) << 2);
+#endif // DM_BMI2
+    }
+
+    inline void MortonDecode3D64(unsigned long long code, unsigned int& x, unsigned int& y, unsigned int& z)
+    {
+#ifdef DM_BMI2
+        x = (unsigned int) _pext_u64(code, 0x1249249249249249ull);
+        y = (unsigned int) _pext_u64(code, 0x2492492492492492ull);
+        z = (unsigned int) _pext_u64(code, 0x4924924924924924ull);
+#else
+        x = (unsigned int) MortonCompact1By2(code);
+        y = (unsigned int) MortonCompact1By2(code >> 1);
+        z = (unsigned int) MortonCompact1By2(code >> 2);
+#endif // DM_BMI2
+    }
+
+    inline int4 MortonEncode2D(int4 x, int4 y)
+    {
+        return _mm_or_si128(MortonPart1By1(x), _mm_slli_epi32(MortonPart1By1(y), 1));
+    }
+
+    inline void MortonDecode2D(int4 code, int4& x, int4& y)
+    {
+        x = MortonCompact1By1(code);
+        y = MortonCompact1By1(_mm_srli_epi32(code, 1));
+    }
+
+    inline int4 MortonEncode3D(int4 x, int4 y, int4 z)
+    {
+        return _mm_or_si128(_mm_or_si128(MortonPart1By2(x), _mm_slli_epi32(MortonPart1By2(y), 1)), _mm_slli_epi32(MortonPart1By2(z), 2));
+    }
+
+    inline void MortonDecode3D(int4 code, int4& x, int4& y, int4& z)
+    {
+        x = MortonCompact1By2(code);
+        y = MortonCompact1By2(_mm_srli_epi32(code, 1));
+        z = MortonCompact1By2(_mm_srli_epi32(code, 2));
+    }
+
+    inline unsigned int HilbertEncode3D(unsigned int x, unsigned int y, unsigned int z)
+    {
+        return (unsigned int) _mm_cvtsi128_si32(HilbertEncode3D(_mm_cvtsi32_si128((int) x), _mm_cvtsi32_si128((int) y), _mm_cvtsi32_si128((int) z)));
+    }
+
+    inline void HilbertDecode3D(unsigned int code, unsigned int& x, unsigned int& y, unsigned int& z)
+    {
+        int4 lx, ly, lz;
+        HilbertDecode3D(_mm_cvtsi32_si128((int) code), lx, ly, lz);
+        x = (unsigned int) _mm_cvtsi128_si32(lx);
+        y = (unsigned int) _mm_cvtsi128_si32(ly);
+        z = (unsigned int) _mm_cvtsi128_si32(lz);
+    }
+
+    inline int4 HilbertEncode3D(int4 x, int4 y, int4 z)
+    {
+        int4 bits = _mm_set1_epi32(0x3FF);
+        x         = _mm_and_si128(x, bits);
+        y         = _mm_and_si128(y, bits);
+        z         = _mm_and_si128(z, bits);
+
+        // Inverse undo, from the top bit down.
+        for (int q = 1 << 9; q > 1; q >>= 1)
+        {
+            int4 mq = _mm_set1_epi32(q), low = _mm_set1_epi32(q - 1);
+            x       = HilbertInvert(x, mq, low);
+            HilbertStep(x, y, mq, low);
+            HilbertStep(x, z, mq, low);
+        }
+
+        // Gray encode.
+        y      = _mm_xor_si128(y, x);
+        z      = _mm_xor_si128(z, y);
+        int4 t = _mm_setzero_si128();
+        for (int q = 1 << 9; q > 1; q >>= 1)
+        {
+            int4 mq = _mm_set1_epi32(q);
+            t       = _mm_xor_si128(t, _mm_and_si128(_mm_cmpeq_epi32(_mm_and_si128(z, mq), mq), _mm_set1_epi32(q - 1)));
+        }
+
+        // The transposed index reads bit by bit from x to z, x is the most significant of each triple.
+        return MortonEncode3D(_mm_xor_si128(z, t), _mm_xor_si128(y, t), _mm_xor_si128(x, t));
+    }
+
+    inline void HilbertDecode3D(int4 code, int4& x, int4& y, int4& z)
+    {
+        int4 a, b, c;
+        MortonDecode3D(code, c, b, a);
+
+        // Gray decode.
+        int4 t = _mm_srli_epi32(c, 1);
+        c      = _mm_xor_si128(c, b);
+        b      = _mm_xor_si128(b, a);
+        a      = _mm_xor_si128(a, t);
+
+        // Undo excess work, from the bottom bit up.
+        for (int q = 2; q != 1 << 10; q <<= 1)
+        {
+            int4 mq = _mm_set1_epi32(q), low = _mm_set1_epi32(q - 1);
+            HilbertStep(a, c, mq, low);
+            HilbertStep(a, b, mq, low);
+            a = HilbertInvert(a, mq, low);
+        }
+        x = a;
+        y = b;
+        z = c;
+    }
+
+    inline void MortonCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned int* codes)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MORTON_CODES, count);
+        MortonForEach4(points, count, bounds, 10,
+                       [&](const int4* q, size_t first, size_t n) { MortonStore(MortonEncode3D(q[0], q[1], q[2]), codes + first, n); });
+    }
+
+    inline void MortonCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned long long* codes)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MORTON_CODES, count);
+        MortonForEach4(points, count, bounds, 21,
+                       [&](const int4* q, size_t first, size_t n)
+                       {
+                           // Encoded lane by lane, with pdep when DM_BMI2 is defined.
+                           alignas(16) unsigned int cells[3][4];
+                           for (int a = 0; a < 3; ++a)
+                               _mm_store_si128(reinterpret_cast<int4*>(cells[a]), q[a]);
+                           for (size_t j = 0; j < n; ++j)
+                               codes[first + j] = MortonEncode3D64(cells[0][j], cells[1][j], cells[2][j]);
+                       });
+    }
+
+    inline void HilbertCodes(const Vec3* points, size_t count, const AABB& bounds, unsigned int* codes)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_HILBERT_CODES, count);
+        MortonForEach4(points, count, bounds, 10,
+                       [&](const int4* q, size_t first, size_t n) { MortonStore(HilbertEncode3D(q[0], q[1], q[2]), codes + first, n); });
+    }
+} // namespace DropMath
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../mat/DM_SVD3.h"
+#include "../thread/DM_ThreadPool.h"
+#include "DM_AABB.h"
+
+// Statistics and bounding volumes of Vec3 point sets, for refitting the bounds of deformed meshes every frame. Not
+// part of DropMath.h because it pulls the thread pool; include it explicitly.
+namespace DropMath
+{
+    struct PointCloudSettings
+    {
+        PointCloudSettings() : parallelThreshold(65536), pool(nullptr) { }
+
+        size_t      parallelThreshold; // Smaller point sets are reduced on the calling thread only.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Bounds, centroid and covariance of a point set.
+    struct PointStats
+    {
+        PointStats() : count(0) { }
+
+        size_t count;
+        AABB   bounds;
+        Vec3   mean;
+        Mat3x3 covariance; // Population covariance (divided by count), 0 for fewer than 2 points.
+
+        // Return the stats of the union of the point sets of a and b, with the pairwise update of Chan et al. so
+        // merging stays exact for sets whose means are far apart.
+        static PointStats Merge(const PointStats& a, const PointStats& b);
+    };
+
+    // Oriented bounding box. The columns of axes are its unit axes (a rotation), halfExtents the half sizes along them.
+    struct OBB
+    {
+        OBB() : center(), axes(Mat3x3::Identity()), halfExtents() { }
+        OBB(const Vec3& center, const Mat3x3& axes, const Vec3& halfExtents) : center(center), axes(axes), halfExtents(halfExtents) { }
+
+        Vec3   center;
+        Mat3x3 axes;
+        Vec3   halfExtents;
+
+        float Volume() const { return 8.0f * halfExtents.x * halfExtents.y * halfExtents.z; }
+
+        // Return true if p is inside the box or within tolerance of its faces.
+        bool Contains(const Vec3& p, float tolerance = 0.0f) const;
+    };
+
+    // One pass over the points, 4 at a time: the moments are accumulated in float relative to the first point of every
+    // 1024 point block and the blocks merged with PointStats::Merge. Every 16384 points are one parallel task, merged in
+    // order, so the result has the same bits for any thread count.
+    inline PointStats ComputePointStats(const Vec3* points, size_t count, const PointCloudSettings& settings = PointCloudSettings());
+
+    // Box along the principal axes of the points (the eigenvectors of the covariance, largest variance first), sized
+    // by a second pass that projects the points onto them. A default OBB for no points.
+    inline OBB FitOBB(const Vec3* points, size_t count, const PointCloudSettings& settings = PointCloudSettings());
+    // Box along the given axes (the columns of a rotation), in one pass.
+    inline OBB FitOBB(const Vec3* points, size_t count, const Mat3x3& axes, const PointCloudSettings& settings = PointCloudSettings());
+} // namespace DropMath
+
+#include "DM_PointCloud.inl"
@@ -0,0 +1,255 @@
+namespace DropMath
+{
+    namespace
+    {
+        const size_t g_POINT_STATS_BLOCK = 1024;  // Points accumulated in float relative to one shift before merging.
+        const size_t g_POINT_CLOUD_CHUNK = 16384; // Points per parallel task. Fixed, so the merge order is too.
+
+        // PointStats in double, what the blocks are merged in so the float result is only rounded once.
+        struct PointCloudMoments
+        {
+            PointCloudMoments() : count(0), mean(), covariance() { }
+
+            size_t count;
+            AABB   bounds;
+            double mean[3];
+            double covariance[3][3];
+        };
+
+        // Chan et al.: c = (na ca + nb cb) / n + delta * transpose(delta) * na nb / n^2 with delta the difference of
+        // the means, which needs no sums of squares about the origin.
+        inline PointCloudMoments PointCloudMerge(const PointCloudMoments& a, const PointCloudMoments& b)
+        {
+            if (a.count == 0)
+                return b;
+            if (b.count == 0)
+                return a;
+
+            const double n  = (double) (a.count + b.count);
+            const double wa = (double) a.count / n;
+            const double wb = (double) b.count / n;
+            double       delta[3];
+            for (int i = 0; i < 3; ++i)
+                delta[i] = b.mean[i] - a.mean[i];
+
+            PointCloudMoments result;
+            result.count  = a.count + b.count;
+            result.bounds = AABB::Union(a.bounds, b.bounds);
+            for (int i = 0; i < 3; ++i)
+            {
+                result.mean[i] = a.mean[i] + delta[i] * wb;
+                for (int j = 0; j < 3; ++j)
+                    result.covariance[i][j] = wa * a.covariance[i][j] + wb * b.covariance[i][j] + wa * wb * delta[i] * delta[j];
+            }
+            return result;
+        }
+
+        inline PointCloudMoments PointCloudToMoments(const PointStats& stats)
+        {
+            PointCloudMoments moments;
+            moments.count  = stats.count;
+            moments.bounds = stats.bounds;
+            for (int i = 0; i < 3; ++i)
+            {
+                moments.mean[i] = stats.mean.Data()[i];
+                for (int j = 0; j < 3; ++j)
+                    moments.covariance[i][j] = stats.covariance.Data()[3 * i + j];
+            }
+            return moments;
+        }
+
+        inline PointStats PointCloudToStats(const PointCloudMoments& moments)
+        {
+            PointStats stats;
+            stats.count  = moments.count;
+            stats.bounds = moments.bounds;
+            stats.mean   = Vec3((float) moments.mean[0], (float) moments.mean[1], (float) moments.mean[2]);
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    stats.covariance.Data()[3 * i + j] = (float) moments.covariance[i][j];
+            return stats;
+        }
+
+        // Lanes of v, added in double.
+        inline double PointCloudSum(float4 v)
+        {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, v);
+            return ((double) lanes[0] + lanes[1]) + ((double) lanes[2] + lanes[3]);
+        }
+
+        inline Vec3 PointCloudMin(const Vec3x4& v)
+        {
+            Vec3 lanes[4];
+            v.Store(lanes);
+            return Vec3(Min(Min(lanes[0].x, lanes[1].x), Min(lanes[2].x, lanes[3].x)), Min(Min(lanes[0].y, lanes[1].y), Min(lanes[2].y, lanes[3].y)),
+                        Min(Min(lanes[0].z, lanes[1].z), Min(lanes[2].z, lanes[3].z)));
+        }
+
+        inline Vec3 PointCloudMax(const Vec3x4& v)
+        {
+            Vec3 lanes[4];
+            v.Store(lanes);
+            return Vec3(Max(Max(lanes[0].x, lanes[1].x), Max(lanes[2].x, lanes[3].x)), Max(Max(lanes[0].y, lanes[1].y), Max(lanes[2].y, lanes[3].y)),
+                        Max(Max(lanes[0].z, lanes[1].z), Max(lanes[2].z, lanes[3].z)));
+        }
+
+        // Call fn(p) for 4 points at a time of points [0, count), count > 0. The last group is padded with points[0],
+        // which the callers make neutral.
+        template <typename Fn>
+        inline void PointCloudForEach4(const Vec3* points, size_t count, Fn fn)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+                fn(Vec3x4::Load(points + i));
+            if (i < count)
+            {
+                Vec3 padded[4] = { points[0], points[0], points[0], points[0] };
+                for (size_t k = 0; i + k < count; ++k)
+                    padded[k] = points[i + k];
+                fn(Vec3x4::Load(padded));
+            }
+        }
+
+        // Stats of a block of count points, 0 < count <= g_POINT_STATS_BLOCK. The sums are taken relative to the first
+        // point, so their size is the spread of the block rather than its distance from the origin, and the padding
+        // point adds nothing.
+        inline PointCloudMoments PointStatsBlock(const Vec3* points, size_t count)
+        {
+            const Vec3x4 shift(points[0]);
+            Vec3x4       sum, lo(points[0]), hi(points[0]);
+            float4       xx = _mm_setzero_ps(), yy = xx, zz = xx, xy = xx, xz = xx, yz = xx;
+            PointCloudForEach4(points, count,
+                               [&](const Vec3x4& p)
+                               {
+                                   const Vec3x4 d = p - shift;
+                                   sum            = sum + d;
+                                   xx             = _mm_add_ps(xx, _mm_mul_ps(d.x, d.x));
+                                   yy             = _mm_add_ps(yy, _mm_mul_ps(d.y, d.y));
+                                   zz             = _mm_add_ps(zz, _mm_mul_ps(d.z, d.z));
+                                   xy             = _mm_add_ps(xy, _mm_mul_ps(d.x, d.y));
+                                   xz             = _mm_add_ps(xz, _mm_mul_ps(d.x, d.z));
+                                   yz             = _mm_add_ps(yz, _mm_mul_ps(d.y, d.z));
+                                   lo             = Vec3x4(_mm_min_ps(lo.x, p.x), _mm_min_ps(lo.y, p.y), _mm_min_ps(lo.z, p.z));
+                                   hi             = Vec3x4(_mm_max_ps(hi.x, p.x), _mm_max_ps(hi.y, p.y), _mm_max_ps(hi.z, p.z));
+                               });
+
+            const double n    = (double) count;
+            const double s[3] = { PointCloudSum(sum.x) / n, PointCloudSum(sum.y) / n, PointCloudSum(sum.z) / n };
+            const float4 products[3][3] = { { xx, xy, xz }, { xy, yy, yz }, { xz, yz, zz } };
+
+            PointCloudMoments moments;
+            moments.count  = count;
+            moments.bounds = AABB(PointCloudMin(lo), PointCloudMax(hi));
+            for (int i = 0; i < 3; ++i)
+            {
+                moments.mean[i] = points[0].Data()[i] + s[i];
+                for (int j = 0; j < 3; ++j)
+                {
+                    const double c           = PointCloudSum(products[i][j]) / n - s[i] * s[j];
+                    moments.covariance[i][j] = i == j ? Max(c, 0.0) : c;
+                }
+            }
+            return moments;
+        }
+
+        inline PointCloudMoments PointStatsChunk(const Vec3* points, size_t count)
+        {
+            PointCloudMoments moments;
+            for (size_t first = 0; first < count; first += g_POINT_STATS_BLOCK)
+                moments = PointCloudMerge(moments, PointStatsBlock(points + first, Min(count - first, g_POINT_STATS_BLOCK)));
+            return moments;
+        }
+
+        // Bounds of the points in the frame of axes (coordinates along its columns).
+        inline AABB PointCloudProjectedBounds(const Vec3* points, size_t count, const Mat3x3& axes)
+        {
+            const float* a   = axes.Data();
+            const float4 a00 = _mm_set1_ps(a[0]), a01 = _mm_set1_ps(a[1]), a02 = _mm_set1_ps(a[2]);
+            const float4 a10 = _mm_set1_ps(a[3]), a11 = _mm_set1_ps(a[4]), a12 = _mm_set1_ps(a[5]);
+            const float4 a20 = _mm_set1_ps(a[6]), a21 = _mm_set1_ps(a[7]), a22 = _mm_set1_ps(a[8]);
+
+            Vec3x4 lo(Vec3(DM_INFINITY_F, DM_INFINITY_F, DM_INFINITY_F)), hi(Vec3(-DM_INFINITY_F, -DM_INFINITY_F, -DM_INFINITY_F));
+            PointCloudForEach4(points, count,
+                               [&](const Vec3x4& p)
+                               {
+                                   // transpose(axes) * p.
+                                   const float4 u = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p.x, a00), _mm_mul_ps(p.y, a10)), _mm_mul_ps(p.z, a20));
+                                   const float4 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p.x, a01), _mm_mul_ps(p.y, a11)), _mm_mul_ps(p.z, a21));
+                                   const float4 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(p.x, a02), _mm_mul_ps(p.y, a12)), _mm_mul_ps(p.z, a22));
+                                   lo             = Vec3x4(_mm_min_ps(lo.x, u), _mm_min_ps(lo.y, v), _mm_min_ps(lo.z, w));
+                                   hi             = Vec3x4(_mm_max_ps(hi.x, u), _mm_max_ps(hi.y, v), _mm_max_ps(hi.z, w));
+                               });
+            return AABB(PointCloudMin(lo), PointCloudMax(hi));
+        }
+
+        // merge(chunk(0), chunk(1), ...) over the g_POINT_CLOUD_CHUNK point chunks, computed in parallel and merged in
+        // order. count > 0.
+        template <typename Result, typename Chunk, typename Merge>
+        inline Result PointCloudReduce(const Vec3* points, size_t count, const PointCloudSettings& settings, Chunk chunk, Merge merge)
+        {
+            const size_t chunks = (count + g_POINT_CLOUD_CHUNK - 1) / g_POINT_CLOUD_CHUNK;
+            std::vector<Result> partial(chunks);
+            auto run = [&](size_t first, size_t last)
+            {
+                for (size_t c = first; c < last; ++c)
+                    partial[c] = chunk(points + c * g_POINT_CLOUD_CHUNK, Min(count - c * g_POINT_CLOUD_CHUNK, g_POINT_CLOUD_CHUNK));
+            };
+            if (chunks == 1 || count < settings.parallelThreshold)
+                run(0, chunks);
+            else
+            {
+                ThreadPool& pool = settings.pool ? *settings.pool : ThreadPool::Default();
+                pool.ParallelFor(0, chunks, 1, run);
+            }
+
+            Result result = partial[0];
+            for (size_t c = 1; c < chunks; ++c)
+                result = merge(result, partial[c]);
+            return result;
+        }
+    } // anonymous namespace
+
+    inline PointStats PointStats::Merge(const PointStats& a, const PointStats& b)
+    {
+        return PointCloudToStats(PointCloudMerge(PointCloudToMoments(a), PointCloudToMoments(b)));
+    }
+
+    inline bool OBB::Contains(const Vec3& p, float tolerance) const
+    {
+        const Vec3   d = p - center;
+        const float* a = axes.Data();
+        return Abs(d.x * a[0] + d.y * a[3] + d.z * a[6]) <= halfExtents.x + tolerance &&
+               Abs(d.x * a[1] + d.y * a[4] + d.z * a[7]) <= halfExtents.y + tolerance &&
+               Abs(d.x * a[2] + d.y * a[5] + d.z * a[8]) <= halfExtents.z + tolerance;
+    }
+
+    inline PointStats ComputePointStats(const Vec3* points, size_t count, const PointCloudSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_POINT_STATS, count);
+        if (count == 0)
+            return PointStats();
+        return PointCloudToStats(PointCloudReduce<PointCloudMoments>(points, count, settings, PointStatsChunk, PointCloudMerge));
+    }
+
+    inline OBB FitOBB(const Vec3* points, size_t count, const PointCloudSettings& settings)
+    {
+        if (count == 0)
+            return OBB();
+        const PointStats stats = ComputePointStats(points, count, settings);
+        Vec3             variances;
+        Mat3x3           axes;
+        SymmetricEigen(stats.covariance, variances, axes);
+        return FitOBB(points, count, axes, settings);
+    }
+
+    inline OBB FitOBB(const Vec3* points, size_t count, const Mat3x3& axes, const PointCloudSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_FIT_OBB, count);
+        if (count == 0)
+            return OBB();
+        const AABB local = PointCloudReduce<AABB>(
+            points, count, settings, [&](const Vec3* first, size_t n) { return PointCloudProjectedBounds(first, n, axes); }, AABB::Union);
+        return OBB(axes * local.Center(), axes, local.Extent() * 0.5f);
+    }
+} // namespace DropMath
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../vec/DM_Vec4.h"
+
+namespace DropMath
+{
+    // One cubic segment c0 + c1 t + c2 t^2 + c3 t^3 over t in [0, 1], the power form that Bezier, Hermite and
+    // Catmull-Rom control points convert to once, so evaluation is 3 multiply-adds whatever the basis. T is Vec2,
+    // Vec3 or Vec4.
+    template <typename T>
+    struct CubicCurve
+    {
+        float4 c[4]; // Coefficients of t^0 to t^3, components in the x, y, z, w lanes (unused lanes are 0).
+
+        // Return the point at t.
+        T Evaluate(float t) const;
+
+        // Return the derivative (tangent, not normalized) at t.
+        T Derivative(float t) const;
+
+        // Evaluate count parameters into out. 4 parameters are evaluated per SSE register, one component at a time.
+        void Evaluate(const float* t, size_t count, T* out) const;
+
+        // Write the count + 1 points at t = i / count, i in [0, count], by forward differencing: 3 additions per
+        // point. The rounding error grows with count, keep it below a few thousand.
+        void SampleUniform(size_t count, T* out) const;
+
+        // Append a polyline within tolerance of the curve to points: every point after t = 0 up to t = 1, and the
+        // point at t = 0 too when points is empty, so consecutive segments chain without duplicates. Flat parts
+        // get few points and tight turns many.
+        void Flatten(float tolerance, AlignedArray<T>& points) const;
+
+        // Create the curve of the Bezier control points p0 to p3.
+        static CubicCurve Bezier(const T& p0, const T& p1, const T& p2, const T& p3);
+
+        // Create the curve from p0 with tangent m0 to p1 with tangent m1.
+        static CubicCurve Hermite(const T& p0, const T& m0, const T& p1, const T& m1);
+
+        // Create the uniform Catmull-Rom segment from p1 to p2, with p0 and p3 the neighbor points.
+        static CubicCurve CatmullRom(const T& p0, const T& p1, const T& p2, const T& p3);
+    };
+
+    // Map from distance along a chain of curve segments to the curve parameter u in [0, segmentCount], where
+    // segment floor(u) is evaluated at u - floor(u). Lengths are measured on samplesPerSegment chords per segment,
+    // so moving by equal distances gives equal steps along the curve regardless of how its parameter speeds up.
+    class ArcLengthTable
+    {
+    public:
+        ArcLengthTable() : m_SegmentCount(0), m_SamplesPerSegment(0) { }
+
+        template <typename T>
+        void Build(const CubicCurve<T>* segments, size_t segmentCount, size_t samplesPerSegment = 32);
+
+        size_t SegmentCount() const { return m_SegmentCount; }
+
+        // Total length of the chain, 0 before Build.
+        float Length() const { return m_Lengths.Empty() ? 0.0f : m_Lengths[m_Lengths.Size() - 1]; }
+
+        // Return the parameter at distance, clamped to [0, Length()].
+        float Parameter(float distance) const;
+
+        // Return the parameters of count distances. Ascending distances, as when moving along the path, walk the
+        // table instead of searching it.
+        void Parameters(const float* distances, size_t count, float* out) const;
+
+    private:
+        // Return the sample interval [m_Lengths[i], m_Lengths[i + 1]] holding distance, walking forward from hint
+        // for a few steps before falling back to a binary search.
+        size_t Interval(float distance, size_t hint) const;
+
+        // Parameter of distance within sample interval i.
+        float ParameterIn(size_t i, float distance) const;
+
+        size_t              m_SegmentCount;
+        size_t              m_SamplesPerSegment;
+        AlignedArray<float> m_Lengths; // Distance at each sample, segmentCount * samplesPerSegment + 1 of them.
+    };
+} // namespace DropMath
+
+#include "DM_Spline.inl"
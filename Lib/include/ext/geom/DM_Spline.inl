@@ -0,0 +1,326 @@
+namespace DropMath
+{
+    namespace
+    {
+        const int g_SPLINE_MAX_DEPTH = 16; // Subdivision depth limit of Flatten, 65536 points per segment at most.
+
+        // Conversions between the point types and the x, y, z, w lanes of a register.
+        template <typename T>
+        struct SplineTraits;
+
+        template <>
+        struct SplineTraits<Vec2>
+        {
+            static const int DIM = 2;
+            static float4    Load(const Vec2& v) { return _mm_set_ps(0.0f, 0.0f, v.y, v.x); }
+            static Vec2      Store(float4 v)
+            {
+                alignas(16) float f[4];
+                _mm_store_ps(f, v);
+                return Vec2(f[0], f[1]);
+            }
+        };
+
+        template <>
+        struct SplineTraits<Vec3>
+        {
+            static const int DIM = 3;
+            static float4    Load(const Vec3& v) { return _mm_set_ps(0.0f, v.z, v.y, v.x); }
+            static Vec3      Store(float4 v)
+            {
+                alignas(16) float f[4];
+                _mm_store_ps(f, v);
+                return Vec3(f[0], f[1], f[2]);
+            }
+        };
+
+        template <>
+        struct SplineTraits<Vec4>
+        {
+            static const int DIM = 4;
+            static float4    Load(const Vec4& v) { return v.v; }
+            static Vec4      Store(float4 v) { return Vec4(v); }
+        };
+
+        inline float4 SplineMulAdd(float4 a, float4 b, float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+        // Cubic Bezier control points of a sub span of a curve.
+        struct SplineSpan
+        {
+            float4 b[4];
+            int    depth;
+        };
+
+        // SampleUniform without the profile scope, for ArcLengthTable::Build which records its own op.
+        template <typename T>
+        inline void SplineSampleUniform(const CubicCurve<T>& curve, size_t count, T* out)
+        {
+            if (count == 0)
+            {
+                out[0] = curve.Evaluate(0.0f);
+                return;
+            }
+
+            // Finite differences of the cubic at step h: the third one is constant.
+            float  h  = 1.0f / (float) count;
+            float4 h1 = _mm_set1_ps(h), h2 = _mm_set1_ps(h * h), h3 = _mm_set1_ps(h * h * h);
+            float4 c3 = _mm_mul_ps(curve.c[3], h3);
+            float4 p  = curve.c[0];
+            float4 d1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(curve.c[1], h1), _mm_mul_ps(curve.c[2], h2)), c3);
+            float4 d3 = _mm_mul_ps(c3, _mm_set1_ps(6.0f));
+            float4 d2 = _mm_add_ps(_mm_mul_ps(curve.c[2], _mm_set1_ps(2.0f * h * h)), d3);
+            for (size_t i = 0; i < count; ++i)
+            {
+                out[i] = SplineTraits<T>::Store(p);
+                p      = _mm_add_ps(p, d1);
+                d1     = _mm_add_ps(d1, d2);
+                d2     = _mm_add_ps(d2, d3);
+            }
+
+            // The end point exactly, so that consecutive segments meet.
+            out[count] = curve.Evaluate(1.0f);
+        }
+    } // anonymous namespace
+
+    template <typename T>
+    inline T CubicCurve<T>::Evaluate(float t) const
+    {
+        float4 s = _mm_set1_ps(t);
+        return SplineTraits<T>::Store(SplineMulAdd(SplineMulAdd(SplineMulAdd(c[3], s, c[2]), s, c[1]), s, c[0]));
+    }
+
+    template <typename T>
+    inline T CubicCurve<T>::Derivative(float t) const
+    {
+        float4 s  = _mm_set1_ps(t);
+        float4 c2 = _mm_mul_ps(c[2], _mm_set1_ps(2.0f)), c3 = _mm_mul_ps(c[3], _mm_set1_ps(3.0f));
+        return SplineTraits<T>::Store(SplineMulAdd(SplineMulAdd(c3, s, c2), s, c[1]));
+    }
+
+    template <typename T>
+    inline void CubicCurve<T>::Evaluate(const float* t, size_t count, T* out) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_CURVE_EVALUATE, count);
+        // Broadcast every coefficient component once, then each group of 4 parameters is 3 multiply-adds per
+        // component and a transpose back to points.
+        const int         dim = SplineTraits<T>::DIM;
+        alignas(16) float coefficients[4][4];
+        float4            b[4][4];
+        for (int j = 0; j < 4; ++j)
+        {
+            _mm_store_ps(coefficients[j], c[j]);
+            for (int k = 0; k < dim; ++k)
+                b[j][k] = _mm_set1_ps(coefficients[j][k]);
+        }
+
+        for (size_t i = 0; i < count; i += 4)
+        {
+            size_t n = Min<size_t>(count - i, 4);
+            float4 s;
+            if (n == 4)
+                s = _mm_loadu_ps(t + i);
+            else
+            {
+                alignas(16) float tail[4] = {};
+                for (size_t j = 0; j < n; ++j)
+                    tail[j] = t[i + j];
+                s = _mm_load_ps(tail);
+            }
+
+            float4 r[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+            for (int k = 0; k < dim; ++k)
+                r[k] = SplineMulAdd(SplineMulAdd(SplineMulAdd(b[3][k], s, b[2][k]), s, b[1][k]), s, b[0][k]);
+            _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+            for (size_t j = 0; j < n; ++j)
+                out[i + j] = SplineTraits<T>::Store(r[j]);
+        }
+    }
+
+    template <typename T>
+    inline void CubicCurve<T>::SampleUniform(size_t count, T* out) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_CURVE_SAMPLE_UNIFORM, count + 1);
+        SplineSampleUniform(*this, count, out);
+    }
+
+    template <typename T>
+    inline void CubicCurve<T>::Flatten(float tolerance, AlignedArray<T>& points) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_CURVE_FLATTEN, 1);
+        float4 third = _mm_set1_ps(1.0f / 3.0f), half = _mm_set1_ps(0.5f);
+
+        SplineSpan stack[g_SPLINE_MAX_DEPTH + 2];
+        int        top = 0;
+        stack[0].b[0]  = c[0];
+        stack[0].b[1]  = SplineMulAdd(c[1], third, c[0]);
+        stack[0].b[2]  = _mm_add_ps(stack[0].b[1], _mm_mul_ps(_mm_add_ps(c[1], c[2]), third));
+        stack[0].b[3]  = _mm_add_ps(_mm_add_ps(c[0], c[1]), _mm_add_ps(c[2], c[3]));
+        stack[0].depth = 0;
+        if (points.Empty())
+            points.PushBack(SplineTraits<T>::Store(c[0]));
+
+        // B(t) - chord(t) = 3 (1 - t)^2 t d1 + 3 (1 - t) t^2 d2, whose length is at most 3/4 max(|d1|, |d2|).
+        float4 limit = _mm_set1_ps(tolerance * tolerance / 0.5625f);
+        while (top >= 0)
+        {
+            SplineSpan span = stack[top--];
+            float4     d1   = _mm_sub_ps(span.b[1], _mm_mul_ps(_mm_add_ps(_mm_add_ps(span.b[0], span.b[0]), span.b[3]), third));
+            float4     d2   = _mm_sub_ps(span.b[2], _mm_mul_ps(_mm_add_ps(_mm_add_ps(span.b[3], span.b[3]), span.b[0]), third));
+            float4     err  = _mm_max_ss(_mm_dp_ps(d1, d1, 0xF1), _mm_dp_ps(d2, d2, 0xF1));
+            if (span.depth == g_SPLINE_MAX_DEPTH || _mm_comile_ss(err, limit))
+            {
+                points.PushBack(SplineTraits<T>::Store(span.b[3]));
+                continue;
+            }
+
+            // Split in halves with de Casteljau, the first half on top so the points come out in order.
+            float4 ab  = _mm_mul_ps(_mm_add_ps(span.b[0], span.b[1]), half);
+            float4 bc  = _mm_mul_ps(_mm_add_ps(span.b[1], span.b[2]), half);
+            float4 cd  = _mm_mul_ps(_mm_add_ps(span.b[2], span.b[3]), half);
+            float4 abc = _mm_mul_ps(_mm_add_ps(ab, bc), half);
+            float4 bcd = _mm_mul_ps(_mm_add_ps(bc, cd), half);
+            float4 mid = _mm_mul_ps(_mm_add_ps(abc, bcd), half);
+
+            SplineSpan& second = stack[++top];
+            second.b[0]        = mid;
+            second.b[1]        = bcd;
+            second.b[2]        = cd;
+            second.b[3]        = span.b[3];
+            second.depth       = span.depth + 1;
+
+            SplineSpan& first = stack[++top];
+            first.b[0]        = span.b[0];
+            first.b[1]        = ab;
+            first.b[2]        = abc;
+            first.b[3]        = mid;
+            first.depth       = span.depth + 1;
+        }
+    }
+
+    template <typename T>
+    inline CubicCurve<T> CubicCurve<T>::Bezier(const T& p0, const T& p1, const T& p2, const T& p3)
+    {
+        float4 a = SplineTraits<T>::Load(p0), b = SplineTraits<T>::Load(p1);
+        float4 c = SplineTraits<T>::Load(p2), d = SplineTraits<T>::Load(p3);
+        float4 three = _mm_set1_ps(3.0f);
+
+        // c0 = a, c1 = 3 (b - a), c2 = 3 (a - 2b + c), c3 = d - a + 3 (b - c).
+        CubicCurve curve;
+        curve.c[0] = a;
+        curve.c[1] = _mm_mul_ps(_mm_sub_ps(b, a), three);
+        curve.c[2] = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(a, _mm_add_ps(b, b)), c), three);
+        curve.c[3] = _mm_add_ps(_mm_sub_ps(d, a), _mm_mul_ps(_mm_sub_ps(b, c), three));
+        return curve;
+    }
+
+    template <typename T>
+    inline CubicCurve<T> CubicCurve<T>::Hermite(const T& p0, const T& m0, const T& p1, const T& m1)
+    {
+        float4 a = SplineTraits<T>::Load(p0), ma = SplineTraits<T>::Load(m0);
+        float4 b = SplineTraits<T>::Load(p1), mb = SplineTraits<T>::Load(m1);
+        float4 diff = _mm_sub_ps(b, a);
+
+        // c0 = p0, c1 = m0, c2 = 3 (p1 - p0) - 2 m0 - m1, c3 = 2 (p0 - p1) + m0 + m1.
+        CubicCurve curve;
+        curve.c[0] = a;
+        curve.c[1] = ma;
+        curve.c[2] = _mm_sub_ps(_mm_mul_ps(diff, _mm_set1_ps(3.0f)), _mm_add_ps(_mm_add_ps(ma, ma), mb));
+        curve.c[3] = _mm_sub_ps(_mm_add_ps(ma, mb), _mm_add_ps(diff, diff));
+        return curve;
+    }
+
+    template <typename T>
+    inline CubicCurve<T> CubicCurve<T>::CatmullRom(const T& p0, const T& p1, const T& p2, const T& p3)
+    {
+        // Hermite from p1 to p2 with the tangents (p2 - p0) / 2 and (p3 - p1) / 2.
+        return Hermite(p1, (p2 - p0) * 0.5f, p2, (p3 - p1) * 0.5f);
+    }
+
+    template <typename T>
+    inline void ArcLengthTable::Build(const CubicCurve<T>* segments, size_t segmentCount, size_t samplesPerSegment)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ARC_LENGTH_BUILD, segmentCount * Max<size_t>(samplesPerSegment, 1));
+        m_SegmentCount      = segmentCount;
+        m_SamplesPerSegment = Max<size_t>(samplesPerSegment, 1);
+        m_Lengths.Clear();
+        if (segmentCount == 0)
+            return;
+
+        m_Lengths.Resize(segmentCount * m_SamplesPerSegment + 1);
+        m_Lengths[0] = 0.0f;
+
+        AlignedArray<T> samples;
+        samples.Resize(m_SamplesPerSegment + 1);
+        float length = 0.0f;
+        for (size_t s = 0; s < segmentCount; ++s)
+        {
+            SplineSampleUniform(segments[s], m_SamplesPerSegment, samples.Data());
+            float4 previous = SplineTraits<T>::Load(samples[0]);
+            for (size_t i = 1; i <= m_SamplesPerSegment; ++i)
+            {
+                float4 current = SplineTraits<T>::Load(samples[i]);
+                float4 chord   = _mm_sub_ps(current, previous);
+                length += _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(chord, chord, 0xF1)));
+                m_Lengths[s * m_SamplesPerSegment + i] = length;
+                previous                               = current;
+            }
+        }
+    }
+
+    inline size_t ArcLengthTable::Interval(float distance, size_t hint) const
+    {
+        size_t last = m_Lengths.Size() - 2;
+        size_t lo   = 0;
+        if (hint <= last && m_Lengths[hint] <= distance)
+        {
+            for (int step = 0; step < 4; ++step, ++hint)
+            {
+                if (hint == last || distance < m_Lengths[hint + 1])
+                    return hint;
+            }
+            lo = hint;
+        }
+
+        // Last sample of [lo, last] at or before distance.
+        size_t hi = last;
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo + 1) / 2;
+            if (m_Lengths[mid] <= distance)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        return lo;
+    }
+
+    inline float ArcLengthTable::ParameterIn(size_t i, float distance) const
+    {
+        float span = m_Lengths[i + 1] - m_Lengths[i];
+        float t    = span > 0.0f ? Clamp((distance - m_Lengths[i]) / span, 0.0f, 1.0f) : 0.0f;
+        return ((float) i + t) / (float) m_SamplesPerSegment;
+    }
+
+    inline float ArcLengthTable::Parameter(float distance) const
+    {
+        if (m_Lengths.Empty())
+            return 0.0f;
+        return ParameterIn(Interval(distance, 0), distance);
+    }
+
+    inline void ArcLengthTable::Parameters(const float* distances, size_t count, float* out) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ARC_LENGTH_PARAMETERS, count);
+        size_t hint = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (m_Lengths.Empty())
+            {
+                out[i] = 0.0f;
+                continue;
+            }
+            hint   = Interval(distances[i], hint);
+            out[i] = ParameterIn(hint, distances[i]);
+        }
+    }
+} // namespace DropMath
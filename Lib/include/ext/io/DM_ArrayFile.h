@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "../DM_Enum.h"
+#include "../mat/DM_Mat4x4.h"
+#include "../mat/DM_Mat3x3.h"
+#include "../pack/DM_Pack.h"
+
+// Binary container for large Vec/Mat arrays. Not part of DropMath.h because it pulls the OS file mapping headers.
+//
+// File layout (little endian), every offset is a multiple of ARRAY_FILE_ALIGNMENT:
+//   ArrayFileHeader
+//   section data...        (SoA sections store one aligned stream per component)
+//   ArrayFileSection[sectionCount]
+namespace DropMath
+{
+    DM_CONSTEXPR unsigned int ARRAY_FILE_MAGIC     = 0x46414D44; // "DMAF"
+    DM_CONSTEXPR unsigned int ARRAY_FILE_VERSION   = 1;
+    DM_CONSTEXPR unsigned int ARRAY_FILE_ALIGNMENT = 64; // Cache line, enough for any SIMD load.
+
+    struct ArrayFileHeader
+    {
+        unsigned int       magic;
+        unsigned int       version;
+        unsigned int       sectionCount;
+        unsigned int       reserved;
+        unsigned long long tableOffset; // Offset of the ArrayFileSection table.
+        unsigned long long pad[5];
+    };
+
+    struct ArrayFileSection
+    {
+        char               name[32];   // Zero terminated.
+        unsigned int       type;       // ARRAY_TYPE.
+        unsigned int       layout;     // ARRAY_LAYOUT.
+        unsigned int       alignment;  // MATRIX_ALLIGNMENT, only meaningful for matrix types.
+        unsigned int       precision;  // ARRAY_PRECISION.
+        unsigned long long count;      // Number of elements (vectors or matrices).
+        unsigned long long offset;     // Offset of the first stream.
+        unsigned long long stride;     // Distance between the component streams of a SoA section, 0 for AoS.
+        unsigned long long size;       // Total bytes of the section data.
+    };
+
+    static_assert(sizeof(ArrayFileHeader) == 64, "ArrayFileHeader must stay 64 bytes.");
+    static_assert(sizeof(ArrayFileSection) == 80, "ArrayFileSection must stay 80 bytes.");
+
+    // Number of floats in one element of type.
+    inline int ArrayTypeComponents(ARRAY_TYPE type);
+
+    // Maps a DropMath type to its ARRAY_TYPE.
+    template <typename T>
+    struct ArrayTypeOf;
+
+    // Read only view of an array file. The file is memory mapped so views point straight into the file
+    // and stay valid until Close() or the destructor.
+    class ArrayFileReader
+    {
+    public:
+        ArrayFileReader() : m_Data(nullptr), m_Size(0), m_Header(nullptr), m_Sections(nullptr) { }
+        ~ArrayFileReader() { Close(); }
+
+        ArrayFileReader(const ArrayFileReader&)            = delete;
+        ArrayFileReader& operator=(const ArrayFileReader&) = delete;
+
+        // Map and validate the file. Return false if it can't be mapped or isn't a valid array file.
+        bool Open(const char* path);
+
+        // Unmap the file. All views become invalid.
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+
+        int SectionCount() const { return m_Header ? (int) m_Header->sectionCount : 0; }
+
+        const ArrayFileSection& Section(int i) const;
+
+        // Return the index of the section called name, or -1.
+        int FindSection(const char* name) const;
+
+        // Zero copy view of an AoS F32 section of type T. Matrices must be row major.
+        // Return nullptr if the section doesn't match. The pointer is ARRAY_FILE_ALIGNMENT aligned.
+        template <typename T>
+        const T* View(int section) const;
+
+        // Zero copy view of component (0 = x, 1 = y, ...) of a SoA F32 section. Return nullptr if the section doesn't match.
+        const float* Stream(int section, int component) const;
+
+        // Raw bytes of a section, for F16 or column major data. component selects the stream of a SoA section.
+        const void* Data(int section, int component = 0) const;
+
+    private:
+        const unsigned char*    m_Data;
+        unsigned long long      m_Size;
+        const ArrayFileHeader*  m_Header;
+        const ArrayFileSection* m_Sections;
+    };
+
+    // Streaming writer. Sections are written one after another, data is converted to the section precision,
+    // layout and matrix alignment on the fly so the whole array never needs to be in memory.
+    class ArrayFileWriter
+    {
+    public:
+        ArrayFileWriter() : m_File(nullptr), m_Cursor(0), m_End(0), m_Failed(false), m_Dropped(false), m_InSection(false), m_Written(0), m_Current() { }
+        ~ArrayFileWriter() { Close(); }
+
+        ArrayFileWriter(const ArrayFileWriter&)            = delete;
+        ArrayFileWriter& operator=(const ArrayFileWriter&) = delete;
+
+        // Create or truncate path. Return false if it can't be opened.
+        bool Open(const char* path);
+
+        // Start a section. count is required for SoA sections (streams are laid out up front)
+        // and can be 0 for AoS sections to mean "whatever gets written".
+        // Matrix sections must be AoS. Return false on misuse.
+        bool BeginSection(const char* name, ARRAY_TYPE type, unsigned long long count = 0,
+                          ARRAY_LAYOUT layout = ARRAY_LAYOUT_AOS, ARRAY_PRECISION precision = ARRAY_PRECISION_F32,
+                          MATRIX_ALLIGNMENT alignment = MATRIX_ALLIGNMENT_ROW_MAJOR);
+
+        // Append count elements to the current section. The type must match the section type.
+        bool Write(const float* data, size_t count);
+        bool Write(const Vec2* data, size_t count);
+        bool Write(const Vec3* data, size_t count);
+        bool Write(const Vec4* data, size_t count);
+        bool Write(const Mat3x3* data, size_t count);
+        bool Write(const Mat4x4* data, size_t count);
+
+        // Finish the current section. Return false if a SoA section got fewer elements than announced, the section
+        // is then dropped and Close() fails.
+        bool EndSection();
+
+        // Write the section table and header, ending an open section. Return false if anything failed to write
+        // or a section was dropped. Called by the destructor if needed.
+        bool Close();
+
+    private:
+        bool WriteElements(ARRAY_TYPE type, const float* data, size_t count);
+        bool WriteFloats(const float* data, size_t count, unsigned long long offset);
+        bool WriteBytes(const void* data, size_t size, unsigned long long offset);
+        bool PadTo(unsigned long long offset);
+
+        FILE*                         m_File;
+        unsigned long long            m_Cursor; // Current file pointer.
+        unsigned long long            m_End;    // Furthest byte written.
+        bool                          m_Failed;
+        bool                          m_Dropped; // A section was left short.
+        bool                          m_InSection;
+        unsigned long long            m_Written;
+        ArrayFileSection              m_Current;
+        std::vector<ArrayFileSection> m_Sections;
+    };
+} // namespace DropMath
+
+#include "DM_ArrayFile.inl"
@@ -0,0 +1,469 @@
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif // WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace DropMath
+{
+    namespace
+    {
+        inline unsigned long long AlignArrayOffset(unsigned long long offset)
+        {
+            return (offset + ARRAY_FILE_ALIGNMENT - 1) & ~(unsigned long long) (ARRAY_FILE_ALIGNMENT - 1);
+        }
+
+        inline bool IsMatrixType(unsigned int type)
+        {
+            return type == ARRAY_TYPE_MAT3X3 || type == ARRAY_TYPE_MAT4X4;
+        }
+
+        inline unsigned int PrecisionBytes(unsigned int precision)
+        {
+            return precision == ARRAY_PRECISION_F16 ? 2 : 4;
+        }
+
+        // Check a section describes data that really is inside the file before handing out pointers to it.
+        inline bool IsValidSection(const ArrayFileSection& s, unsigned long long dataEnd)
+        {
+            if (s.type > ARRAY_TYPE_MAT4X4 || s.layout > ARRAY_LAYOUT_SOA || s.precision > ARRAY_PRECISION_F16 ||
+                s.alignment > MATRIX_ALLIGNMENT_COLUMN_MAJOR)
+                return false;
+            if (IsMatrixType(s.type) && s.layout != ARRAY_LAYOUT_AOS)
+                return false;
+            if (s.offset % ARRAY_FILE_ALIGNMENT != 0 || s.offset > dataEnd || s.size > dataEnd - s.offset)
+                return false;
+            if (s.name[sizeof(s.name) - 1] != '\0')
+                return false;
+
+            unsigned long long components = (unsigned long long) ArrayTypeComponents((ARRAY_TYPE) s.type);
+            unsigned long long elemBytes  = PrecisionBytes(s.precision);
+            if (s.count > dataEnd / (components * elemBytes))
+                return false;
+
+            if (s.layout == ARRAY_LAYOUT_AOS)
+                return s.stride == 0 && s.size == s.count * components * elemBytes;
+            return s.stride % ARRAY_FILE_ALIGNMENT == 0 && s.stride >= s.count * elemBytes &&
+                   s.stride <= dataEnd / components && s.size == s.stride * components;
+        }
+    } // anonymous namespace
+
+    inline int ArrayTypeComponents(ARRAY_TYPE type)
+    {
+        switch (type)
+        {
+        case ARRAY_TYPE_FLOAT:
+            return 1;
+        case ARRAY_TYPE_VEC2:
+            return 2;
+        case ARRAY_TYPE_VEC3:
+            return 3;
+        case ARRAY_TYPE_VEC4:
+            return 4;
+        case ARRAY_TYPE_MAT3X3:
+            return 9;
+        case ARRAY_TYPE_MAT4X4:
+            return 16;
+        default:
+            assert(false && "Unknown array type.");
+            return 1;
+        }
+    }
+
+    template <>
+    struct ArrayTypeOf<float>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_FLOAT;
+    };
+    template <>
+    struct ArrayTypeOf<Vec2>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_VEC2;
+    };
+    template <>
+    struct ArrayTypeOf<Vec3>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_VEC3;
+    };
+    template <>
+    struct ArrayTypeOf<Vec4>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_VEC4;
+    };
+    template <>
+    struct ArrayTypeOf<Mat3x3>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_MAT3X3;
+    };
+    template <>
+    struct ArrayTypeOf<Mat4x4>
+    {
+        static DM_CONSTEXPR ARRAY_TYPE TYPE = ARRAY_TYPE_MAT4X4;
+    };
+
+    inline bool ArrayFileReader::Open(const char* path)
+    {
+        Close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG) sizeof(ArrayFileHeader))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping); // The view keeps the mapping alive.
+        if (!data)
+            return false;
+
+        m_Data = static_cast<const unsigned char*>(data);
+        m_Size = (unsigned long long) size.QuadPart;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(ArrayFileHeader))
+        {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping keeps the file alive.
+        if (data == MAP_FAILED)
+            return false;
+
+        m_Data = static_cast<const unsigned char*>(data);
+        m_Size = (unsigned long long) st.st_size;
+#endif // _WIN32
+
+        const ArrayFileHeader* header = reinterpret_cast<const ArrayFileHeader*>(m_Data);
+        bool valid = header->magic == ARRAY_FILE_MAGIC && header->version == ARRAY_FILE_VERSION &&
+                     header->tableOffset % ARRAY_FILE_ALIGNMENT == 0 && header->tableOffset <= m_Size &&
+                     header->sectionCount <= (m_Size - header->tableOffset) / sizeof(ArrayFileSection);
+        if (valid)
+        {
+            const ArrayFileSection* sections = reinterpret_cast<const ArrayFileSection*>(m_Data + header->tableOffset);
+            for (unsigned int i = 0; i < header->sectionCount && valid; ++i)
+                valid = IsValidSection(sections[i], header->tableOffset);
+
+            m_Header   = header;
+            m_Sections = sections;
+        }
+
+        if (!valid)
+            Close();
+        return valid;
+    }
+
+    inline void ArrayFileReader::Close()
+    {
+        if (m_Data)
+        {
+#ifdef _WIN32
+            UnmapViewOfFile(m_Data);
+#else
+            munmap(const_cast<unsigned char*>(m_Data), (size_t) m_Size);
+#endif // _WIN32
+        }
+        m_Data     = nullptr;
+        m_Size     = 0;
+        m_Header   = nullptr;
+        m_Sections = nullptr;
+    }
+
+    inline const ArrayFileSection& ArrayFileReader::Section(int i) const
+    {
+        assert(i >= 0 && i < SectionCount());
+        return m_Sections[i];
+    }
+
+    inline int ArrayFileReader::FindSection(const char* name) const
+    {
+        for (int i = 0; i < SectionCount(); ++i)
+        {
+            if (std::strcmp(m_Sections[i].name, name) == 0)
+                return i;
+        }
+        return -1;
+    }
+
+    template <typename T>
+    inline const T* ArrayFileReader::View(int section) const
+    {
+        const ArrayFileSection& s = Section(section);
+        if (s.type != (unsigned int) ArrayTypeOf<T>::TYPE || s.layout != ARRAY_LAYOUT_AOS || s.precision != ARRAY_PRECISION_F32)
+            return nullptr;
+        if (IsMatrixType(s.type) && s.alignment != MATRIX_ALLIGNMENT_ROW_MAJOR)
+            return nullptr;
+        return reinterpret_cast<const T*>(m_Data + s.offset);
+    }
+
+    inline const float* ArrayFileReader::Stream(int section, int component) const
+    {
+        const ArrayFileSection& s = Section(section);
+        if (s.layout != ARRAY_LAYOUT_SOA || s.precision != ARRAY_PRECISION_F32)
+            return nullptr;
+        return static_cast<const float*>(Data(section, component));
+    }
+
+    inline const void* ArrayFileReader::Data(int section, int component) const
+    {
+        const ArrayFileSection& s = Section(section);
+        assert(component >= 0 && component < (s.layout == ARRAY_LAYOUT_SOA ? ArrayTypeComponents((ARRAY_TYPE) s.type) : 1));
+        return m_Data + s.offset + s.stride * component;
+    }
+
+    inline bool ArrayFileWriter::Open(const char* path)
+    {
+        Close();
+
+        m_File = std::fopen(path, "wb");
+        if (!m_File)
+            return false;
+
+        m_Cursor    = 0;
+        m_End       = 0;
+        m_Failed    = false;
+        m_Dropped   = false;
+        m_InSection = false;
+        m_Sections.clear();
+
+        // Placeholder, the real header is written by Close() once the table offset is known.
+        ArrayFileHeader header = {};
+        return WriteBytes(&header, sizeof(header), 0);
+    }
+
+    inline bool ArrayFileWriter::BeginSection(const char* name, ARRAY_TYPE type, unsigned long long count, ARRAY_LAYOUT layout,
+                                              ARRAY_PRECISION precision, MATRIX_ALLIGNMENT alignment)
+    {
+        if (!m_File || m_InSection)
+            return false;
+        if (IsMatrixType(type) && layout != ARRAY_LAYOUT_AOS)
+            return false;
+        if (layout == ARRAY_LAYOUT_SOA && count == 0)
+            return false;
+
+        m_Current = ArrayFileSection();
+        std::strncpy(m_Current.name, name, sizeof(m_Current.name) - 1);
+        m_Current.type      = type;
+        m_Current.layout    = layout;
+        m_Current.alignment = alignment;
+        m_Current.precision = precision;
+        m_Current.count     = count;
+        m_Current.offset    = AlignArrayOffset(m_End);
+        m_Current.stride    = layout == ARRAY_LAYOUT_SOA ? AlignArrayOffset(count * PrecisionBytes(precision)) : 0;
+
+        m_InSection = true;
+        m_Written   = 0;
+        return PadTo(m_Current.offset);
+    }
+
+    inline bool ArrayFileWriter::Write(const float* data, size_t count) { return WriteElements(ARRAY_TYPE_FLOAT, data, count); }
+    inline bool ArrayFileWriter::Write(const Vec2* data, size_t count) { return WriteElements(ARRAY_TYPE_VEC2, reinterpret_cast<const float*>(data), count); }
+    inline bool ArrayFileWriter::Write(const Vec3* data, size_t count) { return WriteElements(ARRAY_TYPE_VEC3, reinterpret_cast<const float*>(data), count); }
+    inline bool ArrayFileWriter::Write(const Vec4* data, size_t count) { return WriteElements(ARRAY_TYPE_VEC4, reinterpret_cast<const float*>(data), count); }
+
+    inline bool ArrayFileWriter::Write(const Mat3x3* data, size_t count)
+    {
+        // Mat3x3 is 9 tightly packed floats, only the alignment may need a conversion.
+        float buffer[64 * 9];
+        for (size_t i = 0; i < count; i += 64)
+        {
+            size_t n = Min(count - i, (size_t) 64);
+            for (size_t j = 0; j < n; ++j)
+                data[i + j].Store(buffer + j * 9, (MATRIX_ALLIGNMENT) m_Current.alignment);
+            if (!WriteElements(ARRAY_TYPE_MAT3X3, buffer, n))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool ArrayFileWriter::Write(const Mat4x4* data, size_t count)
+    {
+        if (m_Current.alignment == MATRIX_ALLIGNMENT_ROW_MAJOR)
+            return WriteElements(ARRAY_TYPE_MAT4X4, reinterpret_cast<const float*>(data), count);
+
+        float buffer[64 * 16];
+        for (size_t i = 0; i < count; i += 64)
+        {
+            size_t n = Min(count - i, (size_t) 64);
+            for (size_t j = 0; j < n; ++j)
+                data[i + j].StoreColMajor(buffer + j * 16);
+            if (!WriteElements(ARRAY_TYPE_MAT4X4, buffer, n))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool ArrayFileWriter::EndSection()
+    {
+        if (!m_InSection)
+            return false;
+        m_InSection = false;
+
+        unsigned long long components = (unsigned long long) ArrayTypeComponents((ARRAY_TYPE) m_Current.type);
+        if (m_Current.layout == ARRAY_LAYOUT_SOA)
+        {
+            if (m_Written != m_Current.count)
+            {
+                m_Dropped = true; // The file stays valid without the section, but Close reports it.
+                return false;
+            }
+            m_Current.size = m_Current.stride * components;
+        }
+        else
+        {
+            m_Current.count = m_Written;
+            m_Current.size  = m_Written * components * PrecisionBytes(m_Current.precision);
+        }
+
+        m_Sections.push_back(m_Current);
+        return PadTo(m_Current.offset + m_Current.size);
+    }
+
+    inline bool ArrayFileWriter::Close()
+    {
+        if (!m_File)
+            return true;
+        if (m_InSection)
+            EndSection();
+
+        ArrayFileHeader header = {};
+        header.magic           = ARRAY_FILE_MAGIC;
+        header.version         = ARRAY_FILE_VERSION;
+        header.sectionCount    = (unsigned int) m_Sections.size();
+        header.tableOffset     = AlignArrayOffset(m_End);
+
+        PadTo(header.tableOffset);
+        if (!m_Sections.empty())
+            WriteBytes(m_Sections.data(), m_Sections.size() * sizeof(ArrayFileSection), header.tableOffset);
+        WriteBytes(&header, sizeof(header), 0);
+
+        bool ok = std::fclose(m_File) == 0 && !m_Failed && !m_Dropped;
+        m_File  = nullptr;
+        m_Sections.clear();
+        return ok;
+    }
+
+    inline bool ArrayFileWriter::WriteElements(ARRAY_TYPE type, const float* data, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ARRAY_FILE_WRITE, count);
+        if (!m_InSection || m_Current.type != (unsigned int) type)
+            return false;
+
+        size_t             components = (size_t) ArrayTypeComponents(type);
+        unsigned long long elemBytes  = PrecisionBytes(m_Current.precision);
+
+        if (m_Current.layout == ARRAY_LAYOUT_AOS)
+        {
+            if (!WriteFloats(data, count * components, m_Current.offset + m_Written * components * elemBytes))
+                return false;
+        }
+        else
+        {
+            if (m_Written + count > m_Current.count)
+                return false;
+
+            // Split into the component streams chunk by chunk.
+            float buffer[1024];
+            for (size_t c = 0; c < components; ++c)
+            {
+                for (size_t i = 0; i < count; i += 1024)
+                {
+                    size_t n = Min(count - i, (size_t) 1024);
+                    for (size_t j = 0; j < n; ++j)
+                        buffer[j] = data[(i + j) * components + c];
+                    if (!WriteFloats(buffer, n, m_Current.offset + m_Current.stride * c + (m_Written + i) * elemBytes))
+                        return false;
+                }
+            }
+        }
+
+        m_Written += count;
+        return true;
+    }
+
+    inline bool ArrayFileWriter::WriteFloats(const float* data, size_t count, unsigned long long offset)
+    {
+        if (m_Current.precision == ARRAY_PRECISION_F32)
+            return WriteBytes(data, count * sizeof(float), offset);
+
+        unsigned short buffer[1024];
+        for (size_t i = 0; i < count; i += 1024)
+        {
+            size_t n = Min(count - i, (size_t) 1024);
+            PackHalf(data + i, buffer, n);
+            if (!WriteBytes(buffer, n * sizeof(unsigned short), offset + i * sizeof(unsigned short)))
+                return false;
+        }
+        return true;
+    }
+
+    inline bool ArrayFileWriter::WriteBytes(const void* data, size_t size, unsigned long long offset)
+    {
+        if (!m_File || m_Failed)
+            return false;
+
+        if (offset != m_Cursor)
+        {
+#ifdef _WIN32
+            bool seeked = _fseeki64(m_File, (long long) offset, SEEK_SET) == 0;
+#else
+            bool seeked = fseeko(m_File, (off_t) offset, SEEK_SET) == 0;
+#endif // _WIN32
+            if (!seeked)
+            {
+                m_Failed = true;
+                return false;
+            }
+            m_Cursor = offset;
+        }
+
+        if (size > 0 && std::fwrite(data, 1, size, m_File) != size)
+        {
+            m_Failed = true;
+            return false;
+        }
+
+        m_Cursor += size;
+        m_End = Max(m_End, m_Cursor);
+        return true;
+    }
+
+    inline bool ArrayFileWriter::PadTo(unsigned long long offset)
+    {
+        static const unsigned char zeros[ARRAY_FILE_ALIGNMENT] = {};
+        while (m_End < offset)
+        {
+            size_t n = (size_t) Min(offset - m_End, (unsigned long long) ARRAY_FILE_ALIGNMENT);
+            if (!WriteBytes(zeros, n, m_End))
+                return false;
+        }
+        return true;
+    }
+} // namespace DropMath
@@ -1,6 +1,12 @@
 
 namespace DropMath
 {
+    namespace
+    {
+        // Uninstrumented, so a product doesn't also count as a transpose.
+        inline Mat2x2 Mat2Transpose(const Mat2x2& m) { return Mat2x2(Vec2(m[0][0], m[1][0]), Vec2(m[0][1], m[1][1])); }
+    } // anonymous namespace
+
     inline Vec2& Mat2x2::operator[](int i)
     {
         assert(i >= 0 && i < 2);
@@ -11,19 +17,32 @@ namespace DropMath
         assert(i >= 0 && i < 2);
         return rows[i];
     }
-    inline Vec2   Mat2x2::operator*(const Vec2& v) const { return Vec2(Vec2::Dot(rows[0], v), Vec2::Dot(rows[1], v)); }
+    inline Vec2 Mat2x2::operator*(const Vec2& v) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_MUL_VEC, 1);
+        return Vec2(Vec2::Dot(rows[0], v), Vec2::Dot(rows[1], v));
+    }
     inline Mat2x2 Mat2x2::operator*(const Mat2x2& m) const
     {
-        Mat2x2 t = m.Transposed();
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_MUL_MAT, 1);
+        Mat2x2 t = Mat2Transpose(m);
 
         return Mat2x2(
             Vec2(Vec2::Dot(rows[0], t[0]), Vec2::Dot(rows[0], t[1])),
             Vec2(Vec2::Dot(rows[1], t[0]), Vec2::Dot(rows[1], t[1])));
     }
 
-    inline float Mat2x2::Determinant() const { return Determinant2x2(*this); }
+    inline float Mat2x2::Determinant() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_DETERMINANT, 1);
+        return Determinant2x2(*this);
+    }
 
-    inline Mat2x2 Mat2x2::Transposed() const { return Mat2x2(Vec2(rows[0][0], rows[1][0]), Vec2(rows[0][1], rows[1][1])); }
+    inline Mat2x2 Mat2x2::Transposed() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_TRANSPOSE, 1);
+        return Mat2Transpose(*this);
+    }
 
     inline void Mat2x2::StoreRowMajor(float* dst) const
     {
@@ -67,8 +86,16 @@ namespace DropMath
 
     inline bool Mat2x2::TryInverse(const Mat2x2& m, Mat2x2& out)
     {
-        return TryInverse2x2(m, out);
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_TRY_INVERSE, 1);
+        bool result = TryInverse2x2(m, out);
+        if (!result)
+            DM_PROFILE_FAILURE(PROFILE_OP_MAT2X2_TRY_INVERSE);
+        return result;
     }
 
-    inline Mat2x2 Mat2x2::Transpose(const Mat2x2& m) { return Mat2x2(Vec2(m[0][0], m[1][0]), Vec2(m[0][1], m[1][1])); }
+    inline Mat2x2 Mat2x2::Transpose(const Mat2x2& m)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT2X2_TRANSPOSE, 1);
+        return Mat2Transpose(m);
+    }
 } // namespace Dropmath
\ No newline at end of file
@@ -1,6 +1,18 @@
 
 namespace DropMath
 {
+    namespace
+    {
+        // Shared by Transposed, Transpose and operator*, left uninstrumented so a product is counted once.
+        inline Mat3x3 Mat3Transpose(const Mat3x3& m)
+        {
+            return Mat3x3(
+                Vec3(m[0][0], m[1][0], m[2][0]),
+                Vec3(m[0][1], m[1][1], m[2][1]),
+                Vec3(m[0][2], m[1][2], m[2][2]));
+        }
+    } // anonymous namespace
+
     inline Vec3& Mat3x3::operator[](int i)
     {
         assert(i >= 0 && i < 3);
@@ -13,6 +25,7 @@ namespace DropMath
     }
     inline Vec3 Mat3x3::operator*(const Vec3& v) const
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_MUL_VEC, 1);
         return Vec3(
             Vec3::Dot(rows[0], v),
             Vec3::Dot(rows[1], v),
@@ -20,7 +33,8 @@ namespace DropMath
     }
     inline Mat3x3 Mat3x3::operator*(const Mat3x3& m) const
     {
-        Mat3x3 t = m.Transposed();
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_MUL_MAT, 1);
+        Mat3x3 t = Mat3Transpose(m);
 
         return Mat3x3(
             Vec3(Vec3::Dot(rows[0], t[0]), Vec3::Dot(rows[0], t[1]), Vec3::Dot(rows[0], t[2])),
@@ -28,14 +42,16 @@ namespace DropMath
             Vec3(Vec3::Dot(rows[2], t[0]), Vec3::Dot(rows[2], t[1]), Vec3::Dot(rows[2], t[2])));
     }
 
-    inline float Mat3x3::Determinant() const { return Determinant3x3(*this); }
+    inline float Mat3x3::Determinant() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_DETERMINANT, 1);
+        return Determinant3x3(*this);
+    }
 
     inline Mat3x3 Mat3x3::Transposed() const
     {
-        return Mat3x3(
-            Vec3(rows[0][0], rows[1][0], rows[2][0]),
-            Vec3(rows[0][1], rows[1][1], rows[2][1]),
-            Vec3(rows[0][2], rows[1][2], rows[2][2]));
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_TRANSPOSE, 1);
+        return Mat3Transpose(*this);
     }
 
     inline void Mat3x3::StoreRowMajor(float* dst) const
@@ -91,15 +107,17 @@ namespace DropMath
 
     inline bool Mat3x3::TryInverse(const Mat3x3& m, Mat3x3& out)
     {
-        return TryInverse3x3(m, out);
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_TRY_INVERSE, 1);
+        bool result = TryInverse3x3(m, out);
+        if (!result)
+            DM_PROFILE_FAILURE(PROFILE_OP_MAT3X3_TRY_INVERSE);
+        return result;
     }
 
     inline Mat3x3 Mat3x3::Transpose(const Mat3x3& m)
     {
-        return Mat3x3(
-            Vec3(m[0][0], m[1][0], m[2][0]),
-            Vec3(m[0][1], m[1][1], m[2][1]),
-            Vec3(m[0][2], m[1][2], m[2][2]));
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X3_TRANSPOSE, 1);
+        return Mat3Transpose(m);
     }
 
     inline Mat3x3 Mat3x3::Identity()
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../vec/DM_Vec3x4.h"
+#include "DM_Mat4x4.h"
+
+namespace DropMath
+{
+    // Affine transform: the top three rows of a Mat4x4 whose bottom row is (0, 0, 0, 1). 48 bytes instead of 64,
+    // and composing two of them needs 3 row updates instead of 4. Like Mat4x4 it multiplies column vectors, so the
+    // translation is the w lane of the rows.
+    struct alignas(16) Mat3x4
+    {
+        Vec4 rows[3];
+
+        Mat3x4() : rows {Vec4(), Vec4(), Vec4()} { }
+        Mat3x4(Vec4 r0, Vec4 r1, Vec4 r2) : rows {r0, r1, r2} { }
+        // Drop the bottom row of m, which must be (0, 0, 0, 1).
+        explicit Mat3x4(const Mat4x4& m);
+
+        Vec4&       operator[](int i);
+        const Vec4& operator[](int i) const;
+        // Matrix x Matrix, the transform of m applies first.
+        Mat3x4 operator*(const Mat3x4& m) const;
+
+        // Return matrix data so you can use it directly as a float array.
+        float* Data() { return reinterpret_cast<float*>(&rows[0]); }
+        // Return matrix data so you can use it directly as a float array.
+        const float* Data() const { return reinterpret_cast<const float*>(&rows[0]); }
+
+        // Transform a point (w = 1).
+        Vec3 TransformPoint(const Vec3& p) const;
+        // Transform a direction (w = 0), the translation doesn't apply.
+        Vec3 TransformVector(const Vec3& v) const;
+        // Transform 4 points at once.
+        Vec3x4 TransformPoint(const Vec3x4& p) const;
+        // Transform 4 directions at once.
+        Vec3x4 TransformVector(const Vec3x4& v) const;
+
+        // Return the matrix with the (0, 0, 0, 1) row appended.
+        Mat4x4 ToMat4x4() const;
+
+        // Return the determinant of the 3x3 linear part (the determinant of the whole transform).
+        float Determinant() const;
+
+        // Force inverse. This can cause an error if the determinant is 0.
+        // If you don't really sure about your data, use the TryInverse that was static version with extra check.
+        Mat3x4 Inverse() const;
+
+        // Inverse of a rotation plus translation (orthonormal linear part): transposes instead of dividing.
+        Mat3x4 RigidInverse() const;
+
+        // Safe method for inverse. Return false if determinant is 0 and can't be inversed. Otherwise return true.
+        static bool TryInverse(const Mat3x4& m, Mat3x4& out);
+
+        // Create Identity matrix.
+        static Mat3x4 Identity();
+
+        // Same as Mat4x4::TRS without the bottom row.
+        static Mat3x4 TRS(const Vec3& t, const Vec3& rad, const Vec3& s);
+    };
+} // namespace DropMath
+
+#include "DM_Mat3x4.inl"
@@ -0,0 +1,147 @@
+namespace DropMath
+{
+    namespace
+    {
+        // Rows of the inverse linear part linear^-1 with w = -linear^-1 * t.
+        inline Mat3x4 Mat3x4WithInverseTranslation(float4 l0, float4 l1, float4 l2, const Mat3x4& m)
+        {
+            float4 t = _mm_set_ps(0.0f, m.rows[2].w, m.rows[1].w, m.rows[0].w);
+            return Mat3x4(InverseAffineRow(l0, t), InverseAffineRow(l1, t), InverseAffineRow(l2, t));
+        }
+    } // anonymous namespace
+
+    inline Mat3x4::Mat3x4(const Mat4x4& m) : rows {m.rows[0], m.rows[1], m.rows[2]}
+    {
+        assert(m.rows[3] == Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    }
+
+    inline Vec4& Mat3x4::operator[](int i)
+    {
+        assert(i >= 0 && i < 3);
+        return rows[i];
+    }
+    inline const Vec4& Mat3x4::operator[](int i) const
+    {
+        assert(i >= 0 && i < 3);
+        return rows[i];
+    }
+
+    inline Mat3x4 Mat3x4::operator*(const Mat3x4& m) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X4_MUL_MAT, 1);
+        // Row i = a.x * m0 + a.y * m1 + a.z * m2 + (0, 0, 0, a.w), the implied bottom row of m only adds a.w.
+        Mat3x4 result;
+        for (int i = 0; i < 3; ++i)
+        {
+            float4 a    = rows[i].v;
+            float4 xy   = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), m.rows[0].v),
+                                     _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), m.rows[1].v));
+            float4 zw   = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), m.rows[2].v),
+                                     _mm_blend_ps(_mm_setzero_ps(), a, 0x8));
+            result[i].v = _mm_add_ps(xy, zw);
+        }
+        return result;
+    }
+
+    inline Vec3 Mat3x4::TransformPoint(const Vec3& p) const
+    {
+        float4 v = _mm_set_ps(1.0f, p.z, p.y, p.x);
+        return Vec3(
+            _mm_cvtss_f32(_mm_dp_ps(rows[0].v, v, 0xF1)),
+            _mm_cvtss_f32(_mm_dp_ps(rows[1].v, v, 0xF1)),
+            _mm_cvtss_f32(_mm_dp_ps(rows[2].v, v, 0xF1)));
+    }
+
+    inline Vec3 Mat3x4::TransformVector(const Vec3& v) const
+    {
+        float4 d = _mm_set_ps(0.0f, v.z, v.y, v.x);
+        return Vec3(
+            _mm_cvtss_f32(_mm_dp_ps(rows[0].v, d, 0x71)),
+            _mm_cvtss_f32(_mm_dp_ps(rows[1].v, d, 0x71)),
+            _mm_cvtss_f32(_mm_dp_ps(rows[2].v, d, 0x71)));
+    }
+
+    inline Vec3x4 Mat3x4::TransformPoint(const Vec3x4& p) const
+    {
+        Vec3x4 v = TransformVector(p);
+        return Vec3x4(
+            _mm_add_ps(v.x, _mm_set1_ps(rows[0].w)),
+            _mm_add_ps(v.y, _mm_set1_ps(rows[1].w)),
+            _mm_add_ps(v.z, _mm_set1_ps(rows[2].w)));
+    }
+
+    inline Vec3x4 Mat3x4::TransformVector(const Vec3x4& v) const
+    {
+        float4 out[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            out[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rows[i].x), v.x), _mm_mul_ps(_mm_set1_ps(rows[i].y), v.y)),
+                                _mm_mul_ps(_mm_set1_ps(rows[i].z), v.z));
+        }
+        return Vec3x4(out[0], out[1], out[2]);
+    }
+
+    inline Mat4x4 Mat3x4::ToMat4x4() const { return Mat4x4(rows[0], rows[1], rows[2], Vec4(0, 0, 0, 1)); }
+
+    inline float Mat3x4::Determinant() const
+    {
+        float4 zero = _mm_setzero_ps();
+        float4 b    = _mm_blend_ps(rows[1].v, zero, 0x8);
+        float4 c    = _mm_blend_ps(rows[2].v, zero, 0x8);
+        return _mm_cvtss_f32(_mm_dp_ps(rows[0].v, Cross3(b, c), 0x71));
+    }
+
+    inline Mat3x4 Mat3x4::Inverse() const
+    {
+        Mat3x4 out;
+        bool   result = TryInverse(*this, out);
+        assert(result);
+        return out;
+    }
+
+    inline Mat3x4 Mat3x4::RigidInverse() const
+    {
+        float4 l0, l1, l2;
+        Transpose3(rows[0].v, rows[1].v, rows[2].v, l0, l1, l2);
+        return Mat3x4WithInverseTranslation(l0, l1, l2, *this);
+    }
+
+    inline bool Mat3x4::TryInverse(const Mat3x4& m, Mat3x4& out)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT3X4_TRY_INVERSE, 1);
+        // The inverse of a 3x3 with rows a, b, c has columns b x c, c x a, a x b over det = a . (b x c).
+        float4 zero = _mm_setzero_ps();
+        float4 a    = _mm_blend_ps(m.rows[0].v, zero, 0x8);
+        float4 b    = _mm_blend_ps(m.rows[1].v, zero, 0x8);
+        float4 c    = _mm_blend_ps(m.rows[2].v, zero, 0x8);
+        float4 bc   = Cross3(b, c);
+        float4 ca   = Cross3(c, a);
+        float4 ab   = Cross3(a, b);
+        float4 det  = _mm_dp_ps(a, bc, 0x7F);
+        if (IsZero(_mm_cvtss_f32(det)))
+        {
+            DM_PROFILE_FAILURE(PROFILE_OP_MAT3X4_TRY_INVERSE);
+            return false;
+        }
+
+        float4 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+        float4 l0, l1, l2;
+        Transpose3(_mm_mul_ps(bc, invDet), _mm_mul_ps(ca, invDet), _mm_mul_ps(ab, invDet), l0, l1, l2);
+        out = Mat3x4WithInverseTranslation(l0, l1, l2, m);
+        return true;
+    }
+
+    inline Mat3x4 Mat3x4::Identity()
+    {
+        return Mat3x4(
+            Vec4(1, 0, 0, 0),
+            Vec4(0, 1, 0, 0),
+            Vec4(0, 0, 1, 0));
+    }
+
+    inline Mat3x4 Mat3x4::TRS(const Vec3& t, const Vec3& rad, const Vec3& s)
+    {
+        Mat4x4 m = Mat4x4::TRS(t, rad, s);
+        return Mat3x4(m.rows[0], m.rows[1], m.rows[2]);
+    }
+} // namespace DropMath
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DM_Enum.h"
+#include "../utils/DM_Simd.h"
 #include "../vec/DM_Vec4.h"
 
 namespace DropMath
@@ -51,6 +52,47 @@ namespace DropMath
 
         // Create Identity matrix.
         static Mat4x4 Identity();
+
+        // Transform builders. Matrices multiply column vectors (m * v), so the translation lives in the last column.
+        // View and projection builders are left handed (+z looks forward) and map depth to [0, 1].
+
+        // Create translation matrix.
+        static Mat4x4 Translation(const Vec3& t);
+        // Create scale matrix.
+        static Mat4x4 Scale(const Vec3& s);
+        // Create rotation matrix around the x axis.
+        static Mat4x4 RotationX(float rad);
+        // Create rotation matrix around the y axis.
+        static Mat4x4 RotationY(float rad);
+        // Create rotation matrix around the z axis.
+        static Mat4x4 RotationZ(float rad);
+        // Create rotation matrix around a normalized axis.
+        static Mat4x4 RotationAxis(const Vec3& axis, float rad);
+        // Create rotation matrix from euler angles (x = pitch, y = yaw, z = roll), applied roll, pitch, then yaw.
+        static Mat4x4 RotationEuler(const Vec3& rad);
+
+        // Create Translation(t) * RotationEuler(rad) * Scale(s) directly, without the matrix products.
+        static Mat4x4 TRS(const Vec3& t, const Vec3& rad, const Vec3& s);
+
+        // Create view matrix of a camera at eye looking at target.
+        static Mat4x4 LookAt(const Vec3& eye, const Vec3& target, const Vec3& up);
+        // Create view matrix of a camera at eye looking along direction.
+        static Mat4x4 LookTo(const Vec3& eye, const Vec3& direction, const Vec3& up);
+
+        // Create perspective projection mapping nearZ to depth 0 and farZ to depth 1. farZ can be DM_INFINITY_F.
+        static Mat4x4 Perspective(float fovY, float aspect, float nearZ, float farZ);
+        // Create perspective projection mapping nearZ to depth 1 and farZ to depth 0, which spreads the float
+        // precision evenly over distance. farZ can be DM_INFINITY_F.
+        static Mat4x4 PerspectiveReversedZ(float fovY, float aspect, float nearZ, float farZ);
+        // Create orthographic projection centered on the view axis. Swap nearZ and farZ for reversed depth.
+        static Mat4x4 Orthographic(float width, float height, float nearZ, float farZ);
+        // Create orthographic projection of the given view volume. Swap nearZ and farZ for reversed depth.
+        static Mat4x4 OrthographicOffCenter(float left, float right, float bottom, float top, float nearZ, float farZ);
+
+        // Inverse of any Perspective or PerspectiveReversedZ matrix, cheaper and more precise than Inverse().
+        static Mat4x4 PerspectiveInverse(const Mat4x4& projection);
+        // Inverse of any Orthographic or OrthographicOffCenter matrix.
+        static Mat4x4 OrthographicInverse(const Mat4x4& projection);
     };
 
 } // namespace DropMath
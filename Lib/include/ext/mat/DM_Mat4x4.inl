@@ -1,6 +1,26 @@
 
 namespace DropMath
 {
+    namespace
+    {
+        inline float4 Mat4Normalize3(float4 v) { return _mm_div_ps(v, _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F))); }
+
+        // Transpose 4x4 matrix using SSE. Not instrumented, operator* uses it too.
+        inline Mat4x4 Mat4Transpose(const Mat4x4& m)
+        {
+            float4 t0 = _mm_unpacklo_ps(m[0].v, m[1].v);
+            float4 t1 = _mm_unpackhi_ps(m[0].v, m[1].v);
+            float4 t2 = _mm_unpacklo_ps(m[2].v, m[3].v);
+            float4 t3 = _mm_unpackhi_ps(m[2].v, m[3].v);
+
+            return Mat4x4(
+                Vec4(_mm_movelh_ps(t0, t2)),
+                Vec4(_mm_movehl_ps(t2, t0)),
+                Vec4(_mm_movelh_ps(t1, t3)),
+                Vec4(_mm_movehl_ps(t3, t1)));
+        }
+    } // anonymous namespace
+
     inline Vec4& Mat4x4::operator[](int i)
     {
         assert(i >= 0 && i < 4);
@@ -13,6 +33,7 @@ namespace DropMath
     }
     inline Vec4 Mat4x4::operator*(const Vec4& v) const
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_MUL_VEC, 1);
         return Vec4(
             _mm_cvtss_f32(_mm_dp_ps(rows[0].v, v.v, 0b11110001)),
             _mm_cvtss_f32(_mm_dp_ps(rows[1].v, v.v, 0b11110001)),
@@ -21,8 +42,9 @@ namespace DropMath
     }
     inline Mat4x4 Mat4x4::operator*(const Mat4x4& m) const
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_MUL_MAT, 1);
         Mat4x4 result;
-        Mat4x4 t = m.Transposed(); // Column access becomes row access.
+        Mat4x4 t = Mat4Transpose(m); // Column access becomes row access.
 
         for (int i = 0; i < 4; ++i)
         {
@@ -35,26 +57,16 @@ namespace DropMath
         return result;
     }
 
-    inline float Mat4x4::Determinant() const { return Determinant4x4(*this); }
+    inline float Mat4x4::Determinant() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_DETERMINANT, 1);
+        return Determinant4x4(*this);
+    }
 
     inline Mat4x4 Mat4x4::Transposed() const
     {
-        // Transpose 4x4 matrix using SSE.
-        float4 row0 = rows[0].v;
-        float4 row1 = rows[1].v;
-        float4 row2 = rows[2].v;
-        float4 row3 = rows[3].v;
-
-        float4 t0 = _mm_unpacklo_ps(row0, row1);
-        float4 t1 = _mm_unpackhi_ps(row0, row1);
-        float4 t2 = _mm_unpacklo_ps(row2, row3);
-        float4 t3 = _mm_unpackhi_ps(row2, row3);
-
-        return Mat4x4(
-            Vec4(_mm_movelh_ps(t0, t2)),
-            Vec4(_mm_movehl_ps(t2, t0)),
-            Vec4(_mm_movelh_ps(t1, t3)),
-            Vec4(_mm_movehl_ps(t3, t1)));
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_TRANSPOSE, 1);
+        return Mat4Transpose(*this);
     }
 
     inline void Mat4x4::StoreRowMajor(float* dst) const
@@ -111,35 +123,215 @@ namespace DropMath
 
     inline bool Mat4x4::TryInverse(const Mat4x4& m, Mat4x4& out)
     {
-        return TryInverse4x4(m, out);
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_TRY_INVERSE, 1);
+        bool result = TryInverse4x4(m, out);
+        if (!result)
+            DM_PROFILE_FAILURE(PROFILE_OP_MAT4X4_TRY_INVERSE);
+        return result;
     }
 
     inline Mat4x4 Mat4x4::Transpose(const Mat4x4& m)
     {
-        // Transpose 4x4 matrix using SSE.
-        float4 row0 = m[0].v;
-        float4 row1 = m[1].v;
-        float4 row2 = m[2].v;
-        float4 row3 = m[3].v;
+        DM_PROFILE_SCOPE(PROFILE_OP_MAT4X4_TRANSPOSE, 1);
+        return Mat4Transpose(m);
+    }
 
-        float4 t0 = _mm_unpacklo_ps(row0, row1);
-        float4 t1 = _mm_unpackhi_ps(row0, row1);
-        float4 t2 = _mm_unpacklo_ps(row2, row3);
-        float4 t3 = _mm_unpackhi_ps(row2, row3);
+    inline Mat4x4 Mat4x4::Identity()
+    {
+        return Mat4x4(
+            Vec4(1, 0, 0, 0),
+            Vec4(0, 1, 0, 0),
+            Vec4(0, 0, 1, 0),
+            Vec4(0, 0, 0, 1));
+    }
 
+    inline Mat4x4 Mat4x4::Translation(const Vec3& t)
+    {
         return Mat4x4(
-            Vec4(_mm_movelh_ps(t0, t2)),
-            Vec4(_mm_movehl_ps(t2, t0)),
-            Vec4(_mm_movelh_ps(t1, t3)),
-            Vec4(_mm_movehl_ps(t3, t1)));
+            Vec4(1, 0, 0, t.x),
+            Vec4(0, 1, 0, t.y),
+            Vec4(0, 0, 1, t.z),
+            Vec4(0, 0, 0, 1));
     }
 
-    inline Mat4x4 Mat4x4::Identity()
+    inline Mat4x4 Mat4x4::Scale(const Vec3& s)
     {
+        return Mat4x4(
+            Vec4(s.x, 0, 0, 0),
+            Vec4(0, s.y, 0, 0),
+            Vec4(0, 0, s.z, 0),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::RotationX(float rad)
+    {
+        float s, c;
+        SinCos(rad, s, c);
         return Mat4x4(
             Vec4(1, 0, 0, 0),
+            Vec4(0, c, -s, 0),
+            Vec4(0, s, c, 0),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::RotationY(float rad)
+    {
+        float s, c;
+        SinCos(rad, s, c);
+        return Mat4x4(
+            Vec4(c, 0, s, 0),
             Vec4(0, 1, 0, 0),
+            Vec4(-s, 0, c, 0),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::RotationZ(float rad)
+    {
+        float s, c;
+        SinCos(rad, s, c);
+        return Mat4x4(
+            Vec4(c, -s, 0, 0),
+            Vec4(s, c, 0, 0),
             Vec4(0, 0, 1, 0),
             Vec4(0, 0, 0, 1));
     }
+
+    inline Mat4x4 Mat4x4::RotationAxis(const Vec3& axis, float rad)
+    {
+        float s, c;
+        SinCos(rad, s, c);
+
+        // Rodrigues: R = c * I + (1 - c) * axis * axis^T + s * [axis]x, one row per SSE register.
+        float4 aa = _mm_mul_ps(LoadVec3(axis), _mm_set1_ps(1.0f - c));
+        float  sx = axis.x * s, sy = axis.y * s, sz = axis.z * s;
+        return Mat4x4(
+            Vec4(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(axis.x), aa), _mm_set_ps(0.0f, sy, -sz, c))),
+            Vec4(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(axis.y), aa), _mm_set_ps(0.0f, -sx, c, sz))),
+            Vec4(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(axis.z), aa), _mm_set_ps(0.0f, c, sx, -sy))),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::RotationEuler(const Vec3& rad) { return TRS(Vec3(0.0f, 0.0f, 0.0f), rad, Vec3(1.0f, 1.0f, 1.0f)); }
+
+    inline Mat4x4 Mat4x4::TRS(const Vec3& t, const Vec3& rad, const Vec3& s)
+    {
+        // One SinCos for the three angles.
+        float4 sin, cos;
+        SinCos(LoadVec3(rad), sin, cos);
+        float4 sx = _mm_shuffle_ps(sin, sin, _MM_SHUFFLE(0, 0, 0, 0)), cx = _mm_shuffle_ps(cos, cos, _MM_SHUFFLE(0, 0, 0, 0));
+        float4 sy = _mm_shuffle_ps(sin, sin, _MM_SHUFFLE(1, 1, 1, 1)), cy = _mm_shuffle_ps(cos, cos, _MM_SHUFFLE(1, 1, 1, 1));
+        float  sz = _mm_cvtss_f32(_mm_movehl_ps(sin, sin)), cz = _mm_cvtss_f32(_mm_movehl_ps(cos, cos));
+
+        // Rows of Rx * Rz, then R = Ry * (Rx * Rz) mixes the first and last of them.
+        float4 zRow0 = _mm_set_ps(0.0f, 0.0f, -sz, cz);
+        float4 zRow1 = _mm_set_ps(0.0f, 0.0f, cz, sz);
+        float4 xz1   = _mm_add_ps(_mm_mul_ps(cx, zRow1), _mm_blend_ps(_mm_setzero_ps(), _mm_sub_ps(_mm_setzero_ps(), sx), 0x4));
+        float4 xz2   = _mm_add_ps(_mm_mul_ps(sx, zRow1), _mm_blend_ps(_mm_setzero_ps(), cx, 0x4));
+        float4 r0    = _mm_add_ps(_mm_mul_ps(cy, zRow0), _mm_mul_ps(sy, xz2));
+        float4 r2    = _mm_sub_ps(_mm_mul_ps(cy, xz2), _mm_mul_ps(sy, zRow0));
+
+        // Scale the columns, then put the translation in the last one.
+        float4 scale = LoadVec3(s);
+        return Mat4x4(
+            WithW(_mm_mul_ps(r0, scale), _mm_set1_ps(t.x)),
+            WithW(_mm_mul_ps(xz1, scale), _mm_set1_ps(t.y)),
+            WithW(_mm_mul_ps(r2, scale), _mm_set1_ps(t.z)),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::LookAt(const Vec3& eye, const Vec3& target, const Vec3& up)
+    {
+        return LookTo(eye, target - eye, up);
+    }
+
+    inline Mat4x4 Mat4x4::LookTo(const Vec3& eye, const Vec3& direction, const Vec3& up)
+    {
+        // Camera basis as rows, so the matrix rotates the world into view space; the last column moves eye to the origin.
+        float4 e = LoadVec3(eye);
+        float4 z = Mat4Normalize3(LoadVec3(direction));
+        float4 x = Mat4Normalize3(Cross3(LoadVec3(up), z));
+        float4 y = Cross3(z, x);
+        return Mat4x4(
+            WithW(x, _mm_sub_ps(_mm_setzero_ps(), _mm_dp_ps(x, e, 0x7F))),
+            WithW(y, _mm_sub_ps(_mm_setzero_ps(), _mm_dp_ps(y, e, 0x7F))),
+            WithW(z, _mm_sub_ps(_mm_setzero_ps(), _mm_dp_ps(z, e, 0x7F))),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::Perspective(float fovY, float aspect, float nearZ, float farZ)
+    {
+        assert(nearZ > 0.0f && farZ > nearZ);
+        float s, c;
+        SinCos(0.5f * fovY, s, c);
+        float yScale = c / s;
+        // z' = (1 + range) * (z - nearZ) and w' = z. range is 0 for an infinite farZ.
+        float range = nearZ / (farZ - nearZ);
+        return Mat4x4(
+            Vec4(yScale / aspect, 0, 0, 0),
+            Vec4(0, yScale, 0, 0),
+            Vec4(0, 0, 1.0f + range, -(1.0f + range) * nearZ),
+            Vec4(0, 0, 1, 0));
+    }
+
+    inline Mat4x4 Mat4x4::PerspectiveReversedZ(float fovY, float aspect, float nearZ, float farZ)
+    {
+        assert(nearZ > 0.0f && farZ > nearZ);
+        float s, c;
+        SinCos(0.5f * fovY, s, c);
+        float yScale = c / s;
+        // z' = (1 + range) * nearZ - range * z and w' = z. range is 0 for an infinite farZ.
+        float range = nearZ / (farZ - nearZ);
+        return Mat4x4(
+            Vec4(yScale / aspect, 0, 0, 0),
+            Vec4(0, yScale, 0, 0),
+            Vec4(0, 0, -range, (1.0f + range) * nearZ),
+            Vec4(0, 0, 1, 0));
+    }
+
+    inline Mat4x4 Mat4x4::Orthographic(float width, float height, float nearZ, float farZ)
+    {
+        return OrthographicOffCenter(-0.5f * width, 0.5f * width, -0.5f * height, 0.5f * height, nearZ, farZ);
+    }
+
+    inline Mat4x4 Mat4x4::OrthographicOffCenter(float left, float right, float bottom, float top, float nearZ, float farZ)
+    {
+        float4 lo    = _mm_set_ps(0.0f, nearZ, bottom, left);
+        float4 hi    = _mm_set_ps(1.0f, farZ, top, right);
+        float4 scale = _mm_div_ps(_mm_set_ps(1.0f, 1.0f, 2.0f, 2.0f), _mm_sub_ps(hi, lo));
+        // x and y map [lo, hi] to [-1, 1] around their middle, z maps [nearZ, farZ] to [0, 1] from nearZ.
+        float4 origin = _mm_blend_ps(_mm_mul_ps(_mm_add_ps(lo, hi), _mm_set1_ps(0.5f)), lo, 0x4);
+        float4 offset = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(origin, scale));
+        float4 zero   = _mm_setzero_ps();
+        return Mat4x4(
+            WithW(_mm_blend_ps(zero, scale, 0x1), _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(0, 0, 0, 0))),
+            WithW(_mm_blend_ps(zero, scale, 0x2), _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(1, 1, 1, 1))),
+            WithW(_mm_blend_ps(zero, scale, 0x4), _mm_shuffle_ps(offset, offset, _MM_SHUFFLE(2, 2, 2, 2))),
+            Vec4(0, 0, 0, 1));
+    }
+
+    inline Mat4x4 Mat4x4::PerspectiveInverse(const Mat4x4& projection)
+    {
+        // [a 0 0 0; 0 b 0 0; 0 0 c d; 0 0 1 0] inverts to [1/a 0 0 0; 0 1/b 0 0; 0 0 0 1; 0 0 1/d -c/d].
+        float a = projection.rows[0].x, b = projection.rows[1].y, c = projection.rows[2].z, d = projection.rows[2].w;
+        assert(d != 0.0f);
+        return Mat4x4(
+            Vec4(1.0f / a, 0, 0, 0),
+            Vec4(0, 1.0f / b, 0, 0),
+            Vec4(0, 0, 0, 1),
+            Vec4(0, 0, 1.0f / d, -c / d));
+    }
+
+    inline Mat4x4 Mat4x4::OrthographicInverse(const Mat4x4& projection)
+    {
+        // Diagonal scale and offset: x = (x' - offset) / scale per axis.
+        float4 scale = _mm_set_ps(1.0f, projection.rows[2].z, projection.rows[1].y, projection.rows[0].x);
+        float4 inv   = _mm_div_ps(_mm_set1_ps(1.0f), scale);
+        float4 shift = _mm_mul_ps(_mm_set_ps(0.0f, -projection.rows[2].w, -projection.rows[1].w, -projection.rows[0].w), inv);
+        float4 zero  = _mm_setzero_ps();
+        return Mat4x4(
+            WithW(_mm_blend_ps(zero, inv, 0x1), _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(0, 0, 0, 0))),
+            WithW(_mm_blend_ps(zero, inv, 0x2), _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(1, 1, 1, 1))),
+            WithW(_mm_blend_ps(zero, inv, 0x4), _mm_shuffle_ps(shift, shift, _MM_SHUFFLE(2, 2, 2, 2))),
+            Vec4(0, 0, 0, 1));
+    }
 } // namespace DropMath
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../vec/DM_VecN.h"
+#include "DM_Mat2x2.h"
+#include "DM_Mat3x3.h"
+#include "DM_Mat4x4.h"
+
+namespace DropMath
+{
+    // R x C matrix of T (int, float or double) stored as R row vectors, for the sizes the SSE matrices don't cover,
+    // such as 6x6 inertia tensors and 6x1 spatial vectors. It is an aggregate like Vec, its operations are unrolled at
+    // compile time and constexpr, except Determinant and TryInverse which are constexpr from C++14 only. Like
+    // Mat4x4, it multiplies column vectors: m * v.
+    template <typename T, int R, int C>
+    struct Mat
+    {
+        static_assert(R > 0 && C > 0, "Mat needs at least one row and one column.");
+
+        Vec<T, C> rows[R];
+
+        // Like Vec, temporaries such as (a * b)[i][j] use the const overload, constexpr in C++11.
+        DM_CONSTEXPR const Vec<T, C>& operator[](int i) const& { return rows[i]; }
+        DM_CONSTEXPR_14 Vec<T, C>&    operator[](int i) & { return rows[i]; }
+
+        // Return matrix data so you can use it directly as a T array, row by row.
+        T*       Data() { return rows[0].data; }
+        const T* Data() const { return rows[0].data; }
+
+        static DM_CONSTEXPR Mat Zero();
+
+        // Square matrices only.
+        static DM_CONSTEXPR Mat Identity();
+    };
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator+(const Mat<T, R, C>& a, const Mat<T, R, C>& b);
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator-(const Mat<T, R, C>& a, const Mat<T, R, C>& b);
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(const Mat<T, R, C>& m, T s);
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(T s, const Mat<T, R, C>& m);
+    // Exact comparison, as for Vec.
+    template <typename T, int R, int C>
+    DM_CONSTEXPR bool operator==(const Mat<T, R, C>& a, const Mat<T, R, C>& b);
+    template <typename T, int R, int C>
+    DM_CONSTEXPR bool operator!=(const Mat<T, R, C>& a, const Mat<T, R, C>& b);
+
+    // Matrix x Vector.
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Vec<T, R> operator*(const Mat<T, R, C>& m, const Vec<T, C>& v);
+
+    // Matrix x Matrix. Each row of the result is a sum of rows of b, which the compiler turns into SIMD.
+    template <typename T, int R, int K, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(const Mat<T, R, K>& a, const Mat<T, K, C>& b);
+
+    // The float 4x4 products run on the SSE Mat4x4 instead (not constexpr).
+    inline Mat<float, 4, 4> operator*(const Mat<float, 4, 4>& a, const Mat<float, 4, 4>& b);
+    inline Vec<float, 4>    operator*(const Mat<float, 4, 4>& m, const Vec<float, 4>& v);
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, C, R> Transpose(const Mat<T, R, C>& m);
+
+    // Return the determinant by Gaussian elimination with partial pivoting.
+    template <typename T, int N>
+    DM_CONSTEXPR_14 T Determinant(const Mat<T, N, N>& m);
+
+    // Return the determinant of an int matrix exactly, by fraction free (Bareiss) elimination.
+    template <int N>
+    DM_CONSTEXPR_14 int Determinant(const Mat<int, N, N>& m);
+
+    // Inverse m by Gauss-Jordan elimination with partial pivoting, float and double only. Return false, leaving out
+    // undefined, when a pivot is 0 (within epsilon) and m can't be inversed.
+    template <typename T, int N>
+    DM_CONSTEXPR_14 bool TryInverse(const Mat<T, N, N>& m, Mat<T, N, N>& out);
+
+    // Conversions from and to the SSE matrices.
+    inline Mat2x2 ToSimd(const Mat<float, 2, 2>& m);
+    inline Mat3x3 ToSimd(const Mat<float, 3, 3>& m);
+    inline Mat4x4 ToSimd(const Mat<float, 4, 4>& m);
+
+    inline Mat<float, 2, 2> ToMatN(const Mat2x2& m);
+    inline Mat<float, 3, 3> ToMatN(const Mat3x3& m);
+    inline Mat<float, 4, 4> ToMatN(const Mat4x4& m);
+} // namespace DropMath
+
+#include "DM_MatN.inl"
@@ -0,0 +1,325 @@
+#include <climits>
+
+namespace DropMath
+{
+    namespace
+    {
+        template <typename T>
+        DM_CONSTEXPR T MatNAbs(T x) { return x < T(0) ? -x : x; }
+
+        // Pivots at or below this are 0 for TryInverse.
+        DM_CONSTEXPR inline float  MatNEpsilon(float) { return F::EPSILON; }
+        DM_CONSTEXPR inline double MatNEpsilon(double) { return D::EPSILON; }
+
+        template <typename T, int R, int C, int... I>
+        DM_CONSTEXPR Vec<T, R> MatNColumn(const Mat<T, R, C>& m, int j, VecNIndices<I...>)
+        {
+            return Vec<T, R> { { m.rows[I].data[j]... } };
+        }
+
+        template <typename T, int N, int... J>
+        DM_CONSTEXPR Vec<T, N> MatNIdentityRow(int i, VecNIndices<J...>)
+        {
+            return Vec<T, N> { { (J == i ? T(1) : T(0))... } };
+        }
+
+        template <typename T, int R, int C, typename Op, int... I>
+        DM_CONSTEXPR Mat<T, R, C> MatNMap(const Mat<T, R, C>& a, const Mat<T, R, C>& b, Op op, VecNIndices<I...>)
+        {
+            return Mat<T, R, C> { { VecNMap(a.rows[I], b.rows[I], op, typename VecNMakeIndices<C>::Type())... } };
+        }
+
+        template <typename T, int R, int C, int... I>
+        DM_CONSTEXPR Mat<T, R, C> MatNScale(const Mat<T, R, C>& m, T s, VecNIndices<I...>)
+        {
+            return Mat<T, R, C> { { (m.rows[I] * s)... } };
+        }
+
+        template <typename T, int R, int C, int... I>
+        DM_CONSTEXPR Vec<T, R> MatNMulVec(const Mat<T, R, C>& m, const Vec<T, C>& v, VecNIndices<I...>)
+        {
+            return Vec<T, R> { { Dot(m.rows[I], v)... } };
+        }
+
+        template <typename T, int R, int C, int... I>
+        DM_CONSTEXPR Mat<T, C, R> MatNTranspose(const Mat<T, R, C>& m, VecNIndices<I...>)
+        {
+            return Mat<T, C, R> { { MatNColumn(m, I, typename VecNMakeIndices<R>::Type())... } };
+        }
+
+        // Sums over rows [0, K), unrolled by recursion on K.
+        template <int K>
+        struct MatNUnroll
+        {
+            // Row times matrix: the rows of b weighted by the elements of row.
+            template <typename T, int N, int C>
+            static DM_CONSTEXPR Vec<T, C> RowTimes(const Vec<T, N>& row, const Mat<T, N, C>& b)
+            {
+                return MatNUnroll<K - 1>::RowTimes(row, b) + b.rows[K - 1] * row.data[K - 1];
+            }
+
+            template <typename T, int R, int C>
+            static DM_CONSTEXPR bool Equal(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+            {
+                return MatNUnroll<K - 1>::Equal(a, b) && a.rows[K - 1] == b.rows[K - 1];
+            }
+        };
+
+        template <>
+        struct MatNUnroll<1>
+        {
+            template <typename T, int N, int C>
+            static DM_CONSTEXPR Vec<T, C> RowTimes(const Vec<T, N>& row, const Mat<T, N, C>& b)
+            {
+                return b.rows[0] * row.data[0];
+            }
+
+            template <typename T, int R, int C>
+            static DM_CONSTEXPR bool Equal(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+            {
+                return a.rows[0] == b.rows[0];
+            }
+        };
+
+        template <typename T, int R, int K, int C, int... I>
+        DM_CONSTEXPR Mat<T, R, C> MatNMul(const Mat<T, R, K>& a, const Mat<T, K, C>& b, VecNIndices<I...>)
+        {
+            return Mat<T, R, C> { { MatNUnroll<K>::RowTimes(a.rows[I], b)... } };
+        }
+
+        template <typename T, int N, int... I>
+        DM_CONSTEXPR Mat<T, N, N> MatNIdentity(VecNIndices<I...>)
+        {
+            return Mat<T, N, N> { { MatNIdentityRow<T, N>(I, VecNIndices<I...>())... } };
+        }
+
+        template <typename T, int N>
+        DM_CONSTEXPR_14 void MatNSwapRows(Mat<T, N, N>& m, int i, int j)
+        {
+            Vec<T, N> t = m.rows[i];
+            m.rows[i]   = m.rows[j];
+            m.rows[j]   = t;
+        }
+
+        // Row at or below k with the largest element in column k.
+        template <typename T, int N>
+        DM_CONSTEXPR_14 int MatNPivot(const Mat<T, N, N>& m, int k)
+        {
+            int p = k;
+            for (int i = k + 1; i < N; ++i)
+            {
+                if (MatNAbs(m.rows[i].data[k]) > MatNAbs(m.rows[p].data[k]))
+                    p = i;
+            }
+            return p;
+        }
+    } // anonymous namespace
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> Mat<T, R, C>::Zero()
+    {
+        return Mat { };
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> Mat<T, R, C>::Identity()
+    {
+        static_assert(R == C, "Only square matrices have an identity.");
+        return MatNIdentity<T, R>(typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator+(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+    {
+        return MatNMap(a, b, VecNAdd(), typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator-(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+    {
+        return MatNMap(a, b, VecNSub(), typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(const Mat<T, R, C>& m, T s)
+    {
+        return MatNScale(m, s, typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(T s, const Mat<T, R, C>& m)
+    {
+        return MatNScale(m, s, typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR bool operator==(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+    {
+        return MatNUnroll<R>::Equal(a, b);
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR bool operator!=(const Mat<T, R, C>& a, const Mat<T, R, C>& b)
+    {
+        return !(a == b);
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Vec<T, R> operator*(const Mat<T, R, C>& m, const Vec<T, C>& v)
+    {
+        return MatNMulVec(m, v, typename VecNMakeIndices<R>::Type());
+    }
+
+    template <typename T, int R, int K, int C>
+    DM_CONSTEXPR Mat<T, R, C> operator*(const Mat<T, R, K>& a, const Mat<T, K, C>& b)
+    {
+        return MatNMul(a, b, typename VecNMakeIndices<R>::Type());
+    }
+
+    inline Mat<float, 4, 4> operator*(const Mat<float, 4, 4>& a, const Mat<float, 4, 4>& b)
+    {
+        float4 b0 = _mm_loadu_ps(b.rows[0].data), b1 = _mm_loadu_ps(b.rows[1].data);
+        float4 b2 = _mm_loadu_ps(b.rows[2].data), b3 = _mm_loadu_ps(b.rows[3].data);
+
+        Mat<float, 4, 4> out;
+        for (int i = 0; i < 4; ++i)
+        {
+            const float* r = a.rows[i].data;
+            float4       s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b0, _mm_set1_ps(r[0])), _mm_mul_ps(b1, _mm_set1_ps(r[1]))),
+                                        _mm_add_ps(_mm_mul_ps(b2, _mm_set1_ps(r[2])), _mm_mul_ps(b3, _mm_set1_ps(r[3]))));
+            _mm_storeu_ps(out.rows[i].data, s);
+        }
+        return out;
+    }
+
+    inline Vec<float, 4> operator*(const Mat<float, 4, 4>& m, const Vec<float, 4>& v)
+    {
+        // The columns of m weighted by the elements of v.
+        float4 c0 = _mm_loadu_ps(m.rows[0].data), c1 = _mm_loadu_ps(m.rows[1].data);
+        float4 c2 = _mm_loadu_ps(m.rows[2].data), c3 = _mm_loadu_ps(m.rows[3].data);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        Vec<float, 4> out;
+        _mm_storeu_ps(out.data, _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])), _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+                                           _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(v[2])), _mm_mul_ps(c3, _mm_set1_ps(v[3])))));
+        return out;
+    }
+
+    template <typename T, int R, int C>
+    DM_CONSTEXPR Mat<T, C, R> Transpose(const Mat<T, R, C>& m)
+    {
+        return MatNTranspose(m, typename VecNMakeIndices<C>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR_14 T Determinant(const Mat<T, N, N>& m)
+    {
+        Mat<T, N, N> a   = m;
+        T            det = T(1);
+        for (int k = 0; k < N; ++k)
+        {
+            int p = MatNPivot(a, k);
+            if (a.rows[p].data[k] == T(0))
+                return T(0);
+            if (p != k)
+            {
+                MatNSwapRows(a, p, k);
+                det = -det;
+            }
+
+            det *= a.rows[k].data[k];
+            T inv = T(1) / a.rows[k].data[k];
+            for (int i = k + 1; i < N; ++i)
+            {
+                T f = a.rows[i].data[k] * inv;
+                for (int j = k + 1; j < N; ++j)
+                    a.rows[i].data[j] -= f * a.rows[k].data[j];
+            }
+        }
+        return det;
+    }
+
+    template <int N>
+    DM_CONSTEXPR_14 int Determinant(const Mat<int, N, N>& m)
+    {
+        // Every division by the previous pivot is exact. The entries of the working copy are minors of m, which can
+        // overflow int even when the determinant doesn't, so they stay 64 bit and only the result is narrowed.
+        Mat<long long, N, N> a = {};
+        for (int i = 0; i < N; ++i)
+            for (int j = 0; j < N; ++j)
+                a.rows[i].data[j] = m.rows[i].data[j];
+        long long sign = 1;
+        long long prev = 1;
+        for (int k = 0; k < N - 1; ++k)
+        {
+            int p = MatNPivot(a, k);
+            if (a.rows[p].data[k] == 0)
+                return 0;
+            if (p != k)
+            {
+                MatNSwapRows(a, p, k);
+                sign = -sign;
+            }
+
+            long long pivot = a.rows[k].data[k];
+            for (int i = k + 1; i < N; ++i)
+            {
+                for (int j = k + 1; j < N; ++j)
+                    a.rows[i].data[j] = (a.rows[i].data[j] * pivot - a.rows[i].data[k] * a.rows[k].data[j]) / prev;
+            }
+            prev = pivot;
+        }
+        long long det = sign * a.rows[N - 1].data[N - 1];
+        assert(det >= INT_MIN && det <= INT_MAX);
+        return (int) det;
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR_14 bool TryInverse(const Mat<T, N, N>& m, Mat<T, N, N>& out)
+    {
+        // Reduce m to the identity, applying the same row operations to out.
+        Mat<T, N, N> a = m;
+        out            = Mat<T, N, N>::Identity();
+        for (int k = 0; k < N; ++k)
+        {
+            int p = MatNPivot(a, k);
+            if (MatNAbs(a.rows[p].data[k]) <= MatNEpsilon(T()))
+                return false;
+            if (p != k)
+            {
+                MatNSwapRows(a, p, k);
+                MatNSwapRows(out, p, k);
+            }
+
+            T inv       = T(1) / a.rows[k].data[k];
+            a.rows[k]   = a.rows[k] * inv;
+            out.rows[k] = out.rows[k] * inv;
+            for (int i = 0; i < N; ++i)
+            {
+                T f = a.rows[i].data[k];
+                if (i == k || f == T(0))
+                    continue;
+                a.rows[i]   = a.rows[i] - a.rows[k] * f;
+                out.rows[i] = out.rows[i] - out.rows[k] * f;
+            }
+        }
+        return true;
+    }
+
+    inline Mat2x2 ToSimd(const Mat<float, 2, 2>& m) { return Mat2x2(ToSimd(m.rows[0]), ToSimd(m.rows[1])); }
+    inline Mat3x3 ToSimd(const Mat<float, 3, 3>& m) { return Mat3x3(ToSimd(m.rows[0]), ToSimd(m.rows[1]), ToSimd(m.rows[2])); }
+    inline Mat4x4 ToSimd(const Mat<float, 4, 4>& m)
+    {
+        return Mat4x4(ToSimd(m.rows[0]), ToSimd(m.rows[1]), ToSimd(m.rows[2]), ToSimd(m.rows[3]));
+    }
+
+    inline Mat<float, 2, 2> ToMatN(const Mat2x2& m) { return Mat<float, 2, 2> { { ToVecN(m.rows[0]), ToVecN(m.rows[1]) } }; }
+    inline Mat<float, 3, 3> ToMatN(const Mat3x3& m)
+    {
+        return Mat<float, 3, 3> { { ToVecN(m.rows[0]), ToVecN(m.rows[1]), ToVecN(m.rows[2]) } };
+    }
+    inline Mat<float, 4, 4> ToMatN(const Mat4x4& m)
+    {
+        return Mat<float, 4, 4> { { ToVecN(m.rows[0]), ToVecN(m.rows[1]), ToVecN(m.rows[2]), ToVecN(m.rows[3]) } };
+    }
+} // namespace DropMath
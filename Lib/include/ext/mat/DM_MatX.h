@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../thread/DM_ThreadPool.h"
+#include "../utils/DM_Utils.h"
+
+// Dense matrices sized at run time, for the N x N systems of IK and constraint solvers (tens to hundreds of rows)
+// that the fixed size types don't cover. Not part of DropMath.h because it pulls the thread pool; include it
+// explicitly.
+namespace DropMath
+{
+    struct MatXSettings
+    {
+        MatXSettings() : parallelThreshold(1 << 20), pool(nullptr) { }
+
+        size_t      parallelThreshold; // Products and updates of fewer multiply-adds run on the calling thread only.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Row major float matrix. Every row starts on a cache line (Stride() floats apart), the floats between Cols()
+    // and Stride() are padding. New and resized matrices are zero.
+    class MatX
+    {
+    public:
+        MatX() : m_Rows(0), m_Cols(0), m_Stride(0) { }
+        MatX(size_t rows, size_t cols) : m_Rows(0), m_Cols(0), m_Stride(0) { Resize(rows, cols); }
+
+        static MatX Identity(size_t n);
+
+        size_t Rows() const { return m_Rows; }
+        size_t Cols() const { return m_Cols; }
+        // Floats from the start of a row to the start of the next.
+        size_t Stride() const { return m_Stride; }
+
+        float&       operator()(size_t row, size_t col) { return m_Data[row * m_Stride + col]; }
+        const float& operator()(size_t row, size_t col) const { return m_Data[row * m_Stride + col]; }
+        float*       Row(size_t row) { return m_Data.Data() + row * m_Stride; }
+        const float* Row(size_t row) const { return m_Data.Data() + row * m_Stride; }
+
+        // Change the size and set every element to 0.
+        void Resize(size_t rows, size_t cols);
+        void SetZero();
+
+        MatX Transpose() const;
+
+    private:
+        size_t              m_Rows;
+        size_t              m_Cols;
+        size_t              m_Stride;
+        AlignedArray<float> m_Data;
+    };
+
+    // c = a * b. c is resized and must not be a or b. The product is tiled for the caches, computes 4 x 8 blocks of c
+    // in SSE registers and splits the rows of c across the pool when large enough.
+    inline void Multiply(const MatX& a, const MatX& b, MatX& c, const MatXSettings& settings = MatXSettings());
+    inline MatX operator*(const MatX& a, const MatX& b);
+
+    // y = m * x, x has Cols() floats and y Rows().
+    inline void Multiply(const MatX& m, const float* x, float* y);
+
+    // Solve l * x = b in place (x holds b on input) with l lower triangular, only its lower triangle is read. With
+    // unitDiagonal the diagonal is taken as 1 and not read either.
+    inline void SolveLower(const MatX& l, float* x, bool unitDiagonal = false);
+    // Solve u * x = b in place with u upper triangular.
+    inline void SolveUpper(const MatX& u, float* x, bool unitDiagonal = false);
+    // Solve transpose(l) * x = b in place with l lower triangular, the second half of a Cholesky solve.
+    inline void SolveLowerTransposed(const MatX& l, float* x);
+
+    // Same with every column of b as a right hand side, the columns split across the pool when large enough.
+    inline void SolveLower(const MatX& l, MatX& b, bool unitDiagonal = false, const MatXSettings& settings = MatXSettings());
+    inline void SolveUpper(const MatX& u, MatX& b, bool unitDiagonal = false, const MatXSettings& settings = MatXSettings());
+    inline void SolveLowerTransposed(const MatX& l, MatX& b, const MatXSettings& settings = MatXSettings());
+
+    // p * a = l * u with partial pivoting, for square a. Blocked: every 32 columns factor as a panel, then the rest
+    // of the matrix is updated with the parallel product. The factors replace each other's zeros in one matrix,
+    // keep the object to solve with them for several right hand sides.
+    class LUDecomposition
+    {
+    public:
+        explicit LUDecomposition(const MatXSettings& settings = MatXSettings()) : m_Settings(settings), m_Sign(1) { }
+
+        // Return false if a is singular (a pivot at or below F::EPSILON times the largest element of a).
+        bool Factor(const MatX& a);
+
+        // Solve a * x = b. x may be b.
+        void Solve(const float* b, float* x) const;
+        // Solve a * x = b in place for every column of b.
+        void Solve(MatX& b) const;
+
+        float Determinant() const;
+
+        // l below the diagonal (unit diagonal not stored) and u on and above it.
+        const MatX& Factors() const { return m_LU; }
+        // Row i was swapped with row Pivots()[i] at step i.
+        const unsigned int* Pivots() const { return m_Pivots.Data(); }
+
+    private:
+        MatXSettings               m_Settings;
+        MatX                       m_LU;
+        AlignedArray<unsigned int> m_Pivots;
+        int                        m_Sign;
+    };
+
+    // a = l * transpose(l) for symmetric positive definite a, only the lower triangle of a is read. Blocked like
+    // LUDecomposition, the trailing updates only compute the lower triangle.
+    class CholeskyDecomposition
+    {
+    public:
+        explicit CholeskyDecomposition(const MatXSettings& settings = MatXSettings()) : m_Settings(settings) { }
+
+        // Return false if a is not positive definite.
+        bool Factor(const MatX& a);
+
+        // Solve a * x = b. x may be b.
+        void Solve(const float* b, float* x) const;
+        // Solve a * x = b in place for every column of b.
+        void Solve(MatX& b) const;
+
+        // Lower triangular factor, zero above the diagonal.
+        const MatX& L() const { return m_L; }
+
+    private:
+        MatXSettings m_Settings;
+        MatX         m_L;
+        MatX         m_Panel; // Transposed columns of the current block, the right operand of the trailing update.
+    };
+} // namespace DropMath
+
+#include "DM_MatX.inl"
@@ -0,0 +1,540 @@
+#include <cstring>
+
+namespace DropMath
+{
+    namespace
+    {
+        const size_t g_MATX_ALIGN = CACHE_LINE_SIZE / sizeof(float); // Row strides are a multiple of this.
+        const size_t g_MATX_MC    = 64;  // Rows of a that a product keeps in L2 at once.
+        const size_t g_MATX_KC    = 256; // Depth of a product step: a strip of b (KC x 8) stays in L1.
+        const size_t g_MATX_BLOCK = 32;  // Panel width of the LU and Cholesky factorizations.
+
+        inline float MatXDot(const float* a, const float* b, size_t n)
+        {
+            float4 sum0 = _mm_setzero_ps();
+            float4 sum1 = _mm_setzero_ps();
+            size_t i    = 0;
+            for (; i + 8 <= n; i += 8)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+            if (i + 4 <= n)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                i += 4;
+            }
+            sum0      = _mm_add_ps(sum0, sum1);
+            sum0      = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+            sum0      = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, _MM_SHUFFLE(1, 1, 1, 1)));
+            float sum = _mm_cvtss_f32(sum0);
+            for (; i < n; ++i)
+                sum += a[i] * b[i];
+            return sum;
+        }
+
+        // y += s * x.
+        inline void MatXAxpy(float* y, const float* x, float s, size_t n)
+        {
+            const float4 s4 = _mm_set1_ps(s);
+            size_t       i  = 0;
+            for (; i + 4 <= n; i += 4)
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(s4, _mm_loadu_ps(x + i))));
+            for (; i < n; ++i)
+                y[i] += s * x[i];
+        }
+
+        inline void MatXScale(float* y, float s, size_t n)
+        {
+            const float4 s4 = _mm_set1_ps(s);
+            size_t       i  = 0;
+            for (; i + 4 <= n; i += 4)
+                _mm_storeu_ps(y + i, _mm_mul_ps(s4, _mm_loadu_ps(y + i)));
+            for (; i < n; ++i)
+                y[i] *= s;
+        }
+
+        inline void MatXSwapRows(float* a, float* b, size_t n)
+        {
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                float4 t = _mm_loadu_ps(a + i);
+                _mm_storeu_ps(a + i, _mm_loadu_ps(b + i));
+                _mm_storeu_ps(b + i, t);
+            }
+            for (; i < n; ++i)
+            {
+                float t = a[i];
+                a[i]    = b[i];
+                b[i]    = t;
+            }
+        }
+
+        // c (R x 4W) += alpha * a (R x k) * b (k x 4W), with the block of c in R * W registers. Every step broadcasts
+        // one element of each row of a against the same W vectors of b.
+        template <int R, int W>
+        inline void MatXKernel(const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc, size_t k, float4 alpha)
+        {
+            float4 acc[R][W];
+            for (int r = 0; r < R; ++r)
+                for (int w = 0; w < W; ++w)
+                    acc[r][w] = _mm_setzero_ps();
+
+            for (size_t p = 0; p < k; ++p)
+            {
+                float4 bv[W];
+                for (int w = 0; w < W; ++w)
+                    bv[w] = _mm_loadu_ps(b + p * ldb + 4 * w);
+                for (int r = 0; r < R; ++r)
+                {
+                    const float4 av = _mm_set1_ps(a[r * lda + p]);
+                    for (int w = 0; w < W; ++w)
+                        acc[r][w] = _mm_add_ps(acc[r][w], _mm_mul_ps(av, bv[w]));
+                }
+            }
+
+            for (int r = 0; r < R; ++r)
+                for (int w = 0; w < W; ++w)
+                {
+                    float* out = c + r * ldc + 4 * w;
+                    _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(alpha, acc[r][w])));
+                }
+        }
+
+        // The 4W columns of c starting at c for rows rows, 4 rows at a time.
+        template <int W>
+        inline void MatXStrip(const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc, size_t rows, size_t k, float4 alpha)
+        {
+            size_t i = 0;
+            for (; i + 4 <= rows; i += 4)
+                MatXKernel<4, W>(a + i * lda, lda, b, ldb, c + i * ldc, ldc, k, alpha);
+            for (; i < rows; ++i)
+                MatXKernel<1, W>(a + i * lda, lda, b, ldb, c + i * ldc, ldc, k, alpha);
+        }
+
+        // c (m x n) += alpha * a (m x k) * b (k x n) on the calling thread, the operands given by their first element
+        // and row stride so they can be blocks of larger matrices. Blocks of a (MC x KC) stay in L2 while every 8
+        // column strip of b (KC x 8) is reused from L1 by all their rows.
+        inline void MatXGemm(const float* a, size_t lda, const float* b, size_t ldb, float* c, size_t ldc, size_t m, size_t n, size_t k, float alpha)
+        {
+            const float4 alpha4 = _mm_set1_ps(alpha);
+            for (size_t p0 = 0; p0 < k; p0 += g_MATX_KC)
+            {
+                const size_t kc = k - p0 < g_MATX_KC ? k - p0 : g_MATX_KC;
+                for (size_t i0 = 0; i0 < m; i0 += g_MATX_MC)
+                {
+                    const size_t mc = m - i0 < g_MATX_MC ? m - i0 : g_MATX_MC;
+                    const float* ap = a + i0 * lda + p0;
+                    const float* bp = b + p0 * ldb;
+                    float*       cp = c + i0 * ldc;
+
+                    size_t j = 0;
+                    for (; j + 8 <= n; j += 8)
+                        MatXStrip<2>(ap, lda, bp + j, ldb, cp + j, ldc, mc, kc, alpha4);
+                    if (j + 4 <= n)
+                    {
+                        MatXStrip<1>(ap, lda, bp + j, ldb, cp + j, ldc, mc, kc, alpha4);
+                        j += 4;
+                    }
+                    for (; j < n; ++j)
+                    {
+                        for (size_t i = 0; i < mc; ++i)
+                        {
+                            float sum = 0.0f;
+                            for (size_t p = 0; p < kc; ++p)
+                                sum += ap[i * lda + p] * bp[p * ldb + j];
+                            cp[i * ldc + j] += alpha * sum;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Call fn(first, last) on chunks of [0, count), split across the pool when work (multiply-adds) reaches the
+        // threshold of settings.
+        template <typename Fn>
+        inline void MatXParallel(const MatXSettings& settings, size_t count, double work, Fn fn)
+        {
+            if (count == 0)
+                return;
+            if (work < (double) settings.parallelThreshold || count < 8)
+            {
+                fn((size_t) 0, count);
+                return;
+            }
+            ThreadPool& pool  = settings.pool ? *settings.pool : ThreadPool::Default();
+            size_t      grain = count / (4 * (size_t) pool.ThreadCount());
+            grain             = grain < 4 ? 4 : (grain + 3) & ~(size_t) 3;
+            pool.ParallelFor(0, count, grain, fn);
+        }
+
+        // The multi right hand side triangular solves without their profile scope, for the decompositions' Solve.
+        inline void MatXSolveLower(const MatX& l, MatX& b, bool unitDiagonal, const MatXSettings& settings)
+        {
+            assert(l.Rows() == l.Cols() && l.Rows() == b.Rows());
+            const size_t n = l.Rows();
+            MatXParallel(settings, b.Cols(), 0.5 * (double) n * n * b.Cols(),
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = 0; i < n; ++i)
+                             {
+                                 float* row = b.Row(i) + first;
+                                 for (size_t q = 0; q < i; ++q)
+                                     MatXAxpy(row, b.Row(q) + first, -l(i, q), last - first);
+                                 if (!unitDiagonal)
+                                     MatXScale(row, 1.0f / l(i, i), last - first);
+                             }
+                         });
+        }
+
+        inline void MatXSolveUpper(const MatX& u, MatX& b, bool unitDiagonal, const MatXSettings& settings)
+        {
+            assert(u.Rows() == u.Cols() && u.Rows() == b.Rows());
+            const size_t n = u.Rows();
+            MatXParallel(settings, b.Cols(), 0.5 * (double) n * n * b.Cols(),
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = n; i-- > 0;)
+                             {
+                                 float* row = b.Row(i) + first;
+                                 for (size_t q = i + 1; q < n; ++q)
+                                     MatXAxpy(row, b.Row(q) + first, -u(i, q), last - first);
+                                 if (!unitDiagonal)
+                                     MatXScale(row, 1.0f / u(i, i), last - first);
+                             }
+                         });
+        }
+
+        inline void MatXSolveLowerTransposed(const MatX& l, MatX& b, const MatXSettings& settings)
+        {
+            assert(l.Rows() == l.Cols() && l.Rows() == b.Rows());
+            const size_t n = l.Rows();
+            MatXParallel(settings, b.Cols(), 0.5 * (double) n * n * b.Cols(),
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = n; i-- > 0;)
+                             {
+                                 float* row = b.Row(i) + first;
+                                 MatXScale(row, 1.0f / l(i, i), last - first);
+                                 for (size_t q = 0; q < i; ++q)
+                                     MatXAxpy(b.Row(q) + first, row, -l(i, q), last - first);
+                             }
+                         });
+        }
+    } // anonymous namespace
+
+    inline MatX MatX::Identity(size_t n)
+    {
+        MatX m(n, n);
+        for (size_t i = 0; i < n; ++i)
+            m(i, i) = 1.0f;
+        return m;
+    }
+
+    inline void MatX::Resize(size_t rows, size_t cols)
+    {
+        m_Rows   = rows;
+        m_Cols   = cols;
+        m_Stride = (cols + g_MATX_ALIGN - 1) & ~(g_MATX_ALIGN - 1);
+        m_Data.Clear();
+        m_Data.Resize(rows * m_Stride);
+        SetZero();
+    }
+
+    inline void MatX::SetZero()
+    {
+        if (m_Data.Size())
+            std::memset(m_Data.Data(), 0, m_Data.Size() * sizeof(float));
+    }
+
+    inline MatX MatX::Transpose() const
+    {
+        MatX t(m_Cols, m_Rows);
+        // 16 x 16 tiles, so both the reads and the writes stay on a few cache lines.
+        for (size_t i0 = 0; i0 < m_Rows; i0 += g_MATX_ALIGN)
+        {
+            const size_t i1 = Min(i0 + g_MATX_ALIGN, m_Rows);
+            for (size_t j0 = 0; j0 < m_Cols; j0 += g_MATX_ALIGN)
+            {
+                const size_t j1 = Min(j0 + g_MATX_ALIGN, m_Cols);
+                for (size_t i = i0; i < i1; ++i)
+                    for (size_t j = j0; j < j1; ++j)
+                        t(j, i) = (*this)(i, j);
+            }
+        }
+        return t;
+    }
+
+    inline void Multiply(const MatX& a, const MatX& b, MatX& c, const MatXSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_MUL, a.Rows() * b.Cols());
+        assert(a.Cols() == b.Rows() && &c != &a && &c != &b);
+
+        const size_t m = a.Rows(), n = b.Cols(), k = a.Cols();
+        c.Resize(m, n);
+        if (k == 0)
+            return;
+        MatXParallel(settings, m, (double) m * n * k,
+                     [&](size_t first, size_t last)
+                     { MatXGemm(a.Row(first), a.Stride(), b.Row(0), b.Stride(), c.Row(first), c.Stride(), last - first, n, k, 1.0f); });
+    }
+
+    inline MatX operator*(const MatX& a, const MatX& b)
+    {
+        MatX c;
+        Multiply(a, b, c);
+        return c;
+    }
+
+    inline void Multiply(const MatX& m, const float* x, float* y)
+    {
+        for (size_t i = 0; i < m.Rows(); ++i)
+            y[i] = MatXDot(m.Row(i), x, m.Cols());
+    }
+
+    inline void SolveLower(const MatX& l, float* x, bool unitDiagonal)
+    {
+        assert(l.Rows() == l.Cols());
+        for (size_t i = 0; i < l.Rows(); ++i)
+        {
+            const float s = x[i] - MatXDot(l.Row(i), x, i);
+            x[i]          = unitDiagonal ? s : s / l(i, i);
+        }
+    }
+
+    inline void SolveUpper(const MatX& u, float* x, bool unitDiagonal)
+    {
+        assert(u.Rows() == u.Cols());
+        const size_t n = u.Rows();
+        for (size_t i = n; i-- > 0;)
+        {
+            const float s = x[i] - MatXDot(u.Row(i) + i + 1, x + i + 1, n - i - 1);
+            x[i]          = unitDiagonal ? s : s / u(i, i);
+        }
+    }
+
+    inline void SolveLowerTransposed(const MatX& l, float* x)
+    {
+        assert(l.Rows() == l.Cols());
+        // Column i of transpose(l) is row i of l: once x[i] is known, remove it from the equations above.
+        for (size_t i = l.Rows(); i-- > 0;)
+        {
+            x[i] /= l(i, i);
+            MatXAxpy(x, l.Row(i), -x[i], i);
+        }
+    }
+
+    inline void SolveLower(const MatX& l, MatX& b, bool unitDiagonal, const MatXSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_TRIANGULAR_SOLVE, b.Cols());
+        MatXSolveLower(l, b, unitDiagonal, settings);
+    }
+
+    inline void SolveUpper(const MatX& u, MatX& b, bool unitDiagonal, const MatXSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_TRIANGULAR_SOLVE, b.Cols());
+        MatXSolveUpper(u, b, unitDiagonal, settings);
+    }
+
+    inline void SolveLowerTransposed(const MatX& l, MatX& b, const MatXSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_TRIANGULAR_SOLVE, b.Cols());
+        MatXSolveLowerTransposed(l, b, settings);
+    }
+
+    inline bool LUDecomposition::Factor(const MatX& a)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_LU, 1);
+        assert(a.Rows() == a.Cols());
+
+        const size_t n = a.Rows();
+        m_LU           = a;
+        m_Pivots.Resize(n);
+        m_Sign = 1;
+
+        float scale = 0.0f;
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                scale = Max(scale, Abs(a(i, j)));
+        const float  tolerance = F::EPSILON * scale;
+        const size_t stride    = m_LU.Stride();
+
+        for (size_t k0 = 0; k0 < n; k0 += g_MATX_BLOCK)
+        {
+            const size_t k1 = Min(k0 + g_MATX_BLOCK, n);
+
+            // Unblocked elimination of the panel columns [k0, k1), the row swaps applied to whole rows.
+            for (size_t k = k0; k < k1; ++k)
+            {
+                size_t pivot = k;
+                float  best  = Abs(m_LU(k, k));
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    const float v = Abs(m_LU(i, k));
+                    if (v > best)
+                    {
+                        best  = v;
+                        pivot = i;
+                    }
+                }
+                m_Pivots[k] = (unsigned int) pivot;
+                if (!(best > tolerance))
+                {
+                    DM_PROFILE_FAILURE(PROFILE_OP_MATX_LU);
+                    return false;
+                }
+                if (pivot != k)
+                {
+                    MatXSwapRows(m_LU.Row(k), m_LU.Row(pivot), n);
+                    m_Sign = -m_Sign;
+                }
+
+                const float  inverse  = 1.0f / m_LU(k, k);
+                const float* pivotRow = m_LU.Row(k);
+                for (size_t i = k + 1; i < n; ++i)
+                {
+                    float* row = m_LU.Row(i);
+                    row[k] *= inverse;
+                    MatXAxpy(row + k + 1, pivotRow + k + 1, -row[k], k1 - k - 1);
+                }
+            }
+            if (k1 == n)
+                break;
+
+            // Rows of u right of the panel: the unit lower triangle of the panel solved against them.
+            const size_t rest = n - k1;
+            for (size_t r = k0 + 1; r < k1; ++r)
+                for (size_t q = k0; q < r; ++q)
+                    MatXAxpy(m_LU.Row(r) + k1, m_LU.Row(q) + k1, -m_LU(r, q), rest);
+
+            // Trailing matrix minus the panel's l times those rows of u, the bulk of the work.
+            MatXParallel(m_Settings, rest, (double) rest * rest * (k1 - k0),
+                         [&](size_t first, size_t last)
+                         {
+                             MatXGemm(m_LU.Row(k1 + first) + k0, stride, m_LU.Row(k0) + k1, stride, m_LU.Row(k1 + first) + k1, stride,
+                                      last - first, rest, k1 - k0, -1.0f);
+                         });
+        }
+        return true;
+    }
+
+    inline void LUDecomposition::Solve(const float* b, float* x) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_LU_SOLVE, 1);
+        const size_t n = m_LU.Rows();
+        if (x != b)
+            std::memcpy(x, b, n * sizeof(float));
+        for (size_t k = 0; k < n; ++k)
+        {
+            const float t  = x[k];
+            x[k]           = x[m_Pivots[k]];
+            x[m_Pivots[k]] = t;
+        }
+        SolveLower(m_LU, x, true);
+        SolveUpper(m_LU, x, false);
+    }
+
+    inline void LUDecomposition::Solve(MatX& b) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_LU_SOLVE, b.Cols());
+        assert(b.Rows() == m_LU.Rows());
+        for (size_t k = 0; k < b.Rows(); ++k)
+        {
+            if (m_Pivots[k] != k)
+                MatXSwapRows(b.Row(k), b.Row(m_Pivots[k]), b.Cols());
+        }
+        MatXSolveLower(m_LU, b, true, m_Settings);
+        MatXSolveUpper(m_LU, b, false, m_Settings);
+    }
+
+    inline float LUDecomposition::Determinant() const
+    {
+        float det = (float) m_Sign;
+        for (size_t i = 0; i < m_LU.Rows(); ++i)
+            det *= m_LU(i, i);
+        return det;
+    }
+
+    inline bool CholeskyDecomposition::Factor(const MatX& a)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_CHOLESKY, 1);
+        assert(a.Rows() == a.Cols());
+
+        const size_t n      = a.Rows();
+        m_L                 = a;
+        const size_t stride = m_L.Stride();
+
+        for (size_t k0 = 0; k0 < n; k0 += g_MATX_BLOCK)
+        {
+            const size_t k1 = Min(k0 + g_MATX_BLOCK, n);
+
+            // Diagonal block, the columns left of it were already subtracted by the trailing updates.
+            for (size_t j = k0; j < k1; ++j)
+            {
+                float*      rowJ = m_L.Row(j);
+                const float d    = rowJ[j] - MatXDot(rowJ + k0, rowJ + k0, j - k0);
+                if (!(d > 0.0f))
+                {
+                    DM_PROFILE_FAILURE(PROFILE_OP_MATX_CHOLESKY);
+                    return false;
+                }
+                rowJ[j]             = Sqrt(d);
+                const float inverse = 1.0f / rowJ[j];
+                for (size_t i = j + 1; i < k1; ++i)
+                {
+                    float* rowI = m_L.Row(i);
+                    rowI[j]     = (rowI[j] - MatXDot(rowI + k0, rowJ + k0, j - k0)) * inverse;
+                }
+            }
+            if (k1 == n)
+                break;
+
+            // Rows of l below the block, and their transpose as the right operand of the update.
+            const size_t rest = n - k1;
+            m_Panel.Resize(k1 - k0, rest);
+            MatXParallel(m_Settings, rest, 0.5 * (double) rest * (k1 - k0) * (k1 - k0),
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 float* row = m_L.Row(k1 + i);
+                                 for (size_t j = k0; j < k1; ++j)
+                                 {
+                                     row[j]             = (row[j] - MatXDot(row + k0, m_L.Row(j) + k0, j - k0)) / m_L(j, j);
+                                     m_Panel(j - k0, i) = row[j];
+                                 }
+                             }
+                         });
+
+            // Lower triangle of the trailing matrix minus those rows times their transpose: rows [first, last) only
+            // need the columns up to last.
+            MatXParallel(m_Settings, rest, 0.5 * (double) rest * rest * (k1 - k0),
+                         [&](size_t first, size_t last)
+                         {
+                             MatXGemm(m_L.Row(k1 + first) + k0, stride, m_Panel.Row(0), m_Panel.Stride(), m_L.Row(k1 + first) + k1, stride,
+                                      last - first, last, k1 - k0, -1.0f);
+                         });
+        }
+
+        for (size_t i = 0; i + 1 < n; ++i)
+            std::memset(m_L.Row(i) + i + 1, 0, (n - i - 1) * sizeof(float));
+        return true;
+    }
+
+    inline void CholeskyDecomposition::Solve(const float* b, float* x) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_CHOLESKY_SOLVE, 1);
+        if (x != b)
+            std::memcpy(x, b, m_L.Rows() * sizeof(float));
+        SolveLower(m_L, x, false);
+        SolveLowerTransposed(m_L, x);
+    }
+
+    inline void CholeskyDecomposition::Solve(MatX& b) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_MATX_CHOLESKY_SOLVE, b.Cols());
+        MatXSolveLower(m_L, b, false, m_Settings);
+        MatXSolveLowerTransposed(m_L, b, m_Settings);
+    }
+} // namespace DropMath
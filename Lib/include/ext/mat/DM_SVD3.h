@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../vec/DM_Vec3x4.h"
+#include "DM_Mat3x3.h"
+
+namespace DropMath
+{
+    // 3x3 decompositions for FEM and shape matching, 8 matrices at a time in two interleaved SSE registers (the rest
+    // 4 at a time) with the same branchless steps in every lane, so the cost doesn't depend on the input. The
+    // eigenvectors, u and v are products of Jacobi and Givens rotations, so they are proper rotations (determinant +1)
+    // even for reflections and singular input.
+
+    // a = v * diag(eigenvalues) * transpose(v) for symmetric a, only the upper triangle of a is read. The eigenvalues
+    // are sorted from largest to smallest, the columns of v are the matching unit eigenvectors.
+    inline void SymmetricEigen(const Mat3x3& a, Vec3& eigenvalues, Mat3x3& eigenvectors);
+    inline void SymmetricEigen(const Mat3x3* matrices, size_t count, Vec3* eigenvalues, Mat3x3* eigenvectors);
+
+    // a = u * diag(sigma) * transpose(v) with u and v rotations (McAdams et al., "Computing the Singular Value
+    // Decomposition of 3x3 matrices with minimal branching and elementary floating point operations"): Jacobi
+    // rotations diagonalize transpose(a) * a into v, then Givens rotations turn a * v into u times a triangle whose
+    // diagonal is sigma. The singular values are sorted by decreasing magnitude, sigma.z is negative when a is a
+    // reflection (negative determinant).
+    inline void SVD(const Mat3x3& a, Mat3x3& u, Vec3& sigma, Mat3x3& v);
+    inline void SVD(const Mat3x3* matrices, size_t count, Mat3x3* u, Vec3* sigma, Mat3x3* v);
+
+    // a = rotation * stretch from the SVD: rotation = u * transpose(v) and the symmetric stretch = v * diag(sigma) *
+    // transpose(v). For an inverted element (negative determinant) the rotation stays proper and the stretch takes the
+    // negative singular value, as invertible FEM expects. stretches may be nullptr.
+    inline void PolarDecomposition(const Mat3x3& a, Mat3x3& rotation, Mat3x3& stretch);
+    inline void PolarDecomposition(const Mat3x3* matrices, size_t count, Mat3x3* rotations, Mat3x3* stretches);
+} // namespace DropMath
+
+#include "DM_SVD3.inl"
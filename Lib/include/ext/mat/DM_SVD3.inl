@@ -0,0 +1,460 @@
+namespace DropMath
+{
+    namespace
+    {
+        const int   g_SVD3_SWEEPS      = 4;     // Cyclic Jacobi sweeps of 3 rotations. Convergence is quadratic, 4 reach
+                                                // float round off on the tested inputs, clustered eigenvalues included.
+        const float g_SVD3_MIN_TANGENT = 6e-8f; // Smaller rotations are below float round off and skipped, which also
+                                                // keeps the converged off diagonal from going denormal.
+        // Givens rotations of a squared length below this are skipped. The kernels scale the largest element of a to 1,
+        // so it is relative to the magnitude of a.
+        const float g_SVD3_TINY = 1e-30f;
+
+        // Two SSE registers worked on together. Every rotation is a chain of dependent sqrt and div, the chain of the
+        // second register fills the latency of the first.
+        struct Svd3Wide
+        {
+            float4 lo;
+            float4 hi;
+        };
+
+        // Lane operations for float4 and Svd3Wide, so the kernels below are written once for both widths.
+        inline float4 Svd3Add(float4 a, float4 b) { return _mm_add_ps(a, b); }
+        inline float4 Svd3Sub(float4 a, float4 b) { return _mm_sub_ps(a, b); }
+        inline float4 Svd3Mul(float4 a, float4 b) { return _mm_mul_ps(a, b); }
+        inline float4 Svd3Div(float4 a, float4 b) { return _mm_div_ps(a, b); }
+        inline float4 Svd3Max(float4 a, float4 b) { return _mm_max_ps(a, b); }
+        inline float4 Svd3And(float4 a, float4 b) { return _mm_and_ps(a, b); }
+        inline float4 Svd3Xor(float4 a, float4 b) { return _mm_xor_ps(a, b); }
+        inline float4 Svd3Greater(float4 a, float4 b) { return _mm_cmpgt_ps(a, b); }
+        inline float4 Svd3Less(float4 a, float4 b) { return _mm_cmplt_ps(a, b); }
+        inline float4 Svd3Sqrt(float4 a) { return _mm_sqrt_ps(a); }
+        inline float4 Svd3Abs(float4 a) { return _mm_and_ps(g_SIGN_MASK_F, a); }
+        inline float4 Svd3SignBit(float4 a) { return _mm_andnot_ps(g_SIGN_MASK_F, a); }
+        // b where mask is set, a elsewhere.
+        inline float4 Svd3Select(float4 a, float4 b, float4 mask) { return _mm_blendv_ps(a, b, mask); }
+
+#define DM_SVD3_WIDE_UNARY(name)                                                                                       \
+    inline Svd3Wide name(const Svd3Wide& a)                                                                            \
+    {                                                                                                                  \
+        Svd3Wide r = { name(a.lo), name(a.hi) };                                                                       \
+        return r;                                                                                                      \
+    }
+#define DM_SVD3_WIDE_BINARY(name)                                                                                      \
+    inline Svd3Wide name(const Svd3Wide& a, const Svd3Wide& b)                                                         \
+    {                                                                                                                  \
+        Svd3Wide r = { name(a.lo, b.lo), name(a.hi, b.hi) };                                                           \
+        return r;                                                                                                      \
+    }
+        DM_SVD3_WIDE_BINARY(Svd3Add)
+        DM_SVD3_WIDE_BINARY(Svd3Sub)
+        DM_SVD3_WIDE_BINARY(Svd3Mul)
+        DM_SVD3_WIDE_BINARY(Svd3Div)
+        DM_SVD3_WIDE_BINARY(Svd3Max)
+        DM_SVD3_WIDE_BINARY(Svd3And)
+        DM_SVD3_WIDE_BINARY(Svd3Xor)
+        DM_SVD3_WIDE_BINARY(Svd3Greater)
+        DM_SVD3_WIDE_BINARY(Svd3Less)
+        DM_SVD3_WIDE_UNARY(Svd3Sqrt)
+        DM_SVD3_WIDE_UNARY(Svd3Abs)
+        DM_SVD3_WIDE_UNARY(Svd3SignBit)
+#undef DM_SVD3_WIDE_UNARY
+#undef DM_SVD3_WIDE_BINARY
+
+        inline Svd3Wide Svd3Select(const Svd3Wide& a, const Svd3Wide& b, const Svd3Wide& mask)
+        {
+            Svd3Wide r = { Svd3Select(a.lo, b.lo, mask.lo), Svd3Select(a.hi, b.hi, mask.hi) };
+            return r;
+        }
+
+        // Splats and aligned loads and stores of the lanes, sizeof(L) / sizeof(float) of them.
+        template <typename L>
+        inline L Svd3Set(float s);
+        template <typename L>
+        inline L Svd3LoadLanes(const float* src);
+
+        template <>
+        inline float4 Svd3Set<float4>(float s)
+        {
+            return _mm_set1_ps(s);
+        }
+        template <>
+        inline float4 Svd3LoadLanes<float4>(const float* src)
+        {
+            return _mm_load_ps(src);
+        }
+        inline void Svd3StoreLanes(float* dst, float4 v) { _mm_store_ps(dst, v); }
+
+        template <>
+        inline Svd3Wide Svd3Set<Svd3Wide>(float s)
+        {
+            Svd3Wide r = { _mm_set1_ps(s), _mm_set1_ps(s) };
+            return r;
+        }
+        template <>
+        inline Svd3Wide Svd3LoadLanes<Svd3Wide>(const float* src)
+        {
+            Svd3Wide r = { _mm_load_ps(src), _mm_load_ps(src + 4) };
+            return r;
+        }
+        inline void Svd3StoreLanes(float* dst, const Svd3Wide& v)
+        {
+            _mm_store_ps(dst, v.lo);
+            _mm_store_ps(dst + 4, v.hi);
+        }
+
+        // e[i][j] = element (i, j) of matrices [0, n), lanes past n are zero.
+        template <typename L>
+        inline void Svd3Load(const Mat3x3* m, size_t n, L e[3][3])
+        {
+            alignas(16) float lanes[9][sizeof(L) / sizeof(float)] = {};
+            for (size_t lane = 0; lane < n; ++lane)
+            {
+                const float* d = m[lane].Data();
+                for (int k = 0; k < 9; ++k)
+                    lanes[k][lane] = d[k];
+            }
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    e[i][j] = Svd3LoadLanes<L>(lanes[3 * i + j]);
+        }
+
+        template <typename L>
+        inline void Svd3Store(const L e[3][3], size_t n, Mat3x3* m)
+        {
+            alignas(16) float lanes[9][sizeof(L) / sizeof(float)];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    Svd3StoreLanes(lanes[3 * i + j], e[i][j]);
+            for (size_t lane = 0; lane < n; ++lane)
+            {
+                float* d = m[lane].Data();
+                for (int k = 0; k < 9; ++k)
+                    d[k] = lanes[k][lane];
+            }
+        }
+
+        template <typename L>
+        inline void Svd3Store(const L v[3], size_t n, Vec3* dst)
+        {
+            alignas(16) float lanes[3][sizeof(L) / sizeof(float)];
+            for (int k = 0; k < 3; ++k)
+                Svd3StoreLanes(lanes[k], v[k]);
+            for (size_t lane = 0; lane < n; ++lane)
+                dst[lane] = Vec3(lanes[0][lane], lanes[1][lane], lanes[2][lane]);
+        }
+
+        template <typename L>
+        inline void Svd3Identity(L m[3][3])
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    m[i][j] = Svd3Set<L>(i == j ? 1.0f : 0.0f);
+        }
+
+        // Rotation that diagonalizes the symmetric 2 x 2 [spp spq; spq sqq]. t is the tangent of the smaller angle,
+        // sign(d) * 2 spq / (|d| + sqrt(d^2 + 4 spq^2)) with d = sqq - spp, and 0 when d = spq = 0. The squares only
+        // stay in float range for inputs of moderate magnitude, which the kernels ensure by scaling a first.
+        template <typename L>
+        inline void Svd3Rotation(const L& spp, const L& sqq, const L& spq, L& t, L& c, L& sn)
+        {
+            const L one    = Svd3Set<L>(1.0f);
+            const L d      = Svd3Sub(sqq, spp);
+            const L twoSpq = Svd3Add(spq, spq);
+            const L den    = Svd3Add(Svd3Abs(d), Svd3Sqrt(Svd3Add(Svd3Mul(d, d), Svd3Mul(twoSpq, twoSpq))));
+            t              = Svd3Xor(Svd3Div(twoSpq, den), Svd3SignBit(d));
+            t              = Svd3And(t, Svd3Greater(Svd3Abs(t), Svd3Set<L>(g_SVD3_MIN_TANGENT))); // Also 0 / 0.
+            c              = Svd3Div(one, Svd3Sqrt(Svd3Add(one, Svd3Mul(t, t))));
+            sn             = Svd3Mul(t, c);
+        }
+
+        // Rotate columns P and Q of m by (c, sn).
+        template <int P, int Q, typename L>
+        inline void Svd3RotateColumns(L m[3][3], const L& c, const L& sn)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                const L mp = m[k][P];
+                const L mq = m[k][Q];
+                m[k][P]    = Svd3Sub(Svd3Mul(c, mp), Svd3Mul(sn, mq));
+                m[k][Q]    = Svd3Add(Svd3Mul(sn, mp), Svd3Mul(c, mq));
+            }
+        }
+
+        // Jacobi rotation in the (P, Q) plane that zeroes s[P][Q] of the symmetric s, accumulated into the columns of v.
+        template <int P, int Q, typename L>
+        inline void Svd3Jacobi(L s[3][3], L v[3][3])
+        {
+            const int R   = 3 - P - Q;
+            const L   spq = s[P][Q];
+            L         t, c, sn;
+            Svd3Rotation(s[P][P], s[Q][Q], spq, t, c, sn);
+
+            const L tSpq      = Svd3Mul(t, spq);
+            s[P][P]           = Svd3Sub(s[P][P], tSpq);
+            s[Q][Q]           = Svd3Add(s[Q][Q], tSpq);
+            s[P][Q] = s[Q][P] = Svd3Set<L>(0.0f);
+
+            const L srp       = s[R][P];
+            const L srq       = s[R][Q];
+            s[R][P] = s[P][R] = Svd3Sub(Svd3Mul(c, srp), Svd3Mul(sn, srq));
+            s[R][Q] = s[Q][R] = Svd3Add(Svd3Mul(sn, srp), Svd3Mul(c, srq));
+
+            Svd3RotateColumns<P, Q>(v, c, sn);
+        }
+
+        // One sided Jacobi rotation that makes columns P and Q of b orthogonal, accumulated into v. The dot products
+        // come from b itself, so columns too short to be told apart in transpose(a) * a are still separated.
+        template <int P, int Q, typename L>
+        inline void Svd3Orthogonalize(L b[3][3], L v[3][3])
+        {
+            L spp = Svd3Set<L>(0.0f), sqq = spp, spq = spp, t, c, sn;
+            for (int k = 0; k < 3; ++k)
+            {
+                spp = Svd3Add(spp, Svd3Mul(b[k][P], b[k][P]));
+                sqq = Svd3Add(sqq, Svd3Mul(b[k][Q], b[k][Q]));
+                spq = Svd3Add(spq, Svd3Mul(b[k][P], b[k][Q]));
+            }
+            Svd3Rotation(spp, sqq, spq, t, c, sn);
+            Svd3RotateColumns<P, Q>(b, c, sn);
+            Svd3RotateColumns<P, Q>(v, c, sn);
+        }
+
+        // Diagonalize the symmetric s, v = the accumulated rotation.
+        template <typename L>
+        inline void Svd3Diagonalize(L s[3][3], L v[3][3])
+        {
+            Svd3Identity(v);
+            for (int sweep = 0; sweep < g_SVD3_SWEEPS; ++sweep)
+            {
+                Svd3Jacobi<0, 1>(s, v);
+                Svd3Jacobi<0, 2>(s, v);
+                Svd3Jacobi<1, 2>(s, v);
+            }
+        }
+
+        // Where key[A] < key[B], swap the keys and columns A and B of m (and of n if given), negating the new column B
+        // so a rotation stays a rotation.
+        template <int A, int B, typename L>
+        inline void Svd3SortColumns(L key[3], L m[3][3], L (*n)[3])
+        {
+            const L swap = Svd3Less(key[A], key[B]);
+            const L ka   = key[A];
+            key[A]       = Svd3Select(ka, key[B], swap);
+            key[B]       = Svd3Select(key[B], ka, swap);
+            const L flip = Svd3And(swap, Svd3Set<L>(-0.0f));
+            for (int k = 0; k < 3; ++k)
+            {
+                const L ma = m[k][A];
+                m[k][A]    = Svd3Select(ma, m[k][B], swap);
+                m[k][B]    = Svd3Select(m[k][B], Svd3Xor(ma, flip), swap);
+                if (n)
+                {
+                    const L na = n[k][A];
+                    n[k][A]    = Svd3Select(na, n[k][B], swap);
+                    n[k][B]    = Svd3Select(n[k][B], Svd3Xor(na, flip), swap);
+                }
+            }
+        }
+
+        // Givens rotation of rows P and Q of b that zeroes b[Q][C] against b[P][C], accumulated into the columns of u.
+        // Columns left of C are already zero in both rows.
+        template <int P, int Q, int C, typename L>
+        inline void Svd3Givens(L b[3][3], L u[3][3])
+        {
+            const L one   = Svd3Set<L>(1.0f);
+            const L x     = b[P][C];
+            const L y     = b[Q][C];
+            const L r2    = Svd3Add(Svd3Mul(x, x), Svd3Mul(y, y));
+            const L valid = Svd3Greater(r2, Svd3Set<L>(g_SVD3_TINY));
+            const L inv   = Svd3Div(one, Svd3Sqrt(Svd3Select(one, r2, valid)));
+            const L c     = Svd3Select(one, Svd3Mul(x, inv), valid);
+            const L sn    = Svd3And(Svd3Mul(y, inv), valid);
+
+            for (int j = C; j < 3; ++j)
+            {
+                const L bp = b[P][j];
+                const L bq = b[Q][j];
+                b[P][j]    = Svd3Add(Svd3Mul(c, bp), Svd3Mul(sn, bq));
+                b[Q][j]    = Svd3Sub(Svd3Mul(c, bq), Svd3Mul(sn, bp));
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                const L up = u[k][P];
+                const L uq = u[k][Q];
+                u[k][P]    = Svd3Add(Svd3Mul(c, up), Svd3Mul(sn, uq));
+                u[k][Q]    = Svd3Sub(Svd3Mul(c, uq), Svd3Mul(sn, up));
+            }
+        }
+
+        // Element (i, j) of a * b, or of a * transpose(b).
+        template <typename L>
+        inline L Svd3Dot(const L a[3][3], const L b[3][3], int i, int j, bool transposeB)
+        {
+            return transposeB ? Svd3Add(Svd3Add(Svd3Mul(a[i][0], b[j][0]), Svd3Mul(a[i][1], b[j][1])), Svd3Mul(a[i][2], b[j][2]))
+                              : Svd3Add(Svd3Add(Svd3Mul(a[i][0], b[0][j]), Svd3Mul(a[i][1], b[1][j])), Svd3Mul(a[i][2], b[2][j]));
+        }
+
+        // scaled = a / scale with scale the largest |a_ij| of each lane, 1 for a zero matrix. The squares of the
+        // rotations below then neither underflow nor overflow, whatever the magnitude of a.
+        template <typename L>
+        inline L Svd3Normalize(const L a[3][3], L scaled[3][3])
+        {
+            L scale = Svd3Set<L>(0.0f);
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    scale = Svd3Max(scale, Svd3Abs(a[i][j]));
+            scale = Svd3Select(Svd3Set<L>(1.0f), scale, Svd3Greater(scale, Svd3Set<L>(0.0f)));
+            // Divided rather than multiplied by the reciprocal, which overflows for a denormal scale.
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    scaled[i][j] = Svd3Div(a[i][j], scale);
+            return scale;
+        }
+
+        template <typename L>
+        inline void Svd3Eigen(const L a[3][3], L values[3], L v[3][3])
+        {
+            L s[3][3];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    s[i][j] = i <= j ? a[i][j] : a[j][i];
+            const L scale = Svd3Normalize(s, s);
+            Svd3Diagonalize(s, v);
+
+            L(*none)[3] = nullptr;
+            for (int i = 0; i < 3; ++i)
+                values[i] = Svd3Mul(s[i][i], scale);
+            Svd3SortColumns<0, 1>(values, v, none);
+            Svd3SortColumns<0, 2>(values, v, none);
+            Svd3SortColumns<1, 2>(values, v, none);
+        }
+
+        template <typename L>
+        inline void Svd3Decompose(const L input[3][3], L u[3][3], L sigma[3], L v[3][3])
+        {
+            // The rotations of a / scale are those of a, its singular values are scaled back at the end.
+            L       a[3][3];
+            const L scale = Svd3Normalize(input, a);
+
+            // s = transpose(a) * a, its eigenvectors are the right singular vectors.
+            L s[3][3];
+            for (int i = 0; i < 3; ++i)
+                for (int j = i; j < 3; ++j)
+                {
+                    s[i][j] = Svd3Add(Svd3Add(Svd3Mul(a[0][i], a[0][j]), Svd3Mul(a[1][i], a[1][j])), Svd3Mul(a[2][i], a[2][j]));
+                    s[j][i] = s[i][j];
+                }
+            Svd3Diagonalize(s, v);
+
+            // b = a * v, its columns orthogonalized once more and sorted by decreasing length so the QR below pivots on
+            // the largest column.
+            L b[3][3], lengths[3];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    b[i][j] = Svd3Dot(a, v, i, j, false);
+            Svd3Orthogonalize<0, 1>(b, v);
+            Svd3Orthogonalize<0, 2>(b, v);
+            Svd3Orthogonalize<1, 2>(b, v);
+            for (int j = 0; j < 3; ++j)
+                lengths[j] = Svd3Add(Svd3Add(Svd3Mul(b[0][j], b[0][j]), Svd3Mul(b[1][j], b[1][j])), Svd3Mul(b[2][j], b[2][j]));
+            Svd3SortColumns<0, 1>(lengths, b, v);
+            Svd3SortColumns<0, 2>(lengths, b, v);
+            Svd3SortColumns<1, 2>(lengths, b, v);
+
+            // b = u * r by Givens rotations, the columns of b are orthogonal so r is diagonal up to round off.
+            Svd3Identity(u);
+            Svd3Givens<0, 1, 0>(b, u);
+            Svd3Givens<0, 2, 0>(b, u);
+            Svd3Givens<1, 2, 1>(b, u);
+            for (int i = 0; i < 3; ++i)
+                sigma[i] = Svd3Mul(b[i][i], scale);
+        }
+
+        template <typename L>
+        inline void Svd3Polar(const L a[3][3], L rotation[3][3], L stretch[3][3])
+        {
+            L u[3][3], sigma[3], v[3][3], vSigma[3][3];
+            Svd3Decompose(a, u, sigma, v);
+            for (int i = 0; i < 3; ++i)
+                for (int k = 0; k < 3; ++k)
+                    vSigma[i][k] = Svd3Mul(v[i][k], sigma[k]);
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                {
+                    rotation[i][j] = Svd3Dot(u, v, i, j, true);
+                    stretch[i][j]  = Svd3Dot(vSigma, v, i, j, true);
+                }
+        }
+
+        // Matrices [0, n) of one group of lanes, n at most the lane count.
+        template <typename L>
+        inline void Svd3EigenGroup(const Mat3x3* matrices, size_t n, Vec3* eigenvalues, Mat3x3* eigenvectors)
+        {
+            L a[3][3], values[3], v[3][3];
+            Svd3Load(matrices, n, a);
+            Svd3Eigen(a, values, v);
+            Svd3Store(values, n, eigenvalues);
+            Svd3Store(v, n, eigenvectors);
+        }
+
+        template <typename L>
+        inline void Svd3Group(const Mat3x3* matrices, size_t n, Mat3x3* u, Vec3* sigma, Mat3x3* v)
+        {
+            L a[3][3], lanesU[3][3], lanesSigma[3], lanesV[3][3];
+            Svd3Load(matrices, n, a);
+            Svd3Decompose(a, lanesU, lanesSigma, lanesV);
+            Svd3Store(lanesU, n, u);
+            Svd3Store(lanesSigma, n, sigma);
+            Svd3Store(lanesV, n, v);
+        }
+
+        template <typename L>
+        inline void Svd3PolarGroup(const Mat3x3* matrices, size_t n, Mat3x3* rotations, Mat3x3* stretches)
+        {
+            L a[3][3], rotation[3][3], stretch[3][3];
+            Svd3Load(matrices, n, a);
+            Svd3Polar(a, rotation, stretch);
+            Svd3Store(rotation, n, rotations);
+            if (stretches)
+                Svd3Store(stretch, n, stretches);
+        }
+    } // anonymous namespace
+
+    inline void SymmetricEigen(const Mat3x3& a, Vec3& eigenvalues, Mat3x3& eigenvectors) { SymmetricEigen(&a, 1, &eigenvalues, &eigenvectors); }
+
+    inline void SymmetricEigen(const Mat3x3* matrices, size_t count, Vec3* eigenvalues, Mat3x3* eigenvectors)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SYMMETRIC_EIGEN, count);
+        // 8 matrices at a time, then the rest 4 at a time with the last group padded.
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            Svd3EigenGroup<Svd3Wide>(matrices + i, 8, eigenvalues + i, eigenvectors + i);
+        for (; i < count; i += 4)
+            Svd3EigenGroup<float4>(matrices + i, count - i < 4 ? count - i : 4, eigenvalues + i, eigenvectors + i);
+    }
+
+    inline void SVD(const Mat3x3& a, Mat3x3& u, Vec3& sigma, Mat3x3& v) { SVD(&a, 1, &u, &sigma, &v); }
+
+    inline void SVD(const Mat3x3* matrices, size_t count, Mat3x3* u, Vec3* sigma, Mat3x3* v)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SVD3, count);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            Svd3Group<Svd3Wide>(matrices + i, 8, u + i, sigma + i, v + i);
+        for (; i < count; i += 4)
+            Svd3Group<float4>(matrices + i, count - i < 4 ? count - i : 4, u + i, sigma + i, v + i);
+    }
+
+    inline void PolarDecomposition(const Mat3x3& a, Mat3x3& rotation, Mat3x3& stretch) { PolarDecomposition(&a, 1, &rotation, &stretch); }
+
+    inline void PolarDecomposition(const Mat3x3* matrices, size_t count, Mat3x3* rotations, Mat3x3* stretches)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_POLAR_DECOMPOSITION, count);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            Svd3PolarGroup<Svd3Wide>(matrices + i, 8, rotations + i, stretches ? stretches + i : nullptr);
+        for (; i < count; i += 4)
+            Svd3PolarGroup<float4>(matrices + i, count - i < 4 ? count - i : 4, rotations + i, stretches ? stretches + i : nullptr);
+    }
+} // namespace DropMath
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../quat/DM_Quat.h"
+
+namespace DropMath
+{
+    // Translation, rotation and scale, composed as T * R * S (scale first). The matrix and its inverse are built on
+    // first read and cached until a component changes, which bumps Version(). Reading the caches mutates them, so
+    // share a Transform between threads only for reading after both were read once.
+    class alignas(16) Transform
+    {
+    public:
+        Transform() : m_Scale(1.0f, 1.0f, 1.0f), m_Version(0), m_MatrixVersion(~0u), m_InverseVersion(~0u) { }
+        Transform(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+            : m_Translation(translation), m_Rotation(rotation), m_Scale(scale), m_Version(0), m_MatrixVersion(~0u), m_InverseVersion(~0u) { }
+        // Decompose m, see Decompose.
+        explicit Transform(const Mat4x4& m);
+
+        const Vec3& Translation() const { return m_Translation; }
+        const Quat& Rotation() const { return m_Rotation; }
+        const Vec3& Scale() const { return m_Scale; }
+
+        void SetTranslation(const Vec3& translation);
+        // rotation must be normalized.
+        void SetRotation(const Quat& rotation);
+        void SetScale(const Vec3& scale);
+        void Set(const Vec3& translation, const Quat& rotation, const Vec3& scale);
+
+        // Incremented by every setter, so that other caches built from this transform can tell they are stale.
+        unsigned int Version() const { return m_Version; }
+
+        // Return T * R * S, composed again only if a component changed since the last call.
+        const Mat4x4& Matrix() const;
+
+        // Return the inverse of Matrix(), computed in closed form (S^-1 R^T T^-1) and cached the same way. The scale
+        // must have no zero component.
+        const Mat4x4& InverseMatrix() const;
+
+    private:
+        Vec3         m_Translation;
+        Quat         m_Rotation;
+        Vec3         m_Scale;
+        unsigned int m_Version;
+
+        mutable Mat4x4       m_Matrix;
+        mutable Mat4x4       m_Inverse;
+        mutable unsigned int m_MatrixVersion; // Version m_Matrix was built at, ~0 for never.
+        mutable unsigned int m_InverseVersion;
+    };
+
+    // Split the affine matrix m into T * R * S. A negative determinant is given to scale.x. Shear has no TRS form
+    // and comes out as the nearest rotation only approximately.
+    inline void Decompose(const Mat4x4& m, Vec3& translation, Quat& rotation, Vec3& scale);
+
+    // Decompose count matrices into the translation, rotation and scale arrays, 4 matrices per SSE register.
+    inline void Decompose(const Mat4x4* matrices, size_t count, Vec3* translations, Quat* rotations, Vec3* scales);
+} // namespace DropMath
+
+#include "DM_Transform.inl"
@@ -0,0 +1,187 @@
+namespace DropMath
+{
+    namespace
+    {
+        inline float4 TransformSelect(float4 a, float4 b, float4 mask) { return _mm_blendv_ps(a, b, mask); }
+
+        // Decompose matrices [0, 4) of m, 4 lanes at once: the 3x3 parts are transposed to one register per element,
+        // and every branch of Shepperd's method is computed and blended by which candidate is the largest.
+        inline void DecomposeTRS4(const Mat4x4* m, Vec3* translations, Quat* rotations, Vec3* scales)
+        {
+            float4 e[4][4]; // e[i][j] = element (i, j) of the 4 matrices.
+            for (int i = 0; i < 3; ++i)
+            {
+                e[i][0] = m[0].rows[i].v;
+                e[i][1] = m[1].rows[i].v;
+                e[i][2] = m[2].rows[i].v;
+                e[i][3] = m[3].rows[i].v;
+                _MM_TRANSPOSE4_PS(e[i][0], e[i][1], e[i][2], e[i][3]);
+            }
+
+            float4 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+            float4 s[3];
+            for (int j = 0; j < 3; ++j)
+            {
+                s[j] = _mm_sqrt_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[0][j], e[0][j]), _mm_mul_ps(e[1][j], e[1][j])), _mm_mul_ps(e[2][j], e[2][j])));
+            }
+
+            // det = column 0 . (column 1 x column 2), a reflection goes to scale x.
+            float4 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[0][0], _mm_sub_ps(_mm_mul_ps(e[1][1], e[2][2]), _mm_mul_ps(e[2][1], e[1][2]))),
+                                               _mm_mul_ps(e[1][0], _mm_sub_ps(_mm_mul_ps(e[2][1], e[0][2]), _mm_mul_ps(e[0][1], e[2][2])))),
+                                    _mm_mul_ps(e[2][0], _mm_sub_ps(_mm_mul_ps(e[0][1], e[1][2]), _mm_mul_ps(e[1][1], e[0][2]))));
+            s[0]       = _mm_xor_ps(s[0], _mm_and_ps(_mm_cmplt_ps(det, zero), _mm_set1_ps(-0.0f)));
+
+            float4 r[3][3];
+            for (int j = 0; j < 3; ++j)
+            {
+                float4 degenerate = _mm_cmple_ps(_mm_and_ps(g_SIGN_MASK_F, s[j]), _mm_set1_ps(F::EPSILON));
+                float4 inv        = _mm_div_ps(one, TransformSelect(s[j], one, degenerate));
+                for (int i = 0; i < 3; ++i)
+                    r[i][j] = _mm_mul_ps(e[i][j], inv);
+            }
+
+            // 4 w^2, 4 x^2, 4 y^2 and 4 z^2, each branch divides by the root of its own candidate.
+            float4 t[4] = { _mm_add_ps(_mm_add_ps(one, r[0][0]), _mm_add_ps(r[1][1], r[2][2])),
+                            _mm_sub_ps(_mm_add_ps(one, r[0][0]), _mm_add_ps(r[1][1], r[2][2])),
+                            _mm_sub_ps(_mm_add_ps(one, r[1][1]), _mm_add_ps(r[0][0], r[2][2])),
+                            _mm_sub_ps(_mm_add_ps(one, r[2][2]), _mm_add_ps(r[0][0], r[1][1])) };
+            float4 quarter = _mm_set1_ps(0.25f);
+            float4 d21     = _mm_sub_ps(r[2][1], r[1][2]), d02 = _mm_sub_ps(r[0][2], r[2][0]), d10 = _mm_sub_ps(r[1][0], r[0][1]);
+            float4 s01     = _mm_add_ps(r[0][1], r[1][0]), s02 = _mm_add_ps(r[0][2], r[2][0]), s12 = _mm_add_ps(r[1][2], r[2][1]);
+            float4 inv[4], big[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                float4 root = _mm_mul_ps(_mm_sqrt_ps(_mm_max_ps(t[k], _mm_set1_ps(F::EPSILON))), _mm_set1_ps(2.0f));
+                inv[k]      = _mm_div_ps(one, root);
+                big[k]      = _mm_mul_ps(root, quarter);
+            }
+            float4 q[4][4] = { // q[branch][component]
+                { _mm_mul_ps(d21, inv[0]), _mm_mul_ps(d02, inv[0]), _mm_mul_ps(d10, inv[0]), big[0] },
+                { big[1], _mm_mul_ps(s01, inv[1]), _mm_mul_ps(s02, inv[1]), _mm_mul_ps(d21, inv[1]) },
+                { _mm_mul_ps(s01, inv[2]), big[2], _mm_mul_ps(s12, inv[2]), _mm_mul_ps(d02, inv[2]) },
+                { _mm_mul_ps(s02, inv[3]), _mm_mul_ps(s12, inv[3]), big[3], _mm_mul_ps(d10, inv[3]) }
+            };
+
+            // Keep the branch of the largest candidate, ties go to the earlier one.
+            float4 best   = t[0];
+            float4 out[4] = { q[0][0], q[0][1], q[0][2], q[0][3] };
+            for (int k = 1; k < 4; ++k)
+            {
+                float4 larger = _mm_cmpgt_ps(t[k], best);
+                best          = _mm_max_ps(t[k], best);
+                for (int c = 0; c < 4; ++c)
+                    out[c] = TransformSelect(out[c], q[k][c], larger);
+            }
+
+            float4 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(out[0], out[0]), _mm_mul_ps(out[1], out[1])),
+                                     _mm_add_ps(_mm_mul_ps(out[2], out[2]), _mm_mul_ps(out[3], out[3])));
+            float4 norm = _mm_div_ps(one, _mm_sqrt_ps(len2));
+            for (int c = 0; c < 4; ++c)
+                out[c] = _mm_mul_ps(out[c], norm);
+            _MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+            for (int lane = 0; lane < 4; ++lane)
+                rotations[lane] = Quat(out[lane]);
+
+            Vec3x4(s[0], s[1], s[2]).Store(scales);
+            Vec3x4(e[0][3], e[1][3], e[2][3]).Store(translations);
+        }
+    } // anonymous namespace
+
+    inline Transform::Transform(const Mat4x4& m) : m_Version(0), m_MatrixVersion(~0u), m_InverseVersion(~0u)
+    {
+        Decompose(m, m_Translation, m_Rotation, m_Scale);
+    }
+
+    inline void Transform::SetTranslation(const Vec3& translation)
+    {
+        m_Translation = translation;
+        ++m_Version;
+    }
+
+    inline void Transform::SetRotation(const Quat& rotation)
+    {
+        m_Rotation = rotation;
+        ++m_Version;
+    }
+
+    inline void Transform::SetScale(const Vec3& scale)
+    {
+        m_Scale = scale;
+        ++m_Version;
+    }
+
+    inline void Transform::Set(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+    {
+        m_Translation = translation;
+        m_Rotation    = rotation;
+        m_Scale       = scale;
+        ++m_Version;
+    }
+
+    inline const Mat4x4& Transform::Matrix() const
+    {
+        if (m_MatrixVersion == m_Version)
+            return m_Matrix;
+
+        // Columns of R scaled by S, then the translation in the w lanes.
+        Mat3x4 r     = m_Rotation.ToMat3x4();
+        float4 scale = LoadVec3(m_Scale);
+        m_Matrix     = Mat4x4(
+            WithW(_mm_mul_ps(r[0].v, scale), _mm_set1_ps(m_Translation.x)),
+            WithW(_mm_mul_ps(r[1].v, scale), _mm_set1_ps(m_Translation.y)),
+            WithW(_mm_mul_ps(r[2].v, scale), _mm_set1_ps(m_Translation.z)),
+            Vec4(0, 0, 0, 1));
+        m_MatrixVersion = m_Version;
+        return m_Matrix;
+    }
+
+    inline const Mat4x4& Transform::InverseMatrix() const
+    {
+        if (m_InverseVersion == m_Version)
+            return m_Inverse;
+
+        // (R S)^-1 = S^-1 R^T: the rows of R^T divided by the matching scale.
+        Mat3x4 r = m_Rotation.ToMat3x4();
+        float4 c0, c1, c2;
+        Transpose3(r[0].v, r[1].v, r[2].v, c0, c1, c2);
+        float4 t  = LoadVec3(m_Translation);
+        m_Inverse = Mat4x4(
+            InverseAffineRow(_mm_div_ps(c0, _mm_set1_ps(m_Scale.x)), t),
+            InverseAffineRow(_mm_div_ps(c1, _mm_set1_ps(m_Scale.y)), t),
+            InverseAffineRow(_mm_div_ps(c2, _mm_set1_ps(m_Scale.z)), t),
+            Vec4(0, 0, 0, 1));
+        m_InverseVersion = m_Version;
+        return m_Inverse;
+    }
+
+    inline void Decompose(const Mat4x4& m, Vec3& translation, Quat& rotation, Vec3& scale)
+    {
+        Decompose(&m, 1, &translation, &rotation, &scale);
+    }
+
+    inline void Decompose(const Mat4x4* matrices, size_t count, Vec3* translations, Quat* rotations, Vec3* scales)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_DECOMPOSE, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            DecomposeTRS4(matrices + i, translations + i, rotations + i, scales + i);
+        if (i == count)
+            return;
+
+        // Fewer than 4 left: run them through a padded copy so the tail uses the same math.
+        Mat4x4 tail[4];
+        Vec3   t[4], s[4];
+        Quat   r[4];
+        size_t n = count - i;
+        for (size_t j = 0; j < n; ++j)
+            tail[j] = matrices[i + j];
+        DecomposeTRS4(tail, t, r, s);
+        for (size_t j = 0; j < n; ++j)
+        {
+            translations[i + j] = t[j];
+            rotations[i + j]    = r[j];
+            scales[i + j]       = s[j];
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DM_Pack.h"
+#include "../vec/DM_Vec3x4.h"
+
+namespace DropMath
+{
+    namespace PackError
+    {
+        // Max angle in radians between a unit normal and its 2x16 bit octahedral round trip.
+        DM_CONSTEXPR float OCT16 = 0.0001f;
+        // Max angle in radians between a unit normal and its 2x8 bit octahedral round trip.
+        DM_CONSTEXPR float OCT8 = 0.02f;
+        // Max angle in radians between a normal or tangent and its 4x16 bit quaternion tangent frame round trip.
+        DM_CONSTEXPR float QTANGENT = 0.0002f;
+    } // namespace PackError
+
+    // Encode count unit normals to 2 snorm16 each (4 bytes per normal) with octahedral mapping.
+    // Normals don't need to be exactly unit length, zero normals encode to (0, 0, 1).
+    inline void EncodeOct16(const Vec3* normals, short* dst, size_t count);
+    // Decode count normals from 2 snorm16 each. Output is unit length.
+    inline void DecodeOct16(const short* src, Vec3* normals, size_t count);
+
+    // Encode count unit normals to 2 snorm8 each (2 bytes per normal) with octahedral mapping.
+    inline void EncodeOct8(const Vec3* normals, signed char* dst, size_t count);
+    // Decode count normals from 2 snorm8 each. Output is unit length.
+    inline void DecodeOct8(const signed char* src, Vec3* normals, size_t count);
+
+    // Encode count tangent frames to a quaternion of 4 snorm16 (8 bytes per frame).
+    // tangents[i].w is the bitangent sign (bitangent = Cross(normal, tangent) * w), it is stored in the sign of the quaternion w.
+    // The tangent is orthogonalized against the normal before encoding.
+    inline void EncodeQTangent(const Vec3* normals, const Vec4* tangents, short* dst, size_t count);
+    // Decode count tangent frames from 4 snorm16 each. tangents[i].w gets the bitangent sign (+1 or -1).
+    inline void DecodeQTangent(const short* src, Vec3* normals, Vec4* tangents, size_t count);
+} // namespace DropMath
+
+#include "DM_NormalPack.inl"
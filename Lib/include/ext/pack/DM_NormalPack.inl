@@ -0,0 +1,305 @@
+namespace DropMath
+{
+    namespace
+    {
+        // Return +1 or -1 with the sign of v. Zero counts as positive (and -0 as negative).
+        inline float4 SignNotZero(float4 v)
+        {
+            return _mm_or_ps(_mm_and_ps(v, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f));
+        }
+
+        // Pick per lane the value whose mask is set. The masks must not overlap, vz is used when none is set.
+        inline float4 Pick(float4 isW, float4 vw, float4 isX, float4 vx, float4 isY, float4 vy, float4 vz)
+        {
+            return _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(vz, vy, isY), vx, isX), vw, isW);
+        }
+
+        // Map 4 normals to the octahedron and unfold the lower half, result is in [-1, 1]^2.
+        inline void OctEncode4(const Vec3x4& n, float4& u, float4& v)
+        {
+            float4 absMask = g_SIGN_MASK_F;
+            float4 l1      = _mm_add_ps(_mm_add_ps(_mm_and_ps(n.x, absMask), _mm_and_ps(n.y, absMask)), _mm_and_ps(n.z, absMask));
+            float4 inv     = _mm_div_ps(_mm_set1_ps(1.0f), _mm_max_ps(l1, _mm_set1_ps(1e-30f)));
+            float4 px      = _mm_mul_ps(n.x, inv);
+            float4 py      = _mm_mul_ps(n.y, inv);
+
+            float4 one   = _mm_set1_ps(1.0f);
+            float4 lower = _mm_cmplt_ps(n.z, _mm_setzero_ps());
+            float4 wx    = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(py, absMask)), SignNotZero(px));
+            float4 wy    = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(px, absMask)), SignNotZero(py));
+            u            = _mm_blendv_ps(px, wx, lower);
+            v            = _mm_blendv_ps(py, wy, lower);
+        }
+
+        // Inverse of OctEncode4. Output is unit length.
+        inline Vec3x4 OctDecode4(float4 u, float4 v)
+        {
+            float4 absMask = g_SIGN_MASK_F;
+            float4 signBit = _mm_set1_ps(-0.0f);
+            float4 z       = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_and_ps(u, absMask)), _mm_and_ps(v, absMask));
+            float4 t       = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+
+            Vec3x4 n(
+                _mm_sub_ps(u, _mm_or_ps(t, _mm_and_ps(u, signBit))),
+                _mm_sub_ps(v, _mm_or_ps(t, _mm_and_ps(v, signBit))),
+                z);
+            n.Normalize();
+            return n;
+        }
+
+        // Encode 4 normals to 8 interleaved shorts u0 v0 u1 v1 ... quantized with scale.
+        inline int4 QuantizeOct4(const Vec3x4& n, float scale)
+        {
+            float4 u, v;
+            OctEncode4(n, u, v);
+
+            float4 s  = _mm_set1_ps(scale);
+            int4   qu = _mm_cvtps_epi32(_mm_mul_ps(u, s));
+            int4   qv = _mm_cvtps_epi32(_mm_mul_ps(v, s));
+            return _mm_packs_epi32(_mm_unpacklo_epi32(qu, qv), _mm_unpackhi_epi32(qu, qv));
+        }
+
+        // Decode 8 interleaved shorts u0 v0 u1 v1 ... quantized with 1 / invScale.
+        inline Vec3x4 DequantizeOct4(int4 uv, float invScale)
+        {
+            float4 s     = _mm_set1_ps(invScale);
+            float4 minus = _mm_set1_ps(-1.0f);
+            float4 u     = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(uv, 16), 16)), s), minus);
+            float4 v     = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(uv, 16)), s), minus);
+            return OctDecode4(u, v);
+        }
+
+        inline void EncodeQTangent4(const Vec3* normals, const Vec4* tangents, short* dst)
+        {
+            Vec3x4 n = Vec3x4::Load(normals);
+            n.Normalize();
+
+            float4 tx = tangents[0].v, ty = tangents[1].v, tz = tangents[2].v, sign = tangents[3].v;
+            _MM_TRANSPOSE4_PS(tx, ty, tz, sign);
+
+            // Gram-Schmidt so the frame is a proper rotation.
+            Vec3x4 t(tx, ty, tz);
+            t = t - n * Vec3x4::Dot(n, t);
+            t.Normalize();
+            Vec3x4 b = Vec3x4::Cross(n, t);
+
+            // Shepperd's method on the matrix with columns t, b, n. Pick the largest of w, x, y, z to divide by.
+            float4 m00 = t.x, m11 = b.y, m22 = n.z;
+            float4 one = _mm_set1_ps(1.0f);
+            float4 isW = _mm_cmpgt_ps(_mm_add_ps(_mm_add_ps(m00, m11), m22), _mm_setzero_ps());
+            float4 isX = _mm_andnot_ps(isW, _mm_and_ps(_mm_cmpge_ps(m00, m11), _mm_cmpge_ps(m00, m22)));
+            float4 isY = _mm_andnot_ps(_mm_or_ps(isW, isX), _mm_cmpge_ps(m11, m22));
+
+            float4 dw = _mm_add_ps(_mm_add_ps(_mm_add_ps(one, m00), m11), m22);
+            float4 dx = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, m00), m11), m22);
+            float4 dy = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(one, m00), m11), m22);
+            float4 dz = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(one, m00), m11), m22);
+            float4 r  = _mm_sqrt_ps(Pick(isW, dw, isX, dx, isY, dy, dz));
+            float4 h  = _mm_mul_ps(r, _mm_set1_ps(0.5f));
+            float4 k  = _mm_div_ps(_mm_set1_ps(0.5f), r);
+
+            float4 a  = _mm_mul_ps(_mm_sub_ps(b.z, n.y), k);
+            float4 bb = _mm_mul_ps(_mm_sub_ps(n.x, t.z), k);
+            float4 c  = _mm_mul_ps(_mm_sub_ps(t.y, b.x), k);
+            float4 p  = _mm_mul_ps(_mm_add_ps(b.x, t.y), k);
+            float4 q  = _mm_mul_ps(_mm_add_ps(n.x, t.z), k);
+            float4 s  = _mm_mul_ps(_mm_add_ps(n.y, b.z), k);
+
+            float4 qw = Pick(isW, h, isX, a, isY, bb, c);
+            float4 qx = Pick(isW, a, isX, h, isY, p, q);
+            float4 qy = Pick(isW, bb, isX, p, isY, h, s);
+            float4 qz = Pick(isW, c, isX, q, isY, s, h);
+
+            // Keep w positive and away from 0 so its sign can carry the bitangent sign after quantization.
+            float4 signBit = _mm_set1_ps(-0.0f);
+            float4 flip    = _mm_and_ps(_mm_cmplt_ps(qw, _mm_setzero_ps()), signBit);
+            qx             = _mm_xor_ps(qx, flip);
+            qy             = _mm_xor_ps(qy, flip);
+            qz             = _mm_xor_ps(qz, flip);
+            qw             = _mm_max_ps(_mm_xor_ps(qw, flip), _mm_set1_ps(1.0f / 32767.0f));
+
+            float4 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw)));
+            float4 inv  = _mm_div_ps(one, _mm_sqrt_ps(len2));
+            float4 refl = _mm_and_ps(_mm_cmplt_ps(sign, _mm_setzero_ps()), signBit);
+            float4 sc   = _mm_xor_ps(_mm_mul_ps(inv, _mm_set1_ps(32767.0f)), refl);
+            qx          = _mm_mul_ps(qx, sc);
+            qy          = _mm_mul_ps(qy, sc);
+            qz          = _mm_mul_ps(qz, sc);
+            qw          = _mm_mul_ps(qw, sc);
+
+            _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + 0), _mm_packs_epi32(_mm_cvtps_epi32(qx), _mm_cvtps_epi32(qy)));
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + 8), _mm_packs_epi32(_mm_cvtps_epi32(qz), _mm_cvtps_epi32(qw)));
+        }
+
+        inline void DecodeQTangent4(const short* src, Vec3* normals, Vec4* tangents)
+        {
+            int4   lo = _mm_loadu_si128(reinterpret_cast<const int4*>(src + 0));
+            int4   hi = _mm_loadu_si128(reinterpret_cast<const int4*>(src + 8));
+            // One frame per register, transposed to one component per register.
+            float4 qx = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(lo));
+            float4 qy = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(lo, 8)));
+            float4 qz = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(hi));
+            float4 qw = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(hi, 8)));
+            _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+            float4 one  = _mm_set1_ps(1.0f);
+            float4 two  = _mm_set1_ps(2.0f);
+            float4 sign = _mm_blendv_ps(one, _mm_set1_ps(-1.0f), qw);
+
+            // Scale by 2 / |q|^2 so the rotation below doesn't need a separate normalize.
+            float4 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw)));
+            float4 s    = _mm_div_ps(two, len2);
+
+            float4 xx = _mm_mul_ps(_mm_mul_ps(qx, qx), s), yy = _mm_mul_ps(_mm_mul_ps(qy, qy), s), zz = _mm_mul_ps(_mm_mul_ps(qz, qz), s);
+            float4 xy = _mm_mul_ps(_mm_mul_ps(qx, qy), s), xz = _mm_mul_ps(_mm_mul_ps(qx, qz), s), yz = _mm_mul_ps(_mm_mul_ps(qy, qz), s);
+            float4 wx = _mm_mul_ps(_mm_mul_ps(qw, qx), s), wy = _mm_mul_ps(_mm_mul_ps(qw, qy), s), wz = _mm_mul_ps(_mm_mul_ps(qw, qz), s);
+
+            Vec3x4 t(_mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy));
+            Vec3x4 n(_mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy)));
+            n.Store(normals);
+
+            float4 tx = t.x, ty = t.y, tz = t.z;
+            _MM_TRANSPOSE4_PS(tx, ty, tz, sign);
+            tangents[0].v = tx;
+            tangents[1].v = ty;
+            tangents[2].v = tz;
+            tangents[3].v = sign;
+        }
+    } // anonymous namespace
+
+    inline void EncodeOct16(const Vec3* normals, short* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ENCODE_OCT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + i * 2), QuantizeOct4(Vec3x4::Load(normals + i), 32767.0f));
+
+        if (i < count)
+        {
+            size_t rest = count - i;
+            Vec3   in[4];
+            short  out[8];
+            for (size_t j = 0; j < rest; ++j)
+                in[j] = normals[i + j];
+            _mm_storeu_si128(reinterpret_cast<int4*>(out), QuantizeOct4(Vec3x4::Load(in), 32767.0f));
+            for (size_t j = 0; j < rest * 2; ++j)
+                dst[i * 2 + j] = out[j];
+        }
+    }
+
+    inline void DecodeOct16(const short* src, Vec3* normals, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_DECODE_OCT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            DequantizeOct4(_mm_loadu_si128(reinterpret_cast<const int4*>(src + i * 2)), 1.0f / 32767.0f).Store(normals + i);
+
+        if (i < count)
+        {
+            size_t rest  = count - i;
+            short  in[8] = {};
+            Vec3   out[4];
+            for (size_t j = 0; j < rest * 2; ++j)
+                in[j] = src[i * 2 + j];
+            DequantizeOct4(_mm_loadu_si128(reinterpret_cast<const int4*>(in)), 1.0f / 32767.0f).Store(out);
+            for (size_t j = 0; j < rest; ++j)
+                normals[i + j] = out[j];
+        }
+    }
+
+    inline void EncodeOct8(const Vec3* normals, signed char* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ENCODE_OCT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            int4 q = QuantizeOct4(Vec3x4::Load(normals + i), 127.0f);
+            _mm_storel_epi64(reinterpret_cast<int4*>(dst + i * 2), _mm_packs_epi16(q, q));
+        }
+
+        if (i < count)
+        {
+            size_t      rest = count - i;
+            Vec3        in[4];
+            signed char out[8];
+            for (size_t j = 0; j < rest; ++j)
+                in[j] = normals[i + j];
+            int4 q = QuantizeOct4(Vec3x4::Load(in), 127.0f);
+            _mm_storel_epi64(reinterpret_cast<int4*>(out), _mm_packs_epi16(q, q));
+            for (size_t j = 0; j < rest * 2; ++j)
+                dst[i * 2 + j] = out[j];
+        }
+    }
+
+    inline void DecodeOct8(const signed char* src, Vec3* normals, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_DECODE_OCT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            int4 q = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const int4*>(src + i * 2)));
+            DequantizeOct4(q, 1.0f / 127.0f).Store(normals + i);
+        }
+
+        if (i < count)
+        {
+            size_t      rest  = count - i;
+            signed char in[8] = {};
+            Vec3        out[4];
+            for (size_t j = 0; j < rest * 2; ++j)
+                in[j] = src[i * 2 + j];
+            DequantizeOct4(_mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const int4*>(in))), 1.0f / 127.0f).Store(out);
+            for (size_t j = 0; j < rest; ++j)
+                normals[i + j] = out[j];
+        }
+    }
+
+    inline void EncodeQTangent(const Vec3* normals, const Vec4* tangents, short* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_ENCODE_QTANGENT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            EncodeQTangent4(normals + i, tangents + i, dst + i * 4);
+
+        if (i < count)
+        {
+            size_t rest   = count - i;
+            Vec3   inN[4] = {Vec3::Forward(), Vec3::Forward(), Vec3::Forward(), Vec3::Forward()};
+            Vec4   inT[4] = {Vec4(1, 0, 0, 1), Vec4(1, 0, 0, 1), Vec4(1, 0, 0, 1), Vec4(1, 0, 0, 1)};
+            short  out[16];
+            for (size_t j = 0; j < rest; ++j)
+            {
+                inN[j] = normals[i + j];
+                inT[j] = tangents[i + j];
+            }
+            EncodeQTangent4(inN, inT, out);
+            for (size_t j = 0; j < rest * 4; ++j)
+                dst[i * 4 + j] = out[j];
+        }
+    }
+
+    inline void DecodeQTangent(const short* src, Vec3* normals, Vec4* tangents, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_DECODE_QTANGENT, count);
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+            DecodeQTangent4(src + i * 4, normals + i, tangents + i);
+
+        if (i < count)
+        {
+            size_t rest   = count - i;
+            short  in[16] = {0, 0, 0, 32767, 0, 0, 0, 32767, 0, 0, 0, 32767, 0, 0, 0, 32767};
+            Vec3   outN[4];
+            Vec4   outT[4];
+            for (size_t j = 0; j < rest * 4; ++j)
+                in[j] = src[i * 4 + j];
+            DecodeQTangent4(in, outN, outT);
+            for (size_t j = 0; j < rest; ++j)
+            {
+                normals[i + j]  = outN[j];
+                tangents[i + j] = outT[j];
+            }
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+
+#include "../vec/DM_Vec4.h"
+
+namespace DropMath
+{
+    // Worst case error of a pack -> unpack round trip for every format in this file.
+    namespace PackError
+    {
+        // Relative error for values inside the normal half range [6.104e-5, 65504].
+        DM_CONSTEXPR float HALF_RELATIVE = 1.0f / 2048.0f;
+        // Absolute error for values below the normal half range (they become half subnormals).
+        DM_CONSTEXPR float HALF_SUBNORMAL = 1.0f / 33554432.0f;
+        // Absolute error for values inside [-1, 1]. Values outside are clamped.
+        DM_CONSTEXPR float SNORM16 = 0.5f / 32767.0f;
+        // Absolute error for values inside [0, 1]. Values outside are clamped.
+        DM_CONSTEXPR float UNORM8 = 0.5f / 255.0f;
+    } // namespace PackError
+
+    // Convert x to IEEE half with round to nearest even. Values above 65504 become infinity and NaN stays NaN.
+    inline unsigned short FloatToHalf(float x);
+    // Convert IEEE half h back to float. This is exact.
+    inline float HalfToFloat(unsigned short h);
+
+    // Pack count floats to halves. Uses F16C when DM_F16C is defined, otherwise SSE integer math with the same result.
+    inline void PackHalf(const float* src, unsigned short* dst, size_t count);
+    // Pack count Vec2 to 2 halves each (4 bytes per vector).
+    inline void PackHalf(const Vec2* src, unsigned short* dst, size_t count);
+    // Pack count Vec3 to 3 halves each (6 bytes per vector).
+    inline void PackHalf(const Vec3* src, unsigned short* dst, size_t count);
+    // Pack count Vec4 to 4 halves each (8 bytes per vector).
+    inline void PackHalf(const Vec4* src, unsigned short* dst, size_t count);
+
+    // Unpack count halves to floats.
+    inline void UnpackHalf(const unsigned short* src, float* dst, size_t count);
+    // Unpack count Vec2 from 2 halves each.
+    inline void UnpackHalf(const unsigned short* src, Vec2* dst, size_t count);
+    // Unpack count Vec3 from 3 halves each.
+    inline void UnpackHalf(const unsigned short* src, Vec3* dst, size_t count);
+    // Unpack count Vec4 from 4 halves each.
+    inline void UnpackHalf(const unsigned short* src, Vec4* dst, size_t count);
+
+    // Pack count floats in [-1, 1] to signed 16 bit normalized integers. Error bound is PackError::SNORM16.
+    inline void PackSnorm16(const float* src, short* dst, size_t count);
+    // Pack count Vec2 to 2 snorm16 each.
+    inline void PackSnorm16(const Vec2* src, short* dst, size_t count);
+    // Pack count Vec3 to 3 snorm16 each. Good fit for unit normals.
+    inline void PackSnorm16(const Vec3* src, short* dst, size_t count);
+    // Pack count Vec4 to 4 snorm16 each.
+    inline void PackSnorm16(const Vec4* src, short* dst, size_t count);
+
+    // Unpack count snorm16 to floats in [-1, 1].
+    inline void UnpackSnorm16(const short* src, float* dst, size_t count);
+    // Unpack count Vec2 from 2 snorm16 each.
+    inline void UnpackSnorm16(const short* src, Vec2* dst, size_t count);
+    // Unpack count Vec3 from 3 snorm16 each.
+    inline void UnpackSnorm16(const short* src, Vec3* dst, size_t count);
+    // Unpack count Vec4 from 4 snorm16 each.
+    inline void UnpackSnorm16(const short* src, Vec4* dst, size_t count);
+
+    // Pack count floats in [0, 1] to unsigned 8 bit normalized integers. Error bound is PackError::UNORM8.
+    inline void PackUnorm8(const float* src, unsigned char* dst, size_t count);
+    // Pack count Vec2 to 2 unorm8 each.
+    inline void PackUnorm8(const Vec2* src, unsigned char* dst, size_t count);
+    // Pack count Vec3 to 3 unorm8 each.
+    inline void PackUnorm8(const Vec3* src, unsigned char* dst, size_t count);
+    // Pack count Vec4 to 4 unorm8 each.
+    inline void PackUnorm8(const Vec4* src, unsigned char* dst, size_t count);
+
+    // Unpack count unorm8 to floats in [0, 1].
+    inline void UnpackUnorm8(const unsigned char* src, float* dst, size_t count);
+    // Unpack count Vec2 from 2 unorm8 each.
+    inline void UnpackUnorm8(const unsigned char* src, Vec2* dst, size_t count);
+    // Unpack count Vec3 from 3 unorm8 each.
+    inline void UnpackUnorm8(const unsigned char* src, Vec3* dst, size_t count);
+    // Unpack count Vec4 from 4 unorm8 each.
+    inline void UnpackUnorm8(const unsigned char* src, Vec4* dst, size_t count);
+
+    // Pack count colors to 0xAABBGGRR (r in the lowest byte, same byte order as an RGBA8 texture).
+    // Error bound is PackError::UNORM8 per channel.
+    inline void PackRGBA8(const Vec4* src, unsigned int* dst, size_t count);
+    // Unpack count 0xAABBGGRR colors.
+    inline void UnpackRGBA8(const unsigned int* src, Vec4* dst, size_t count);
+} // namespace DropMath
+
+#include "DM_Pack.inl"
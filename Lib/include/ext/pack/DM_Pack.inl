@@ -0,0 +1,226 @@
+namespace DropMath
+{
+    namespace
+    {
+        static_assert(sizeof(Vec2) == 2 * sizeof(float), "Vec2 must be tightly packed to be used as a float stream.");
+        static_assert(sizeof(Vec3) == 3 * sizeof(float), "Vec3 must be tightly packed to be used as a float stream.");
+        static_assert(sizeof(Vec4) == 4 * sizeof(float), "Vec4 must be tightly packed to be used as a float stream.");
+
+        DM_CONSTEXPR float g_INV_SNORM16 = 1.0f / 32767.0f;
+        DM_CONSTEXPR float g_INV_UNORM8  = 1.0f / 255.0f;
+
+#ifndef DM_F16C
+        // Convert 4 floats to halves with round to nearest even. Each half is in the low 16 bits of its lane.
+        inline int4 FloatToHalf4(float4 f)
+        {
+            const int4 f16max       = _mm_set1_epi32((127 + 16) << 23);            // Everything from here rounds to infinity.
+            const int4 minNormal    = _mm_set1_epi32((127 - 14) << 23);            // Smallest float that is a normal half.
+            const int4 subnormMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+            const int4 normalBias   = _mm_set1_epi32(0xFFF - ((127 - 15) << 23)); // Rebias exponent and add rounding.
+
+            float4 justSign = _mm_and_ps(_mm_castsi128_ps(_mm_set1_epi32(0x80000000)), f);
+            float4 absF     = _mm_xor_ps(f, justSign);
+            int4   absI     = _mm_castps_si128(absF);
+
+            int4 isNan      = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+            int4 isRegular  = _mm_cmpgt_epi32(f16max, absI);
+            int4 isSubnorm  = _mm_cmpgt_epi32(minNormal, absI);
+            int4 infOrNan   = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+
+            // Subnormal result: let the FPU do the rounding by adding a magic number.
+            float4 subnorm1 = _mm_add_ps(absF, _mm_castsi128_ps(subnormMagic));
+            int4   subnorm2 = _mm_sub_epi32(_mm_castps_si128(subnorm1), subnormMagic);
+
+            // Normal result: bias towards rounding up when the half mantissa is odd (ties to even).
+            int4 mantOdd = _mm_srai_epi32(_mm_slli_epi32(absI, 31 - 13), 31);
+            int4 normal  = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absI, normalBias), mantOdd), 13);
+
+            int4 nonSpecial = _mm_blendv_epi8(normal, subnorm2, isSubnorm);
+            int4 joined     = _mm_blendv_epi8(infOrNan, nonSpecial, isRegular);
+            return _mm_or_si128(joined, _mm_srli_epi32(_mm_castps_si128(justSign), 16));
+        }
+
+        // Convert 4 halves (zero extended to 32 bits) to floats.
+        inline float4 HalfToFloat4(int4 h)
+        {
+            const float4 magic     = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+            const float4 expInfNan = _mm_castsi128_ps(_mm_set1_epi32(255 << 23));
+
+            int4   expMant   = _mm_and_si128(_mm_set1_epi32(0x7FFF), h);
+            int4   justSign  = _mm_xor_si128(h, expMant);
+            float4 scaled    = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expMant, 13)), magic);
+            int4   wasInfNan = _mm_cmpgt_epi32(expMant, _mm_set1_epi32(0x7BFF));
+            float4 signInf   = _mm_or_ps(_mm_castsi128_ps(_mm_slli_epi32(justSign, 16)), _mm_and_ps(_mm_castsi128_ps(wasInfNan), expInfNan));
+            return _mm_or_ps(scaled, signInf);
+        }
+#endif // DM_F16C
+
+        // Convert 8 floats to 8 halves.
+        inline int4 FloatToHalf8(float4 lo, float4 hi)
+        {
+#ifdef DM_F16C
+            return _mm_unpacklo_epi64(_mm_cvtps_ph(lo, _MM_FROUND_TO_NEAREST_INT), _mm_cvtps_ph(hi, _MM_FROUND_TO_NEAREST_INT));
+#else
+            return _mm_packus_epi32(FloatToHalf4(lo), FloatToHalf4(hi));
+#endif // DM_F16C
+        }
+
+        // Convert the 4 halves in the low 64 bits of h to floats.
+        inline float4 HalfToFloatLow4(int4 h)
+        {
+#ifdef DM_F16C
+            return _mm_cvtph_ps(h);
+#else
+            return HalfToFloat4(_mm_cvtepu16_epi32(h));
+#endif // DM_F16C
+        }
+    } // anonymous namespace
+
+    inline unsigned short FloatToHalf(float x)
+    {
+        int4 h = FloatToHalf8(_mm_set_ss(x), _mm_setzero_ps());
+        return (unsigned short) _mm_extract_epi16(h, 0);
+    }
+
+    inline float HalfToFloat(unsigned short h)
+    {
+        return _mm_cvtss_f32(HalfToFloatLow4(_mm_cvtsi32_si128(h)));
+    }
+
+    inline void PackHalf(const float* src, unsigned short* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_PACK_HALF, count);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int4 h = FloatToHalf8(_mm_loadu_ps(src + i), _mm_loadu_ps(src + i + 4));
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + i), h);
+        }
+        for (size_t k = 0; k < (count & 7); ++k)
+            dst[i + k] = FloatToHalf(src[i + k]);
+    }
+    inline void PackHalf(const Vec2* src, unsigned short* dst, size_t count) { PackHalf(reinterpret_cast<const float*>(src), dst, count * 2); }
+    inline void PackHalf(const Vec3* src, unsigned short* dst, size_t count) { PackHalf(reinterpret_cast<const float*>(src), dst, count * 3); }
+    inline void PackHalf(const Vec4* src, unsigned short* dst, size_t count) { PackHalf(reinterpret_cast<const float*>(src), dst, count * 4); }
+
+    inline void UnpackHalf(const unsigned short* src, float* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_UNPACK_HALF, count);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int4 h = _mm_loadu_si128(reinterpret_cast<const int4*>(src + i));
+            _mm_storeu_ps(dst + i, HalfToFloatLow4(h));
+            _mm_storeu_ps(dst + i + 4, HalfToFloatLow4(_mm_srli_si128(h, 8)));
+        }
+        for (size_t k = 0; k < (count & 7); ++k)
+            dst[i + k] = HalfToFloat(src[i + k]);
+    }
+    inline void UnpackHalf(const unsigned short* src, Vec2* dst, size_t count) { UnpackHalf(src, reinterpret_cast<float*>(dst), count * 2); }
+    inline void UnpackHalf(const unsigned short* src, Vec3* dst, size_t count) { UnpackHalf(src, reinterpret_cast<float*>(dst), count * 3); }
+    inline void UnpackHalf(const unsigned short* src, Vec4* dst, size_t count) { UnpackHalf(src, reinterpret_cast<float*>(dst), count * 4); }
+
+    inline void PackSnorm16(const float* src, short* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_PACK_SNORM16, count);
+        const float4 one   = _mm_set1_ps(1.0f);
+        const float4 minus = _mm_set1_ps(-1.0f);
+        const float4 scale = _mm_set1_ps(32767.0f);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            float4 lo = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), minus), one);
+            float4 hi = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), minus), one);
+            int4   q  = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(lo, scale)), _mm_cvtps_epi32(_mm_mul_ps(hi, scale)));
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + i), q);
+        }
+        for (size_t k = 0; k < (count & 7); ++k)
+            dst[i + k] = (short) _mm_cvtss_si32(_mm_set_ss(Clamp(src[i + k], -1.0f, 1.0f) * 32767.0f));
+    }
+    inline void PackSnorm16(const Vec2* src, short* dst, size_t count) { PackSnorm16(reinterpret_cast<const float*>(src), dst, count * 2); }
+    inline void PackSnorm16(const Vec3* src, short* dst, size_t count) { PackSnorm16(reinterpret_cast<const float*>(src), dst, count * 3); }
+    inline void PackSnorm16(const Vec4* src, short* dst, size_t count) { PackSnorm16(reinterpret_cast<const float*>(src), dst, count * 4); }
+
+    inline void UnpackSnorm16(const short* src, float* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_UNPACK_SNORM16, count);
+        const float4 minus = _mm_set1_ps(-1.0f);
+        const float4 scale = _mm_set1_ps(g_INV_SNORM16);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            int4 q = _mm_loadu_si128(reinterpret_cast<const int4*>(src + i));
+            // -32768 is the only value below -1, clamp it like the graphics APIs do.
+            float4 lo = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(q)), scale), minus);
+            float4 hi = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(q, 8))), scale), minus);
+            _mm_storeu_ps(dst + i, lo);
+            _mm_storeu_ps(dst + i + 4, hi);
+        }
+        for (size_t k = 0; k < (count & 7); ++k)
+            dst[i + k] = Max(src[i + k] * g_INV_SNORM16, -1.0f);
+    }
+    inline void UnpackSnorm16(const short* src, Vec2* dst, size_t count) { UnpackSnorm16(src, reinterpret_cast<float*>(dst), count * 2); }
+    inline void UnpackSnorm16(const short* src, Vec3* dst, size_t count) { UnpackSnorm16(src, reinterpret_cast<float*>(dst), count * 3); }
+    inline void UnpackSnorm16(const short* src, Vec4* dst, size_t count) { UnpackSnorm16(src, reinterpret_cast<float*>(dst), count * 4); }
+
+    inline void PackUnorm8(const float* src, unsigned char* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_PACK_UNORM8, count);
+        const float4 zero  = _mm_setzero_ps();
+        const float4 one   = _mm_set1_ps(1.0f);
+        const float4 scale = _mm_set1_ps(255.0f);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int4 q[4];
+            for (int j = 0; j < 4; ++j)
+            {
+                float4 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), zero), one);
+                q[j]     = _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+            }
+            int4 bytes = _mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));
+            _mm_storeu_si128(reinterpret_cast<int4*>(dst + i), bytes);
+        }
+        for (size_t k = 0; k < (count & 15); ++k)
+            dst[i + k] = (unsigned char) _mm_cvtss_si32(_mm_set_ss(Clamp(src[i + k], 0.0f, 1.0f) * 255.0f));
+    }
+    inline void PackUnorm8(const Vec2* src, unsigned char* dst, size_t count) { PackUnorm8(reinterpret_cast<const float*>(src), dst, count * 2); }
+    inline void PackUnorm8(const Vec3* src, unsigned char* dst, size_t count) { PackUnorm8(reinterpret_cast<const float*>(src), dst, count * 3); }
+    inline void PackUnorm8(const Vec4* src, unsigned char* dst, size_t count) { PackUnorm8(reinterpret_cast<const float*>(src), dst, count * 4); }
+
+    inline void UnpackUnorm8(const unsigned char* src, float* dst, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_UNPACK_UNORM8, count);
+        const float4 scale = _mm_set1_ps(g_INV_UNORM8);
+
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            int4 bytes = _mm_loadu_si128(reinterpret_cast<const int4*>(src + i));
+            for (int j = 0; j < 4; ++j)
+            {
+                _mm_storeu_ps(dst + i + j * 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_cvtepu8_epi32(bytes)), scale));
+                bytes = _mm_srli_si128(bytes, 4);
+            }
+        }
+        for (size_t k = 0; k < (count & 15); ++k)
+            dst[i + k] = src[i + k] * g_INV_UNORM8;
+    }
+    inline void UnpackUnorm8(const unsigned char* src, Vec2* dst, size_t count) { UnpackUnorm8(src, reinterpret_cast<float*>(dst), count * 2); }
+    inline void UnpackUnorm8(const unsigned char* src, Vec3* dst, size_t count) { UnpackUnorm8(src, reinterpret_cast<float*>(dst), count * 3); }
+    inline void UnpackUnorm8(const unsigned char* src, Vec4* dst, size_t count) { UnpackUnorm8(src, reinterpret_cast<float*>(dst), count * 4); }
+
+    // On little endian the byte stream r, g, b, a is exactly 0xAABBGGRR.
+    inline void PackRGBA8(const Vec4* src, unsigned int* dst, size_t count)
+    {
+        PackUnorm8(reinterpret_cast<const float*>(src), reinterpret_cast<unsigned char*>(dst), count * 4);
+    }
+
+    inline void UnpackRGBA8(const unsigned int* src, Vec4* dst, size_t count)
+    {
+        UnpackUnorm8(reinterpret_cast<const unsigned char*>(src), reinterpret_cast<float*>(dst), count * 4);
+    }
+} // namespace DropMath
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DM_Quat.h"
+
+namespace DropMath
+{
+    // Rigid transform (rotation then translation) as a unit dual quaternion real + eps * dual, with
+    // dual = 0.5 * (t, 0) * real. Unlike matrices, a weighted sum of them renormalizes to a rigid transform, which
+    // is what dual quaternion skinning relies on.
+    struct alignas(16) DualQuat
+    {
+        Quat real;
+        Quat dual;
+
+        // Identity transform.
+        DualQuat() : real(), dual(0.0f, 0.0f, 0.0f, 0.0f) { }
+        DualQuat(const Quat& real, const Quat& dual) : real(real), dual(dual) { }
+
+        DualQuat operator+(const DualQuat& q) const { return DualQuat(real + q.real, dual + q.dual); }
+        DualQuat operator*(float s) const { return DualQuat(real * s, dual * s); }
+        // Composition, the transform of q applies first.
+        DualQuat operator*(const DualQuat& q) const;
+        bool     operator==(const DualQuat& q) const;
+        bool     operator!=(const DualQuat& q) const;
+
+        // Return the quaternion conjugate of both parts, the inverse of a unit dual quaternion.
+        DualQuat Conjugate() const;
+
+        // Divide both parts by the length of the real part, so that it is a rigid transform again.
+        void Normalize();
+
+        // Return the normalized dual quaternion.
+        DualQuat Normalized() const;
+
+        // Return the rotation part.
+        Quat Rotation() const { return real; }
+
+        // Return the translation part.
+        Vec3 Translation() const;
+
+        // Transform a point (the dual quaternion must be normalized).
+        Vec3 TransformPoint(const Vec3& p) const;
+
+        // Rotate a direction, the translation is ignored.
+        Vec3 TransformVector(const Vec3& v) const;
+
+        // Return the matrix of the transform.
+        Mat3x4 ToMat3x4() const;
+
+        // Return the matrix of the transform.
+        Mat4x4 ToMat4x4() const;
+
+        // Create Identity dual quaternion.
+        static DualQuat Identity() { return DualQuat(); }
+
+        // Create the transform rotating by r (normalized) then translating by t.
+        static DualQuat FromRotationTranslation(const Quat& r, const Vec3& t);
+
+        // Create the transform of m, which must be rigid (no scale or shear).
+        static DualQuat FromMat3x4(const Mat3x4& m);
+
+        // Create the transform of m, which must be rigid (no scale, shear or projection).
+        static DualQuat FromMat4x4(const Mat4x4& m);
+    };
+} // namespace DropMath
+
+#include "DM_DualQuat.inl"
@@ -0,0 +1,83 @@
+namespace DropMath
+{
+    namespace
+    {
+        // 2 * (d * conj(r)).xyz = 2 * (r.w * d.xyz - d.w * r.xyz + r.xyz x d.xyz).
+        inline float4 DualQuatTranslation(float4 r, float4 d)
+        {
+            float4 t = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)), d),
+                                  _mm_mul_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3)), r));
+            t        = _mm_add_ps(t, Cross3(r, d));
+            return _mm_blend_ps(_mm_add_ps(t, t), _mm_setzero_ps(), 0x8);
+        }
+    } // anonymous namespace
+
+    inline DualQuat DualQuat::operator*(const DualQuat& q) const
+    {
+        // (r1 + eps d1)(r2 + eps d2) = r1 r2 + eps (r1 d2 + d1 r2), eps^2 = 0.
+        return DualQuat(Quat(QuatMul(real.v, q.real.v)), Quat(_mm_add_ps(QuatMul(real.v, q.dual.v), QuatMul(dual.v, q.real.v))));
+    }
+
+    inline bool DualQuat::operator==(const DualQuat& q) const { return real == q.real && dual == q.dual; }
+    inline bool DualQuat::operator!=(const DualQuat& q) const { return !(*this == q); }
+
+    inline DualQuat DualQuat::Conjugate() const { return DualQuat(Quat(QuatConjugate(real.v)), Quat(QuatConjugate(dual.v))); }
+
+    inline void DualQuat::Normalize()
+    {
+        float len = real.Length();
+        if (len > F::EPSILON)
+        {
+            float4 inv = _mm_set1_ps(1.0f / len);
+            real.v     = _mm_mul_ps(real.v, inv);
+            dual.v     = _mm_mul_ps(dual.v, inv);
+        }
+    }
+
+    inline DualQuat DualQuat::Normalized() const
+    {
+        DualQuat q = *this;
+        q.Normalize();
+        return q;
+    }
+
+    inline Vec3 DualQuat::Translation() const
+    {
+        alignas(16) float t[4];
+        _mm_store_ps(t, DualQuatTranslation(real.v, dual.v));
+        return Vec3(t[0], t[1], t[2]);
+    }
+
+    inline Vec3 DualQuat::TransformPoint(const Vec3& p) const
+    {
+        alignas(16) float out[4];
+        _mm_store_ps(out, _mm_add_ps(QuatRotate(real.v, LoadVec3(p)), DualQuatTranslation(real.v, dual.v)));
+        return Vec3(out[0], out[1], out[2]);
+    }
+
+    inline Vec3 DualQuat::TransformVector(const Vec3& v) const { return real.Rotate(v); }
+
+    inline Mat3x4 DualQuat::ToMat3x4() const
+    {
+        Mat3x4 m = real.ToMat3x4();
+        Vec3   t = Translation();
+        m[0].w   = t.x;
+        m[1].w   = t.y;
+        m[2].w   = t.z;
+        return m;
+    }
+
+    inline Mat4x4 DualQuat::ToMat4x4() const { return ToMat3x4().ToMat4x4(); }
+
+    inline DualQuat DualQuat::FromRotationTranslation(const Quat& r, const Vec3& t)
+    {
+        return DualQuat(r, Quat(QuatMul(LoadVec3(t), r.v)) * 0.5f);
+    }
+
+    inline DualQuat DualQuat::FromMat3x4(const Mat3x4& m)
+    {
+        return FromRotationTranslation(Quat::FromRotation(m), Vec3(m[0].w, m[1].w, m[2].w));
+    }
+
+    inline DualQuat DualQuat::FromMat4x4(const Mat4x4& m) { return FromMat3x4(Mat3x4(m)); }
+} // namespace DropMath
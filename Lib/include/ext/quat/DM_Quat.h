@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../mat/DM_Mat3x4.h"
+
+namespace DropMath
+{
+    // Rotation quaternion (x, y, z) = axis * sin(angle / 2), w = cos(angle / 2), in one SSE register. Products follow
+    // the matrices: (a * b) rotates by b first, then by a.
+    struct alignas(16) Quat
+    {
+        union
+        {
+            float4 v; // Don't ever use this directly unless you know about SSE alignment.
+            struct
+            {
+                float x, y, z, w;
+            };
+        };
+
+        // Identity rotation.
+        Quat() : v(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)) { }
+        Quat(float x, float y, float z, float w) : v(_mm_set_ps(w, z, y, x)) { }
+        explicit Quat(const float4& v) : v(v) { }
+
+        Quat operator+(const Quat& q) const { return Quat(_mm_add_ps(v, q.v)); }
+        Quat operator-(const Quat& q) const { return Quat(_mm_sub_ps(v, q.v)); }
+        Quat operator*(float s) const { return Quat(_mm_mul_ps(v, _mm_set1_ps(s))); }
+        // Hamilton product.
+        Quat operator*(const Quat& q) const;
+        bool operator==(const Quat& q) const;
+        bool operator!=(const Quat& q) const;
+
+        // Return (-x, -y, -z, w), the inverse of a unit quaternion.
+        Quat Conjugate() const;
+
+        float Length() const;
+
+        float LengthSquared() const;
+
+        // Normalize the length of the quaternion so that it is 1.
+        void Normalize();
+
+        // Return the normalized quaternion.
+        Quat Normalized() const;
+
+        // Rotate v (the quaternion must be normalized).
+        Vec3 Rotate(const Vec3& v) const;
+
+        // Return the rotation matrix of a normalized quaternion, with no translation.
+        Mat3x4 ToMat3x4() const;
+
+        // Dot product of a and b.
+        static float Dot(const Quat& a, const Quat& b);
+
+        // Normalized lerp along the shorter arc. Cheaper than a slerp and close to it for nearby rotations.
+        static Quat Nlerp(const Quat& a, const Quat& b, float t);
+
+        // Create Identity quaternion.
+        static Quat Identity() { return Quat(); }
+
+        // Create rotation around a normalized axis.
+        static Quat FromAxisAngle(const Vec3& axis, float rad);
+
+        // Create rotation from euler angles, the same rotation as Mat4x4::RotationEuler.
+        static Quat FromEuler(const Vec3& rad);
+
+        // Create rotation from the linear part of m, which must be a rotation (orthonormal, determinant 1).
+        static Quat FromRotation(const Mat3x4& m);
+    };
+} // namespace DropMath
+
+#include "DM_Quat.inl"
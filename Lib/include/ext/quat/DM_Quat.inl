@@ -0,0 +1,129 @@
+namespace DropMath
+{
+    namespace
+    {
+        // Hamilton product a * b on raw registers, shared with the dual quaternion code.
+        inline float4 QuatMul(float4 a, float4 b)
+        {
+            // Lane by lane: a.w * b + a.x * b.wzyx * (+-+-) + a.y * b.zwxy * (++--) + a.z * b.yxwz * (-++-).
+            float4 r = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+            float4 x = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)));
+            float4 y = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)));
+            float4 z = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)));
+            r        = _mm_add_ps(r, _mm_xor_ps(x, _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f)));
+            r        = _mm_add_ps(r, _mm_xor_ps(y, _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f)));
+            return _mm_add_ps(r, _mm_xor_ps(z, _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f)));
+        }
+
+        inline float4 QuatConjugate(float4 q) { return _mm_xor_ps(q, _mm_set_ps(0.0f, -0.0f, -0.0f, -0.0f)); }
+
+        // Rotate v (w lane ignored) by the unit quaternion q: v + w * t + q.xyz x t with t = 2 * q.xyz x v.
+        inline float4 QuatRotate(float4 q, float4 v)
+        {
+            float4 t = _mm_mul_ps(Cross3(q, v), _mm_set1_ps(2.0f));
+            return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)), t)), Cross3(q, t));
+        }
+    } // anonymous namespace
+
+    inline Quat Quat::operator*(const Quat& q) const { return Quat(QuatMul(v, q.v)); }
+
+    inline bool Quat::operator==(const Quat& q) const
+    {
+        float4 delta = _mm_sub_ps(q.v, v);
+        float4 abs   = _mm_and_ps(g_SIGN_MASK_F, delta);
+        return _mm_movemask_ps(_mm_cmplt_ps(abs, g_EPSILON_F)) == 0xF;
+    }
+    inline bool Quat::operator!=(const Quat& q) const { return !(*this == q); }
+
+    inline Quat Quat::Conjugate() const { return Quat(QuatConjugate(v)); }
+
+    inline float Quat::Length() const { return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(v, v, 0xF1))); }
+
+    inline float Quat::LengthSquared() const { return _mm_cvtss_f32(_mm_dp_ps(v, v, 0xF1)); }
+
+    inline void Quat::Normalize()
+    {
+        float len = Length();
+        if (len > F::EPSILON)
+            v = _mm_div_ps(v, _mm_set1_ps(len));
+    }
+
+    inline Quat Quat::Normalized() const
+    {
+        Quat q = *this;
+        q.Normalize();
+        return q;
+    }
+
+    inline Vec3 Quat::Rotate(const Vec3& p) const
+    {
+        alignas(16) float out[4];
+        _mm_store_ps(out, QuatRotate(v, _mm_set_ps(0.0f, p.z, p.y, p.x)));
+        return Vec3(out[0], out[1], out[2]);
+    }
+
+    inline Mat3x4 Quat::ToMat3x4() const
+    {
+        float xx = x * x, yy = y * y, zz = z * z;
+        float xy = x * y, xz = x * z, yz = y * z;
+        float wx = w * x, wy = w * y, wz = w * z;
+        return Mat3x4(
+            Vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy), 0.0f),
+            Vec4(2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx), 0.0f),
+            Vec4(2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy), 0.0f));
+    }
+
+    inline float Quat::Dot(const Quat& a, const Quat& b) { return _mm_cvtss_f32(_mm_dp_ps(a.v, b.v, 0xF1)); }
+
+    inline Quat Quat::Nlerp(const Quat& a, const Quat& b, float t)
+    {
+        // q and -q are the same rotation, flip b onto the hemisphere of a.
+        float4 flip = _mm_and_ps(_mm_cmplt_ps(_mm_dp_ps(a.v, b.v, 0xFF), _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+        float4 to   = _mm_xor_ps(b.v, flip);
+        Quat   q(_mm_add_ps(a.v, _mm_mul_ps(_mm_sub_ps(to, a.v), _mm_set1_ps(t))));
+        q.Normalize();
+        return q;
+    }
+
+    inline Quat Quat::FromAxisAngle(const Vec3& axis, float rad)
+    {
+        float s, c;
+        SinCos(0.5f * rad, s, c);
+        return Quat(axis.x * s, axis.y * s, axis.z * s, c);
+    }
+
+    inline Quat Quat::FromEuler(const Vec3& rad)
+    {
+        // Half angles of the three axes in one SinCos, then yaw * pitch * roll like Mat4x4::RotationEuler.
+        alignas(16) float s[4], c[4];
+        float4            sin, cos;
+        SinCos(_mm_mul_ps(_mm_set_ps(0.0f, rad.z, rad.y, rad.x), _mm_set1_ps(0.5f)), sin, cos);
+        _mm_store_ps(s, sin);
+        _mm_store_ps(c, cos);
+        return Quat(0.0f, s[1], 0.0f, c[1]) * (Quat(s[0], 0.0f, 0.0f, c[0]) * Quat(0.0f, 0.0f, s[2], c[2]));
+    }
+
+    inline Quat Quat::FromRotation(const Mat3x4& m)
+    {
+        // Shepperd: divide by the largest of the four candidates for a stable result near 180 degree turns.
+        float m00 = m[0].x, m11 = m[1].y, m22 = m[2].z;
+        float trace = m00 + m11 + m22;
+        if (trace > 0.0f)
+        {
+            float s = Sqrt(trace + 1.0f) * 2.0f;
+            return Quat((m[2].y - m[1].z) / s, (m[0].z - m[2].x) / s, (m[1].x - m[0].y) / s, 0.25f * s);
+        }
+        if (m00 > m11 && m00 > m22)
+        {
+            float s = Sqrt(1.0f + m00 - m11 - m22) * 2.0f;
+            return Quat(0.25f * s, (m[0].y + m[1].x) / s, (m[0].z + m[2].x) / s, (m[2].y - m[1].z) / s);
+        }
+        if (m11 > m22)
+        {
+            float s = Sqrt(1.0f + m11 - m00 - m22) * 2.0f;
+            return Quat((m[0].y + m[1].x) / s, 0.25f * s, (m[1].z + m[2].y) / s, (m[0].z - m[2].x) / s);
+        }
+        float s = Sqrt(1.0f + m22 - m00 - m11) * 2.0f;
+        return Quat((m[0].z + m[2].x) / s, (m[1].z + m[2].y) / s, 0.25f * s, (m[1].x - m[0].y) / s);
+    }
+} // namespace DropMath
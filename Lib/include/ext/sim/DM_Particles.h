@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../DM_Enum.h"
+#include "../thread/DM_ThreadPool.h"
+#include "../vec/DM_Vec3x4.h"
+
+namespace DropMath
+{
+    // The SoA streams of a particle set, owned by the caller (AlignedArray<float> works well). Streams need no
+    // particular alignment.
+    struct ParticleStreams
+    {
+        ParticleStreams()
+            : x(nullptr), y(nullptr), z(nullptr), vx(nullptr), vy(nullptr), vz(nullptr), ax(nullptr), ay(nullptr), az(nullptr), count(0) { }
+
+        float* x;
+        float* y;
+        float* z;
+        float* vx;
+        float* vy;
+        float* vz;
+        // Per particle acceleration added to the field forces (springs, collision response, ...), held constant over
+        // the step. nullptr for none.
+        const float* ax;
+        const float* ay;
+        const float* az;
+        size_t       count;
+    };
+
+    // Softened inverse square attractor: a particle at p accelerates by strength * d / (|d|^2 + softening^2)^1.5 with
+    // d = position - p. Negative strength repels. Keep softening > 0 if particles can reach the position.
+    struct ParticleAttractor
+    {
+        ParticleAttractor() : position(0.0f, 0.0f, 0.0f), strength(0.0f), softening(1.0f) { }
+        ParticleAttractor(const Vec3& position, float strength, float softening) : position(position), strength(strength), softening(softening) { }
+
+        Vec3  position;
+        float strength;
+        float softening;
+    };
+
+    // Forces shared by every particle, expressed as accelerations (unit mass).
+    struct ParticleForces
+    {
+        ParticleForces() : gravity(0.0f, 0.0f, 0.0f), drag(0.0f), attractors(nullptr), attractorCount(0) { }
+
+        Vec3                     gravity;
+        float                    drag; // Linear drag: a -= drag * v.
+        const ParticleAttractor* attractors;
+        size_t                   attractorCount;
+    };
+
+    // Advance every particle of streams by dt. The kernel works on 4 particles per SSE register and 8 per loop
+    // iteration, without temporaries. With a pool the streams are split into chunks that run in parallel, without
+    // one everything runs on the calling thread.
+    inline void IntegrateParticles(const ParticleStreams& streams, const ParticleForces& forces, float dt, PARTICLE_INTEGRATOR integrator,
+                                   ThreadPool* pool = nullptr);
+} // namespace DropMath
+
+#include "DM_Particles.inl"
@@ -0,0 +1,135 @@
+namespace DropMath
+{
+    namespace
+    {
+        const size_t g_PARTICLE_GRAIN = 8192; // Particles per parallel chunk, a multiple of 8.
+
+        inline Vec3x4 ParticleAcceleration(const ParticleForces& forces, const Vec3x4& p, const Vec3x4& v, const Vec3x4& extra)
+        {
+            Vec3x4 a = Vec3x4(forces.gravity) + extra - v * forces.drag;
+            for (size_t i = 0; i < forces.attractorCount; ++i)
+            {
+                const ParticleAttractor& attractor = forces.attractors[i];
+
+                Vec3x4 d     = Vec3x4(attractor.position) - p;
+                float4 r2    = _mm_add_ps(d.LengthSquared(), _mm_set1_ps(attractor.softening * attractor.softening));
+                float4 scale = _mm_div_ps(_mm_set1_ps(attractor.strength), _mm_mul_ps(r2, _mm_sqrt_ps(r2)));
+                a            = a + d * scale;
+            }
+            return a;
+        }
+
+        // Integrate particles [i, i + 4) of streams.
+        template <PARTICLE_INTEGRATOR Integrator>
+        inline void IntegrateParticles4(const ParticleStreams& s, size_t i, const ParticleForces& forces, float dt)
+        {
+            Vec3x4 p     = Vec3x4::LoadSoA(s.x + i, s.y + i, s.z + i);
+            Vec3x4 v     = Vec3x4::LoadSoA(s.vx + i, s.vy + i, s.vz + i);
+            Vec3x4 extra = s.ax ? Vec3x4::LoadSoA(s.ax + i, s.ay + i, s.az + i) : Vec3x4();
+            Vec3x4 a     = ParticleAcceleration(forces, p, v, extra);
+
+            if (Integrator == PARTICLE_INTEGRATOR_EULER)
+            {
+                p = p + v * dt;
+                v = v + a * dt;
+            }
+            else if (Integrator == PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER)
+            {
+                v = v + a * dt;
+                p = p + v * dt;
+            }
+            else
+            {
+                // Velocity Verlet. Drag needs the velocity at the end of the step, the Euler prediction stands in for it.
+                p             = p + v * dt + a * (0.5f * dt * dt);
+                Vec3x4 aAfter = ParticleAcceleration(forces, p, v + a * dt, extra);
+                v             = v + (a + aAfter) * (0.5f * dt);
+            }
+
+            p.StoreSoA(s.x + i, s.y + i, s.z + i);
+            v.StoreSoA(s.vx + i, s.vy + i, s.vz + i);
+        }
+
+        template <PARTICLE_INTEGRATOR Integrator>
+        inline void IntegrateParticleRange(const ParticleStreams& s, size_t first, size_t last, const ParticleForces& forces, float dt)
+        {
+            // Two independent groups per iteration keep both SSE pipes busy while the attractor divisions run.
+            size_t i = first;
+            for (; i + 8 <= last; i += 8)
+            {
+                IntegrateParticles4<Integrator>(s, i, forces, dt);
+                IntegrateParticles4<Integrator>(s, i + 4, forces, dt);
+            }
+            for (; i + 4 <= last; i += 4)
+                IntegrateParticles4<Integrator>(s, i, forces, dt);
+            if (i == last)
+                return;
+
+            // Fewer than 4 left: run them through a padded copy so the tail uses the same math.
+            alignas(16) float tail[9][4] = {};
+            float*            streams[9] = { s.x, s.y, s.z, s.vx, s.vy, s.vz };
+            const float*      accel[3]   = { s.ax, s.ay, s.az };
+            size_t            n          = last - i;
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (int k = 0; k < 6; ++k)
+                    tail[k][j] = streams[k][i + j];
+                for (int k = 0; s.ax && k < 3; ++k)
+                    tail[6 + k][j] = accel[k][i + j];
+            }
+
+            ParticleStreams padded;
+            padded.x     = tail[0];
+            padded.y     = tail[1];
+            padded.z     = tail[2];
+            padded.vx    = tail[3];
+            padded.vy    = tail[4];
+            padded.vz    = tail[5];
+            padded.ax    = s.ax ? tail[6] : nullptr;
+            padded.ay    = s.ax ? tail[7] : nullptr;
+            padded.az    = s.ax ? tail[8] : nullptr;
+            padded.count = 4;
+            IntegrateParticles4<Integrator>(padded, 0, forces, dt);
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (int k = 0; k < 6; ++k)
+                    streams[k][i + j] = tail[k][j];
+            }
+        }
+
+        template <PARTICLE_INTEGRATOR Integrator>
+        inline void IntegrateParticlesWith(const ParticleStreams& s, const ParticleForces& forces, float dt, ThreadPool* pool)
+        {
+            if (!pool)
+            {
+                IntegrateParticleRange<Integrator>(s, 0, s.count, forces, dt);
+                return;
+            }
+            pool->ParallelFor(0, s.count, g_PARTICLE_GRAIN,
+                              [&](size_t first, size_t last) { IntegrateParticleRange<Integrator>(s, first, last, forces, dt); });
+        }
+    } // anonymous namespace
+
+    inline void IntegrateParticles(const ParticleStreams& streams, const ParticleForces& forces, float dt, PARTICLE_INTEGRATOR integrator,
+                                   ThreadPool* pool)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_INTEGRATE_PARTICLES, streams.count);
+
+        switch (integrator)
+        {
+        case PARTICLE_INTEGRATOR_EULER:
+            IntegrateParticlesWith<PARTICLE_INTEGRATOR_EULER>(streams, forces, dt, pool);
+            break;
+        case PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER:
+            IntegrateParticlesWith<PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER>(streams, forces, dt, pool);
+            break;
+        case PARTICLE_INTEGRATOR_VERLET:
+            IntegrateParticlesWith<PARTICLE_INTEGRATOR_VERLET>(streams, forces, dt, pool);
+            break;
+        default:
+            assert(false && "Unknown particle integrator.");
+            break;
+        }
+    }
+} // namespace DropMath
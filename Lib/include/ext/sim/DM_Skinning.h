@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../quat/DM_DualQuat.h"
+#include "../thread/DM_ThreadPool.h"
+
+namespace DropMath
+{
+    // The SoA vertex streams of a skinned mesh, owned by the caller. Every vertex has 4 influences: joints[4 * i + k]
+    // indexes the palette and weights[4 * i + k] should sum to 1 over k (unused influences have weight 0). Streams
+    // need no particular alignment. The output streams must not alias the inputs.
+    struct SkinningStreams
+    {
+        SkinningStreams()
+            : x(nullptr), y(nullptr), z(nullptr), nx(nullptr), ny(nullptr), nz(nullptr), joints(nullptr), weights(nullptr), outX(nullptr),
+              outY(nullptr), outZ(nullptr), outNX(nullptr), outNY(nullptr), outNZ(nullptr), count(0) { }
+
+        const float* x;
+        const float* y;
+        const float* z;
+        // Normals, nullptr for none.
+        const float*          nx;
+        const float*          ny;
+        const float*          nz;
+        const unsigned short* joints;
+        const float*          weights;
+        float*                outX;
+        float*                outY;
+        float*                outZ;
+        // Skinned normals, written when the normals are set.
+        float* outNX;
+        float* outNY;
+        float* outNZ;
+        size_t count;
+    };
+
+    // Dual quaternion linear blending: every vertex is moved by the normalized weighted sum of the palette entries
+    // of its joints, with each entry flipped onto the hemisphere of the first one. Unlike blended matrices this keeps
+    // volume at twisting joints. The kernel blends 4 vertices per SSE register and skips influences that are 0 for
+    // all 4. With a pool the streams are split into chunks that run in parallel.
+    inline void SkinDualQuat(const DualQuat* palette, size_t jointCount, const SkinningStreams& streams, ThreadPool* pool = nullptr);
+} // namespace DropMath
+
+#include "DM_Skinning.inl"
@@ -0,0 +1,159 @@
+namespace DropMath
+{
+    namespace
+    {
+        const size_t g_SKIN_GRAIN = 4096; // Vertices per parallel chunk, a multiple of 4.
+
+        // A dual quaternion per lane, one register per component.
+        struct SkinDualQuat4
+        {
+            float4 r[4]; // Real x, y, z, w.
+            float4 d[4]; // Dual x, y, z, w.
+        };
+
+        // Gather influence k of 4 vertices from the palette and transpose them to SoA.
+        inline SkinDualQuat4 SkinGather(const DualQuat* palette, size_t jointCount, const unsigned short* joints, int k)
+        {
+            (void) jointCount;
+            SkinDualQuat4 q;
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                unsigned short joint = joints[4 * lane + k];
+                assert(joint < jointCount && "Joint index out of the palette.");
+                q.r[lane] = palette[joint].real.v;
+                q.d[lane] = palette[joint].dual.v;
+            }
+            _MM_TRANSPOSE4_PS(q.r[0], q.r[1], q.r[2], q.r[3]);
+            _MM_TRANSPOSE4_PS(q.d[0], q.d[1], q.d[2], q.d[3]);
+            return q;
+        }
+
+        // Rotate v by the unit quaternions (r, w): v + w * t + r x t with t = 2 * r x v.
+        inline Vec3x4 SkinRotate(const Vec3x4& r, float4 w, const Vec3x4& v)
+        {
+            Vec3x4 t = Vec3x4::Cross(r, v) * 2.0f;
+            return v + t * w + Vec3x4::Cross(r, t);
+        }
+
+        // Skin vertices [i, i + 4) of s.
+        inline void SkinVertices4(const DualQuat* palette, size_t jointCount, const SkinningStreams& s, size_t i)
+        {
+            const unsigned short* joints = s.joints + 4 * i;
+
+            // Rows are vertices, transpose so that w[k] holds influence k of the 4 vertices.
+            float4 w[4] = { _mm_loadu_ps(s.weights + 4 * i), _mm_loadu_ps(s.weights + 4 * i + 4), _mm_loadu_ps(s.weights + 4 * i + 8),
+                            _mm_loadu_ps(s.weights + 4 * i + 12) };
+            _MM_TRANSPOSE4_PS(w[0], w[1], w[2], w[3]);
+
+            SkinDualQuat4 blend = SkinGather(palette, jointCount, joints, 0);
+            float4        ref[4] = { blend.r[0], blend.r[1], blend.r[2], blend.r[3] };
+            for (int c = 0; c < 4; ++c)
+            {
+                blend.r[c] = _mm_mul_ps(blend.r[c], w[0]);
+                blend.d[c] = _mm_mul_ps(blend.d[c], w[0]);
+            }
+
+            for (int k = 1; k < 4; ++k)
+            {
+                if (_mm_movemask_ps(_mm_cmpneq_ps(w[k], _mm_setzero_ps())) == 0)
+                    continue;
+
+                SkinDualQuat4 q = SkinGather(palette, jointCount, joints, k);
+
+                // q and -q are the same transform, flip the weight where q is on the other hemisphere of influence 0.
+                float4 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(q.r[0], ref[0]), _mm_mul_ps(q.r[1], ref[1])),
+                                        _mm_add_ps(_mm_mul_ps(q.r[2], ref[2]), _mm_mul_ps(q.r[3], ref[3])));
+                float4 weight = _mm_xor_ps(w[k], _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+                for (int c = 0; c < 4; ++c)
+                {
+                    blend.r[c] = _mm_add_ps(blend.r[c], _mm_mul_ps(q.r[c], weight));
+                    blend.d[c] = _mm_add_ps(blend.d[c], _mm_mul_ps(q.d[c], weight));
+                }
+            }
+
+            float4 len2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(blend.r[0], blend.r[0]), _mm_mul_ps(blend.r[1], blend.r[1])),
+                                     _mm_add_ps(_mm_mul_ps(blend.r[2], blend.r[2]), _mm_mul_ps(blend.r[3], blend.r[3])));
+            float4 inv  = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len2));
+            Vec3x4 r    = Vec3x4(blend.r[0], blend.r[1], blend.r[2]) * inv;
+            Vec3x4 d    = Vec3x4(blend.d[0], blend.d[1], blend.d[2]) * inv;
+            float4 rw   = _mm_mul_ps(blend.r[3], inv);
+            float4 dw   = _mm_mul_ps(blend.d[3], inv);
+
+            // Translation 2 * (rw * d - dw * r + r x d), see DualQuat::Translation.
+            Vec3x4 t = (d * rw - r * dw + Vec3x4::Cross(r, d)) * 2.0f;
+            Vec3x4 p = Vec3x4::LoadSoA(s.x + i, s.y + i, s.z + i);
+            (SkinRotate(r, rw, p) + t).StoreSoA(s.outX + i, s.outY + i, s.outZ + i);
+
+            if (s.nx)
+                SkinRotate(r, rw, Vec3x4::LoadSoA(s.nx + i, s.ny + i, s.nz + i)).StoreSoA(s.outNX + i, s.outNY + i, s.outNZ + i);
+        }
+
+        inline void SkinDualQuatRange(const DualQuat* palette, size_t jointCount, const SkinningStreams& s, size_t first, size_t last)
+        {
+            size_t i = first;
+            for (; i + 4 <= last; i += 4)
+                SkinVertices4(palette, jointCount, s, i);
+            if (i == last)
+                return;
+
+            // Fewer than 4 left: run them through a padded copy. Padding lanes use joint 0 at full weight so that
+            // their blend stays normalizable.
+            alignas(16) float in[6][4]      = {};
+            alignas(16) float out[6][4]     = {};
+            alignas(16) float weights[16]   = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+            unsigned short    joints[16]    = {};
+            const float*      inStreams[6]  = { s.x, s.y, s.z, s.nx, s.ny, s.nz };
+            float*            outStreams[6] = { s.outX, s.outY, s.outZ, s.outNX, s.outNY, s.outNZ };
+            int               streamCount   = s.nx ? 6 : 3;
+            size_t            n             = last - i;
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (int k = 0; k < streamCount; ++k)
+                    in[k][j] = inStreams[k][i + j];
+                for (int k = 0; k < 4; ++k)
+                {
+                    joints[4 * j + k]  = s.joints[4 * (i + j) + k];
+                    weights[4 * j + k] = s.weights[4 * (i + j) + k];
+                }
+            }
+
+            SkinningStreams padded;
+            padded.x       = in[0];
+            padded.y       = in[1];
+            padded.z       = in[2];
+            padded.nx      = s.nx ? in[3] : nullptr;
+            padded.ny      = s.nx ? in[4] : nullptr;
+            padded.nz      = s.nx ? in[5] : nullptr;
+            padded.joints  = joints;
+            padded.weights = weights;
+            padded.outX    = out[0];
+            padded.outY    = out[1];
+            padded.outZ    = out[2];
+            padded.outNX   = out[3];
+            padded.outNY   = out[4];
+            padded.outNZ   = out[5];
+            padded.count   = 4;
+            SkinVertices4(palette, jointCount, padded, 0);
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                for (int k = 0; k < streamCount; ++k)
+                    outStreams[k][i + j] = out[k][j];
+            }
+        }
+    } // anonymous namespace
+
+    inline void SkinDualQuat(const DualQuat* palette, size_t jointCount, const SkinningStreams& streams, ThreadPool* pool)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SKIN_DUAL_QUAT, streams.count);
+        assert((streams.count == 0 || jointCount > 0) && "Skinning needs a palette.");
+
+        if (!pool)
+        {
+            SkinDualQuatRange(palette, jointCount, streams, 0, streams.count);
+            return;
+        }
+        pool->ParallelFor(0, streams.count, g_SKIN_GRAIN,
+                          [&](size_t first, size_t last) { SkinDualQuatRange(palette, jointCount, streams, first, last); });
+    }
+} // namespace DropMath
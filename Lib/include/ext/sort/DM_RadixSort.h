@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../thread/DM_ThreadPool.h"
+
+namespace DropMath
+{
+    // Map a float to an unsigned int of the same order: negative floats flip every bit, the others the sign only.
+    // -0 sorts before +0, NaNs with the sign bit clear after +infinity and the others before -infinity.
+    inline unsigned int FloatSortKey(float f);
+    inline float        FloatFromSortKey(unsigned int key);
+
+    // Same for doubles, into 64 bits.
+    inline unsigned long long DoubleSortKey(double d);
+    inline double             DoubleFromSortKey(unsigned long long key);
+
+    struct RadixSortSettings
+    {
+        RadixSortSettings() : parallelThreshold(65536), pool(nullptr) { }
+
+        size_t      parallelThreshold; // Fewer keys are sorted on the calling thread only.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Stable LSD radix sort of 32 and 64 bit keys (Morton codes, depths, distances) with an optional index payload,
+    // 8 bits per pass. Every thread counts the digits of its own slice of the keys, so the scatter can give each
+    // slice its own slots per digit and stay stable without locking. Large slices scatter through a small buffer per
+    // digit that is flushed a cache line at a time, instead of writing to 256 places at once. Passes where every
+    // key has the same digit are skipped, so codes that use fewer bits than the key type don't pay for the rest.
+    //
+    // The scratch buffers are kept between calls, a sort every frame stops allocating once the size settles.
+    class RadixSorter
+    {
+    public:
+        explicit RadixSorter(const RadixSortSettings& settings = RadixSortSettings()) : m_Settings(settings) { }
+
+        // Sort keys ascending. values may be nullptr, otherwise values[i] moves with keys[i].
+        void Sort(unsigned int* keys, unsigned int* values, size_t count);
+        void Sort(unsigned long long* keys, unsigned int* values, size_t count);
+        // Float keys are ordered as FloatSortKey / DoubleSortKey order them.
+        void Sort(float* keys, unsigned int* values, size_t count);
+        void Sort(double* keys, unsigned int* values, size_t count);
+
+        // Write the permutation that sorts keys to order (keys[order[0]] is the smallest), leaving keys unchanged.
+        void SortOrder(const unsigned int* keys, size_t count, unsigned int* order);
+        void SortOrder(const unsigned long long* keys, size_t count, unsigned int* order);
+        void SortOrder(const float* keys, size_t count, unsigned int* order);
+        void SortOrder(const double* keys, size_t count, unsigned int* order);
+
+        // Release the scratch buffers.
+        void Clear();
+
+    private:
+        template <typename Key>
+        void SortMapped(Key* keys, unsigned int* values, size_t count);
+        template <typename Key>
+        void SortOrderMapped(const Key* keys, size_t count, unsigned int* order);
+        // Sort keys and values (may be nullptr) ping-ponging with the temp arrays. Return the array holding the sorted
+        // keys and point values at the one holding the sorted values.
+        template <typename Bits>
+        Bits* SortBits(Bits* keys, Bits* keysTemp, unsigned int*& values, unsigned int* valuesTemp, size_t count);
+        template <typename Bits>
+        Bits*         KeyScratch(int which, size_t count);
+        unsigned int* ValueScratch(size_t count);
+
+        RadixSortSettings           m_Settings;
+        AlignedArray<unsigned char> m_Keys[2];
+        AlignedArray<unsigned int>  m_Values;
+        AlignedArray<size_t>        m_Histogram;
+        AlignedArray<unsigned char> m_Buffers; // Per thread scatter buffers.
+    };
+} // namespace DropMath
+
+#include "DM_RadixSort.inl"
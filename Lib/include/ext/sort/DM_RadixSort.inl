@@ -0,0 +1,364 @@
+#include <cstring>
+#include <utility>
+
+namespace DropMath
+{
+    namespace
+    {
+        const int    g_RADIX_BITS         = 8;
+        const int    g_RADIX_SIZE         = 1 << g_RADIX_BITS;
+        const size_t g_RADIX_LINE         = 64;                              // Bytes of keys a scatter buffer flushes at once.
+        const size_t g_RADIX_BUFFER_BYTES = 2 * g_RADIX_SIZE * g_RADIX_LINE; // Keys and values of one thread's scatter buffers.
+        const size_t g_RADIX_BUFFER_MIN   = 8192;                            // Shorter slices scatter directly.
+
+        template <typename Key>
+        struct RadixKey;
+        template <>
+        struct RadixKey<float>
+        {
+            typedef unsigned int Bits;
+            static Bits  ToBits(float f) { return FloatSortKey(f); }
+            static float FromBits(Bits b) { return FloatFromSortKey(b); }
+        };
+        template <>
+        struct RadixKey<double>
+        {
+            typedef unsigned long long Bits;
+            static Bits   ToBits(double d) { return DoubleSortKey(d); }
+            static double FromBits(Bits b) { return DoubleFromSortKey(b); }
+        };
+        template <>
+        struct RadixKey<unsigned int>
+        {
+            typedef unsigned int Bits;
+            static Bits         ToBits(unsigned int u) { return u; }
+            static unsigned int FromBits(Bits b) { return b; }
+        };
+        template <>
+        struct RadixKey<unsigned long long>
+        {
+            typedef unsigned long long Bits;
+            static Bits               ToBits(unsigned long long u) { return u; }
+            static unsigned long long FromBits(Bits b) { return b; }
+        };
+
+        // Call fn(slice, first, last) for the slices of [0, count), on the pool when there is more than one.
+        template <typename Fn>
+        inline void RadixForSlices(ThreadPool* pool, size_t slices, size_t count, Fn fn)
+        {
+            if (slices == 1)
+            {
+                fn((size_t) 0, (size_t) 0, count);
+                return;
+            }
+            pool->ParallelFor(0, slices, 1,
+                              [&](size_t firstSlice, size_t lastSlice)
+                              {
+                                  for (size_t slice = firstSlice; slice < lastSlice; ++slice)
+                                      fn(slice, count * slice / slices, count * (slice + 1) / slices);
+                              });
+        }
+
+        template <typename Bits, bool HasValues>
+        inline void RadixScatter(const Bits* srcKeys, const unsigned int* srcValues, size_t first, size_t last, int shift,
+                                 size_t* slots, Bits* dstKeys, unsigned int* dstValues)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                const Bits   key = srcKeys[i];
+                const size_t s   = slots[(size_t) (key >> shift) & (g_RADIX_SIZE - 1)]++;
+                dstKeys[s]       = key;
+                if (HasValues)
+                    dstValues[s] = srcValues[i];
+            }
+        }
+
+        // Same as RadixScatter, through one line of buffered keys per digit. An entry sits in its buffer at the
+        // position its slot has within a line, so every flush but the first and last of a digit writes whole
+        // aligned lines of the output.
+        template <typename Bits, bool HasValues>
+        inline void RadixScatterBuffered(const Bits* srcKeys, const unsigned int* srcValues, size_t first, size_t last,
+                                         int shift, size_t* slots, Bits* dstKeys, unsigned int* dstValues,
+                                         unsigned char* buffer)
+        {
+            const size_t  line   = g_RADIX_LINE / sizeof(Bits);
+            Bits*         keys   = reinterpret_cast<Bits*>(buffer);
+            unsigned int* values = reinterpret_cast<unsigned int*>(buffer + g_RADIX_SIZE * g_RADIX_LINE);
+
+            // Position of the first entry not flushed yet, per digit.
+            unsigned char start[g_RADIX_SIZE];
+            for (int d = 0; d < g_RADIX_SIZE; ++d)
+                start[d] = (unsigned char) (slots[d] & (line - 1));
+
+            for (size_t i = first; i < last; ++i)
+            {
+                const Bits   key = srcKeys[i];
+                const size_t d   = (size_t) (key >> shift) & (g_RADIX_SIZE - 1);
+                const size_t s   = slots[d]++;
+                const size_t b   = s & (line - 1);
+
+                keys[d * line + b] = key;
+                if (HasValues)
+                    values[d * line + b] = srcValues[i];
+                if (b == line - 1)
+                {
+                    const size_t from = start[d];
+                    std::memcpy(dstKeys + s + 1 - line + from, keys + d * line + from, (line - from) * sizeof(Bits));
+                    if (HasValues)
+                        std::memcpy(dstValues + s + 1 - line + from, values + d * line + from, (line - from) * sizeof(unsigned int));
+                    start[d] = 0;
+                }
+            }
+
+            for (int d = 0; d < g_RADIX_SIZE; ++d)
+            {
+                const size_t from    = start[d];
+                const size_t pending = (slots[d] & (line - 1)) - from;
+                if (pending == 0)
+                    continue;
+                std::memcpy(dstKeys + slots[d] - pending, keys + d * line + from, pending * sizeof(Bits));
+                if (HasValues)
+                    std::memcpy(dstValues + slots[d] - pending, values + d * line + from, pending * sizeof(unsigned int));
+            }
+        }
+    } // anonymous namespace
+
+    inline unsigned int FloatSortKey(float f)
+    {
+        unsigned int u;
+        std::memcpy(&u, &f, sizeof(u));
+        return u ^ ((u >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+    }
+
+    inline float FloatFromSortKey(unsigned int key)
+    {
+        unsigned int u = key ^ ((key >> 31) ? 0x80000000u : 0xFFFFFFFFu);
+        float        f;
+        std::memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+
+    inline unsigned long long DoubleSortKey(double d)
+    {
+        unsigned long long u;
+        std::memcpy(&u, &d, sizeof(u));
+        return u ^ ((u >> 63) ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull);
+    }
+
+    inline double DoubleFromSortKey(unsigned long long key)
+    {
+        unsigned long long u = key ^ ((key >> 63) ? 0x8000000000000000ull : 0xFFFFFFFFFFFFFFFFull);
+        double             d;
+        std::memcpy(&d, &u, sizeof(d));
+        return d;
+    }
+
+    inline void RadixSorter::Sort(unsigned int* keys, unsigned int* values, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_RADIX_SORT, count);
+        unsigned int* keysTemp = KeyScratch<unsigned int>(0, count);
+        unsigned int* sorted   = values;
+        unsigned int* result   = SortBits(keys, keysTemp, sorted, values ? ValueScratch(count) : nullptr, count);
+        if (result != keys)
+        {
+            std::memcpy(keys, result, count * sizeof(unsigned int));
+            if (values)
+                std::memcpy(values, sorted, count * sizeof(unsigned int));
+        }
+    }
+
+    inline void RadixSorter::Sort(unsigned long long* keys, unsigned int* values, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_RADIX_SORT, count);
+        unsigned long long* keysTemp = KeyScratch<unsigned long long>(0, count);
+        unsigned int*       sorted   = values;
+        unsigned long long* result   = SortBits(keys, keysTemp, sorted, values ? ValueScratch(count) : nullptr, count);
+        if (result != keys)
+        {
+            std::memcpy(keys, result, count * sizeof(unsigned long long));
+            if (values)
+                std::memcpy(values, sorted, count * sizeof(unsigned int));
+        }
+    }
+
+    inline void RadixSorter::Sort(float* keys, unsigned int* values, size_t count) { SortMapped(keys, values, count); }
+
+    inline void RadixSorter::Sort(double* keys, unsigned int* values, size_t count) { SortMapped(keys, values, count); }
+
+    inline void RadixSorter::SortOrder(const unsigned int* keys, size_t count, unsigned int* order) { SortOrderMapped(keys, count, order); }
+
+    inline void RadixSorter::SortOrder(const unsigned long long* keys, size_t count, unsigned int* order) { SortOrderMapped(keys, count, order); }
+
+    inline void RadixSorter::SortOrder(const float* keys, size_t count, unsigned int* order) { SortOrderMapped(keys, count, order); }
+
+    inline void RadixSorter::SortOrder(const double* keys, size_t count, unsigned int* order) { SortOrderMapped(keys, count, order); }
+
+    inline void RadixSorter::Clear()
+    {
+        m_Keys[0]   = AlignedArray<unsigned char>();
+        m_Keys[1]   = AlignedArray<unsigned char>();
+        m_Values    = AlignedArray<unsigned int>();
+        m_Histogram = AlignedArray<size_t>();
+        m_Buffers   = AlignedArray<unsigned char>();
+    }
+
+    template <typename Key>
+    inline void RadixSorter::SortMapped(Key* keys, unsigned int* values, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_RADIX_SORT, count);
+        typedef typename RadixKey<Key>::Bits Bits;
+
+        ThreadPool*  pool   = count < m_Settings.parallelThreshold ? nullptr : m_Settings.pool ? m_Settings.pool : &ThreadPool::Default();
+        const size_t slices = pool ? (size_t) pool->ThreadCount() : 1;
+
+        Bits* bits = KeyScratch<Bits>(0, count);
+        RadixForSlices(pool, slices, count,
+                       [&](size_t, size_t first, size_t last)
+                       {
+                           for (size_t i = first; i < last; ++i)
+                               bits[i] = RadixKey<Key>::ToBits(keys[i]);
+                       });
+
+        Bits*         bitsTemp = KeyScratch<Bits>(1, count);
+        unsigned int* sorted   = values;
+        Bits*         result   = SortBits(bits, bitsTemp, sorted, values ? ValueScratch(count) : nullptr, count);
+        RadixForSlices(pool, slices, count,
+                       [&](size_t, size_t first, size_t last)
+                       {
+                           for (size_t i = first; i < last; ++i)
+                               keys[i] = RadixKey<Key>::FromBits(result[i]);
+                           if (sorted != values)
+                               std::memcpy(values + first, sorted + first, (last - first) * sizeof(unsigned int));
+                       });
+    }
+
+    template <typename Key>
+    inline void RadixSorter::SortOrderMapped(const Key* keys, size_t count, unsigned int* order)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_RADIX_SORT_ORDER, count);
+        typedef typename RadixKey<Key>::Bits Bits;
+
+        ThreadPool*  pool   = count < m_Settings.parallelThreshold ? nullptr : m_Settings.pool ? m_Settings.pool : &ThreadPool::Default();
+        const size_t slices = pool ? (size_t) pool->ThreadCount() : 1;
+
+        Bits* bits = KeyScratch<Bits>(0, count);
+        RadixForSlices(pool, slices, count,
+                       [&](size_t, size_t first, size_t last)
+                       {
+                           for (size_t i = first; i < last; ++i)
+                           {
+                               bits[i]  = RadixKey<Key>::ToBits(keys[i]);
+                               order[i] = (unsigned int) i;
+                           }
+                       });
+
+        Bits*         bitsTemp = KeyScratch<Bits>(1, count);
+        unsigned int* sorted   = order;
+        SortBits(bits, bitsTemp, sorted, ValueScratch(count), count);
+        if (sorted != order)
+            std::memcpy(order, sorted, count * sizeof(unsigned int));
+    }
+
+    template <typename Bits>
+    inline Bits* RadixSorter::SortBits(Bits* keys, Bits* keysTemp, unsigned int*& values, unsigned int* valuesTemp, size_t count)
+    {
+        const int passes = (int) sizeof(Bits);
+
+        ThreadPool*  pool   = count < m_Settings.parallelThreshold ? nullptr : m_Settings.pool ? m_Settings.pool : &ThreadPool::Default();
+        const size_t slices = pool ? (size_t) pool->ThreadCount() : 1;
+        const bool   buffer = count / slices >= g_RADIX_BUFFER_MIN;
+
+        m_Histogram.Resize((slices > (size_t) passes ? slices : (size_t) passes) * g_RADIX_SIZE);
+        if (buffer)
+            m_Buffers.Resize(slices * g_RADIX_BUFFER_BYTES);
+        size_t* histogram = m_Histogram.Data();
+
+        // On one thread the digit counts of every pass come from a single read of the keys: the count of a digit
+        // over the whole array doesn't depend on the order.
+        if (slices == 1)
+        {
+            std::memset(histogram, 0, passes * g_RADIX_SIZE * sizeof(size_t));
+            for (size_t i = 0; i < count; ++i)
+            {
+                const Bits key = keys[i];
+                for (int pass = 0; pass < passes; ++pass)
+                    ++histogram[pass * g_RADIX_SIZE + ((size_t) (key >> (pass * g_RADIX_BITS)) & (g_RADIX_SIZE - 1))];
+            }
+        }
+
+        Bits*         srcKeys   = keys;
+        Bits*         dstKeys   = keysTemp;
+        unsigned int* srcValues = values;
+        unsigned int* dstValues = valuesTemp;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            const int shift = pass * g_RADIX_BITS;
+            // Slots of every slice, digit major then slice.
+            size_t* slots = slices == 1 ? histogram + pass * g_RADIX_SIZE : histogram;
+            if (slices > 1)
+            {
+                RadixForSlices(pool, slices, count,
+                               [&](size_t slice, size_t first, size_t last)
+                               {
+                                   size_t* counts = &histogram[slice * g_RADIX_SIZE];
+                                   std::memset(counts, 0, g_RADIX_SIZE * sizeof(size_t));
+                                   for (size_t i = first; i < last; ++i)
+                                       ++counts[(size_t) (srcKeys[i] >> shift) & (g_RADIX_SIZE - 1)];
+                               });
+            }
+
+            size_t slot    = 0;
+            bool   uniform = false;
+            for (int digit = 0; digit < g_RADIX_SIZE; ++digit)
+            {
+                size_t digitCount = 0;
+                for (size_t slice = 0; slice < slices; ++slice)
+                {
+                    size_t n                            = slots[slice * g_RADIX_SIZE + digit];
+                    slots[slice * g_RADIX_SIZE + digit] = slot;
+                    slot += n;
+                    digitCount += n;
+                }
+                uniform = uniform || digitCount == count;
+            }
+            // Every key has the same digit, the pass would copy the arrays unchanged.
+            if (uniform)
+                continue;
+
+            RadixForSlices(pool, slices, count,
+                           [&](size_t slice, size_t first, size_t last)
+                           {
+                               size_t* sliceSlots = slots + slice * g_RADIX_SIZE;
+                               if (buffer && srcValues)
+                                   RadixScatterBuffered<Bits, true>(srcKeys, srcValues, first, last, shift, sliceSlots, dstKeys, dstValues, &m_Buffers[slice * g_RADIX_BUFFER_BYTES]);
+                               else if (buffer)
+                                   RadixScatterBuffered<Bits, false>(srcKeys, srcValues, first, last, shift, sliceSlots, dstKeys, dstValues, &m_Buffers[slice * g_RADIX_BUFFER_BYTES]);
+                               else if (srcValues)
+                                   RadixScatter<Bits, true>(srcKeys, srcValues, first, last, shift, sliceSlots, dstKeys, dstValues);
+                               else
+                                   RadixScatter<Bits, false>(srcKeys, srcValues, first, last, shift, sliceSlots, dstKeys, dstValues);
+                           });
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcValues, dstValues);
+        }
+
+        values = srcValues;
+        return srcKeys;
+    }
+
+    template <typename Bits>
+    inline Bits* RadixSorter::KeyScratch(int which, size_t count)
+    {
+        // Cleared first, growing would copy the old contents.
+        m_Keys[which].Clear();
+        m_Keys[which].Resize(count * sizeof(Bits));
+        return reinterpret_cast<Bits*>(m_Keys[which].Data());
+    }
+
+    inline unsigned int* RadixSorter::ValueScratch(size_t count)
+    {
+        m_Values.Clear();
+        m_Values.Resize(count);
+        return m_Values.Data();
+    }
+} // namespace DropMath
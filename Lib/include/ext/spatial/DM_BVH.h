@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../geom/DM_Intersect.h"
+#include "../thread/DM_ThreadPool.h"
+
+namespace DropMath
+{
+    // Binary node, 32 bytes. Children are allocated in pairs starting at an even index, so two siblings fill one
+    // 64 byte cache line.
+    struct BVHNode
+    {
+        float        min[3];
+        unsigned int leftFirst; // Left child index (the right child is leftFirst + 1), or first index of a leaf.
+        float        max[3];
+        unsigned int count; // Primitive count of a leaf, 0 for an inner node.
+
+        bool IsLeaf() const { return count != 0; }
+        AABB Bounds() const { return AABB(Vec3(min[0], min[1], min[2]), Vec3(max[0], max[1], max[2])); }
+    };
+
+    // 4-wide node, 128 bytes (two cache lines). Child bounds are stored SoA so one SSE op tests all 4 children.
+    struct alignas(16) BVH4Node
+    {
+        float minX[4], minY[4], minZ[4];
+        float maxX[4], maxY[4], maxZ[4];
+        int   child[4]; // Wide node index of an inner child, first index of a leaf child.
+        int   count[4]; // Primitive count of a leaf child, 0 for an inner child, -1 for an empty slot.
+    };
+
+    static_assert(sizeof(BVHNode) == 32, "BVHNode must stay 32 bytes.");
+    static_assert(sizeof(BVH4Node) == 128, "BVH4Node must stay 128 bytes.");
+
+    struct BVHBuildSettings
+    {
+        BVHBuildSettings() : maxLeafSize(4), binCount(16), traversalCost(1.0f), parallelThreshold(4096), pool(nullptr) { }
+
+        int         maxLeafSize;       // Leaves never hold more primitives than this.
+        int         binCount;          // SAH bins per axis, at most 32.
+        float       traversalCost;     // Cost of visiting a node relative to testing one primitive.
+        size_t      parallelThreshold; // Subtrees with more primitives are built as separate tasks.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Bounding volume hierarchy built with binned SAH. The binary tree is collapsed into a 4-wide tree that all
+    // queries traverse with SSE, 4 child boxes per step. Queries report primitive indices, the caller does the exact test.
+    class BVH
+    {
+    public:
+        BVH() { }
+
+        // Build over count boxes. Primitive i is boxes[i].
+        void Build(const AABB* boxes, size_t count, const BVHBuildSettings& settings = BVHBuildSettings());
+        // Build over triangleCount triangles of vertices, 3 indices per triangle. Primitive i is triangle i.
+        void Build(const Vec3* vertices, const unsigned int* indices, size_t triangleCount,
+                   const BVHBuildSettings& settings = BVHBuildSettings());
+
+        void Clear();
+
+        bool   IsEmpty() const { return m_Indices.Empty(); }
+        size_t PrimitiveCount() const { return m_Indices.Size(); }
+        // Bounds of every primitive.
+        AABB Bounds() const { return m_Nodes.Empty() ? AABB() : m_Nodes[0].Bounds(); }
+
+        // Binary nodes, node 0 is the root and node 1 is padding so sibling pairs stay cache line aligned.
+        const BVHNode* Nodes() const { return m_Nodes.Data(); }
+        size_t         NodeCount() const { return m_Nodes.Size(); }
+        // 4-wide nodes, node 0 is the root.
+        const BVH4Node* WideNodes() const { return m_WideNodes.Data(); }
+        size_t          WideNodeCount() const { return m_WideNodes.Size(); }
+        // Leaf order of the primitives: a leaf holds primitives Indices()[first, first + count).
+        const unsigned int* Indices() const { return m_Indices.Data(); }
+
+        // Call hit(primitive, tMax) for every primitive whose box the ray origin + t * direction enters at t <= tMax,
+        // nearest boxes first. hit returns true and lowers tMax when it finds a closer intersection, which culls the
+        // boxes behind it. Return true if any primitive was hit, tMax then holds the nearest distance.
+        template <typename Hit>
+        bool Raycast(const Vec3& origin, const Vec3& direction, float& tMax, Hit hit) const;
+
+        // Call fn(primitive) for every primitive whose box overlaps box.
+        template <typename Fn>
+        void QueryAABB(const AABB& box, Fn fn) const;
+
+        // Call fn(primitive) for every primitive whose box is within radius of center.
+        template <typename Fn>
+        void QuerySphere(const Vec3& center, float radius, Fn fn) const;
+
+    private:
+        struct BuildContext;
+
+        void BuildNode(BuildContext& context, unsigned int node, unsigned int first, unsigned int count, int depth);
+        int  Collapse(unsigned int node);
+
+        AlignedArray<BVHNode>      m_Nodes;
+        AlignedArray<BVH4Node>     m_WideNodes;
+        AlignedArray<unsigned int> m_Indices;
+        AlignedArray<AABB>         m_Boxes; // Primitive boxes in leaf order.
+    };
+} // namespace DropMath
+
+#include "DM_BVH.inl"
@@ -0,0 +1,444 @@
+#include <algorithm>
+
+namespace DropMath
+{
+    namespace
+    {
+        const int g_BVH_MAX_BINS  = 32;
+        const int g_BVH_SAH_DEPTH = 48;  // Deeper subtrees switch to median splits, which bounds the tree depth.
+        const int g_BVH_STACK     = 512; // Traversal stack, enough for any tree the depth limit allows.
+
+        struct BVHBin
+        {
+            AABB         bounds;
+            unsigned int count;
+        };
+
+        struct BVHStackEntry
+        {
+            int   child;
+            int   count;
+            float t;
+        };
+
+        inline void SetWideSlot(BVH4Node& wide, int slot, const AABB& bounds, int child, int count)
+        {
+            wide.minX[slot]  = bounds.min.x;
+            wide.minY[slot]  = bounds.min.y;
+            wide.minZ[slot]  = bounds.min.z;
+            wide.maxX[slot]  = bounds.max.x;
+            wide.maxY[slot]  = bounds.max.y;
+            wide.maxZ[slot]  = bounds.max.z;
+            wide.child[slot] = child;
+            wide.count[slot] = count;
+        }
+    } // anonymous namespace
+
+    struct BVH::BuildContext
+    {
+        BuildContext(const AABB* boxes, const BVHBuildSettings& settings, ThreadPool& pool)
+            : boxes(boxes), settings(settings), group(pool), nodeCount(2) { }
+
+        const AABB*               boxes;
+        AlignedArray<Vec3>        centroids;
+        const BVHBuildSettings&   settings;
+        TaskGroup                 group;
+        std::atomic<unsigned int> nodeCount;
+    };
+
+    inline void BVH::Build(const AABB* boxes, size_t count, const BVHBuildSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_BVH_BUILD, count);
+        Clear();
+        if (count == 0)
+            return;
+
+        ThreadPool&  pool = settings.pool ? *settings.pool : ThreadPool::Default();
+        BuildContext context(boxes, settings, pool);
+
+        m_Indices.Resize(count);
+        context.centroids.Resize(count);
+        pool.ParallelFor(0, count, 16384,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 m_Indices[i]          = (unsigned int) i;
+                                 context.centroids[i] = boxes[i].Center();
+                             }
+                         });
+
+        // A binary tree over n primitives has at most 2n - 1 nodes, plus the padding node.
+        m_Nodes.Resize(2 * count + 1);
+        BuildNode(context, 0, 0, (unsigned int) count, 0);
+        context.group.Wait();
+        m_Nodes.Resize(context.nodeCount.load());
+        m_Nodes[1] = m_Nodes[0]; // Padding, never visited.
+
+        m_Boxes.Resize(count);
+        pool.ParallelFor(0, count, 16384,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                                 m_Boxes[i] = boxes[m_Indices[i]];
+                         });
+
+        m_WideNodes.Reserve(m_Nodes.Size() / 2 + 1);
+        Collapse(0);
+    }
+
+    inline void BVH::Build(const Vec3* vertices, const unsigned int* indices, size_t triangleCount, const BVHBuildSettings& settings)
+    {
+        ThreadPool&        pool = settings.pool ? *settings.pool : ThreadPool::Default();
+        AlignedArray<AABB> boxes(triangleCount);
+        pool.ParallelFor(0, triangleCount, 16384,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 AABB box;
+                                 box.Expand(vertices[indices[i * 3 + 0]]);
+                                 box.Expand(vertices[indices[i * 3 + 1]]);
+                                 box.Expand(vertices[indices[i * 3 + 2]]);
+                                 boxes[i] = box;
+                             }
+                         });
+        Build(boxes.Data(), triangleCount, settings);
+    }
+
+    inline void BVH::Clear()
+    {
+        m_Nodes.Clear();
+        m_WideNodes.Clear();
+        m_Indices.Clear();
+        m_Boxes.Clear();
+    }
+
+    inline void BVH::BuildNode(BuildContext& context, unsigned int nodeIndex, unsigned int first, unsigned int count, int depth)
+    {
+        const BVHBuildSettings& settings = context.settings;
+        const int               binCount = Clamp(settings.binCount, 2, g_BVH_MAX_BINS);
+
+        // Loop on the right child instead of recursing so only left children grow the call stack.
+        for (;;)
+        {
+            AABB bounds, centroidBounds;
+            for (unsigned int i = first; i < first + count; ++i)
+            {
+                bounds.Expand(context.boxes[m_Indices[i]]);
+                centroidBounds.Expand(context.centroids[m_Indices[i]]);
+            }
+
+            BVHNode& node = m_Nodes[nodeIndex];
+            bounds.min.Store(node.min);
+            bounds.max.Store(node.max);
+            node.leftFirst = first;
+            node.count     = count;
+            if (count <= 1)
+                return;
+
+            // Binned SAH over the centroid bounds of every axis at once.
+            Vec3   extent = centroidBounds.Extent();
+            BVHBin bins[3][g_BVH_MAX_BINS];
+            for (int axis = 0; axis < 3; ++axis)
+                for (int b = 0; b < binCount; ++b)
+                    bins[axis][b] = BVHBin {AABB(), 0};
+
+            float scale[3];
+            for (int axis = 0; axis < 3; ++axis)
+                scale[axis] = extent[axis] > 0.0f ? (float) binCount / extent[axis] : 0.0f;
+
+            if (depth < g_BVH_SAH_DEPTH)
+            {
+                for (unsigned int i = first; i < first + count; ++i)
+                {
+                    const Vec3& c = context.centroids[m_Indices[i]];
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        int b = Min((int) ((c[axis] - centroidBounds.min[axis]) * scale[axis]), binCount - 1);
+                        bins[axis][b].bounds.Expand(context.boxes[m_Indices[i]]);
+                        ++bins[axis][b].count;
+                    }
+                }
+            }
+
+            float bestCost = DM_INFINITY_F;
+            int   bestAxis = -1;
+            int   bestBin  = 0;
+            for (int axis = 0; axis < 3 && depth < g_BVH_SAH_DEPTH; ++axis)
+            {
+                if (scale[axis] == 0.0f)
+                    continue;
+
+                // Right to left sweep keeps the area and count of every right side, left to right sweep finishes the cost.
+                float        rightArea[g_BVH_MAX_BINS];
+                unsigned int rightCount[g_BVH_MAX_BINS];
+                AABB         right;
+                unsigned int rightSum = 0;
+                for (int b = binCount - 1; b > 0; --b)
+                {
+                    right.Expand(bins[axis][b].bounds);
+                    rightSum += bins[axis][b].count;
+                    rightArea[b]  = right.SurfaceArea();
+                    rightCount[b] = rightSum;
+                }
+
+                AABB         left;
+                unsigned int leftSum = 0;
+                for (int b = 1; b < binCount; ++b)
+                {
+                    left.Expand(bins[axis][b - 1].bounds);
+                    leftSum += bins[axis][b - 1].count;
+                    if (leftSum == 0 || rightCount[b] == 0)
+                        continue;
+                    float cost = left.SurfaceArea() * (float) leftSum + rightArea[b] * (float) rightCount[b];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin  = b;
+                    }
+                }
+            }
+
+            float area     = bounds.SurfaceArea();
+            float leafCost = (float) count;
+            float cost     = area > 0.0f ? settings.traversalCost + bestCost / area : DM_INFINITY_F;
+            if (count <= (unsigned int) settings.maxLeafSize && cost >= leafCost)
+                return;
+
+            unsigned int* begin = m_Indices.Data() + first;
+            unsigned int* end   = begin + count;
+            unsigned int* mid   = begin;
+            if (bestAxis >= 0)
+            {
+                int            axis   = bestAxis;
+                float          origin = centroidBounds.min[axis];
+                float          s      = scale[axis];
+                const Vec3*    c      = context.centroids.Data();
+                mid = std::partition(begin, end,
+                                     [&](unsigned int p) { return Min((int) ((c[p][axis] - origin) * s), binCount - 1) < bestBin; });
+            }
+            if (mid == begin || mid == end)
+            {
+                // No SAH split (too deep, or every centroid in one bin): object median on the widest centroid axis.
+                int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+                mid      = begin + count / 2;
+                const Vec3* c = context.centroids.Data();
+                std::nth_element(begin, mid, end, [&](unsigned int a, unsigned int b) { return c[a][axis] < c[b][axis]; });
+            }
+
+            unsigned int leftCount = (unsigned int) (mid - begin);
+            unsigned int left      = context.nodeCount.fetch_add(2);
+            node.leftFirst         = left;
+            node.count             = 0;
+
+            if (leftCount > settings.parallelThreshold)
+            {
+                int childDepth = depth + 1;
+                context.group.Run([this, &context, left, first, leftCount, childDepth]()
+                                  { BuildNode(context, left, first, leftCount, childDepth); });
+            }
+            else
+            {
+                BuildNode(context, left, first, leftCount, depth + 1);
+            }
+
+            nodeIndex = left + 1;
+            first += leftCount;
+            count -= leftCount;
+            ++depth;
+        }
+    }
+
+    inline int BVH::Collapse(unsigned int nodeIndex)
+    {
+        // Open the inner child with the largest surface area until there are 4 children or only leaves.
+        unsigned int children[4] = {nodeIndex};
+        int          childCount  = 1;
+        while (childCount < 4)
+        {
+            int   open     = -1;
+            float openArea = -1.0f;
+            for (int i = 0; i < childCount; ++i)
+            {
+                const BVHNode& child = m_Nodes[children[i]];
+                float          area  = child.Bounds().SurfaceArea();
+                if (!child.IsLeaf() && area > openArea)
+                {
+                    open     = i;
+                    openArea = area;
+                }
+            }
+            if (open < 0)
+                break;
+            unsigned int left        = m_Nodes[children[open]].leftFirst;
+            children[open]           = left;
+            children[childCount++]   = left + 1;
+        }
+
+        int      wideIndex = (int) m_WideNodes.Size();
+        BVH4Node wide;
+        for (int i = 0; i < 4; ++i)
+            SetWideSlot(wide, i, AABB(), 0, -1);
+        m_WideNodes.PushBack(wide);
+
+        for (int i = 0; i < childCount; ++i)
+        {
+            const BVHNode& child = m_Nodes[children[i]];
+            if (child.IsLeaf())
+                SetWideSlot(wide, i, child.Bounds(), (int) child.leftFirst, (int) child.count);
+            else
+                SetWideSlot(wide, i, child.Bounds(), Collapse(children[i]), 0);
+        }
+        m_WideNodes[wideIndex] = wide;
+        return wideIndex;
+    }
+
+    template <typename Hit>
+    inline bool BVH::Raycast(const Vec3& origin, const Vec3& direction, float& tMax, Hit hit) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_BVH_RAYCAST, 1);
+        if (m_WideNodes.Empty())
+            return false;
+
+        const Vec3x4 o(origin);
+        const Vec3x4 invDirection(Vec3(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z));
+
+        BVHStackEntry stack[g_BVH_STACK];
+        int           top = 0;
+        stack[top++]      = BVHStackEntry {0, 0, 0.0f};
+
+        bool anyHit = false;
+        while (top > 0)
+        {
+            BVHStackEntry entry = stack[--top];
+            if (entry.t > tMax)
+                continue;
+
+            if (entry.count > 0)
+            {
+                for (int i = entry.child; i < entry.child + entry.count; ++i)
+                    anyHit |= hit(m_Indices[i], tMax);
+                continue;
+            }
+
+            // Slab test of the 4 children, with the kernel of IntersectRayAABB4 so every node isn't profiled as a call.
+            const BVH4Node& node = m_WideNodes[entry.child];
+            float4          enter;
+            int             mask = RayAABB4(o, invDirection, Vec3x4(_mm_load_ps(node.minX), _mm_load_ps(node.minY), _mm_load_ps(node.minZ)),
+                                            Vec3x4(_mm_load_ps(node.maxX), _mm_load_ps(node.maxY), _mm_load_ps(node.maxZ)), _mm_set1_ps(tMax),
+                                            enter);
+            if (mask == 0)
+                continue;
+
+            alignas(16) float t[4];
+            _mm_store_ps(t, enter);
+
+            // Push far to near so the nearest child is popped first.
+            int base = top;
+            for (int i = 0; i < 4; ++i)
+            {
+                if (!(mask & (1 << i)) || node.count[i] < 0)
+                    continue;
+                BVHStackEntry child = {node.child[i], node.count[i], t[i]};
+                int           j     = top++;
+                for (; j > base && stack[j - 1].t < child.t; --j)
+                    stack[j] = stack[j - 1];
+                stack[j] = child;
+            }
+        }
+        return anyHit;
+    }
+
+    template <typename Fn>
+    inline void BVH::QueryAABB(const AABB& box, Fn fn) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_BVH_QUERY_AABB, 1);
+        if (m_WideNodes.Empty())
+            return;
+
+        const float4 minX = _mm_set1_ps(box.min.x);
+        const float4 minY = _mm_set1_ps(box.min.y);
+        const float4 minZ = _mm_set1_ps(box.min.z);
+        const float4 maxX = _mm_set1_ps(box.max.x);
+        const float4 maxY = _mm_set1_ps(box.max.y);
+        const float4 maxZ = _mm_set1_ps(box.max.z);
+
+        int stack[g_BVH_STACK];
+        int top      = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const BVH4Node& node = m_WideNodes[stack[--top]];
+            float4 overlap = _mm_and_ps(_mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minX), maxX), _mm_cmpge_ps(_mm_load_ps(node.maxX), minX)),
+                                        _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minY), maxY), _mm_cmpge_ps(_mm_load_ps(node.maxY), minY)));
+            overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_load_ps(node.minZ), maxZ), _mm_cmpge_ps(_mm_load_ps(node.maxZ), minZ)));
+            int mask = _mm_movemask_ps(overlap);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                if (!(mask & (1 << i)))
+                    continue;
+                if (node.count[i] == 0)
+                {
+                    stack[top++] = node.child[i];
+                    continue;
+                }
+                for (int p = node.child[i]; p < node.child[i] + node.count[i]; ++p)
+                    if (m_Boxes[p].Overlaps(box))
+                        fn(m_Indices[p]);
+            }
+        }
+    }
+
+    template <typename Fn>
+    inline void BVH::QuerySphere(const Vec3& center, float radius, Fn fn) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_BVH_QUERY_SPHERE, 1);
+        if (m_WideNodes.Empty())
+            return;
+
+        const float4 cx      = _mm_set1_ps(center.x);
+        const float4 cy      = _mm_set1_ps(center.y);
+        const float4 cz      = _mm_set1_ps(center.z);
+        const float4 zero    = _mm_setzero_ps();
+        const float4 radius2 = _mm_set1_ps(radius * radius);
+        const float  r2      = radius * radius;
+
+        int stack[g_BVH_STACK];
+        int top      = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const BVH4Node& node = m_WideNodes[stack[--top]];
+
+            // Distance from the center to each box: per axis, how far the center is outside the slab.
+            float4 dx   = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minX), cx), zero), _mm_max_ps(_mm_sub_ps(cx, _mm_load_ps(node.maxX)), zero));
+            float4 dy   = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minY), cy), zero), _mm_max_ps(_mm_sub_ps(cy, _mm_load_ps(node.maxY)), zero));
+            float4 dz   = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_load_ps(node.minZ), cz), zero), _mm_max_ps(_mm_sub_ps(cz, _mm_load_ps(node.maxZ)), zero));
+            float4 d2   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            int    mask = _mm_movemask_ps(_mm_cmple_ps(d2, radius2));
+
+            for (int i = 0; i < 4; ++i)
+            {
+                if (!(mask & (1 << i)))
+                    continue;
+                if (node.count[i] == 0)
+                {
+                    stack[top++] = node.child[i];
+                    continue;
+                }
+                for (int p = node.child[i]; p < node.child[i] + node.count[i]; ++p)
+                {
+                    const AABB& b = m_Boxes[p];
+                    float       x = Max(Max(b.min.x - center.x, center.x - b.max.x), 0.0f);
+                    float       y = Max(Max(b.min.y - center.y, center.y - b.max.y), 0.0f);
+                    float       z = Max(Max(b.min.z - center.z, center.z - b.max.z), 0.0f);
+                    if (x * x + y * y + z * z <= r2)
+                        fn(m_Indices[p]);
+                }
+            }
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../geom/DM_AABB.h"
+#include "../thread/DM_ThreadPool.h"
+#include "DM_Neighbors.h"
+
+namespace DropMath
+{
+    struct HashGridSettings
+    {
+        HashGridSettings() : maxSlack(0.5f), parallelThreshold(16384), pool(nullptr) { }
+
+        float       maxSlack;          // How far (in cells) Update lets a point drift out of its cell before it re-bins everything.
+        size_t      parallelThreshold; // Smaller point sets are built on the calling thread only.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Uniform grid over a Vec3 point set, hashed into one bucket per point (rounded up to a power of two) so the
+    // memory does not depend on the extent of the points. Build counting-sorts the points by bucket in parallel and
+    // keeps them in that order as SoA streams, so the points of a cell are contiguous and queries test 4 at a time.
+    // Cell coordinates must stay within +-2^20 cells of the origin.
+    class HashGrid
+    {
+    public:
+        HashGrid() : m_CellSize(1.0f), m_InvCellSize(1.0f), m_Slack(0.0f) { }
+
+        // Build over count points. Point i is points[i]. A cell size around the typical query radius works best.
+        void Build(const Vec3* points, size_t count, float cellSize, const HashGridSettings& settings = HashGridSettings());
+
+        // Move the points in place. points has the Build count and order. Points keep their cell as long as they
+        // stay within settings.maxSlack cells of it, which only widens the cells queries visit; past that the grid
+        // is rebuilt. Return true if it was rebuilt.
+        bool Update(const Vec3* points);
+
+        void Clear();
+
+        bool   IsEmpty() const { return m_Indices.Empty(); }
+        size_t Count() const { return m_Indices.Size(); }
+        float  CellSize() const { return m_CellSize; }
+        // Largest distance any point sits outside its cell since the last Build.
+        float Slack() const { return m_Slack; }
+
+        // Point positions in cell order. Slot i holds point Indices()[i].
+        const float*        X() const { return m_X.Data(); }
+        const float*        Y() const { return m_Y.Data(); }
+        const float*        Z() const { return m_Z.Data(); }
+        const unsigned int* Indices() const { return m_Indices.Data(); }
+
+        // Call fn(point, distanceSquared) for every point within radius of center, in no particular order.
+        template <typename Fn>
+        void QueryRadius(const Vec3& center, float radius, Fn fn) const;
+
+        // Find the k points nearest to center within maxRadius. Write their indices and squared distances nearest
+        // first and return how many were found (less than k if the grid holds fewer points in range).
+        size_t QueryKNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared,
+                             float maxRadius = DM_INFINITY_F) const;
+
+    private:
+        // Call fn(point, distanceSquared) for the points of cell (x, y, z) within sqrt(radius2) of center.
+        template <typename Fn>
+        void ScanCell(int x, int y, int z, const Vec3& center, const float& radius2, Fn fn) const;
+
+        unsigned int Bucket(int x, int y, int z) const;
+
+        float            m_CellSize;
+        float            m_InvCellSize;
+        float            m_Slack;
+        int              m_CellMin[3];
+        int              m_CellMax[3];
+        HashGridSettings m_Settings;
+
+        AlignedArray<unsigned int>       m_CellStart; // Bucket b holds slots [m_CellStart[b], m_CellStart[b + 1]).
+        AlignedArray<float>              m_X;         // Padded with 3 NaN so the last bucket can be read 4 wide.
+        AlignedArray<float>              m_Y;
+        AlignedArray<float>              m_Z;
+        AlignedArray<unsigned long long> m_Keys; // Cell of every slot, buckets can hold several cells.
+        AlignedArray<unsigned int>       m_Indices;
+    };
+} // namespace DropMath
+
+#include "DM_HashGrid.inl"
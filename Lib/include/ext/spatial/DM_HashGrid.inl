@@ -0,0 +1,372 @@
+#include <climits>
+#include <cstring>
+#include <limits>
+
+namespace DropMath
+{
+    namespace
+    {
+        const int                g_GRID_KEY_BITS    = 21;
+        const int                g_GRID_KEY_OFFSET  = 1 << (g_GRID_KEY_BITS - 1);
+        const unsigned long long g_GRID_KEY_MASK    = (1ull << g_GRID_KEY_BITS) - 1;
+        const float              g_GRID_COORD_MAX   = 1073741824.0f; // Clamp before Floor so huge query extents stay in int range.
+        const size_t             g_GRID_GRAIN       = 4096;
+        const size_t             g_GRID_RADIX       = 1024; // Bucket ranges of the parallel build, counted per chunk.
+        const size_t             g_GRID_RANGE_GRAIN = 16;
+
+        inline int GridCoordinate(float v, float invCellSize) { return Floor(Clamp(v * invCellSize, -g_GRID_COORD_MAX, g_GRID_COORD_MAX)); }
+
+        inline unsigned long long GridKey(int x, int y, int z)
+        {
+            return ((unsigned long long) (x + g_GRID_KEY_OFFSET) & g_GRID_KEY_MASK) << (2 * g_GRID_KEY_BITS) |
+                   ((unsigned long long) (y + g_GRID_KEY_OFFSET) & g_GRID_KEY_MASK) << g_GRID_KEY_BITS |
+                   ((unsigned long long) (z + g_GRID_KEY_OFFSET) & g_GRID_KEY_MASK);
+        }
+
+        inline int GridKeyCoordinate(unsigned long long key, int axis)
+        {
+            return (int) ((key >> ((2 - axis) * g_GRID_KEY_BITS)) & g_GRID_KEY_MASK) - g_GRID_KEY_OFFSET;
+        }
+
+        // How far v lies outside [cell, cell + 1) * cellSize.
+        inline float GridOutside(float v, int cell, float cellSize)
+        {
+            float lo = (float) cell * cellSize;
+            return Max(Max(lo - v, v - (lo + cellSize)), 0.0f);
+        }
+    } // anonymous namespace
+
+    inline void HashGrid::Build(const Vec3* points, size_t count, float cellSize, const HashGridSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_HASH_GRID_BUILD, count);
+        assert(cellSize > 0.0f && "HashGrid cell size must be positive");
+        HashGridSettings copy = settings; // settings may be m_Settings when Update rebuilds.
+        Clear();
+        m_Settings    = copy;
+        m_CellSize    = cellSize;
+        m_InvCellSize = 1.0f / cellSize;
+        if (count == 0)
+            return;
+
+        ThreadPool& pool      = m_Settings.pool ? *m_Settings.pool : ThreadPool::Default();
+        size_t      tableSize = 1;
+        while (tableSize < count)
+            tableSize <<= 1;
+        m_CellStart.Resize(tableSize + 1);
+
+        // Parallel two level counting sort. Every chunk of points counts how many of its points fall in every range of
+        // g_GRID_RADIX buckets, into its own row of counts, and scatters its point indices by range. Then every range
+        // counting sorts its points into its buckets, which no other range touches. counts[c * ranges + r] is the
+        // count (later the next slot) of chunk c in range r, chunk c covers points [count * c / chunks,
+        // count * (c + 1) / chunks) and range r buckets [r << rangeShift, (r + 1) << rangeShift). The memory is
+        // bounded by the radix rather than the table and a bucket keeps its points in index order.
+        const size_t chunks     = count < m_Settings.parallelThreshold ? 1 : (size_t) pool.ThreadCount();
+        const size_t ranges     = chunks == 1 ? 1 : Min(tableSize, g_GRID_RADIX);
+        int          rangeShift = 0;
+        while (((size_t) 1 << rangeShift) * ranges < tableSize)
+            ++rangeShift;
+
+        AlignedArray<unsigned int>       counts(chunks * ranges);
+        AlignedArray<unsigned int>       buckets(count);
+        AlignedArray<unsigned int>       order(count);
+        AlignedArray<unsigned long long> keys(count);
+        AlignedArray<int>                chunkBounds(chunks * 6);
+        AlignedArray<unsigned int>       rangeStart(ranges + 1);
+
+        pool.ParallelFor(0, chunks, 1,
+                         [&](size_t firstChunk, size_t lastChunk)
+                         {
+                             for (size_t c = firstChunk; c < lastChunk; ++c)
+                             {
+                                 unsigned int* row = counts.Data() + c * ranges;
+                                 std::memset(row, 0, ranges * sizeof(unsigned int));
+
+                                 int* bounds = chunkBounds.Data() + c * 6;
+                                 bounds[0] = bounds[1] = bounds[2] = INT_MAX;
+                                 bounds[3] = bounds[4] = bounds[5] = INT_MIN;
+                                 for (size_t i = count * c / chunks; i < count * (c + 1) / chunks; ++i)
+                                 {
+                                     int cell[3] = { GridCoordinate(points[i].x, m_InvCellSize), GridCoordinate(points[i].y, m_InvCellSize),
+                                                     GridCoordinate(points[i].z, m_InvCellSize) };
+                                     keys[i]     = GridKey(cell[0], cell[1], cell[2]);
+                                     buckets[i]  = Bucket(cell[0], cell[1], cell[2]);
+                                     ++row[buckets[i] >> rangeShift];
+                                     for (int a = 0; a < 3; ++a)
+                                     {
+                                         bounds[a]     = Min(bounds[a], cell[a]);
+                                         bounds[a + 3] = Max(bounds[a + 3], cell[a]);
+                                     }
+                                 }
+                             }
+                         });
+
+        for (int a = 0; a < 3; ++a)
+        {
+            m_CellMin[a] = INT_MAX;
+            m_CellMax[a] = INT_MIN;
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                m_CellMin[a] = Min(m_CellMin[a], chunkBounds[c * 6 + a]);
+                m_CellMax[a] = Max(m_CellMax[a], chunkBounds[c * 6 + a + 3]);
+            }
+        }
+
+        unsigned int next = 0;
+        for (size_t r = 0; r < ranges; ++r)
+        {
+            rangeStart[r] = next;
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                unsigned int n         = counts[c * ranges + r];
+                counts[c * ranges + r] = next;
+                next += n;
+            }
+        }
+        rangeStart[ranges] = next;
+
+        pool.ParallelFor(0, chunks, 1,
+                         [&](size_t firstChunk, size_t lastChunk)
+                         {
+                             for (size_t c = firstChunk; c < lastChunk; ++c)
+                             {
+                                 unsigned int* row = counts.Data() + c * ranges;
+                                 for (size_t i = count * c / chunks; i < count * (c + 1) / chunks; ++i)
+                                     order[row[buckets[i] >> rangeShift]++] = (unsigned int) i;
+                             }
+                         });
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        m_X.Resize(count + 3);
+        m_Y.Resize(count + 3);
+        m_Z.Resize(count + 3);
+        for (size_t i = count; i < count + 3; ++i)
+            m_X[i] = m_Y[i] = m_Z[i] = nan;
+        m_Keys.Resize(count);
+        m_Indices.Resize(count);
+
+        // m_CellStart[b] counts bucket b, then holds its end and is decremented to its start by the backward scatter.
+        pool.ParallelFor(0, ranges, chunks == 1 ? ranges : g_GRID_RANGE_GRAIN,
+                         [&](size_t firstRange, size_t lastRange)
+                         {
+                             for (size_t r = firstRange; r < lastRange; ++r)
+                             {
+                                 const size_t firstBucket = r << rangeShift, lastBucket = (r + 1) << rangeShift;
+                                 for (size_t b = firstBucket; b < lastBucket; ++b)
+                                     m_CellStart[b] = 0;
+                                 for (unsigned int j = rangeStart[r]; j < rangeStart[r + 1]; ++j)
+                                     ++m_CellStart[buckets[order[j]]];
+                                 unsigned int end = rangeStart[r];
+                                 for (size_t b = firstBucket; b < lastBucket; ++b)
+                                 {
+                                     end += m_CellStart[b];
+                                     m_CellStart[b] = end;
+                                 }
+                                 for (unsigned int j = rangeStart[r + 1]; j-- > rangeStart[r];)
+                                 {
+                                     const unsigned int i    = order[j];
+                                     const unsigned int slot = --m_CellStart[buckets[i]];
+                                     m_X[slot]               = points[i].x;
+                                     m_Y[slot]               = points[i].y;
+                                     m_Z[slot]               = points[i].z;
+                                     m_Keys[slot]            = keys[i];
+                                     m_Indices[slot]         = i;
+                                 }
+                             }
+                         });
+        m_CellStart[tableSize] = (unsigned int) count;
+    }
+
+    inline bool HashGrid::Update(const Vec3* points)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_HASH_GRID_UPDATE, Count());
+        if (IsEmpty())
+            return false;
+
+        ThreadPool& pool  = m_Settings.pool ? *m_Settings.pool : ThreadPool::Default();
+        size_t      count = Count();
+
+        // Non-negative floats order like their bit patterns, so the largest slack can be kept in an atomic uint.
+        std::atomic<unsigned int> slackBits(0);
+        pool.ParallelFor(0, count, count < m_Settings.parallelThreshold ? count : g_GRID_GRAIN,
+                         [&](size_t first, size_t last)
+                         {
+                             float slack = 0.0f;
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 const Vec3& p = points[m_Indices[i]];
+                                 m_X[i]        = p.x;
+                                 m_Y[i]        = p.y;
+                                 m_Z[i]        = p.z;
+                                 slack         = Max(slack, GridOutside(p.x, GridKeyCoordinate(m_Keys[i], 0), m_CellSize));
+                                 slack         = Max(slack, GridOutside(p.y, GridKeyCoordinate(m_Keys[i], 1), m_CellSize));
+                                 slack         = Max(slack, GridOutside(p.z, GridKeyCoordinate(m_Keys[i], 2), m_CellSize));
+                             }
+                             unsigned int bits;
+                             std::memcpy(&bits, &slack, sizeof(bits));
+                             unsigned int current = slackBits.load();
+                             while (bits > current && !slackBits.compare_exchange_weak(current, bits)) { }
+                         });
+
+        unsigned int bits = slackBits.load();
+        std::memcpy(&m_Slack, &bits, sizeof(bits));
+        if (m_Slack <= m_Settings.maxSlack * m_CellSize)
+            return false;
+
+        // Past the slack the refit failed and the grid is rebuilt.
+        DM_PROFILE_FAILURE(PROFILE_OP_HASH_GRID_UPDATE);
+        Build(points, count, m_CellSize, m_Settings);
+        return true;
+    }
+
+    inline void HashGrid::Clear()
+    {
+        m_CellStart.Clear();
+        m_X.Clear();
+        m_Y.Clear();
+        m_Z.Clear();
+        m_Keys.Clear();
+        m_Indices.Clear();
+        m_Slack = 0.0f;
+        for (int a = 0; a < 3; ++a)
+            m_CellMin[a] = m_CellMax[a] = 0;
+    }
+
+    inline unsigned int HashGrid::Bucket(int x, int y, int z) const
+    {
+        unsigned int hash = ((unsigned int) x * 73856093u) ^ ((unsigned int) y * 19349663u) ^ ((unsigned int) z * 83492791u);
+        return hash & (unsigned int) (m_CellStart.Size() - 2);
+    }
+
+    template <typename Fn>
+    inline void HashGrid::ScanCell(int x, int y, int z, const Vec3& center, const float& radius2, Fn fn) const
+    {
+        unsigned int       b   = Bucket(x, y, z);
+        unsigned long long key = GridKey(x, y, z);
+        ScanPoints4(m_X.Data(), m_Y.Data(), m_Z.Data(), m_CellStart[b], m_CellStart[b + 1], center, radius2,
+                    [&](size_t slot, float d2)
+                    {
+                        // A bucket can hold several cells, only report the points of the visited one.
+                        if (m_Keys[slot] == key)
+                            fn(m_Indices[slot], d2);
+                    });
+    }
+
+    template <typename Fn>
+    inline void HashGrid::QueryRadius(const Vec3& center, float radius, Fn fn) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_HASH_GRID_QUERY_RADIUS, 1);
+        if (IsEmpty() || !(radius >= 0.0f))
+            return;
+
+        // Points sit up to m_Slack outside their cell, so the cells within radius + slack can hold a hit.
+        const float radius2 = radius * radius;
+        const float extent  = radius + m_Slack;
+        int         lo[3], hi[3];
+        double      cells = 1.0;
+        for (int a = 0; a < 3; ++a)
+        {
+            lo[a] = Max(GridCoordinate(center[a] - extent, m_InvCellSize), m_CellMin[a]);
+            hi[a] = Min(GridCoordinate(center[a] + extent, m_InvCellSize), m_CellMax[a]);
+            if (lo[a] > hi[a])
+                return;
+            cells *= (double) (hi[a] - lo[a] + 1);
+        }
+
+        // Visiting more cells than there are buckets costs more than testing every point.
+        if (cells >= (double) (m_CellStart.Size() - 1))
+        {
+            ScanPoints4(m_X.Data(), m_Y.Data(), m_Z.Data(), 0, Count(), center, radius2,
+                        [&](size_t slot, float d2) { fn(m_Indices[slot], d2); });
+            return;
+        }
+
+        for (int z = lo[2]; z <= hi[2]; ++z)
+        {
+            for (int y = lo[1]; y <= hi[1]; ++y)
+            {
+                for (int x = lo[0]; x <= hi[0]; ++x)
+                    ScanCell(x, y, z, center, radius2, fn);
+            }
+        }
+    }
+
+    inline size_t HashGrid::QueryKNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared,
+                                          float maxRadius) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_HASH_GRID_KNEAREST, 1);
+        if (IsEmpty() || k == 0 || !(maxRadius >= 0.0f))
+            return 0;
+
+        NeighborHeap heap(indices, distancesSquared, k, maxRadius * maxRadius);
+        auto         visit     = [&](unsigned int point, float d2) { heap.Push(point, d2); };
+        auto         visitCell = [&](int x, int y, int z)
+        {
+            // Skip cells whose box, grown by the slack, is farther than the distance to beat.
+            float dx = GridOutside(center.x, x, m_CellSize), dy = GridOutside(center.y, y, m_CellSize), dz = GridOutside(center.z, z, m_CellSize);
+            dx       = Max(dx - m_Slack, 0.0f);
+            dy       = Max(dy - m_Slack, 0.0f);
+            dz       = Max(dz - m_Slack, 0.0f);
+            if (dx * dx + dy * dy + dz * dz > heap.Bound())
+                return;
+            ScanCell(x, y, z, center, heap.Bound(), visit);
+        };
+
+        // Visit rings of cells at Chebyshev distance 0, 1, 2, ... from the center cell, clipped to the occupied
+        // cells. Rings closer than the occupied cells are empty, rings past them add nothing.
+        int c[3];
+        int firstRing = 0, lastRing = 0;
+        for (int a = 0; a < 3; ++a)
+        {
+            c[a]      = GridCoordinate(center[a], m_InvCellSize);
+            firstRing = Max(firstRing, Max(m_CellMin[a] - c[a], c[a] - m_CellMax[a]));
+            lastRing  = Max(lastRing, Max(c[a] - m_CellMin[a], m_CellMax[a] - c[a]));
+        }
+
+        for (int ring = firstRing; ring <= lastRing; ++ring)
+        {
+            // Points of cells in this ring or further are at least (ring - 1) * cellSize - slack away.
+            float nearest = (float) (ring - 1) * m_CellSize - m_Slack;
+            if (nearest > 0.0f && nearest * nearest > heap.Bound())
+                break;
+
+            int    lo[3], hi[3];
+            double cells = 1.0;
+            for (int a = 0; a < 3; ++a)
+            {
+                lo[a] = Max(c[a] - ring, m_CellMin[a]);
+                hi[a] = Min(c[a] + ring, m_CellMax[a]);
+                cells *= (double) (hi[a] - lo[a] + 1);
+            }
+
+            // Rings up to this one cover the clipped box, once it holds as many cells as there are buckets testing every
+            // point is cheaper. The kth nearest found so far still bounds the answer.
+            if (cells >= (double) (m_CellStart.Size() - 1))
+            {
+                heap = NeighborHeap(indices, distancesSquared, k, heap.Bound());
+                ScanPoints4(m_X.Data(), m_Y.Data(), m_Z.Data(), 0, Count(), center, heap.Bound(),
+                            [&](size_t slot, float d2) { heap.Push(m_Indices[slot], d2); });
+                break;
+            }
+
+            for (int z = lo[2]; z <= hi[2]; ++z)
+            {
+                for (int y = lo[1]; y <= hi[1]; ++y)
+                {
+                    if (z == c[2] - ring || z == c[2] + ring || y == c[1] - ring || y == c[1] + ring)
+                    {
+                        for (int x = lo[0]; x <= hi[0]; ++x)
+                            visitCell(x, y, z);
+                        continue;
+                    }
+                    // Inside rows only touch the ring at its two ends.
+                    if (c[0] - ring >= lo[0])
+                        visitCell(c[0] - ring, y, z);
+                    if (c[0] + ring <= hi[0])
+                        visitCell(c[0] + ring, y, z);
+                }
+            }
+        }
+
+        return heap.Finish();
+    }
+} // namespace DropMath
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "../DM_Memory.h"
+#include "../geom/DM_AABB.h"
+#include "../thread/DM_ThreadPool.h"
+#include "DM_Neighbors.h"
+
+namespace DropMath
+{
+    // Inner node of the implicit tree: the children of node i are 2i + 1 and 2i + 2.
+    struct KDNode
+    {
+        float split; // Left subtree points have coordinate <= split on axis, right subtree points >= split.
+        int   axis;
+    };
+
+    struct KDTreeSettings
+    {
+        KDTreeSettings() : leafSize(8), parallelThreshold(16384), pool(nullptr) { }
+
+        int         leafSize;          // Leaves never hold more points than this.
+        size_t      parallelThreshold; // Subtrees with more points are built as separate tasks.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default(), also used by the batched queries.
+    };
+
+    // k-d tree over a static Vec3 point set. Every subtree splits its points at the median of the widest axis, so
+    // the tree is complete and stored without pointers: the inner nodes as an implicit heap, the leaves in order at
+    // the last level. Points are stored in leaf order as SoA streams and leaves are tested 4 points at a time.
+    class KDTree
+    {
+    public:
+        KDTree() : m_Depth(0) { }
+
+        // Build over count points. Point i is points[i].
+        void Build(const Vec3* points, size_t count, const KDTreeSettings& settings = KDTreeSettings());
+
+        void Clear();
+
+        bool   IsEmpty() const { return m_Indices.Empty(); }
+        size_t Count() const { return m_Indices.Size(); }
+        // Levels of inner nodes; there are 2^Depth() leaves.
+        int Depth() const { return m_Depth; }
+
+        const KDNode* Nodes() const { return m_Nodes.Data(); }
+        size_t        NodeCount() const { return m_Nodes.Size(); }
+        // Leaf i holds slots [LeafStarts()[i], LeafStarts()[i + 1]).
+        const unsigned int* LeafStarts() const { return m_LeafStart.Data(); }
+        // Point positions in leaf order. Slot i holds point Indices()[i].
+        const float*        X() const { return m_X.Data(); }
+        const float*        Y() const { return m_Y.Data(); }
+        const float*        Z() const { return m_Z.Data(); }
+        const unsigned int* Indices() const { return m_Indices.Data(); }
+
+        // Call fn(point, distanceSquared) for every point within radius of center, in no particular order.
+        template <typename Fn>
+        void QueryRadius(const Vec3& center, float radius, Fn fn) const;
+
+        // Find the k points nearest to center within maxRadius. Write their indices and squared distances nearest
+        // first and return how many were found.
+        size_t QueryKNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared,
+                             float maxRadius = DM_INFINITY_F) const;
+
+        // Batched versions, the queries run in parallel on the pool.
+        // Results of query q go to indices[q * k, q * k + k) and distancesSquared[q * k, q * k + k), nearest first.
+        // Slots past the points found get index ~0u and distance infinity.
+        void QueryKNearest(const Vec3* centers, size_t queryCount, size_t k, unsigned int* indices, float* distancesSquared,
+                           float maxRadius = DM_INFINITY_F) const;
+        // fn(query, point, distanceSquared) is called from several threads at once.
+        template <typename Fn>
+        void QueryRadius(const Vec3* centers, size_t queryCount, float radius, Fn fn) const;
+
+    private:
+        struct BuildPoint
+        {
+            Vec3         position;
+            unsigned int index;
+        };
+
+        void BuildNode(BuildPoint* points, unsigned int node, size_t first, size_t last, TaskGroup& group);
+
+        // Visit the leaves that can hold a point within sqrt(radius2) of center, nearest side first, and scan them.
+        // radius2 is re-read as the search goes, so fn may shrink it.
+        template <typename Fn>
+        void Search(const Vec3& center, const float& radius2, Fn fn) const;
+        // QueryKNearest without the profile scope, which the batched version records once for all its queries.
+        size_t KNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared, float maxRadius) const;
+
+        ThreadPool& Pool() const { return m_Settings.pool ? *m_Settings.pool : ThreadPool::Default(); }
+
+        int            m_Depth;
+        KDTreeSettings m_Settings;
+
+        AlignedArray<KDNode>       m_Nodes;
+        AlignedArray<unsigned int> m_LeafStart;
+        AlignedArray<float>        m_X; // Padded with 3 NaN so the last leaf can be read 4 wide.
+        AlignedArray<float>        m_Y;
+        AlignedArray<float>        m_Z;
+        AlignedArray<unsigned int> m_Indices;
+    };
+} // namespace DropMath
+
+#include "DM_KDTree.inl"
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <limits>
+
+namespace DropMath
+{
+    namespace
+    {
+        const int    g_KD_STACK       = 64; // Holds one far child per level, the depth is at most 32.
+        const size_t g_KD_GRAIN       = 16384;
+        const size_t g_KD_QUERY_GRAIN = 64;
+
+        struct KDStackEntry
+        {
+            unsigned int node;
+            float        bound; // Lower bound of the squared distance from the query to the subtree.
+        };
+    } // anonymous namespace
+
+    inline void KDTree::Build(const Vec3* points, size_t count, const KDTreeSettings& settings)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_KD_TREE_BUILD, count);
+        Clear();
+        m_Settings = settings;
+        if (count == 0)
+            return;
+
+        // Halving the points per level, the smallest depth whose leaves fit leafSize.
+        const size_t leafSize = (size_t) Max(settings.leafSize, 1);
+        while (((count + ((size_t) 1 << m_Depth) - 1) >> m_Depth) > leafSize)
+            ++m_Depth;
+        const size_t leafCount = (size_t) 1 << m_Depth;
+        m_Nodes.Resize(leafCount - 1);
+        m_LeafStart.Resize(leafCount + 1);
+
+        ThreadPool&              pool = Pool();
+        AlignedArray<BuildPoint> work(count);
+        pool.ParallelFor(0, count, g_KD_GRAIN,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 work[i].position = points[i];
+                                 work[i].index    = (unsigned int) i;
+                             }
+                         });
+
+        TaskGroup group(pool);
+        BuildNode(work.Data(), 0, 0, count, group);
+        group.Wait();
+        m_LeafStart[leafCount] = (unsigned int) count;
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        m_X.Resize(count + 3);
+        m_Y.Resize(count + 3);
+        m_Z.Resize(count + 3);
+        for (size_t i = count; i < count + 3; ++i)
+            m_X[i] = m_Y[i] = m_Z[i] = nan;
+        m_Indices.Resize(count);
+        pool.ParallelFor(0, count, g_KD_GRAIN,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 m_X[i]       = work[i].position.x;
+                                 m_Y[i]       = work[i].position.y;
+                                 m_Z[i]       = work[i].position.z;
+                                 m_Indices[i] = work[i].index;
+                             }
+                         });
+    }
+
+    inline void KDTree::Clear()
+    {
+        m_Depth = 0;
+        m_Nodes.Clear();
+        m_LeafStart.Clear();
+        m_X.Clear();
+        m_Y.Clear();
+        m_Z.Clear();
+        m_Indices.Clear();
+    }
+
+    inline void KDTree::BuildNode(BuildPoint* points, unsigned int node, size_t first, size_t last, TaskGroup& group)
+    {
+        const unsigned int innerCount = (unsigned int) m_Nodes.Size();
+
+        // Loop on the right child instead of recursing so only left children grow the call stack.
+        while (node < innerCount)
+        {
+            AABB bounds;
+            for (size_t i = first; i < last; ++i)
+                bounds.Expand(points[i].position);
+            Vec3 extent = bounds.Extent();
+            int  axis   = extent.y > extent.x ? 1 : 0;
+            if (extent.z > extent[axis])
+                axis = 2;
+
+            // Left gets the lower half, so every subtree size and leaf range follows from the count alone.
+            size_t mid = first + (last - first) / 2;
+            std::nth_element(points + first, points + mid, points + last,
+                             [axis](const BuildPoint& a, const BuildPoint& b) { return a.position[axis] < b.position[axis]; });
+            m_Nodes[node].split = mid < last ? points[mid].position[axis] : 0.0f;
+            m_Nodes[node].axis  = axis;
+
+            unsigned int left = 2 * node + 1;
+            if (mid - first > m_Settings.parallelThreshold)
+                group.Run([this, points, left, first, mid, &group]() { BuildNode(points, left, first, mid, group); });
+            else
+                BuildNode(points, left, first, mid, group);
+
+            node  = left + 1;
+            first = mid;
+        }
+        m_LeafStart[node - innerCount] = (unsigned int) first;
+    }
+
+    template <typename Fn>
+    inline void KDTree::Search(const Vec3& center, const float& radius2, Fn fn) const
+    {
+        if (IsEmpty())
+            return;
+
+        const unsigned int innerCount = (unsigned int) m_Nodes.Size();
+
+        KDStackEntry stack[g_KD_STACK];
+        int          top = 0;
+        stack[top++]     = { 0, 0.0f };
+        while (top > 0)
+        {
+            KDStackEntry entry = stack[--top];
+            if (entry.bound > radius2)
+                continue;
+
+            // Descend to the leaf on the query side, keeping each far child with the distance to its split plane.
+            unsigned int node = entry.node;
+            while (node < innerCount)
+            {
+                const KDNode& inner     = m_Nodes[node];
+                float         diff      = center[inner.axis] - inner.split;
+                unsigned int  nearChild = 2 * node + (diff > 0.0f ? 2 : 1);
+                unsigned int  farChild  = 2 * node + (diff > 0.0f ? 1 : 2);
+                float         bound     = Max(entry.bound, diff * diff);
+                if (bound <= radius2)
+                    stack[top++] = { farChild, bound };
+                node = nearChild;
+            }
+
+            unsigned int leaf = node - innerCount;
+            ScanPoints4(m_X.Data(), m_Y.Data(), m_Z.Data(), m_LeafStart[leaf], m_LeafStart[leaf + 1], center, radius2,
+                        [&](size_t slot, float d2) { fn(m_Indices[slot], d2); });
+        }
+    }
+
+    template <typename Fn>
+    inline void KDTree::QueryRadius(const Vec3& center, float radius, Fn fn) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_KD_TREE_QUERY_RADIUS, 1);
+        if (!(radius >= 0.0f))
+            return;
+        const float radius2 = radius * radius;
+        Search(center, radius2, fn);
+    }
+
+    inline size_t KDTree::QueryKNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared, float maxRadius) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_KD_TREE_KNEAREST, 1);
+        return KNearest(center, k, indices, distancesSquared, maxRadius);
+    }
+
+    inline size_t KDTree::KNearest(const Vec3& center, size_t k, unsigned int* indices, float* distancesSquared, float maxRadius) const
+    {
+        if (IsEmpty() || k == 0 || !(maxRadius >= 0.0f))
+            return 0;
+
+        NeighborHeap heap(indices, distancesSquared, k, maxRadius * maxRadius);
+        Search(center, heap.Bound(), [&](unsigned int point, float d2) { heap.Push(point, d2); });
+        return heap.Finish();
+    }
+
+    inline void KDTree::QueryKNearest(const Vec3* centers, size_t queryCount, size_t k, unsigned int* indices, float* distancesSquared,
+                                      float maxRadius) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_KD_TREE_KNEAREST, queryCount);
+        Pool().ParallelFor(0, queryCount, g_KD_QUERY_GRAIN,
+                           [&](size_t first, size_t last)
+                           {
+                               for (size_t q = first; q < last; ++q)
+                               {
+                                   unsigned int* queryIndices   = indices + q * k;
+                                   float*        queryDistances = distancesSquared + q * k;
+                                   for (size_t i = KNearest(centers[q], k, queryIndices, queryDistances, maxRadius); i < k; ++i)
+                                   {
+                                       queryIndices[i]   = ~0u;
+                                       queryDistances[i] = DM_INFINITY_F;
+                                   }
+                               }
+                           });
+    }
+
+    template <typename Fn>
+    inline void KDTree::QueryRadius(const Vec3* centers, size_t queryCount, float radius, Fn fn) const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_KD_TREE_QUERY_RADIUS, queryCount);
+        if (!(radius >= 0.0f))
+            return;
+        // Search directly, so the queries aren't counted again by the single QueryRadius.
+        const float radius2 = radius * radius;
+        Pool().ParallelFor(0, queryCount, g_KD_QUERY_GRAIN,
+                           [&](size_t first, size_t last)
+                           {
+                               for (size_t q = first; q < last; ++q)
+                                   Search(centers[q], radius2, [&](unsigned int point, float d2) { fn(q, point, d2); });
+                           });
+    }
+} // namespace DropMath
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../vec/DM_Vec3.h"
+
+// Building blocks shared by the point structures (HashGrid, KDTree): the k nearest candidate heap and the
+// 4-wide distance scan over SoA point streams.
+namespace DropMath
+{
+    // Max heap of the k nearest candidates so far, stored in the caller's index and squared distance arrays.
+    // Bound() is the squared distance a candidate must not exceed: the search radius until k candidates are
+    // in, then the current kth nearest.
+    class NeighborHeap
+    {
+    public:
+        NeighborHeap(unsigned int* indices, float* distancesSquared, size_t k, float maxDistanceSquared)
+            : m_Indices(indices), m_Distances(distancesSquared), m_K(k), m_Count(0), m_Bound(maxDistanceSquared) { }
+
+        // A reference, so a scan in progress sees the bound shrink.
+        const float& Bound() const { return m_Bound; }
+        size_t       Count() const { return m_Count; }
+
+        void Push(unsigned int index, float distanceSquared)
+        {
+            if (distanceSquared > m_Bound || m_K == 0)
+                return;
+            if (m_Count < m_K)
+            {
+                size_t i        = m_Count++;
+                m_Indices[i]   = index;
+                m_Distances[i] = distanceSquared;
+                while (i > 0 && m_Distances[(i - 1) / 2] < m_Distances[i])
+                {
+                    Swap(i, (i - 1) / 2);
+                    i = (i - 1) / 2;
+                }
+                if (m_Count == m_K)
+                    m_Bound = m_Distances[0];
+                return;
+            }
+            m_Indices[0]   = index;
+            m_Distances[0] = distanceSquared;
+            SiftDown(m_K, 0);
+            m_Bound = m_Distances[0];
+        }
+
+        // Sort the candidates nearest first and return how many there are. The heap is unusable afterwards.
+        size_t Finish()
+        {
+            // Popping the farthest to the back leaves the array nearest first.
+            for (size_t n = m_Count; n > 1; --n)
+            {
+                Swap(0, n - 1);
+                SiftDown(n - 1, 0);
+            }
+            return m_Count;
+        }
+
+    private:
+        void Swap(size_t a, size_t b)
+        {
+            unsigned int index = m_Indices[a];
+            float        dist  = m_Distances[a];
+            m_Indices[a]       = m_Indices[b];
+            m_Distances[a]     = m_Distances[b];
+            m_Indices[b]       = index;
+            m_Distances[b]     = dist;
+        }
+
+        void SiftDown(size_t count, size_t i)
+        {
+            for (;;)
+            {
+                size_t largest = i;
+                size_t left    = 2 * i + 1;
+                if (left < count && m_Distances[left] > m_Distances[largest])
+                    largest = left;
+                if (left + 1 < count && m_Distances[left + 1] > m_Distances[largest])
+                    largest = left + 1;
+                if (largest == i)
+                    return;
+                Swap(i, largest);
+                i = largest;
+            }
+        }
+
+        unsigned int* m_Indices;
+        float*        m_Distances;
+        size_t        m_K;
+        size_t        m_Count;
+        float         m_Bound;
+    };
+
+    // Call fn(slot, distanceSquared) for every slot in [first, last) of the x/y/z streams within sqrt(radius2) of
+    // center, 4 slots per step. The streams must be readable 3 floats past last (pad the arrays), lanes past last
+    // are masked off. radius2 is re-read every step, so fn may shrink it.
+    template <typename Fn>
+    inline void ScanPoints4(const float* x, const float* y, const float* z, size_t first, size_t last, const Vec3& center,
+                            const float& radius2, Fn fn)
+    {
+        const float4 cx = _mm_set1_ps(center.x);
+        const float4 cy = _mm_set1_ps(center.y);
+        const float4 cz = _mm_set1_ps(center.z);
+
+        for (size_t i = first; i < last; i += 4)
+        {
+            float4 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+            float4 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+            float4 dz = _mm_sub_ps(_mm_loadu_ps(z + i), cz);
+            float4 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            int mask = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_set1_ps(radius2)));
+            if (last - i < 4)
+                mask &= (1 << (last - i)) - 1;
+            if (!mask)
+                continue;
+
+            alignas(16) float dist[4];
+            _mm_store_ps(dist, d2);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (mask & (1 << lane))
+                    fn(i + lane, dist[lane]);
+            }
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+
+#include "../DM_Memory.h"
+#include "../geom/DM_AABB.h"
+#include "../sort/DM_RadixSort.h"
+#include "../thread/DM_ThreadPool.h"
+
+namespace DropMath
+{
+    // Two bodies whose boxes overlap, a < b.
+    struct BroadphasePair
+    {
+        unsigned int a;
+        unsigned int b;
+    };
+
+    struct SweepAndPruneSettings
+    {
+        SweepAndPruneSettings() : maxInsertionMoves(8), parallelThreshold(8192), pool(nullptr) { }
+
+        int         maxInsertionMoves; // Insertion sort shifts per body an update may spend before it radix sorts instead.
+        size_t      parallelThreshold; // Fewer bodies are processed on the calling thread only.
+        ThreadPool* pool;              // nullptr means ThreadPool::Default().
+    };
+
+    // Sweep and prune broadphase. The bodies are kept sorted by their min endpoint along the axis where the box
+    // centers spread the most, and every body sweeps forward over the bodies that start before it ends, testing
+    // the other two axes 4 bodies at a time.
+    //
+    // From frame to frame bodies move little, so the previous order is nearly sorted and an insertion sort pass
+    // fixes it in about linear time. When that takes too many moves (teleports, a new sweep axis, a new body count)
+    // the update falls back to a parallel radix sort.
+    class SweepAndPrune
+    {
+    public:
+        explicit SweepAndPrune(const SweepAndPruneSettings& settings = SweepAndPruneSettings())
+            : m_Settings(settings), m_Axis(0), m_Resorted(false), m_Sorter(SortSettings(settings)) { }
+
+        // Sort count boxes (body i is boxes[i]) and find every overlapping pair. Keep the body numbering stable
+        // between updates, the incremental sort relies on it.
+        void Update(const AABB* boxes, size_t count);
+
+        void Clear();
+
+        size_t Count() const { return m_Order.Size(); }
+        // Sweep axis of the last update (0 = x, 1 = y, 2 = z).
+        int Axis() const { return m_Axis; }
+        // True if the last update radix sorted instead of fixing the previous order.
+        bool Resorted() const { return m_Resorted; }
+        // Bodies sorted by their min endpoint on Axis().
+        const unsigned int* Order() const { return m_Order.Data(); }
+
+        // Overlapping pairs of the last update, in sweep order.
+        const BroadphasePair* Pairs() const { return m_Pairs.Data(); }
+        size_t                PairCount() const { return m_Pairs.Size(); }
+
+    private:
+        static RadixSortSettings SortSettings(const SweepAndPruneSettings& settings);
+
+        int  ChooseAxis(const AABB* boxes, size_t count) const;
+        bool InsertionSort(size_t maxMoves);
+        void RadixSort(const AABB* boxes, size_t count, ThreadPool& pool);
+        void FindPairs(ThreadPool& pool);
+
+        SweepAndPruneSettings m_Settings;
+        int                   m_Axis;
+        bool                  m_Resorted;
+
+        // Endpoints in sweep order: A is the sweep axis, B and C the other two. Padded with 3 entries for 4 wide loads.
+        AlignedArray<float>          m_MinA;
+        AlignedArray<float>          m_MaxA;
+        AlignedArray<float>          m_MinB;
+        AlignedArray<float>          m_MaxB;
+        AlignedArray<float>          m_MinC;
+        AlignedArray<float>          m_MaxC;
+        AlignedArray<unsigned int>   m_Order;
+        AlignedArray<BroadphasePair> m_Pairs;
+
+        RadixSorter                m_Sorter;
+        AlignedArray<unsigned int> m_SortKeys; // FloatSortKey of the min endpoints, only used by RadixSort.
+
+        std::vector<AlignedArray<BroadphasePair>> m_ChunkPairs; // Pair lists of the FindPairs chunks, kept to reuse their memory.
+    };
+} // namespace DropMath
+
+#include "DM_SweepAndPrune.inl"
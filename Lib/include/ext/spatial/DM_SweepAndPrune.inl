@@ -0,0 +1,256 @@
+#include <cstring>
+#include <limits>
+
+namespace DropMath
+{
+    namespace
+    {
+        const size_t g_SAP_GRAIN           = 16384;
+        const size_t g_SAP_PAIR_GRAIN      = 1024; // Small, the sweep cost per body varies a lot between sparse and crowded regions.
+        const double g_SAP_AXIS_HYSTERESIS = 1.25; // A new sweep axis must spread the centers this much more than the current one.
+    } // anonymous namespace
+
+    inline RadixSortSettings SweepAndPrune::SortSettings(const SweepAndPruneSettings& settings)
+    {
+        RadixSortSettings sort;
+        sort.parallelThreshold = settings.parallelThreshold;
+        sort.pool              = settings.pool;
+        return sort;
+    }
+
+    inline void SweepAndPrune::Update(const AABB* boxes, size_t count)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_SWEEP_AND_PRUNE_UPDATE, count);
+        m_Pairs.Clear();
+        if (count == 0)
+        {
+            Clear();
+            return;
+        }
+
+        ThreadPool&  pool  = m_Settings.pool ? *m_Settings.pool : ThreadPool::Default();
+        const size_t grain = count < m_Settings.parallelThreshold ? count : g_SAP_GRAIN;
+
+        const int axis = ChooseAxis(boxes, count);
+        m_Resorted     = axis != m_Axis || count != m_Order.Size();
+        m_Axis         = axis;
+        if (!m_Resorted)
+        {
+            // Refresh the sweep keys in the previous order, then repair it.
+            pool.ParallelFor(0, count, grain,
+                             [&](size_t first, size_t last)
+                             {
+                                 for (size_t i = first; i < last; ++i)
+                                     m_MinA[i] = boxes[m_Order[i]].min[m_Axis];
+                             });
+            m_Resorted = !InsertionSort(count * (size_t) Max(m_Settings.maxInsertionMoves, 0));
+        }
+        if (m_Resorted)
+            RadixSort(boxes, count, pool);
+
+        if (m_MinA.Size() != count + 3)
+        {
+            // NaN padding fails every comparison, so padded lanes are never in range.
+            const float          nan       = std::numeric_limits<float>::quiet_NaN();
+            AlignedArray<float>* arrays[6] = { &m_MinA, &m_MaxA, &m_MinB, &m_MaxB, &m_MinC, &m_MaxC };
+            for (int k = 0; k < 6; ++k)
+            {
+                arrays[k]->Resize(count + 3);
+                for (size_t i = count; i < count + 3; ++i)
+                    (*arrays[k])[i] = nan;
+            }
+        }
+
+        const int b = (m_Axis + 1) % 3;
+        const int c = (m_Axis + 2) % 3;
+        pool.ParallelFor(0, count, grain,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 const AABB& box = boxes[m_Order[i]];
+                                 m_MinA[i]       = box.min[m_Axis];
+                                 m_MaxA[i]       = box.max[m_Axis];
+                                 m_MinB[i]       = box.min[b];
+                                 m_MaxB[i]       = box.max[b];
+                                 m_MinC[i]       = box.min[c];
+                                 m_MaxC[i]       = box.max[c];
+                             }
+                         });
+
+        FindPairs(pool);
+    }
+
+    inline void SweepAndPrune::Clear()
+    {
+        m_Axis     = 0;
+        m_Resorted = false;
+        m_MinA.Clear();
+        m_MaxA.Clear();
+        m_MinB.Clear();
+        m_MaxB.Clear();
+        m_MinC.Clear();
+        m_MaxC.Clear();
+        m_Order.Clear();
+        m_Pairs.Clear();
+    }
+
+    inline int SweepAndPrune::ChooseAxis(const AABB* boxes, size_t count) const
+    {
+        // Variance of the box centers per axis (times count), in double so large worlds do not cancel out.
+        double sum[3] = { 0.0, 0.0, 0.0 }, sumSq[3] = { 0.0, 0.0, 0.0 };
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (int a = 0; a < 3; ++a)
+            {
+                double center = 0.5 * ((double) boxes[i].min[a] + boxes[i].max[a]);
+                sum[a] += center;
+                sumSq[a] += center * center;
+            }
+        }
+
+        double spread[3];
+        int    best = m_Axis;
+        for (int a = 0; a < 3; ++a)
+            spread[a] = sumSq[a] - sum[a] * sum[a] / (double) count;
+        for (int a = 0; a < 3; ++a)
+        {
+            if (spread[a] > spread[best])
+                best = a;
+        }
+        // Switching costs a full resort, so only switch for a clearly better axis.
+        return spread[best] > g_SAP_AXIS_HYSTERESIS * spread[m_Axis] ? best : m_Axis;
+    }
+
+    inline bool SweepAndPrune::InsertionSort(size_t maxMoves)
+    {
+        float*        keys  = m_MinA.Data();
+        unsigned int* order = m_Order.Data();
+        const size_t  count = m_Order.Size();
+        size_t        moves = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            const float key = keys[i];
+            if (!(key < keys[i - 1]))
+                continue;
+
+            const unsigned int body = order[i];
+            size_t             j    = i;
+            do
+            {
+                keys[j]  = keys[j - 1];
+                order[j] = order[j - 1];
+                --j;
+            } while (j > 0 && key < keys[j - 1]);
+            keys[j]  = key;
+            order[j] = body;
+
+            moves += i - j;
+            if (moves > maxMoves)
+                return false;
+        }
+        return true;
+    }
+
+    inline void SweepAndPrune::RadixSort(const AABB* boxes, size_t count, ThreadPool& pool)
+    {
+        const size_t grain = count < m_Settings.parallelThreshold ? count : g_SAP_GRAIN;
+
+        m_SortKeys.Resize(count);
+        m_Order.Resize(count);
+        pool.ParallelFor(0, count, grain,
+                         [&](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 m_SortKeys[i] = FloatSortKey(boxes[i].min[m_Axis]);
+                                 m_Order[i]    = (unsigned int) i;
+                             }
+                         });
+        m_Sorter.Sort(m_SortKeys.Data(), m_Order.Data(), count);
+    }
+
+    inline void SweepAndPrune::FindPairs(ThreadPool& pool)
+    {
+        const size_t count      = m_Order.Size();
+        const size_t chunkCount = (count + g_SAP_PAIR_GRAIN - 1) / g_SAP_PAIR_GRAIN;
+        if (m_ChunkPairs.size() < chunkCount)
+            m_ChunkPairs.resize(chunkCount);
+
+        const float*        minA  = m_MinA.Data();
+        const float*        maxA  = m_MaxA.Data();
+        const float*        minB  = m_MinB.Data();
+        const float*        maxB  = m_MaxB.Data();
+        const float*        minC  = m_MinC.Data();
+        const float*        maxC  = m_MaxC.Data();
+        const unsigned int* order = m_Order.Data();
+
+        auto findChunk = [&](size_t chunk)
+        {
+            AlignedArray<BroadphasePair>& pairs = m_ChunkPairs[chunk];
+            pairs.Clear();
+
+            const size_t last = Min(count, (chunk + 1) * g_SAP_PAIR_GRAIN);
+            for (size_t i = chunk * g_SAP_PAIR_GRAIN; i < last; ++i)
+            {
+                const float4 endA   = _mm_set1_ps(maxA[i]);
+                const float4 startB = _mm_set1_ps(minB[i]);
+                const float4 endB   = _mm_set1_ps(maxB[i]);
+                const float4 startC = _mm_set1_ps(minC[i]);
+                const float4 endC   = _mm_set1_ps(maxC[i]);
+
+                // Sweep forward while the next bodies start before body i ends.
+                for (size_t j = i + 1; j < count; j += 4)
+                {
+                    float4 inRange  = _mm_cmple_ps(_mm_loadu_ps(minA + j), endA);
+                    float4 overlapB = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minB + j), endB), _mm_cmpge_ps(_mm_loadu_ps(maxB + j), startB));
+                    float4 overlapC = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minC + j), endC), _mm_cmpge_ps(_mm_loadu_ps(maxC + j), startC));
+                    int    overlap  = _mm_movemask_ps(_mm_and_ps(inRange, _mm_and_ps(overlapB, overlapC)));
+                    while (overlap)
+                    {
+                        int lane = 0;
+                        while (!(overlap & (1 << lane)))
+                            ++lane;
+                        overlap &= overlap - 1;
+
+                        unsigned int   a = order[i], b = order[j + lane];
+                        BroadphasePair pair;
+                        pair.a = Min(a, b);
+                        pair.b = Max(a, b);
+                        pairs.PushBack(pair);
+                    }
+                    if (_mm_movemask_ps(inRange) != 0xF)
+                        break;
+                }
+            }
+        };
+
+        if (count < m_Settings.parallelThreshold)
+        {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+                findChunk(chunk);
+        }
+        else
+        {
+            pool.ParallelFor(0, chunkCount, 1,
+                             [&](size_t firstChunk, size_t lastChunk)
+                             {
+                                 for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+                                     findChunk(chunk);
+                             });
+        }
+
+        // Concatenate in chunk order so the pairs do not depend on the thread count.
+        size_t pairCount = 0;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+            pairCount += m_ChunkPairs[chunk].Size();
+        m_Pairs.Resize(pairCount);
+        BroadphasePair* out = m_Pairs.Data();
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            if (!m_ChunkPairs[chunk].Empty())
+                std::memcpy(out, m_ChunkPairs[chunk].Data(), m_ChunkPairs[chunk].Size() * sizeof(BroadphasePair));
+            out += m_ChunkPairs[chunk].Size();
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../DM_Common.h"
+
+// Small work queue used by the parallel builders (BVH, spatial grids, ...). Not part of DropMath.h because it pulls
+// <thread>; the modules that need it include it themselves.
+namespace DropMath
+{
+    class ThreadPool
+    {
+    public:
+        // Start threadCount workers. -1 means one per hardware thread minus the caller, 0 runs every task on the
+        // thread that waits for it.
+        explicit ThreadPool(int threadCount = -1);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Number of threads that execute tasks, including the caller of Wait/ParallelFor.
+        int ThreadCount() const { return (int) m_Workers.size() + 1; }
+
+        // Queue task. Prefer TaskGroup, which can wait for it.
+        void Submit(std::function<void()> task);
+
+        // Run one queued task on the calling thread. Return false if the queue was empty.
+        bool RunOne();
+
+        // Call fn(first, last) on disjoint chunks of at most grain indices covering [begin, end), in parallel.
+        // Return once every chunk is done.
+        template <typename Fn>
+        void ParallelFor(size_t begin, size_t end, size_t grain, Fn fn);
+
+        // Process wide pool, created on first use.
+        static ThreadPool& Default();
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread>          m_Workers;
+        std::deque<std::function<void()>> m_Tasks;
+        std::mutex                        m_Mutex;
+        std::condition_variable           m_Wake;
+        bool                              m_Stop;
+    };
+
+    // Set of tasks that can be waited for together. Tasks may add more tasks to the same group (recursive builds),
+    // Wait returns when all of them are done. The waiting thread runs queued tasks instead of blocking.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(ThreadPool& pool) : m_Pool(pool), m_Pending(0) { }
+        ~TaskGroup() { Wait(); }
+
+        TaskGroup(const TaskGroup&)            = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template <typename Fn>
+        void Run(Fn fn);
+
+        void Wait();
+
+    private:
+        ThreadPool&      m_Pool;
+        std::atomic<int> m_Pending;
+    };
+} // namespace DropMath
+
+#include "DM_ThreadPool.inl"
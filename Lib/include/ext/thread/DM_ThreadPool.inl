@@ -0,0 +1,128 @@
+namespace DropMath
+{
+    inline ThreadPool::ThreadPool(int threadCount) : m_Stop(false)
+    {
+        if (threadCount < 0)
+        {
+            int hardware = (int) std::thread::hardware_concurrency();
+            threadCount  = hardware > 1 ? hardware - 1 : 0;
+        }
+        m_Workers.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i)
+            m_Workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_all();
+        for (size_t i = 0; i < m_Workers.size(); ++i)
+            m_Workers[i].join();
+    }
+
+    inline void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.push_back(std::move(task));
+        }
+        m_Wake.notify_one();
+    }
+
+    inline bool ThreadPool::RunOne()
+    {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Tasks.empty())
+                return false;
+            // Newest first: in a recursive build that is the smallest, most cache friendly subtree.
+            task = std::move(m_Tasks.back());
+            m_Tasks.pop_back();
+        }
+        task();
+        return true;
+    }
+
+    template <typename Fn>
+    inline void ThreadPool::ParallelFor(size_t begin, size_t end, size_t grain, Fn fn)
+    {
+        if (begin >= end)
+            return;
+        if (grain == 0)
+            grain = 1;
+
+        size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks == 1 || m_Workers.empty())
+        {
+            for (size_t first = begin; first < end; first += grain)
+                fn(first, first + grain < end ? first + grain : end);
+            return;
+        }
+
+        // Every runner pulls chunks from a shared counter, so uneven chunks balance themselves.
+        std::atomic<size_t> next(0);
+        auto                runner = [&]()
+        {
+            for (size_t chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1))
+            {
+                size_t first = begin + chunk * grain;
+                fn(first, first + grain < end ? first + grain : end);
+            }
+        };
+
+        TaskGroup group(*this);
+        size_t    helpers = chunks - 1 < m_Workers.size() ? chunks - 1 : m_Workers.size();
+        for (size_t i = 0; i < helpers; ++i)
+            group.Run(runner);
+        runner();
+        group.Wait();
+    }
+
+    inline ThreadPool& ThreadPool::Default()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    inline void ThreadPool::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Wake.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+                if (m_Tasks.empty())
+                    return; // Stopping and nothing left to do.
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    template <typename Fn>
+    inline void TaskGroup::Run(Fn fn)
+    {
+        m_Pending.fetch_add(1, std::memory_order_relaxed);
+        m_Pool.Submit(
+            [this, fn]()
+            {
+                fn();
+                m_Pending.fetch_sub(1, std::memory_order_release);
+            });
+    }
+
+    inline void TaskGroup::Wait()
+    {
+        while (m_Pending.load(std::memory_order_acquire) > 0)
+        {
+            if (!m_Pool.RunOne())
+                std::this_thread::yield();
+        }
+    }
+} // namespace DropMath
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../vec/DM_Vec4.h"
+
+namespace DropMath
+{
+    // Register helpers shared by the matrix, quaternion and transform code. The w lane carries no vector component:
+    // the 3 lane operations ignore it or leave it 0.
+    namespace
+    {
+        // (x, y, z, 0) of v.
+        inline float4 LoadVec3(const Vec3& v) { return _mm_set_ps(0.0f, v.z, v.y, v.x); }
+
+        // a x b in the xyz lanes, 0 in w.
+        inline float4 Cross3(float4 a, float4 b)
+        {
+            float4 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+            float4 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+            float4 c    = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+            return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        // Replace the w lane of row by w.
+        inline Vec4 WithW(float4 row, float4 w) { return Vec4(_mm_blend_ps(row, w, 0x8)); }
+
+        // Transpose the 3x3 part of 3 rows. The w lanes of the result are 0.
+        inline void Transpose3(float4 r0, float4 r1, float4 r2, float4& c0, float4& c1, float4& c2)
+        {
+            float4 r3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            c0 = r0;
+            c1 = r1;
+            c2 = r2;
+        }
+
+        // Row of an affine inverse: the row l of linear^-1 with w = -dot(l, t), t the translation of the forward
+        // transform.
+        inline Vec4 InverseAffineRow(float4 l, float4 t) { return WithW(l, _mm_sub_ps(_mm_setzero_ps(), _mm_dp_ps(l, t, 0x7F))); }
+    } // anonymous namespace
+} // namespace DropMath
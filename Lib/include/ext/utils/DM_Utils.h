@@ -50,6 +50,11 @@ namespace DropMath
 	// Return tan of rad(double).
     inline double Tan(double rad);
 
+    // Return sin and cos of 4 angles at once. Accurate to a few ulp for |rad| up to about 1e4.
+    inline void SinCos(float4 rad, float4& sin, float4& cos);
+    // Return sin and cos of rad(float) with the SSE path of SinCos.
+    inline void SinCos(float rad, float& sin, float& cos);
+
 	// Return 1 if x is greater than 0, 0 if x is 0, and -1 if x is less than 0.
 	DM_CONSTEXPR_14 inline float Sign(float x);
 	// Return 1 if x is greater than 0, 0 if x is 0, and -1 if x is less than 0.
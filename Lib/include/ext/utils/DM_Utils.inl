@@ -4,32 +4,22 @@ namespace DropMath
 {
     namespace
     {
-        // Return the sign(float) and change the rad(float) that already in range [-pi, pi] to the range [-pi/2, pi/2].
-        DM_CONSTEXPR_14 inline float FoldToHalfPiRef(float& wrappedRad)
+        // Change the rad(float) that already in range [-pi, pi] to the range [-pi/2, pi/2] with the same sine.
+        DM_CONSTEXPR_14 inline void FoldToHalfPiRef(float& wrappedRad)
         {
-            float sign = 1.0f;
             if (wrappedRad > F::HALF_PI)
                 wrappedRad = F::PI - wrappedRad;
             else if (wrappedRad < -F::HALF_PI)
-            {
                 wrappedRad = -F::PI - wrappedRad;
-                sign       = -1.0f;
-            }
-            return sign;
         }
 
-        // Return the sign(double) and change the rad(double) that already in range [-pi, pi] to the range [-pi/2, pi/2].
-        DM_CONSTEXPR_14 inline double FoldToHalfPiRef(double& wrappedRad)
+        // Change the rad(double) that already in range [-pi, pi] to the range [-pi/2, pi/2] with the same sine.
+        DM_CONSTEXPR_14 inline void FoldToHalfPiRef(double& wrappedRad)
         {
-            double sign = 1.0;
             if (wrappedRad > D::HALF_PI)
                 wrappedRad = D::PI - wrappedRad;
             else if (wrappedRad < -D::HALF_PI)
-            {
                 wrappedRad = -D::PI - wrappedRad;
-                sign       = -1.0;
-            }
-            return sign;
         }
 
         DM_CONSTEXPR_14 inline float SinApprox(float x)
@@ -41,7 +31,7 @@ namespace DropMath
         DM_CONSTEXPR_14 inline double SinApprox(double x)
         {
             double x2 = x * x;
-            return ((((((((((-1.9509019e-19 * x2 + 8.33216087e-17) * x2 - 1.95152959e-14) * x2 + 2.59230160e-12) * x2 - 2.50521084e-10) * x2 + 1.60590438e-08) * x2 - 7.64716373e-07) * x2 + 2.75573192e-05) * x2 - 0.00019841270) * x2 + 0.00833333333) * x2 - 0.16666666667) * x2 * x + x;
+            return ((((((((((-3.8681701706306841e-23 * x2 + 1.9572941063391263e-20) * x2 - 8.2206352466243295e-18) * x2 + 2.8114572543455206e-15) * x2 - 7.6471637318198164e-13) * x2 + 1.6059043836821613e-10) * x2 - 2.505210838544172e-08) * x2 + 2.7557319223985893e-06) * x2 - 0.00019841269841269841) * x2 + 0.0083333333333333332) * x2 - 0.16666666666666666) * x2 * x + x;
         }
     } // anonymous namespace
 
@@ -108,16 +98,16 @@ namespace DropMath
 
     DM_CONSTEXPR_14 inline float Sin(float rad)
     {
-        rad        = WrapPi(rad);
-        float sign = FoldToHalfPiRef(rad);
-        return sign * SinApprox(rad);
+        rad = WrapPi(rad);
+        FoldToHalfPiRef(rad);
+        return SinApprox(rad);
     }
 
     DM_CONSTEXPR_14 inline double Sin(double rad)
     {
-        rad         = WrapPi(rad);
-        double sign = FoldToHalfPiRef(rad);
-        return sign * SinApprox(rad);
+        rad = WrapPi(rad);
+        FoldToHalfPiRef(rad);
+        return SinApprox(rad);
     }
 
     DM_CONSTEXPR_14 inline float Cos(float rad)
@@ -132,6 +122,7 @@ namespace DropMath
 
     inline float Tan(float rad)
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_TAN, 1);
         float sin = Sin(rad);
         float cos = Cos(rad);
         return IsZero(cos) ? DM_INFINITY : sin / cos;
@@ -139,11 +130,46 @@ namespace DropMath
 
     inline double Tan(double rad)
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_TAN, 1);
         double sin = Sin(rad);
         double cos = Cos(rad);
         return IsZero(cos) ? DM_INFINITY : sin / cos;
     }
 
+    inline void SinCos(float4 rad, float4& sin, float4& cos)
+    {
+        // rad = q * pi/2 + r with r in [-pi/4, pi/4]. pi/2 is subtracted in three parts so r stays exact.
+        float4 q = _mm_round_ps(_mm_mul_ps(rad, _mm_set1_ps(2.0f * F::INV_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        float4 r = _mm_sub_ps(rad, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+        r        = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+        r        = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+
+        // Minimax polynomials on [-pi/4, pi/4].
+        float4 r2 = _mm_mul_ps(r, r);
+        float4 s  = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), r2), _mm_set1_ps(8.3321608736e-3f));
+        s         = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(-1.6666654611e-1f));
+        s         = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+        float4 c  = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), r2), _mm_set1_ps(-1.388731625493765e-3f));
+        c         = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(4.166664568298827e-2f));
+        c         = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, r2), r2), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), _mm_set1_ps(1.0f));
+
+        // Odd quadrants swap sin and cos. sin is negative in quadrants 2 and 3, cos in quadrants 1 and 2.
+        int4   quadrant = _mm_cvtps_epi32(q);
+        float4 swap     = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+        float4 sinSign  = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+        float4 cosSign  = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+        sin             = _mm_xor_ps(_mm_blendv_ps(s, c, swap), sinSign);
+        cos             = _mm_xor_ps(_mm_blendv_ps(c, s, swap), cosSign);
+    }
+
+    inline void SinCos(float rad, float& sin, float& cos)
+    {
+        float4 s, c;
+        SinCos(_mm_set_ss(rad), s, c);
+        sin = _mm_cvtss_f32(s);
+        cos = _mm_cvtss_f32(c);
+    }
+
     DM_CONSTEXPR_14 inline float Sign(float x) { return (x > 0.0f) - (x < 0.0f); }
 
     DM_CONSTEXPR_14 inline double Sign(double x) { return (x > 0.0) - (x < 0.0); }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "DM_Vec3x4.h"
+#include "DM_Vec4.h"
+
+namespace DropMath
+{
+    // Float vector type with N components, the type IntVec converts from and to.
+    template <int N>
+    struct IntVecFloat;
+    template <>
+    struct IntVecFloat<2>
+    {
+        typedef Vec2 Type;
+    };
+    template <>
+    struct IntVecFloat<3>
+    {
+        typedef Vec3 Type;
+    };
+    template <>
+    struct IntVecFloat<4>
+    {
+        typedef Vec4 Type;
+    };
+
+    // N ints (T = int) or unsigned ints (T = unsigned int) in one SSE register, for grid and voxel coordinates and
+    // hash keys. Lanes past N are kept 0 by every operation. Use the IVec2/3/4 and UVec2/3/4 names below.
+    template <typename T, int N>
+    struct alignas(16) IntVec
+    {
+        static_assert(N >= 2 && N <= 4, "IntVec has 2, 3 or 4 components.");
+
+        typedef typename IntVecFloat<N>::Type FloatVec;
+
+        union
+        {
+            int4 v; // Don't ever use this directly unless you know about SSE alignment.
+            struct
+            {
+                T x, y, z, w;
+            };
+            T array[4]; // Don't use this directly. You need to use [] operator or x, y, z, w.
+        };
+
+        IntVec() : v(_mm_setzero_si128()) { }
+        explicit IntVec(const int4& v) : v(v) { }
+        // The constructors with fewer or more components than N don't compile.
+        IntVec(T x, T y);
+        IntVec(T x, T y, T z);
+        IntVec(T x, T y, T z, T w);
+
+        T&       operator[](int i);
+        const T& operator[](int i) const;
+        IntVec   operator+(const IntVec& v) const { return IntVec(_mm_add_epi32(this->v, v.v)); }
+        IntVec   operator-(const IntVec& v) const { return IntVec(_mm_sub_epi32(this->v, v.v)); }
+        // Per component product, the low 32 bits like scalar int math.
+        IntVec operator*(const IntVec& v) const { return IntVec(_mm_mullo_epi32(this->v, v.v)); }
+        IntVec operator*(T s) const { return IntVec(_mm_mullo_epi32(v, _mm_set1_epi32((int) s))); }
+        IntVec operator&(const IntVec& v) const { return IntVec(_mm_and_si128(this->v, v.v)); }
+        IntVec operator|(const IntVec& v) const { return IntVec(_mm_or_si128(this->v, v.v)); }
+        IntVec operator^(const IntVec& v) const { return IntVec(_mm_xor_si128(this->v, v.v)); }
+        IntVec operator<<(int bits) const { return IntVec(_mm_slli_epi32(v, bits)); }
+        // Arithmetic shift for int (rounds toward negative infinity, a floor division by 2^bits), logical for unsigned.
+        IntVec operator>>(int bits) const;
+        bool   operator==(const IntVec& v) const;
+        bool   operator!=(const IntVec& v) const { return !(*this == v); }
+
+        // Return the components as floats.
+        FloatVec ToFloat() const;
+
+        // Hash of the components, the same as HashGrid uses for its cells.
+        unsigned int Hash() const;
+
+        // Create a vector with the N components set to s.
+        static IntVec Filled(T s);
+
+        static IntVec Min(const IntVec& a, const IntVec& b);
+        static IntVec Max(const IntVec& a, const IntVec& b);
+        static IntVec Clamp(const IntVec& v, const IntVec& min, const IntVec& max) { return Max(min, Min(v, max)); }
+
+        // Return a mask with bit i set when component i of a is less than (equal to) component i of b.
+        static unsigned int LessThan(const IntVec& a, const IntVec& b);
+        static unsigned int Equal(const IntVec& a, const IntVec& b);
+
+        // Convert with Floor semantics: the greatest integers at or below v. The components must fit in T.
+        static IntVec Floor(const FloatVec& v);
+
+        // Convert with Round semantics: the closest integers, halves away from 0. The components must fit in T.
+        static IntVec Round(const FloatVec& v);
+    };
+
+    typedef IntVec<int, 2>          IVec2;
+    typedef IntVec<int, 3>          IVec3;
+    typedef IntVec<int, 4>          IVec4;
+    typedef IntVec<unsigned int, 2> UVec2;
+    typedef IntVec<unsigned int, 3> UVec3;
+    typedef IntVec<unsigned int, 4> UVec4;
+
+    // cells[i] = IVec3::Floor((positions[i] - origin) * (1 / cellSize)), 4 positions per SSE register. The cell
+    // coordinates must fit in int.
+    inline void WorldToCell(const Vec3* positions, size_t count, const Vec3& origin, float cellSize, IVec3* cells);
+} // namespace DropMath
+
+#include "DM_IVec.inl"
@@ -0,0 +1,224 @@
+namespace DropMath
+{
+    namespace
+    {
+        const int4   g_IVEC_SIGN_BIT = _mm_set1_epi32((int) 0x80000000u);
+        const float4 g_IVEC_TWO_31   = _mm_set1_ps(2147483648.0f);
+
+        // The operations that differ between int and unsigned int lanes.
+        template <typename T>
+        struct IVecLanes;
+
+        template <>
+        struct IVecLanes<int>
+        {
+            static int4 Min(int4 a, int4 b) { return _mm_min_epi32(a, b); }
+            static int4 Max(int4 a, int4 b) { return _mm_max_epi32(a, b); }
+            static int4 ShiftRight(int4 v, int bits) { return _mm_srai_epi32(v, bits); }
+            static int4 Less(int4 a, int4 b) { return _mm_cmplt_epi32(a, b); }
+            static float4 ToFloat(int4 v) { return _mm_cvtepi32_ps(v); }
+            // Truncate toward 0.
+            static int4 FromFloat(float4 v) { return _mm_cvttps_epi32(v); }
+        };
+
+        template <>
+        struct IVecLanes<unsigned int>
+        {
+            static int4 Min(int4 a, int4 b) { return _mm_min_epu32(a, b); }
+            static int4 Max(int4 a, int4 b) { return _mm_max_epu32(a, b); }
+            static int4 ShiftRight(int4 v, int bits) { return _mm_srli_epi32(v, bits); }
+            // Flipping the sign bits turns the unsigned order into the signed one.
+            static int4 Less(int4 a, int4 b) { return _mm_cmplt_epi32(_mm_xor_si128(a, g_IVEC_SIGN_BIT), _mm_xor_si128(b, g_IVEC_SIGN_BIT)); }
+            // Both 16 bit halves convert exactly, only the sum rounds.
+            static float4 ToFloat(int4 v)
+            {
+                float4 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(v, 16)), _mm_set1_ps(65536.0f));
+                return _mm_add_ps(hi, _mm_cvtepi32_ps(_mm_and_si128(v, _mm_set1_epi32(0xFFFF))));
+            }
+            // Truncate toward 0. Values at or above 2^31 don't fit the signed conversion, convert v - 2^31 and add the
+            // top bit back.
+            static int4 FromFloat(float4 v)
+            {
+                float4 big = _mm_cmpge_ps(v, g_IVEC_TWO_31);
+                int4   i   = _mm_cvttps_epi32(_mm_sub_ps(v, _mm_and_ps(big, g_IVEC_TWO_31)));
+                return _mm_xor_si128(i, _mm_and_si128(_mm_castps_si128(big), g_IVEC_SIGN_BIT));
+            }
+        };
+
+        inline float4 IVecLoad(const Vec2& v) { return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(v.Data()))); }
+        inline float4 IVecLoad(const Vec3& v) { return _mm_set_ps(0.0f, v.z, v.y, v.x); }
+        inline float4 IVecLoad(const Vec4& v) { return v.v; }
+
+        template <typename FloatVec>
+        inline FloatVec IVecStore(float4 v);
+
+        template <>
+        inline Vec2 IVecStore<Vec2>(float4 v)
+        {
+            Vec2 out;
+            _mm_store_sd(reinterpret_cast<double*>(out.Data()), _mm_castps_pd(v));
+            return out;
+        }
+
+        template <>
+        inline Vec3 IVecStore<Vec3>(float4 v)
+        {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, v);
+            return Vec3(lanes[0], lanes[1], lanes[2]);
+        }
+
+        template <>
+        inline Vec4 IVecStore<Vec4>(float4 v)
+        {
+            return Vec4(v);
+        }
+
+        // floor(v) to int, lane by lane.
+        inline int4 IVecFloor(float4 v) { return _mm_cvttps_epi32(_mm_floor_ps(v)); }
+
+        // Write cells [0, 4) from the SoA cell coordinates, w = 0.
+        inline void IVecStoreCells(int4 x, int4 y, int4 z, IVec3* cells)
+        {
+            float4 c0 = _mm_castsi128_ps(x), c1 = _mm_castsi128_ps(y), c2 = _mm_castsi128_ps(z), c3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            cells[0] = IVec3(_mm_castps_si128(c0));
+            cells[1] = IVec3(_mm_castps_si128(c1));
+            cells[2] = IVec3(_mm_castps_si128(c2));
+            cells[3] = IVec3(_mm_castps_si128(c3));
+        }
+    } // anonymous namespace
+
+    template <typename T, int N>
+    inline IntVec<T, N>::IntVec(T x, T y) : v(_mm_set_epi32(0, 0, (int) y, (int) x))
+    {
+        static_assert(N == 2, "This IntVec has more than 2 components.");
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N>::IntVec(T x, T y, T z) : v(_mm_set_epi32(0, (int) z, (int) y, (int) x))
+    {
+        static_assert(N == 3, "This IntVec doesn't have 3 components.");
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N>::IntVec(T x, T y, T z, T w) : v(_mm_set_epi32((int) w, (int) z, (int) y, (int) x))
+    {
+        static_assert(N == 4, "This IntVec has less than 4 components.");
+    }
+
+    template <typename T, int N>
+    inline T& IntVec<T, N>::operator[](int i)
+    {
+        assert(i >= 0 && i < N);
+        return array[i];
+    }
+
+    template <typename T, int N>
+    inline const T& IntVec<T, N>::operator[](int i) const
+    {
+        assert(i >= 0 && i < N);
+        return array[i];
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::operator>>(int bits) const
+    {
+        return IntVec(IVecLanes<T>::ShiftRight(v, bits));
+    }
+
+    template <typename T, int N>
+    inline bool IntVec<T, N>::operator==(const IntVec& v) const
+    {
+        // The lanes past N are 0 on both sides.
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(this->v, v.v)) == 0xFFFF;
+    }
+
+    template <typename T, int N>
+    inline typename IntVec<T, N>::FloatVec IntVec<T, N>::ToFloat() const
+    {
+        return IVecStore<FloatVec>(IVecLanes<T>::ToFloat(v));
+    }
+
+    template <typename T, int N>
+    inline unsigned int IntVec<T, N>::Hash() const
+    {
+        // Product with one large prime per component, xor folded. The lanes past N add 0.
+        int4 h = _mm_mullo_epi32(v, _mm_set_epi32((int) 2654435761u, 83492791, 19349663, 73856093));
+        h      = _mm_xor_si128(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+        h      = _mm_xor_si128(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+        return (unsigned int) _mm_cvtsi128_si32(h);
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::Filled(T s)
+    {
+        int i = (int) s;
+        return IntVec(_mm_set_epi32(N > 3 ? i : 0, N > 2 ? i : 0, i, i));
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::Min(const IntVec& a, const IntVec& b)
+    {
+        return IntVec(IVecLanes<T>::Min(a.v, b.v));
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::Max(const IntVec& a, const IntVec& b)
+    {
+        return IntVec(IVecLanes<T>::Max(a.v, b.v));
+    }
+
+    template <typename T, int N>
+    inline unsigned int IntVec<T, N>::LessThan(const IntVec& a, const IntVec& b)
+    {
+        return (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(IVecLanes<T>::Less(a.v, b.v))) & ((1u << N) - 1);
+    }
+
+    template <typename T, int N>
+    inline unsigned int IntVec<T, N>::Equal(const IntVec& a, const IntVec& b)
+    {
+        return (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a.v, b.v))) & ((1u << N) - 1);
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::Floor(const FloatVec& v)
+    {
+        return IntVec(IVecLanes<T>::FromFloat(_mm_floor_ps(IVecLoad(v))));
+    }
+
+    template <typename T, int N>
+    inline IntVec<T, N> IntVec<T, N>::Round(const FloatVec& v)
+    {
+        // Like the scalar Round: add 0.5 with the sign of v, then truncate.
+        float4 f    = IVecLoad(v);
+        float4 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(f, _mm_set1_ps(-0.0f)));
+        return IntVec(IVecLanes<T>::FromFloat(_mm_add_ps(f, half)));
+    }
+
+    inline void WorldToCell(const Vec3* positions, size_t count, const Vec3& origin, float cellSize, IVec3* cells)
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_WORLD_TO_CELL, count);
+        Vec3x4 o(origin);
+        float4 inv = _mm_set1_ps(1.0f / cellSize);
+        size_t i   = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            Vec3x4 p = (Vec3x4::Load(positions + i) - o) * inv;
+            IVecStoreCells(IVecFloor(p.x), IVecFloor(p.y), IVecFloor(p.z), cells + i);
+        }
+        if (i == count)
+            return;
+
+        // Fewer than 4 left: run them through a padded copy so the tail uses the same math.
+        Vec3   tail[4];
+        IVec3  out[4];
+        size_t n = count - i;
+        for (size_t j = 0; j < n; ++j)
+            tail[j] = positions[i + j];
+        Vec3x4 p = (Vec3x4::Load(tail) - o) * inv;
+        IVecStoreCells(IVecFloor(p.x), IVecFloor(p.y), IVecFloor(p.z), out);
+        for (size_t j = 0; j < n; ++j)
+            cells[i + j] = out[j];
+    }
+} // namespace DropMath
@@ -14,11 +14,16 @@ namespace DropMath
     inline bool Vec2::operator==(const Vec2& v) const { return IsZero(x - v.x) && IsZero(y - v.y); }
     inline bool Vec2::operator!=(const Vec2& v) const { return !(*this == v); }
 
-    inline float Vec2::Length() const { return Sqrt(LengthSquared()); }
+    inline float Vec2::Length() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC2_LENGTH, 1);
+        return Sqrt(LengthSquared());
+    }
 
     inline void Vec2::Normalize()
     {
-        float len = Length();
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC2_NORMALIZE, 1);
+        float len = Sqrt(LengthSquared());
         if (len > F::EPSILON)
         {
             x /= len;
@@ -14,11 +14,16 @@ namespace DropMath
     inline bool Vec3::operator==(const Vec3& v) const { return IsZero(x - v.x) && IsZero(y - v.y) && IsZero(z - v.z); }
     inline bool Vec3::operator!=(const Vec3& v) const { return !(*this == v); }
 
-    inline float Vec3::Length() const { return Sqrt(LengthSquared()); }
+    inline float Vec3::Length() const
+    {
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC3_LENGTH, 1);
+        return Sqrt(LengthSquared());
+    }
 
     inline void Vec3::Normalize()
     {
-        float len = Length();
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC3_NORMALIZE, 1);
+        float len = Sqrt(LengthSquared());
         if (len > F::EPSILON)
         {
             x /= len;
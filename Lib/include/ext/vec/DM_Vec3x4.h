@@ -0,0 +1,56 @@
+#pragma once
+
+#include "DM_Vec3.h"
+
+namespace DropMath
+{
+    // Four Vec3 in SoA form, one SSE register per component. This is the building block of the batch kernels:
+    // load 4 Vec3 from an array, do the math on all 4 lanes at once, store them back.
+    struct Vec3x4
+    {
+        float4 x, y, z;
+
+        Vec3x4() : x(_mm_setzero_ps()), y(_mm_setzero_ps()), z(_mm_setzero_ps()) { }
+        Vec3x4(float4 x, float4 y, float4 z) : x(x), y(y), z(z) { }
+        // Broadcast v to all 4 lanes.
+        explicit Vec3x4(const Vec3& v) : x(_mm_set1_ps(v.x)), y(_mm_set1_ps(v.y)), z(_mm_set1_ps(v.z)) { }
+
+        Vec3x4 operator+(const Vec3x4& v) const { return Vec3x4(_mm_add_ps(x, v.x), _mm_add_ps(y, v.y), _mm_add_ps(z, v.z)); }
+        Vec3x4 operator-(const Vec3x4& v) const { return Vec3x4(_mm_sub_ps(x, v.x), _mm_sub_ps(y, v.y), _mm_sub_ps(z, v.z)); }
+        // Per lane scale.
+        Vec3x4 operator*(float4 s) const { return Vec3x4(_mm_mul_ps(x, s), _mm_mul_ps(y, s), _mm_mul_ps(z, s)); }
+        Vec3x4 operator*(float s) const { return *this * _mm_set1_ps(s); }
+
+        // Return the squared length of every lane.
+        float4 LengthSquared() const { return Dot(*this, *this); }
+
+        // Normalize every lane. Lanes with a length below F::EPSILON are left untouched, like Vec3::Normalize.
+        void Normalize();
+
+        // Store lane i as a Vec3.
+        Vec3 Get(int i) const;
+
+        // Store the 4 lanes into 4 consecutive Vec3.
+        void Store(Vec3* dst) const;
+
+        // Store the 4 lanes into 3 float arrays (x, y and z streams).
+        void StoreSoA(float* dstX, float* dstY, float* dstZ) const;
+
+        // Load 4 consecutive Vec3.
+        static Vec3x4 Load(const Vec3* src);
+
+        // Load 4 lanes from 3 float arrays (x, y and z streams).
+        static Vec3x4 LoadSoA(const float* srcX, const float* srcY, const float* srcZ);
+
+        // Dot product of every lane.
+        static float4 Dot(const Vec3x4& a, const Vec3x4& b);
+
+        // Cross product of every lane.
+        static Vec3x4 Cross(const Vec3x4& a, const Vec3x4& b);
+
+        // Pick b where mask lane is set, otherwise a.
+        static Vec3x4 Select(const Vec3x4& a, const Vec3x4& b, float4 mask);
+    };
+} // namespace DropMath
+
+#include "DM_Vec3x4.inl"
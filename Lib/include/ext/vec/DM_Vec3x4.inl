@@ -0,0 +1,81 @@
+namespace DropMath
+{
+    inline void Vec3x4::Normalize()
+    {
+        float4 len  = _mm_sqrt_ps(LengthSquared());
+        float4 mask = _mm_cmpgt_ps(len, _mm_set1_ps(F::EPSILON));
+        float4 inv  = _mm_div_ps(_mm_set1_ps(1.0f), len);
+        *this       = Select(*this, *this * inv, mask);
+    }
+
+    inline Vec3 Vec3x4::Get(int i) const
+    {
+        assert(i >= 0 && i < 4);
+        alignas(16) float sx[4], sy[4], sz[4];
+        _mm_store_ps(sx, x);
+        _mm_store_ps(sy, y);
+        _mm_store_ps(sz, z);
+        return Vec3(sx[i], sy[i], sz[i]);
+    }
+
+    inline void Vec3x4::Store(Vec3* dst) const
+    {
+        // SoA -> AoS: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3.
+        float4 a = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 0, 0)), _mm_shuffle_ps(y, y, _MM_SHUFFLE(0, 0, 0, 0)), 0b0010), _mm_shuffle_ps(z, z, _MM_SHUFFLE(0, 0, 0, 0)), 0b0100);
+        float4 b = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 1, 1, 1)), _mm_shuffle_ps(z, z, _MM_SHUFFLE(1, 1, 1, 1)), 0b0010), _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 2, 2, 2)), 0b0100);
+        float4 c = _mm_blend_ps(_mm_blend_ps(_mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 2, 2, 2)), _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)), 0b0010), _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3)), 0b0100);
+
+        float* out = reinterpret_cast<float*>(dst);
+        _mm_storeu_ps(out + 0, a);
+        _mm_storeu_ps(out + 4, b);
+        _mm_storeu_ps(out + 8, c);
+    }
+
+    inline void Vec3x4::StoreSoA(float* dstX, float* dstY, float* dstZ) const
+    {
+        _mm_storeu_ps(dstX, x);
+        _mm_storeu_ps(dstY, y);
+        _mm_storeu_ps(dstZ, z);
+    }
+
+    inline Vec3x4 Vec3x4::Load(const Vec3* src)
+    {
+        // AoS -> SoA: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3.
+        const float* in = reinterpret_cast<const float*>(src);
+        float4       a  = _mm_loadu_ps(in + 0);
+        float4       b  = _mm_loadu_ps(in + 4);
+        float4       c  = _mm_loadu_ps(in + 8);
+
+        float4 tx = _mm_blend_ps(_mm_blend_ps(a, b, 0b0100), c, 0b0010); // x0 x3 x2 x1
+        float4 ty = _mm_blend_ps(_mm_blend_ps(a, b, 0b1001), c, 0b0100); // y1 y0 y3 y2
+        float4 tz = _mm_blend_ps(_mm_blend_ps(a, b, 0b0010), c, 0b1001); // z2 z1 z0 z3
+
+        return Vec3x4(
+            _mm_shuffle_ps(tx, tx, _MM_SHUFFLE(1, 2, 3, 0)),
+            _mm_shuffle_ps(ty, ty, _MM_SHUFFLE(2, 3, 0, 1)),
+            _mm_shuffle_ps(tz, tz, _MM_SHUFFLE(3, 0, 1, 2)));
+    }
+
+    inline Vec3x4 Vec3x4::LoadSoA(const float* srcX, const float* srcY, const float* srcZ)
+    {
+        return Vec3x4(_mm_loadu_ps(srcX), _mm_loadu_ps(srcY), _mm_loadu_ps(srcZ));
+    }
+
+    inline float4 Vec3x4::Dot(const Vec3x4& a, const Vec3x4& b)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+    }
+
+    inline Vec3x4 Vec3x4::Cross(const Vec3x4& a, const Vec3x4& b)
+    {
+        return Vec3x4(
+            _mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+            _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+            _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x)));
+    }
+
+    inline Vec3x4 Vec3x4::Select(const Vec3x4& a, const Vec3x4& b, float4 mask)
+    {
+        return Vec3x4(_mm_blendv_ps(a.x, b.x, mask), _mm_blendv_ps(a.y, b.y, mask), _mm_blendv_ps(a.z, b.z, mask));
+    }
+} // namespace DropMath
@@ -30,6 +30,7 @@ namespace DropMath
 
     inline float Vec4::Length() const
     {
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC4_LENGTH, 1);
         float4 dot  = _mm_dp_ps(v, v, g_DOT_MASK);
         float4 sqrt = _mm_sqrt_ps(dot);
         return _mm_cvtss_f32(sqrt);
@@ -43,10 +44,12 @@ namespace DropMath
 
     inline void Vec4::Normalize()
     {
-        float len = Length();
-        if (len > F::EPSILON)
+        DM_PROFILE_SCOPE(PROFILE_OP_VEC4_NORMALIZE, 1);
+        // Length broadcast to every lane.
+        float4 len = _mm_sqrt_ps(_mm_dp_ps(v, v, 0xFF));
+        if (_mm_cvtss_f32(len) > F::EPSILON)
         {
-            v = _mm_div_ps(v, _mm_set1_ps(len));
+            v = _mm_div_ps(v, len);
         }
     }
 
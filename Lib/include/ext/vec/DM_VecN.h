@@ -0,0 +1,78 @@
+#pragma once
+
+#include "DM_Vec4.h"
+
+namespace DropMath
+{
+    // Fixed size vector of N elements of T (int, float or double). It is an aggregate, built with braces as
+    // Vec<double, 6> {{ 1, 2, 3, 4, 5, 6 }}, and every operation below is unrolled at compile time and usable in
+    // constant expressions. Use Vec2, Vec3 and Vec4 for float math that fits them, ToSimd and ToVecN convert.
+    template <typename T, int N>
+    struct Vec
+    {
+        static_assert(N > 0, "Vec needs at least one element.");
+
+        T data[N];
+
+        // Temporaries bind to the const overload, which is constexpr in C++11, so (a + b)[i] is a constant expression.
+        DM_CONSTEXPR const T& operator[](int i) const& { return data[i]; }
+        DM_CONSTEXPR_14 T&    operator[](int i) & { return data[i]; }
+
+        T*       Data() { return data; }
+        const T* Data() const { return data; }
+
+        // Create a vector with every element set to value.
+        static DM_CONSTEXPR Vec Filled(T value);
+
+        static DM_CONSTEXPR Vec Zero() { return Filled(T(0)); }
+    };
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator+(const Vec<T, N>& a, const Vec<T, N>& b);
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator-(const Vec<T, N>& a, const Vec<T, N>& b);
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator-(const Vec<T, N>& v);
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator*(const Vec<T, N>& v, T s);
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator*(T s, const Vec<T, N>& v);
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator/(const Vec<T, N>& v, T s);
+    // Exact comparison, unlike the tolerance of the SSE vectors, so that it works for int and in constant expressions.
+    template <typename T, int N>
+    DM_CONSTEXPR bool operator==(const Vec<T, N>& a, const Vec<T, N>& b);
+    template <typename T, int N>
+    DM_CONSTEXPR bool operator!=(const Vec<T, N>& a, const Vec<T, N>& b);
+
+    // Element-wise product.
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> Scale(const Vec<T, N>& a, const Vec<T, N>& b);
+
+    template <typename T, int N>
+    DM_CONSTEXPR T Dot(const Vec<T, N>& a, const Vec<T, N>& b);
+
+    template <typename T>
+    DM_CONSTEXPR Vec<T, 3> Cross(const Vec<T, 3>& a, const Vec<T, 3>& b);
+
+    template <typename T, int N>
+    DM_CONSTEXPR T LengthSquared(const Vec<T, N>& v);
+
+    // Length and Normalized are for float and double elements only.
+    template <typename T, int N>
+    inline T Length(const Vec<T, N>& v);
+
+    template <typename T, int N>
+    inline Vec<T, N> Normalized(const Vec<T, N>& v);
+
+    // Conversions from and to the SSE vectors.
+    inline Vec2 ToSimd(const Vec<float, 2>& v) { return Vec2(v[0], v[1]); }
+    inline Vec3 ToSimd(const Vec<float, 3>& v) { return Vec3(v[0], v[1], v[2]); }
+    inline Vec4 ToSimd(const Vec<float, 4>& v);
+
+    inline Vec<float, 2> ToVecN(const Vec2& v) { return Vec<float, 2> { { v.x, v.y } }; }
+    inline Vec<float, 3> ToVecN(const Vec3& v) { return Vec<float, 3> { { v.x, v.y, v.z } }; }
+    inline Vec<float, 4> ToVecN(const Vec4& v);
+} // namespace DropMath
+
+#include "DM_VecN.inl"
@@ -0,0 +1,197 @@
+namespace DropMath
+{
+    namespace
+    {
+        // Compile time list 0, 1, ..., N - 1, expanded in braces to unroll the element-wise operations. C++11 has no
+        // std::index_sequence.
+        template <int... I>
+        struct VecNIndices
+        {
+        };
+
+        template <int N, int... I>
+        struct VecNMakeIndices : VecNMakeIndices<N - 1, N - 1, I...>
+        {
+        };
+
+        template <int... I>
+        struct VecNMakeIndices<0, I...>
+        {
+            typedef VecNIndices<I...> Type;
+        };
+
+        struct VecNAdd
+        {
+            template <typename T>
+            DM_CONSTEXPR T operator()(T a, T b) const { return a + b; }
+        };
+
+        struct VecNSub
+        {
+            template <typename T>
+            DM_CONSTEXPR T operator()(T a, T b) const { return a - b; }
+        };
+
+        struct VecNMul
+        {
+            template <typename T>
+            DM_CONSTEXPR T operator()(T a, T b) const { return a * b; }
+        };
+
+        struct VecNDiv
+        {
+            template <typename T>
+            DM_CONSTEXPR T operator()(T a, T b) const { return a / b; }
+        };
+
+        template <typename T>
+        DM_CONSTEXPR T VecNRepeat(T value, int) { return value; }
+
+        template <typename T, int... I>
+        DM_CONSTEXPR Vec<T, sizeof...(I)> VecNFill(T value, VecNIndices<I...>)
+        {
+            return Vec<T, sizeof...(I)> { { VecNRepeat(value, I)... } };
+        }
+
+        template <typename T, int N, typename Op, int... I>
+        DM_CONSTEXPR Vec<T, N> VecNMap(const Vec<T, N>& a, const Vec<T, N>& b, Op op, VecNIndices<I...>)
+        {
+            return Vec<T, N> { { static_cast<T>(op(a.data[I], b.data[I]))... } };
+        }
+
+        template <typename T, int N, typename Op, int... I>
+        DM_CONSTEXPR Vec<T, N> VecNMap(const Vec<T, N>& a, T s, Op op, VecNIndices<I...>)
+        {
+            return Vec<T, N> { { static_cast<T>(op(a.data[I], s))... } };
+        }
+
+        // Reductions over elements [0, I), unrolled by recursion on I.
+        template <int I>
+        struct VecNUnroll
+        {
+            template <typename T, int N>
+            static DM_CONSTEXPR T Dot(const Vec<T, N>& a, const Vec<T, N>& b)
+            {
+                return VecNUnroll<I - 1>::Dot(a, b) + a.data[I - 1] * b.data[I - 1];
+            }
+
+            template <typename T, int N>
+            static DM_CONSTEXPR bool Equal(const Vec<T, N>& a, const Vec<T, N>& b)
+            {
+                return VecNUnroll<I - 1>::Equal(a, b) && a.data[I - 1] == b.data[I - 1];
+            }
+        };
+
+        template <>
+        struct VecNUnroll<1>
+        {
+            template <typename T, int N>
+            static DM_CONSTEXPR T Dot(const Vec<T, N>& a, const Vec<T, N>& b) { return a.data[0] * b.data[0]; }
+
+            template <typename T, int N>
+            static DM_CONSTEXPR bool Equal(const Vec<T, N>& a, const Vec<T, N>& b) { return a.data[0] == b.data[0]; }
+        };
+    } // anonymous namespace
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> Vec<T, N>::Filled(T value)
+    {
+        return VecNFill(value, typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator+(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return VecNMap(a, b, VecNAdd(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator-(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return VecNMap(a, b, VecNSub(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator-(const Vec<T, N>& v)
+    {
+        return VecNMap(v, T(-1), VecNMul(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator*(const Vec<T, N>& v, T s)
+    {
+        return VecNMap(v, s, VecNMul(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator*(T s, const Vec<T, N>& v)
+    {
+        return VecNMap(v, s, VecNMul(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> operator/(const Vec<T, N>& v, T s)
+    {
+        return VecNMap(v, s, VecNDiv(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR bool operator==(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return VecNUnroll<N>::Equal(a, b);
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR bool operator!=(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return !(a == b);
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR Vec<T, N> Scale(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return VecNMap(a, b, VecNMul(), typename VecNMakeIndices<N>::Type());
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR T Dot(const Vec<T, N>& a, const Vec<T, N>& b)
+    {
+        return VecNUnroll<N>::Dot(a, b);
+    }
+
+    template <typename T>
+    DM_CONSTEXPR Vec<T, 3> Cross(const Vec<T, 3>& a, const Vec<T, 3>& b)
+    {
+        return Vec<T, 3> { { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] } };
+    }
+
+    template <typename T, int N>
+    DM_CONSTEXPR T LengthSquared(const Vec<T, N>& v)
+    {
+        return Dot(v, v);
+    }
+
+    template <typename T, int N>
+    inline T Length(const Vec<T, N>& v)
+    {
+        return Sqrt(LengthSquared(v));
+    }
+
+    template <typename T, int N>
+    inline Vec<T, N> Normalized(const Vec<T, N>& v)
+    {
+        return v * (T(1) / Length(v));
+    }
+
+    inline Vec4 ToSimd(const Vec<float, 4>& v)
+    {
+        return Vec4(_mm_loadu_ps(v.data));
+    }
+
+    inline Vec<float, 4> ToVecN(const Vec4& v)
+    {
+        Vec<float, 4> out;
+        _mm_storeu_ps(out.data, v.v);
+        return out;
+    }
+} // namespace DropMath
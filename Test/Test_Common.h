@@ -0,0 +1,57 @@
+#pragma once
+
+#include <DropMath.h>
+
+#include <cfloat>
+
+// Shared helpers of the test mains: a reproducible random sequence, and the references and tolerances several
+// tests compare against.
+namespace Test
+{
+    inline unsigned int& RandomState()
+    {
+        static unsigned int state = 1;
+        return state;
+    }
+
+    // Restart the sequence of Random. Every test main seeds its own sequence first, so a failure reproduces.
+    inline void SeedRandom(unsigned int seed) { RandomState() = seed; }
+
+    // Uniform in [lo, hi), from a linear congruential generator so the sequence is the same on every platform.
+    inline float Random(float lo, float hi)
+    {
+        unsigned int& state = RandomState();
+        state               = state * 1664525u + 1013904223u;
+        return lo + (hi - lo) * (float) (state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    inline DropMath::Vec3 RandomVec3(float lo, float hi)
+    {
+        return DropMath::Vec3(Random(lo, hi), Random(lo, hi), Random(lo, hi));
+    }
+
+    inline float Component(const DropMath::Vec3& v, int i) { return i == 0 ? v.x : (i == 1 ? v.y : v.z); }
+
+    // Rotation about z then x, by angles with exact sines and cosines (3-4-5 and 5-12-13 triangles).
+    inline DropMath::Mat3x3 ExactRotation()
+    {
+        using DropMath::Vec3;
+        const DropMath::Mat3x3 z(Vec3(0.6f, -0.8f, 0.0f), Vec3(0.8f, 0.6f, 0.0f), Vec3(0.0f, 0.0f, 1.0f));
+        const DropMath::Mat3x3 x(Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 5.0f / 13.0f, -12.0f / 13.0f), Vec3(0.0f, 12.0f / 13.0f, 5.0f / 13.0f));
+        return x * z;
+    }
+
+    // Scalar reference of the squared distance the neighbor query kernels compute.
+    inline float DistanceSquared(const DropMath::Vec3& p, const DropMath::Vec3& c)
+    {
+        float dx = p.x - c.x, dy = p.y - c.y, dz = p.z - c.z;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // A kernel's squared distance against DistanceSquared. Both sum three non-negative products, so each lies within
+    // 3 roundings (1.5 FLT_EPSILON) of the exact sum whether or not FMA contracts it, and the two within 3 FLT_EPSILON.
+    inline bool SameDistanceSquared(float d2, float reference)
+    {
+        return DropMath::Abs(d2 - reference) <= 4.0f * FLT_EPSILON * reference;
+    }
+} // namespace Test
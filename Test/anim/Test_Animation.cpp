@@ -0,0 +1,173 @@
+#include "../Test_Common.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    bool NearlyEqual(const Vec3& a, const Vec3& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps; }
+
+    bool NearlyEqual(const Quat& a, const Quat& b, float eps)
+    {
+        return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps && Abs(a.w - b.w) <= eps;
+    }
+
+    // Keys at uneven times in [0, 10].
+    std::vector<float> RandomTimes(size_t count)
+    {
+        std::vector<float> times(count);
+        for (size_t i = 0; i < count; ++i)
+            times[i] = (i == 0 ? 0.0f : times[i - 1]) + Random(0.05f, 10.0f / (float) count);
+        return times;
+    }
+
+    // Rotations that wander off, some stored on the opposite hemisphere.
+    std::vector<Quat> RandomRotations(size_t count)
+    {
+        std::vector<Quat> rotations(count);
+        Vec3              euler;
+        for (size_t i = 0; i < count; ++i)
+        {
+            euler        = euler + RandomVec3(-0.4f, 0.4f);
+            rotations[i] = Quat::FromEuler(euler) * (i % 3 == 1 ? -1.0f : 1.0f);
+        }
+        return rotations;
+    }
+} // namespace
+
+// Testing the interpolation modes and the clamping at both ends.
+void TestAnimation_Interpolation()
+{
+    const float    times[3]  = { 1.0f, 2.0f, 4.0f };
+    const Vec3     values[3] = { Vec3(0.0f, 0.0f, 0.0f), Vec3(2.0f, -2.0f, 4.0f), Vec3(6.0f, -6.0f, 12.0f) };
+    KeyTrack<Vec3> track(times, values, 3, KEY_INTERPOLATION_LINEAR);
+    unsigned int   cursor = 0;
+
+    assert(NearlyEqual(SampleTrack(track, 1.5f, cursor), Vec3(1.0f, -1.0f, 2.0f), 1e-6f));
+    assert(NearlyEqual(SampleTrack(track, 3.0f, cursor), Vec3(4.0f, -4.0f, 8.0f), 1e-6f) && cursor == 1);
+    assert(NearlyEqual(SampleTrack(track, -5.0f, cursor), values[0], 0.0f) && cursor == 0);
+    assert(NearlyEqual(SampleTrack(track, 9.0f, cursor), values[2], 0.0f));
+
+    track.interpolation = KEY_INTERPOLATION_STEP;
+    assert(NearlyEqual(SampleTrack(track, 1.9f, cursor), values[0], 0.0f));
+    assert(NearlyEqual(SampleTrack(track, 2.0f, cursor), values[1], 0.0f));
+    assert(NearlyEqual(SampleTrack(track, 9.0f, cursor), values[2], 0.0f));
+
+    // The keys lie on a line through time, which Catmull-Rom with time scaled tangents reproduces exactly.
+    track.interpolation = KEY_INTERPOLATION_CUBIC;
+    for (float t = 1.0f; t <= 4.0f; t += 0.125f)
+        assert(NearlyEqual(SampleTrack(track, t, cursor), Vec3(2.0f, -2.0f, 4.0f) * (t - 1.0f), 1e-5f));
+
+    // A single key is constant.
+    KeyTrack<Vec3> single(times, values + 1, 1, KEY_INTERPOLATION_CUBIC);
+    assert(NearlyEqual(SampleTrack(single, 3.0f, cursor), values[1], 0.0f));
+
+    // Rotations: linear is nlerp on the shorter arc, cubic goes through the keys.
+    std::vector<float> rotationTimes = RandomTimes(6);
+    std::vector<Quat>  rotations     = RandomRotations(6);
+    KeyTrack<Quat>     rotation(rotationTimes.data(), rotations.data(), 6, KEY_INTERPOLATION_LINEAR);
+    for (size_t k = 0; k + 1 < 6; ++k)
+    {
+        float t = 0.7f * rotationTimes[k] + 0.3f * rotationTimes[k + 1];
+        assert(NearlyEqual(SampleTrack(rotation, t, cursor), Quat::Nlerp(rotations[k], rotations[k + 1], 0.3f), 1e-5f));
+    }
+    rotation.interpolation = KEY_INTERPOLATION_CUBIC;
+    for (size_t k = 0; k < 6; ++k)
+        assert(Abs(Abs(Quat::Dot(SampleTrack(rotation, rotationTimes[k], cursor), rotations[k])) - 1.0f) < 1e-5f);
+}
+
+// Testing that the cursor gives the same samples as a fresh search, playing forward, backward and jumping.
+void TestAnimation_Cursor()
+{
+    std::vector<float> times  = RandomTimes(200);
+    std::vector<Vec3>  values(times.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = RandomVec3(-5.0f, 5.0f);
+
+    const KEY_INTERPOLATION modes[3] = { KEY_INTERPOLATION_STEP, KEY_INTERPOLATION_LINEAR, KEY_INTERPOLATION_CUBIC };
+    for (int m = 0; m < 3; ++m)
+    {
+        KeyTrack<Vec3> track(times.data(), values.data(), times.size(), modes[m]);
+        unsigned int   cursor = 0;
+        float          end    = times.back() + 0.5f;
+        for (float t = -0.5f; t < end; t += 0.013f)
+        {
+            unsigned int fresh = 0;
+            assert(SampleTrack(track, t, cursor) == SampleTrack(track, t, fresh) && cursor == fresh);
+        }
+        for (float t = end; t > -0.5f; t -= 0.029f)
+        {
+            unsigned int fresh = 0;
+            assert(SampleTrack(track, t, cursor) == SampleTrack(track, t, fresh) && cursor == fresh);
+        }
+        for (int i = 0; i < 500; ++i)
+        {
+            float        t     = Random(-1.0f, end);
+            unsigned int fresh = (unsigned int) (i % times.size());
+            assert(SampleTrack(track, t, cursor) == SampleTrack(track, t, fresh) && cursor == fresh);
+        }
+    }
+}
+
+// Testing the batched sampling against the single track one, with mixed modes and key counts.
+void TestAnimation_Batch()
+{
+    const size_t                count = 1003;
+    std::vector<std::vector<float>> times(count);
+    std::vector<std::vector<Vec3>>  positions(count);
+    std::vector<std::vector<Quat>>  rotations(count);
+    std::vector<KeyTrack<Vec3>>     positionTracks(count);
+    std::vector<KeyTrack<Quat>>     rotationTracks(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t keys  = 1 + i % 17;
+        times[i]     = RandomTimes(keys);
+        rotations[i] = RandomRotations(keys);
+        positions[i].resize(keys);
+        for (size_t k = 0; k < keys; ++k)
+            positions[i][k] = RandomVec3(-5.0f, 5.0f);
+
+        KEY_INTERPOLATION mode = (KEY_INTERPOLATION) (i % 3);
+        positionTracks[i]      = KeyTrack<Vec3>(times[i].data(), positions[i].data(), keys, mode);
+        rotationTracks[i]      = KeyTrack<Quat>(times[i].data(), rotations[i].data(), keys, mode);
+    }
+
+    std::vector<unsigned int> cursors(count, 0), rotationCursors(count, 0), single(count, 0);
+    std::vector<float>        out(7 * count);
+    for (float t = -0.25f; t < 11.0f; t += 0.37f)
+    {
+        SampleTracks(positionTracks.data(), count, t, cursors.data(), &out[0], &out[count], &out[2 * count]);
+        SampleTracks(rotationTracks.data(), count, t, rotationCursors.data(), &out[3 * count], &out[4 * count], &out[5 * count], &out[6 * count]);
+        for (size_t i = 0; i < count; ++i)
+        {
+            unsigned int cursor = single[i];
+            Vec3         p      = SampleTrack(positionTracks[i], t, single[i]);
+            Quat         r      = SampleTrack(rotationTracks[i], t, cursor);
+            assert(cursors[i] == single[i] && rotationCursors[i] == single[i]);
+            assert(NearlyEqual(p, Vec3(out[i], out[count + i], out[2 * count + i]), 1e-5f));
+            assert(NearlyEqual(r, Quat(out[3 * count + i], out[4 * count + i], out[5 * count + i], out[6 * count + i]), 1e-5f));
+        }
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(23);
+
+    TestAnimation_Interpolation();
+    TestAnimation_Cursor();
+    TestAnimation_Batch();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Animation] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "../../Bench/Bench_Common.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+// Testing the median of odd and even sample counts.
+void TestBenchStats_Median()
+{
+    assert(Bench::Median({3.0, 1.0, 2.0}) == 2.0);
+    assert(Bench::Median({4.0, 1.0, 3.0, 2.0}) == 2.5);
+    assert(Bench::Median({}) == 0.0);
+}
+
+// Testing the rank test against hand computed values.
+void TestBenchStats_MannWhitney()
+{
+    // Fully separated samples: U = 25, z = (25 - 12.5 - 0.5) / sqrt(25 * 11 / 12), p = 0.0061.
+    Bench::RankTest test = Bench::MannWhitney({1.0, 2.0, 3.0, 4.0, 5.0}, {6.0, 7.0, 8.0, 9.0, 10.0});
+    assert(test.u == 25.0);
+    assert(std::fabs(test.pGreater - 0.0061) < 0.0005);
+    assert(test.pLess > 0.99);
+
+    // Same samples in the other order give the mirrored result.
+    Bench::RankTest mirrored = Bench::MannWhitney({6.0, 7.0, 8.0, 9.0, 10.0}, {1.0, 2.0, 3.0, 4.0, 5.0});
+    assert(mirrored.u == 0.0);
+    assert(std::fabs(mirrored.pLess - test.pGreater) < 1e-12);
+
+    // All ties: no evidence either way.
+    Bench::RankTest ties = Bench::MannWhitney({2.0, 2.0, 2.0}, {2.0, 2.0, 2.0});
+    assert(ties.pGreater == 1.0 && ties.pLess == 1.0);
+
+    // Interleaved samples: not significant.
+    Bench::RankTest mixed = Bench::MannWhitney({1.0, 3.0, 5.0, 7.0, 9.0}, {2.0, 4.0, 6.0, 8.0, 10.0});
+    assert(mixed.pGreater > 0.2 && mixed.pLess > 0.2);
+}
+
+// Testing the verdict needs both the threshold and the significance.
+void TestBenchStats_Judge()
+{
+    Bench::Kernel base, slower, noisy, faster;
+    for (int i = 0; i < 30; ++i)
+    {
+        double jitter = (i % 5) * 0.01;
+        base.samples.push_back(1.0 + jitter);
+        slower.samples.push_back(1.3 + jitter);
+        noisy.samples.push_back(1.02 + jitter); // Significant but below the threshold.
+        faster.samples.push_back(0.7 + jitter);
+    }
+
+    assert(Bench::Judge(base, slower, 0.1, 0.01) == Bench::VERDICT_SLOWER);
+    assert(Bench::Judge(base, noisy, 0.1, 0.01) == Bench::VERDICT_SAME);
+    assert(Bench::Judge(base, faster, 0.1, 0.01) == Bench::VERDICT_FASTER);
+    assert(Bench::Judge(base, base, 0.1, 0.01) == Bench::VERDICT_SAME);
+}
+
+// Testing baselines survive a write and read.
+void TestBenchStats_Baseline()
+{
+    const char* path = "Test_BenchStats.json";
+
+    std::vector<Bench::Kernel> kernels(2);
+    kernels[0].name    = "Mat4x4::operator*(Mat4x4)";
+    kernels[0].samples = {1.5, 2.25, 3.0};
+    kernels[1].name    = "Quote\"Name";
+    kernels[1].samples = {};
+    assert(Bench::WriteBaseline(path, kernels));
+
+    std::vector<Bench::Kernel> read;
+    std::string                machine;
+    assert(Bench::ReadBaseline(path, read, &machine));
+    assert(machine == Bench::MachineName());
+    assert(read.size() == 2);
+    assert(read[0].name == kernels[0].name && read[0].samples == kernels[0].samples);
+    assert(read[1].name == kernels[1].name && read[1].samples.empty());
+
+    // One regressed kernel out of two, plus a kernel without baseline.
+    std::vector<Bench::Kernel> current = kernels;
+    current[0].samples                 = {3.0, 4.5, 6.0};
+    current.push_back(Bench::Kernel {"New", {1.0}});
+    FILE* null = std::fopen(path, "w");
+    assert(Bench::Compare(kernels, current, 0.1, 0.2, null) == 1);
+    std::fclose(null);
+
+    std::remove(path);
+    assert(!Bench::ReadBaseline(path, read));
+}
+
+// Testing ULP distances and the float sweep.
+void TestBenchStats_Ulp()
+{
+    assert(Bench::UlpOf(1.0f) == std::ldexp(1.0, -23));
+    assert(Bench::UlpOf(-1.0f) == std::ldexp(1.0, -23));
+    assert(Bench::UlpOf(0.0f) == std::ldexp(1.0, -149));
+
+    assert(Bench::UlpError(1.0f, 1.0) == 0.0);
+    assert(Bench::UlpError(std::nextafter(1.0f, 2.0f), 1.0) == 1.0);
+    assert(Bench::UlpError(1.0f, 1.0 + std::ldexp(1.0, -24)) == 0.5);
+    assert(Bench::UlpError(DM_INFINITY_F, 1e300) == 0.0);
+    assert(Bench::UlpError(1.0f, std::nan("")) == HUGE_VAL);
+
+    Bench::ErrorStats stats;
+    stats.Add(2.0f, 1.0f, 1.0);
+    stats.Add(3.0f, std::nextafter(1.0f, 2.0f), 1.0);
+    assert(stats.count == 2 && stats.maxUlp == 1.0 && stats.MeanUlp() == 0.5 && stats.worst == 3.0f);
+
+    // Keys keep the float order across the sign change.
+    assert(Bench::FloatKey(-1.0f) < Bench::FloatKey(-0.0f));
+    assert(Bench::FloatKey(-0.0f) + 1 == Bench::FloatKey(0.0f));
+    assert(Bench::FloatKey(0.0f) < Bench::FloatKey(1e-45f));
+    assert(Bench::KeyFloat(Bench::FloatKey(-3.5f)) == -3.5f);
+
+    // Exhaustive sweep of [1, 2] visits every float of the binade once.
+    float     previous = 0.0f;
+    long long visited  = Bench::SweepFloats(1.0f, 2.0f, 0,
+                                            [&](float x)
+                                            {
+                                                assert(x > previous);
+                                                previous = x;
+                                            });
+    assert(visited == (1 << 23) + 1 && previous == 2.0f);
+    assert(Bench::SweepFloats(-1.0f, 1.0f, 1000, [](float) { }) <= 1001);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestBenchStats_Median();
+    TestBenchStats_MannWhitney();
+    TestBenchStats_Judge();
+    TestBenchStats_Baseline();
+    TestBenchStats_Ulp();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test BenchStats] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
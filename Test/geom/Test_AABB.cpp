@@ -0,0 +1,65 @@
+#include <ext/geom/DM_AABB.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+// Testing empty boxes and growth.
+void TestAABB_Expand()
+{
+    AABB box;
+    assert(box.IsEmpty());
+    assert(box.SurfaceArea() == 0.0f);
+
+    box.Expand(Vec3(1.0f, 2.0f, 3.0f));
+    assert(!box.IsEmpty());
+    assert(box.min == Vec3(1.0f, 2.0f, 3.0f) && box.max == Vec3(1.0f, 2.0f, 3.0f));
+
+    box.Expand(Vec3(-1.0f, 4.0f, 3.0f));
+    assert(box.min == Vec3(-1.0f, 2.0f, 3.0f) && box.max == Vec3(1.0f, 4.0f, 3.0f));
+    assert(box.Center() == Vec3(0.0f, 3.0f, 3.0f));
+    assert(box.Extent() == Vec3(2.0f, 2.0f, 0.0f));
+
+    AABB other(Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 1.0f));
+    AABB both = AABB::Union(box, other);
+    assert(both.min == Vec3(-1.0f, 0.0f, 0.0f) && both.max == Vec3(1.0f, 4.0f, 3.0f));
+    assert(AABB::Union(AABB(), other).min == other.min);
+
+    Vec3 points[3] = {Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, -2.0f, 0.0f), Vec3(0.0f, 0.0f, 5.0f)};
+    AABB fromPoints = AABB::FromPoints(points, 3);
+    assert(fromPoints.min == Vec3(0.0f, -2.0f, 0.0f) && fromPoints.max == Vec3(1.0f, 0.0f, 5.0f));
+    assert(AABB::FromPoints(points, 0).IsEmpty());
+}
+
+// Testing area, containment and overlap.
+void TestAABB_Queries()
+{
+    AABB unit(Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 1.0f));
+    assert(unit.SurfaceArea() == 6.0f);
+    assert(AABB(Vec3(0.0f, 0.0f, 0.0f), Vec3(2.0f, 3.0f, 4.0f)).SurfaceArea() == 52.0f);
+
+    assert(unit.Contains(Vec3(0.5f, 0.5f, 0.5f)));
+    assert(unit.Contains(Vec3(1.0f, 0.0f, 1.0f))); // Boundary is inside.
+    assert(!unit.Contains(Vec3(1.5f, 0.5f, 0.5f)));
+
+    assert(unit.Overlaps(AABB(Vec3(1.0f, 1.0f, 1.0f), Vec3(2.0f, 2.0f, 2.0f)))); // Touching.
+    assert(!unit.Overlaps(AABB(Vec3(1.1f, 0.0f, 0.0f), Vec3(2.0f, 1.0f, 1.0f))));
+    assert(!unit.Overlaps(AABB()));
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestAABB_Expand();
+    TestAABB_Queries();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test AABB] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "../Test_Common.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    float Lane(float4 v, int i)
+    {
+        alignas(16) float f[4];
+        _mm_store_ps(f, v);
+        return f[i];
+    }
+
+    // Scalar Moller-Trumbore in double, the reference for the batch kernel. condition is |d| |e1| |e2| / |det|, which
+    // grows as the ray grazes the triangle and scales the float error of the kernel (infinite for det == 0).
+    bool RayTriangle(const Vec3& o, const Vec3& d, const Vec3& v0, const Vec3& v1, const Vec3& v2, float tMax, double& t, double& u, double& v,
+                     double& condition)
+    {
+        double e1[3], e2[3], s[3], p[3], q[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            e1[i] = (double) v1[i] - v0[i];
+            e2[i] = (double) v2[i] - v0[i];
+            s[i]  = (double) o[i] - v0[i];
+        }
+        p[0]       = d[1] * e2[2] - d[2] * e2[1];
+        p[1]       = d[2] * e2[0] - d[0] * e2[2];
+        p[2]       = d[0] * e2[1] - d[1] * e2[0];
+        q[0]       = s[1] * e1[2] - s[2] * e1[1];
+        q[1]       = s[2] * e1[0] - s[0] * e1[2];
+        q[2]       = s[0] * e1[1] - s[1] * e1[0];
+        double det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        t = u = v = 0.0;
+        if (det == 0.0)
+        {
+            condition = DM_INFINITY_F;
+            return false;
+        }
+        double dd  = (double) d[0] * d[0] + (double) d[1] * d[1] + (double) d[2] * d[2];
+        double ee1 = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2];
+        double ee2 = e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2];
+        condition  = std::sqrt(dd * ee1 * ee2) / Abs(det);
+        u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+        v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) / det;
+        t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+        return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0 && t <= tMax;
+    }
+
+    bool RayBox(const Vec3& o, const Vec3& d, const AABB& b, float tMax, double& tEnter)
+    {
+        double enter = 0.0, exit = tMax;
+        for (int a = 0; a < 3; ++a)
+        {
+            double inv = 1.0 / d[a];
+            double t1  = (b.min[a] - (double) o[a]) * inv;
+            double t2  = (b.max[a] - (double) o[a]) * inv;
+            enter      = Max(enter, Min(t1, t2));
+            exit       = Min(exit, Max(t1, t2));
+        }
+        tEnter = enter;
+        return enter <= exit;
+    }
+
+    // Lanes whose reference result is this close to an edge, times the condition, may go either way in float. The
+    // kernel results match the reference within g_ValueTolerance times the condition (relative for t), with or
+    // without FMA contraction.
+    const double g_EdgeTolerance  = 1e-4;
+    const double g_ValueTolerance = 2e-5;
+} // namespace
+
+// Testing 4 rays against 1 triangle and 1 ray against 4 triangles against the scalar reference.
+void TestIntersect_RayTriangle()
+{
+    int hits = 0;
+    for (int iteration = 0; iteration < 5000; ++iteration)
+    {
+        Vec3 v0[4], v1[4], v2[4], o[4], d[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            v0[i] = RandomVec3(-1.0f, 1.0f);
+            v1[i] = RandomVec3(-1.0f, 1.0f);
+            v2[i] = RandomVec3(-1.0f, 1.0f);
+            o[i]  = RandomVec3(-3.0f, 3.0f);
+            // Aim at a point near the triangle, some lanes land outside the edges.
+            float a = Random(-0.2f, 1.0f), b = Random(-0.2f, 1.0f);
+            d[i]    = v0[i] + (v1[i] - v0[i]) * a + (v2[i] - v0[i]) * b - o[i];
+        }
+        float tMax = Random(0.5f, 1.5f);
+
+        // Lane i: ray i against triangle i.
+        float4 t, u, v;
+        int    mask = IntersectRayTriangle4(Vec3x4::Load(o), Vec3x4::Load(d), Vec3x4::Load(v0), Vec3x4::Load(v1), Vec3x4::Load(v2),
+                                            _mm_set1_ps(tMax), t, u, v);
+        for (int i = 0; i < 4; ++i)
+        {
+            double rt, ru, rv, condition;
+            bool   expected = RayTriangle(o[i], d[i], v0[i], v1[i], v2[i], tMax, rt, ru, rv, condition);
+            double edge     = Min(Min(Abs(ru), Abs(rv)), Min(Abs(1.0 - ru - rv), Min(Abs(rt), Abs(rt - tMax))));
+            if (edge < g_EdgeTolerance * condition)
+                continue;
+            assert(((mask >> i) & 1) == (int) expected);
+            if (expected)
+            {
+                ++hits;
+                assert(Abs(Lane(t, i) - rt) < g_ValueTolerance * condition * Max(1.0, Abs(rt)));
+                assert(Abs(Lane(u, i) - ru) < g_ValueTolerance * condition && Abs(Lane(v, i) - rv) < g_ValueTolerance * condition);
+            }
+        }
+
+        // 4 rays against triangle 0.
+        mask = IntersectRayTriangle4(Vec3x4::Load(o), Vec3x4::Load(d), v0[0], v1[0], v2[0], _mm_set1_ps(tMax), t, u, v);
+        for (int i = 0; i < 4; ++i)
+        {
+            double rt, ru, rv, condition;
+            bool   expected = RayTriangle(o[i], d[i], v0[0], v1[0], v2[0], tMax, rt, ru, rv, condition);
+            double edge     = Min(Min(Abs(ru), Abs(rv)), Min(Abs(1.0 - ru - rv), Min(Abs(rt), Abs(rt - tMax))));
+            if (edge >= g_EdgeTolerance * condition)
+                assert(((mask >> i) & 1) == (int) expected);
+        }
+
+        // Ray 0 against 4 triangles.
+        mask = IntersectRayTriangle4(o[0], d[0], Vec3x4::Load(v0), Vec3x4::Load(v1), Vec3x4::Load(v2), tMax, t, u, v);
+        for (int i = 0; i < 4; ++i)
+        {
+            double rt, ru, rv, condition;
+            bool   expected = RayTriangle(o[0], d[0], v0[i], v1[i], v2[i], tMax, rt, ru, rv, condition);
+            double edge     = Min(Min(Abs(ru), Abs(rv)), Min(Abs(1.0 - ru - rv), Min(Abs(rt), Abs(rt - tMax))));
+            if (edge >= g_EdgeTolerance * condition)
+                assert(((mask >> i) & 1) == (int) expected);
+        }
+    }
+    assert(hits > 500); // The setup must actually exercise hits.
+
+    // Parallel ray and degenerate triangle never hit.
+    float4 t, u, v;
+    Vec3   a(0.0f, 0.0f, 0.0f), b(1.0f, 0.0f, 0.0f), c(0.0f, 1.0f, 0.0f);
+    assert(IntersectRayTriangle4(Vec3(0.2f, 0.2f, 1.0f), Vec3(1.0f, 0.0f, 0.0f), Vec3x4(a), Vec3x4(b), Vec3x4(c), 10.0f, t, u, v) == 0);
+    assert(IntersectRayTriangle4(Vec3(0.2f, 0.2f, 1.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3x4(a), Vec3x4(b), Vec3x4(b), 10.0f, t, u, v) == 0);
+    assert(IntersectRayTriangle4(Vec3(0.2f, 0.3f, 1.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3x4(a), Vec3x4(b), Vec3x4(c), 10.0f, t, u, v) == 0xF);
+    assert(Lane(t, 0) == 1.0f && Abs(Lane(u, 0) - 0.2f) < 1e-6f && Abs(Lane(v, 0) - 0.3f) < 1e-6f);
+}
+
+// Testing the slab test in both packet shapes.
+void TestIntersect_RayAABB()
+{
+    for (int iteration = 0; iteration < 5000; ++iteration)
+    {
+        Vec3 o[4], d[4], inv[4], mn[4], mx[4];
+        AABB boxes[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            Vec3 c   = RandomVec3(-2.0f, 2.0f);
+            Vec3 e   = RandomVec3(0.1f, 1.0f);
+            boxes[i] = AABB(c - e, c + e);
+            mn[i]    = boxes[i].min;
+            mx[i]    = boxes[i].max;
+            o[i]     = RandomVec3(-5.0f, 5.0f);
+            d[i]     = RandomVec3(-1.0f, 1.0f) - o[i] * 0.2f;
+            inv[i]   = Vec3(1.0f / d[i].x, 1.0f / d[i].y, 1.0f / d[i].z);
+        }
+        float tMax = Random(1.0f, 20.0f);
+
+        float4 tEnter;
+        int    mask = IntersectRayAABB4(Vec3x4::Load(o), Vec3x4::Load(inv), Vec3x4::Load(mn), Vec3x4::Load(mx), _mm_set1_ps(tMax), tEnter);
+        for (int i = 0; i < 4; ++i)
+        {
+            double enter;
+            bool   expected = RayBox(o[i], d[i], boxes[i], tMax, enter);
+            double ignored;
+            bool   nearEdge = RayBox(o[i], d[i], AABB(mn[i] - Vec3(1e-4f, 1e-4f, 1e-4f), mx[i] + Vec3(1e-4f, 1e-4f, 1e-4f)), tMax * 1.001f, ignored) !=
+                            RayBox(o[i], d[i], AABB(mn[i] + Vec3(1e-4f, 1e-4f, 1e-4f), mx[i] - Vec3(1e-4f, 1e-4f, 1e-4f)), tMax * 0.999f, ignored);
+            if (nearEdge)
+                continue;
+            assert(((mask >> i) & 1) == (int) expected);
+            if (expected)
+                assert(Abs(Lane(tEnter, i) - enter) < 1e-4 * Max(1.0, enter));
+        }
+
+        int one = IntersectRayAABB4(Vec3x4::Load(o), Vec3x4::Load(inv), boxes[0], _mm_set1_ps(tMax), tEnter);
+        int all = IntersectRayAABB4(o[0], inv[0], Vec3x4::Load(mn), Vec3x4::Load(mx), tMax, tEnter);
+        (void) one;
+        (void) all;
+        assert(((one & 1) != 0) == ((mask & 1) != 0) && ((all & 1) != 0) == ((mask & 1) != 0)); // Lane 0 is the same pair.
+    }
+
+    // Axis parallel ray: infinite inverse direction.
+    float4 tEnter;
+    AABB   unit(Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 1.0f, 1.0f));
+    Vec3   inv(DM_INFINITY_F, DM_INFINITY_F, 1.0f);
+    assert(IntersectRayAABB4(Vec3x4(Vec3(0.5f, 0.5f, -2.0f)), Vec3x4(inv), unit, _mm_set1_ps(10.0f), tEnter) == 0xF);
+    assert(Lane(tEnter, 0) == 2.0f);
+    assert(IntersectRayAABB4(Vec3x4(Vec3(1.5f, 0.5f, -2.0f)), Vec3x4(inv), unit, _mm_set1_ps(10.0f), tEnter) == 0);
+    assert(IntersectRayAABB4(Vec3x4(Vec3(0.5f, 0.5f, -2.0f)), Vec3x4(inv), unit, _mm_set1_ps(1.0f), tEnter) == 0); // Beyond tMax.
+    assert(IntersectRayAABB4(Vec3x4(Vec3(0.5f, 0.5f, 0.5f)), Vec3x4(inv), unit, _mm_set1_ps(1.0f), tEnter) == 0xF); // Inside.
+    assert(Lane(tEnter, 0) == 0.0f);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(7);
+
+    TestIntersect_RayTriangle();
+    TestIntersect_RayAABB();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Intersect] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    // Bit by bit interleave, the definition the encoders are checked against.
+    unsigned long long Interleave(const unsigned int* axes, int dims, int bits)
+    {
+        unsigned long long code = 0;
+        for (int b = 0; b < bits; ++b)
+            for (int a = 0; a < dims; ++a)
+                code |= (unsigned long long) ((axes[a] >> b) & 1u) << (b * dims + a);
+        return code;
+    }
+
+    // Skilling's AxesToTranspose with branches, 3 axes of 10 bits, then the transposed bits read from x[0] to x[2].
+    unsigned int HilbertReference(unsigned int x, unsigned int y, unsigned int z)
+    {
+        unsigned int a[3] = { x, y, z };
+        for (unsigned int q = 1u << 9; q > 1; q >>= 1)
+        {
+            unsigned int p = q - 1;
+            for (int i = 0; i < 3; ++i)
+            {
+                if (a[i] & q)
+                    a[0] ^= p;
+                else
+                {
+                    unsigned int t = (a[0] ^ a[i]) & p;
+                    a[0] ^= t;
+                    a[i] ^= t;
+                }
+            }
+        }
+        a[1] ^= a[0];
+        a[2] ^= a[1];
+        unsigned int t = 0;
+        for (unsigned int q = 1u << 9; q > 1; q >>= 1)
+            if (a[2] & q)
+                t ^= q - 1;
+        for (int i = 0; i < 3; ++i)
+            a[i] ^= t;
+
+        unsigned int axes[3] = { a[2], a[1], a[0] };
+        return (unsigned int) Interleave(axes, 3, 10);
+    }
+
+    unsigned int Lane(int4 v, int i)
+    {
+        alignas(16) unsigned int lanes[4];
+        _mm_store_si128(reinterpret_cast<int4*>(lanes), v);
+        return lanes[i];
+    }
+} // namespace
+
+// Testing the scalar and SSE encoders against the bit by bit interleave, and that decoding gives the input back.
+void TestMorton_EncodeDecode()
+{
+    for (unsigned int i = 0; i < 2000; ++i)
+    {
+        unsigned int axes[3] = { (i * 2654435761u) >> 7, (i * 40503u + 17u) ^ (i << 9), i * 977u };
+
+        unsigned int c2 = MortonEncode2D(axes[0], axes[1]);
+        unsigned int low16[2] = { axes[0] & 0xFFFFu, axes[1] & 0xFFFFu };
+        assert(c2 == Interleave(low16, 2, 16));
+        unsigned int x, y, z;
+        MortonDecode2D(c2, x, y);
+        assert(x == low16[0] && y == low16[1]);
+
+        unsigned int c3 = MortonEncode3D(axes[0], axes[1], axes[2]);
+        unsigned int low10[3] = { axes[0] & 0x3FFu, axes[1] & 0x3FFu, axes[2] & 0x3FFu };
+        assert(c3 == Interleave(low10, 3, 10));
+        MortonDecode3D(c3, x, y, z);
+        assert(x == low10[0] && y == low10[1] && z == low10[2]);
+
+        unsigned long long c64 = MortonEncode3D64(axes[0], axes[1], axes[2]);
+        unsigned int low21[3] = { axes[0] & 0x1FFFFFu, axes[1] & 0x1FFFFFu, axes[2] & 0x1FFFFFu };
+        assert(c64 == Interleave(low21, 3, 21));
+        MortonDecode3D64(c64, x, y, z);
+        assert(x == low21[0] && y == low21[1] && z == low21[2]);
+
+        // The 4 lane versions agree with the scalar ones in every lane.
+        int4 vx = _mm_set_epi32(7, (int) axes[2], (int) axes[1], (int) axes[0]);
+        int4 vy = _mm_set_epi32((int) axes[0], 1023, (int) axes[2], (int) axes[1]);
+        int4 vz = _mm_set_epi32((int) axes[1], (int) axes[0], 0, (int) axes[2]);
+        int4 m3 = MortonEncode3D(vx, vy, vz);
+        int4 m2 = MortonEncode2D(vx, vy);
+        int4 dx, dy, dz;
+        MortonDecode3D(m3, dx, dy, dz);
+        for (int l = 0; l < 4; ++l)
+        {
+            assert(Lane(m3, l) == MortonEncode3D(Lane(vx, l), Lane(vy, l), Lane(vz, l)));
+            assert(Lane(m2, l) == MortonEncode2D(Lane(vx, l), Lane(vy, l)));
+            assert(Lane(dz, l) == (Lane(vz, l) & 0x3FFu));
+        }
+        MortonDecode2D(m2, dx, dy);
+        assert(Lane(dy, 3) == ((unsigned int) axes[0] & 0xFFFFu));
+    }
+}
+
+// Testing the Hilbert index against Skilling's branchy version, its inverse, and that it only steps to neighbor cells.
+void TestMorton_Hilbert()
+{
+    for (unsigned int i = 0; i < 3000; ++i)
+    {
+        unsigned int x = (i * 2654435761u) >> 22, y = (i * 7919u) & 1023u, z = (i * 31u + (i >> 3)) & 1023u;
+        unsigned int code = HilbertEncode3D(x, y, z);
+        assert(code == HilbertReference(x, y, z));
+        unsigned int dx, dy, dz;
+        HilbertDecode3D(code, dx, dy, dz);
+        assert(dx == x && dy == y && dz == z);
+    }
+
+    unsigned int px, py, pz;
+    HilbertDecode3D(0, px, py, pz);
+    assert(px == 0 && py == 0 && pz == 0);
+    for (unsigned int code = 1; code < 40000; ++code)
+    {
+        unsigned int x, y, z;
+        HilbertDecode3D(code, x, y, z);
+        int step = Abs((int) x - (int) px) + Abs((int) y - (int) py) + Abs((int) z - (int) pz);
+        assert(step == 1);
+        px = x;
+        py = y;
+        pz = z;
+    }
+}
+
+// Testing the batched codes of Vec3 arrays quantized against bounds, including the padded tail.
+void TestMorton_Batch()
+{
+    const size_t count = 23;
+    Vec3         points[count];
+    for (size_t i = 0; i < count; ++i)
+        points[i] = Vec3((float) i * 0.37f - 2.0f, (float) (i * i % 11) * 0.5f, 3.0f - (float) i * 0.1f);
+    points[5] = Vec3(-100.0f, 100.0f, 0.0f); // Outside the bounds, clamped.
+
+    AABB               bounds(Vec3(-2.0f, 0.0f, 0.0f), Vec3(6.0f, 5.0f, 3.0f));
+    unsigned int       codes[count], hilbert[count];
+    unsigned long long codes64[count];
+    MortonCodes(points, count, bounds, codes);
+    MortonCodes(points, count, bounds, codes64);
+    HilbertCodes(points, count, bounds, hilbert);
+
+    Vec3 extent = bounds.Extent();
+    for (size_t i = 0; i < count; ++i)
+    {
+        unsigned int q10[3], q21[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            float t = (points[i][a] - bounds.min[a]) / extent[a];
+            q10[a]  = (unsigned int) Clamp(Floor(t * 1024.0f), 0, 1023);
+            q21[a]  = (unsigned int) Clamp(Floor(t * 2097152.0f), 0, 2097151);
+        }
+        // The quantization multiplies by the reciprocal extent, allow one cell of rounding.
+        unsigned int x, y, z;
+        MortonDecode3D(codes[i], x, y, z);
+        assert(Abs((int) x - (int) q10[0]) <= 1 && Abs((int) y - (int) q10[1]) <= 1 && Abs((int) z - (int) q10[2]) <= 1);
+        assert(hilbert[i] == HilbertEncode3D(x, y, z));
+        MortonDecode3D64(codes64[i], x, y, z);
+        assert(Abs((int) x - (int) q21[0]) <= 1 && Abs((int) y - (int) q21[1]) <= 1 && Abs((int) z - (int) q21[2]) <= 1);
+    }
+
+    unsigned int x, y, z;
+    MortonDecode3D(codes[5], x, y, z);
+    assert(x == 0 && y == 1023);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestMorton_EncodeDecode();
+    TestMorton_Hilbert();
+    TestMorton_Batch();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Morton] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include "../Test_Common.h"
+
+#include <ext/geom/DM_PointCloud.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    // Two pass reference in double.
+    void ReferenceStats(const std::vector<Vec3>& points, double mean[3], double covariance[3][3])
+    {
+        const double n = (double) points.size();
+        for (int i = 0; i < 3; ++i)
+        {
+            mean[i] = 0.0;
+            for (const Vec3& p : points)
+                mean[i] += Component(p, i);
+            mean[i] /= n;
+        }
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+            {
+                covariance[i][j] = 0.0;
+                for (const Vec3& p : points)
+                    covariance[i][j] += (Component(p, i) - mean[i]) * (Component(p, j) - mean[j]);
+                covariance[i][j] /= n;
+            }
+    }
+
+    bool Identical(const PointStats& a, const PointStats& b)
+    {
+        for (int k = 0; k < 9; ++k)
+            if (a.covariance.Data()[k] != b.covariance.Data()[k])
+                return false;
+        return a.count == b.count && a.mean == b.mean && a.bounds.min == b.bounds.min && a.bounds.max == b.bounds.max;
+    }
+} // namespace
+
+// Testing bounds, mean and covariance against a double reference for every tail of the 4 point groups and for points
+// far from the origin, where summing squares without a shift cancels.
+void TestPointCloud_Stats()
+{
+    for (size_t count = 1; count <= 9; ++count)
+    {
+        std::vector<Vec3> points(count);
+        for (Vec3& p : points)
+            p = Vec3(Random(-1.0f, 1.0f), Random(-2.0f, 2.0f), Random(0.0f, 1.0f));
+        const PointStats stats = ComputePointStats(points.data(), count);
+
+        double mean[3], covariance[3][3];
+        ReferenceStats(points, mean, covariance);
+        assert(stats.count == count);
+        const AABB bounds = AABB::FromPoints(points.data(), count);
+        assert(stats.bounds.min == bounds.min && stats.bounds.max == bounds.max);
+        for (int i = 0; i < 3; ++i)
+        {
+            assert(Abs(Component(stats.mean, i) - mean[i]) < 1e-5);
+            for (int j = 0; j < 3; ++j)
+                assert(Abs(stats.covariance.Data()[3 * i + j] - covariance[i][j]) < 1e-5);
+        }
+    }
+
+    const size_t      count = 100003; // Several blocks and chunks and a tail.
+    std::vector<Vec3> points(count);
+    for (Vec3& p : points)
+        p = Vec3(10000.0f + Random(-1.0f, 1.0f), -5000.0f + Random(-0.5f, 0.5f), 20000.0f + Random(-3.0f, 3.0f));
+    const PointStats stats = ComputePointStats(points.data(), count);
+
+    double mean[3], covariance[3][3];
+    ReferenceStats(points, mean, covariance);
+    for (int i = 0; i < 3; ++i)
+    {
+        assert(Abs(Component(stats.mean, i) - mean[i]) < 2e-3);
+        for (int j = 0; j < 3; ++j)
+            assert(Abs(stats.covariance.Data()[3 * i + j] - covariance[i][j]) < 1e-5 * (1.0 + Abs(covariance[i][j])));
+    }
+
+    assert(ComputePointStats(points.data(), 0).count == 0);
+}
+
+// Testing that merging the stats of two halves gives the stats of the whole, and that the pool doesn't change the bits.
+void TestPointCloud_Merge()
+{
+    std::vector<Vec3> points(50000);
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = i < 20000 ? Vec3(Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f))
+                              : Vec3(Random(9.0f, 11.0f), Random(-1.0f, 0.0f), Random(4.0f, 5.0f));
+
+    const PointStats whole  = ComputePointStats(points.data(), points.size());
+    const PointStats merged = PointStats::Merge(ComputePointStats(points.data(), 20000), ComputePointStats(points.data() + 20000, 30000));
+    assert(merged.count == whole.count);
+    assert(merged.bounds.min == whole.bounds.min && merged.bounds.max == whole.bounds.max);
+    for (int i = 0; i < 3; ++i)
+        assert(Abs(Component(merged.mean, i) - Component(whole.mean, i)) < 1e-4f);
+    for (int k = 0; k < 9; ++k)
+        assert(Abs(merged.covariance.Data()[k] - whole.covariance.Data()[k]) < 1e-4f * (1.0f + Abs(whole.covariance.Data()[k])));
+    assert(Identical(PointStats::Merge(whole, PointStats()), whole) && Identical(PointStats::Merge(PointStats(), whole), whole));
+
+    ThreadPool         pool(3);
+    PointCloudSettings parallel;
+    parallel.parallelThreshold = 0;
+    parallel.pool              = &pool;
+    PointCloudSettings serial;
+    serial.parallelThreshold = (size_t) -1;
+    assert(Identical(ComputePointStats(points.data(), points.size(), parallel), ComputePointStats(points.data(), points.size(), serial)));
+}
+
+// Testing the PCA box of points filling a rotated box: the axes follow the rotation, the box holds every point and
+// is close to the box the points were drawn from.
+void TestPointCloud_FitOBB()
+{
+    const Mat3x3      rotation = ExactRotation();
+    const Vec3        center(3.0f, -2.0f, 7.0f);
+    const Vec3        half(4.0f, 2.0f, 0.5f);
+    std::vector<Vec3> points(20000);
+    for (Vec3& p : points)
+        p = center + rotation * Vec3(Random(-half.x, half.x), Random(-half.y, half.y), Random(-half.z, half.z));
+
+    ThreadPool         pool(2);
+    PointCloudSettings settings;
+    settings.parallelThreshold = 0;
+    settings.pool              = &pool;
+    const OBB box              = FitOBB(points.data(), points.size(), settings);
+
+    for (int j = 0; j < 3; ++j)
+    {
+        float dot = 0.0f;
+        for (int i = 0; i < 3; ++i)
+            dot += box.axes.Data()[3 * i + j] * rotation.Data()[3 * i + j];
+        assert(Abs(dot) > 0.999f); // Up to the sign of the axis.
+    }
+    assert(Abs(box.axes.Determinant() - 1.0f) < 1e-5f);
+    for (int i = 0; i < 3; ++i)
+    {
+        assert(Abs(Component(box.halfExtents, i) - Component(half, i)) < 0.05f);
+        assert(Abs(Component(box.center, i) - Component(center, i)) < 0.05f);
+    }
+    for (const Vec3& p : points)
+        assert(box.Contains(p, 1e-4f));
+    assert(!box.Contains(center + rotation * Vec3(0.0f, 0.0f, 1.0f)));
+    const AABB bounds = AABB::FromPoints(points.data(), points.size());
+    assert(box.Volume() < bounds.Extent().x * bounds.Extent().y * bounds.Extent().z);
+
+    // Fixed axes: the identity gives the bounding box.
+    const OBB aligned = FitOBB(points.data(), points.size(), Mat3x3::Identity());
+    assert(aligned.center == bounds.Center() && aligned.halfExtents == bounds.Extent() * 0.5f);
+
+    const OBB single = FitOBB(points.data(), 1);
+    assert(single.center == points[0] && single.halfExtents == Vec3(0.0f, 0.0f, 0.0f));
+    assert(FitOBB(points.data(), 0).Volume() == 0.0f);
+}
+
+// Testing the PCA box of the same rotated box far from unit scale. The covariances are around 1e-24 and 1e24, their
+// squares leave the float range, yet the eigen solver must find the same axes.
+void TestPointCloud_FitOBBScale()
+{
+    const Mat3x3 rotation = ExactRotation();
+    const Vec3   half(4.0f, 2.0f, 0.5f);
+    for (float scale : { 1e-12f, 1e12f })
+    {
+        std::vector<Vec3> points(5000);
+        for (Vec3& p : points)
+            p = rotation * Vec3(Random(-half.x, half.x), Random(-half.y, half.y), Random(-half.z, half.z)) * scale;
+        const OBB box = FitOBB(points.data(), points.size());
+
+        for (int j = 0; j < 3; ++j)
+        {
+            float dot = 0.0f;
+            for (int i = 0; i < 3; ++i)
+                dot += box.axes.Data()[3 * i + j] * rotation.Data()[3 * i + j];
+            assert(Abs(dot) > 0.999f);
+        }
+        for (int i = 0; i < 3; ++i)
+            assert(Abs(Component(box.halfExtents, i) / scale - Component(half, i)) < 0.05f);
+        for (const Vec3& p : points)
+            assert(box.Contains(p, 1e-4f * scale));
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(17);
+
+    TestPointCloud_Stats();
+    TestPointCloud_Merge();
+    TestPointCloud_FitOBB();
+    TestPointCloud_FitOBBScale();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test PointCloud] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+
+namespace
+{
+    bool NearlyEqual(const Vec2& a, const Vec2& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps; }
+
+    bool NearlyEqual(const Vec3& a, const Vec3& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps; }
+
+    bool NearlyEqual(const Vec4& a, const Vec4& b, float eps)
+    {
+        return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps && Abs(a.w - b.w) <= eps;
+    }
+
+    // de Casteljau, the reference for the power form.
+    Vec3 Casteljau(const Vec3* p, float t)
+    {
+        Vec3 a = Lerp(p[0], p[1], t), b = Lerp(p[1], p[2], t), c = Lerp(p[2], p[3], t);
+        return Lerp(Lerp(a, b, t), Lerp(b, c, t), t);
+    }
+
+    float DistanceToSegment(const Vec3& p, const Vec3& a, const Vec3& b)
+    {
+        Vec3  ab = b - a;
+        float t  = ab.LengthSquared() > 0.0f ? Clamp(Vec3::Dot(p - a, ab) / ab.LengthSquared(), 0.0f, 1.0f) : 0.0f;
+        return (a + ab * t - p).Length();
+    }
+
+    const Vec3 g_Control[4] = { Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f, 4.0f, -1.0f), Vec3(5.0f, -2.0f, 2.0f), Vec3(6.0f, 1.0f, 0.5f) };
+} // namespace
+
+// Testing the three bases against their definitions.
+void TestSpline_Bases()
+{
+    CubicCurve<Vec3> bezier = CubicCurve<Vec3>::Bezier(g_Control[0], g_Control[1], g_Control[2], g_Control[3]);
+    for (float t = 0.0f; t <= 1.0f; t += 0.0625f)
+        assert(NearlyEqual(bezier.Evaluate(t), Casteljau(g_Control, t), 1e-5f));
+    assert(NearlyEqual(bezier.Derivative(0.0f), (g_Control[1] - g_Control[0]) * 3.0f, 1e-5f));
+    assert(NearlyEqual(bezier.Derivative(1.0f), (g_Control[3] - g_Control[2]) * 3.0f, 1e-5f));
+
+    CubicCurve<Vec3> hermite = CubicCurve<Vec3>::Hermite(g_Control[0], g_Control[1], g_Control[3], g_Control[2]);
+    assert(NearlyEqual(hermite.Evaluate(0.0f), g_Control[0], 1e-6f) && NearlyEqual(hermite.Evaluate(1.0f), g_Control[3], 1e-5f));
+    assert(NearlyEqual(hermite.Derivative(0.0f), g_Control[1], 1e-6f) && NearlyEqual(hermite.Derivative(1.0f), g_Control[2], 1e-5f));
+
+    CubicCurve<Vec3> catmull = CubicCurve<Vec3>::CatmullRom(g_Control[0], g_Control[1], g_Control[2], g_Control[3]);
+    assert(NearlyEqual(catmull.Evaluate(0.0f), g_Control[1], 1e-6f) && NearlyEqual(catmull.Evaluate(1.0f), g_Control[2], 1e-5f));
+    assert(NearlyEqual(catmull.Derivative(0.0f), (g_Control[2] - g_Control[0]) * 0.5f, 1e-5f));
+
+    CubicCurve<Vec2> flat = CubicCurve<Vec2>::Bezier(Vec2(0.0f, 0.0f), Vec2(1.0f, 2.0f), Vec2(3.0f, 2.0f), Vec2(4.0f, 0.0f));
+    assert(NearlyEqual(flat.Evaluate(0.5f), Vec2(2.0f, 1.5f), 1e-6f));
+}
+
+// Testing the batched and forward differenced evaluation against single evaluations.
+void TestSpline_Batch()
+{
+    std::vector<float> t(11);
+    for (size_t i = 0; i < t.size(); ++i)
+        t[i] = (float) i / 10.0f;
+
+    CubicCurve<Vec2> curve2 = CubicCurve<Vec2>::Bezier(Vec2(0.0f, 1.0f), Vec2(2.0f, 3.0f), Vec2(-1.0f, 2.0f), Vec2(4.0f, 0.0f));
+    CubicCurve<Vec3> curve3 = CubicCurve<Vec3>::Bezier(g_Control[0], g_Control[1], g_Control[2], g_Control[3]);
+    CubicCurve<Vec4> curve4 = CubicCurve<Vec4>::CatmullRom(Vec4(0, 1, 2, 3), Vec4(1, 0, 2, -1), Vec4(4, 2, 0, 1), Vec4(5, 5, 5, 5));
+    std::vector<Vec2> out2(t.size());
+    std::vector<Vec3> out3(t.size());
+    std::vector<Vec4> out4(t.size());
+    curve2.Evaluate(t.data(), t.size(), out2.data());
+    curve3.Evaluate(t.data(), t.size(), out3.data());
+    curve4.Evaluate(t.data(), t.size(), out4.data());
+    for (size_t i = 0; i < t.size(); ++i)
+    {
+        assert(NearlyEqual(out2[i], curve2.Evaluate(t[i]), 1e-6f));
+        assert(NearlyEqual(out3[i], curve3.Evaluate(t[i]), 1e-6f));
+        assert(NearlyEqual(out4[i], curve4.Evaluate(t[i]), 1e-6f));
+    }
+
+    const size_t      counts[3] = { 0, 1, 1000 };
+    std::vector<Vec3> samples(1001);
+    for (int c = 0; c < 3; ++c)
+    {
+        curve3.SampleUniform(counts[c], samples.data());
+        for (size_t i = 0; i <= counts[c]; ++i)
+            assert(NearlyEqual(samples[i], curve3.Evaluate(counts[c] ? (float) i / (float) counts[c] : 0.0f), 1e-4f));
+        assert(samples[counts[c]] == curve3.Evaluate(counts[c] ? 1.0f : 0.0f));
+    }
+}
+
+// Testing that the polyline stays within the tolerance and chains over segments.
+void TestSpline_Flatten()
+{
+    CubicCurve<Vec3>   curve = CubicCurve<Vec3>::Bezier(g_Control[0], g_Control[1], g_Control[2], g_Control[3]);
+    const float        tolerances[3] = { 0.5f, 0.05f, 0.001f };
+    size_t             previous      = 0;
+    AlignedArray<Vec3> points;
+    for (int k = 0; k < 3; ++k)
+    {
+        points.Clear();
+        curve.Flatten(tolerances[k], points);
+        assert(points.Size() > previous && points[0] == g_Control[0] && points[points.Size() - 1] == curve.Evaluate(1.0f));
+        previous = points.Size();
+
+        for (float t = 0.0f; t <= 1.0f; t += 1.0f / 2048.0f)
+        {
+            Vec3  p    = curve.Evaluate(t);
+            float best = DM_INFINITY_F;
+            for (size_t i = 0; i + 1 < points.Size(); ++i)
+                best = Min(best, DistanceToSegment(p, points[i], points[i + 1]));
+            assert(best <= tolerances[k] * 1.01f + 1e-5f);
+        }
+    }
+
+    // A straight curve needs a single line, and the next segment doesn't repeat the shared point.
+    CubicCurve<Vec3> line = CubicCurve<Vec3>::Bezier(Vec3(0, 0, 0), Vec3(1, 1, 1), Vec3(2, 2, 2), Vec3(3, 3, 3));
+    points.Clear();
+    line.Flatten(0.01f, points);
+    assert(points.Size() == 2);
+    CubicCurve<Vec3>::Bezier(Vec3(3, 3, 3), Vec3(4, 4, 4), Vec3(5, 5, 5), Vec3(6, 6, 6)).Flatten(0.01f, points);
+    assert(points.Size() == 3 && points[2] == Vec3(6, 6, 6));
+}
+
+// Testing distances to parameters on a chain whose parameter speed varies a lot.
+void TestSpline_ArcLength()
+{
+    // x = 10 t^3 on the first segment, then a straight line from 10 to 20 at constant speed.
+    CubicCurve<Vec3> chain[2] = { CubicCurve<Vec3>::Bezier(Vec3(0, 0, 0), Vec3(0, 0, 0), Vec3(0, 0, 0), Vec3(10, 0, 0)),
+                                  CubicCurve<Vec3>::Hermite(Vec3(10, 0, 0), Vec3(10, 0, 0), Vec3(20, 0, 0), Vec3(10, 0, 0)) };
+    ArcLengthTable   table;
+    assert(table.Length() == 0.0f && table.Parameter(3.0f) == 0.0f);
+    table.Build(chain, 2, 256);
+    assert(table.SegmentCount() == 2 && Abs(table.Length() - 20.0f) < 1e-3f);
+
+    std::vector<float> distances, parameters;
+    for (float d = -1.0f; d <= 21.0f; d += 0.25f)
+        distances.push_back(d);
+    parameters.resize(distances.size());
+    table.Parameters(distances.data(), distances.size(), parameters.data());
+    for (size_t i = 0; i < distances.size(); ++i)
+    {
+        float u = table.Parameter(distances[i]);
+        assert(u == parameters[i] && u >= 0.0f && u <= 2.0f);
+
+        int  segment = Min((int) u, 1);
+        Vec3 p       = chain[segment].Evaluate(u - (float) segment);
+        assert(Abs(p.x - Clamp(distances[i], 0.0f, 20.0f)) < 0.02f);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestSpline_Bases();
+    TestSpline_Batch();
+    TestSpline_Flatten();
+    TestSpline_ArcLength();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Spline] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,2 @@
+// DM_Animation.h compiles as the first include of a translation unit.
+#include <ext/anim/DM_Animation.h>
@@ -0,0 +1,2 @@
+// DM_ArrayFile.h compiles as the first include of a translation unit.
+#include <ext/io/DM_ArrayFile.h>
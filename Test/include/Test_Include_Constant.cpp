@@ -0,0 +1,2 @@
+// DM_Constant.h compiles as the first include of a translation unit.
+#include <ext/DM_Constant.h>
@@ -0,0 +1,2 @@
+// DM_DualQuat.h compiles as the first include of a translation unit.
+#include <ext/quat/DM_DualQuat.h>
@@ -0,0 +1,2 @@
+// DM_Enum.h compiles as the first include of a translation unit.
+#include <ext/DM_Enum.h>
@@ -0,0 +1,2 @@
+// DM_KDTree.h compiles as the first include of a translation unit.
+#include <ext/spatial/DM_KDTree.h>
@@ -0,0 +1,2 @@
+// DM_Mat4x4.h compiles as the first include of a translation unit.
+#include <ext/mat/DM_Mat4x4.h>
@@ -0,0 +1,2 @@
+// DM_MatN.h compiles as the first include of a translation unit.
+#include <ext/mat/DM_MatN.h>
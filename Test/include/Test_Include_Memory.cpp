@@ -0,0 +1,2 @@
+// DM_Memory.h compiles as the first include of a translation unit.
+#include <ext/DM_Memory.h>
@@ -0,0 +1,2 @@
+// DM_NormalPack.h compiles as the first include of a translation unit.
+#include <ext/pack/DM_NormalPack.h>
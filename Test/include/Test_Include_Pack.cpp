@@ -0,0 +1,2 @@
+// DM_Pack.h compiles as the first include of a translation unit.
+#include <ext/pack/DM_Pack.h>
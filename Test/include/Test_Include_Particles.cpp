@@ -0,0 +1,2 @@
+// DM_Particles.h compiles as the first include of a translation unit.
+#include <ext/sim/DM_Particles.h>
@@ -0,0 +1,2 @@
+// DM_Profile.h compiles as the first include of a translation unit.
+#include <ext/DM_Profile.h>
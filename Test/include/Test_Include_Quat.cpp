@@ -0,0 +1,2 @@
+// DM_Quat.h compiles as the first include of a translation unit.
+#include <ext/quat/DM_Quat.h>
@@ -0,0 +1,2 @@
+// DM_RadixSort.h compiles as the first include of a translation unit.
+#include <ext/sort/DM_RadixSort.h>
@@ -0,0 +1,2 @@
+// DM_SVD3.h compiles as the first include of a translation unit.
+#include <ext/mat/DM_SVD3.h>
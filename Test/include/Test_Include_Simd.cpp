@@ -0,0 +1,2 @@
+// DM_Simd.h compiles as the first include of a translation unit.
+#include <ext/utils/DM_Simd.h>
@@ -0,0 +1,2 @@
+// DM_Spline.h compiles as the first include of a translation unit.
+#include <ext/geom/DM_Spline.h>
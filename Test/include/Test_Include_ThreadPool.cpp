@@ -0,0 +1,2 @@
+// DM_ThreadPool.h compiles as the first include of a translation unit.
+#include <ext/thread/DM_ThreadPool.h>
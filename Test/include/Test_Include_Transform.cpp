@@ -0,0 +1,2 @@
+// DM_Transform.h compiles as the first include of a translation unit.
+#include <ext/mat/DM_Transform.h>
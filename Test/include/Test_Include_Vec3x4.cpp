@@ -0,0 +1,2 @@
+// DM_Vec3x4.h compiles as the first include of a translation unit.
+#include <ext/vec/DM_Vec3x4.h>
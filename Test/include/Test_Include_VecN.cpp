@@ -0,0 +1,2 @@
+// DM_VecN.h compiles as the first include of a translation unit.
+#include <ext/vec/DM_VecN.h>
@@ -0,0 +1,208 @@
+#include <DropMath.h>
+#include <ext/io/DM_ArrayFile.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    const char* g_PATH = "Test_ArrayFile.dmaf";
+
+    bool IsAligned(const void* p)
+    {
+        return reinterpret_cast<uintptr_t>(p) % ARRAY_FILE_ALIGNMENT == 0;
+    }
+} // anonymous namespace
+
+// Testing AoS round trip of every vector type, zero copy and aligned.
+void TestArrayFile_AoS()
+{
+    const int count = 100;
+    Vec3      points[count];
+    Vec4      colors[count];
+    for (int i = 0; i < count; ++i)
+    {
+        points[i] = Vec3((float) i, i * 2.0f, i * -3.0f);
+        colors[i] = Vec4(i * 0.01f, 0.5f, 1.0f, 1.0f);
+    }
+
+    ArrayFileWriter writer;
+    assert(writer.Open(g_PATH));
+    assert(writer.BeginSection("points", ARRAY_TYPE_VEC3));
+    assert(writer.Write(points, 40)); // Streamed in two parts.
+    assert(writer.Write(points + 40, count - 40));
+    assert(!writer.Write(colors, count)); // Wrong type for this section.
+    assert(writer.EndSection());
+    assert(writer.BeginSection("colors", ARRAY_TYPE_VEC4));
+    assert(writer.Write(colors, count));
+    assert(writer.EndSection());
+    assert(writer.Close());
+
+    ArrayFileReader reader;
+    assert(reader.Open(g_PATH));
+    assert(reader.SectionCount() == 2);
+
+    int pointSection = reader.FindSection("points");
+    int colorSection = reader.FindSection("colors");
+    assert(pointSection == 0 && colorSection == 1);
+    assert(reader.FindSection("missing") == -1);
+    assert(reader.Section(pointSection).count == count);
+
+    const Vec3* p = reader.View<Vec3>(pointSection);
+    const Vec4* c = reader.View<Vec4>(colorSection);
+    assert(p && c);
+    assert(IsAligned(p) && IsAligned(c));
+    assert(reader.View<Vec4>(pointSection) == nullptr);
+    for (int i = 0; i < count; ++i)
+    {
+        assert(p[i] == points[i]);
+        assert(c[i] == colors[i]);
+    }
+    reader.Close();
+    assert(!reader.IsOpen());
+}
+
+// Testing SoA streams, each component aligned on its own.
+void TestArrayFile_SoA()
+{
+    const int count = 37;
+    Vec3      points[count];
+    for (int i = 0; i < count; ++i)
+        points[i] = Vec3((float) i, i + 0.5f, -(float) i);
+
+    ArrayFileWriter writer;
+    assert(writer.Open(g_PATH));
+    assert(!writer.BeginSection("points", ARRAY_TYPE_VEC3, 0, ARRAY_LAYOUT_SOA)); // SoA needs a count.
+    assert(writer.BeginSection("points", ARRAY_TYPE_VEC3, count, ARRAY_LAYOUT_SOA));
+    assert(writer.Write(points, 10));
+    assert(writer.Write(points + 10, count - 10));
+    assert(!writer.Write(points, 1)); // More than announced.
+    assert(writer.EndSection());
+    assert(writer.Close());
+
+    ArrayFileReader reader;
+    assert(reader.Open(g_PATH));
+    assert(reader.View<Vec3>(0) == nullptr);
+    const float* xs = reader.Stream(0, 0);
+    const float* ys = reader.Stream(0, 1);
+    const float* zs = reader.Stream(0, 2);
+    assert(IsAligned(xs) && IsAligned(ys) && IsAligned(zs));
+    for (int i = 0; i < count; ++i)
+        assert(Vec3(xs[i], ys[i], zs[i]) == points[i]);
+}
+
+// Testing a SoA section left short is dropped and fails Close, whether it is ended explicitly or by Close.
+void TestArrayFile_ShortSection()
+{
+    Vec3 points[4] = {Vec3::Up(), Vec3::Down(), Vec3::Left(), Vec3::Forward()};
+
+    ArrayFileWriter writer;
+    assert(writer.Open(g_PATH));
+    assert(writer.BeginSection("full", ARRAY_TYPE_VEC3, 4, ARRAY_LAYOUT_SOA));
+    assert(writer.Write(points, 4));
+    assert(writer.EndSection());
+    assert(writer.BeginSection("short", ARRAY_TYPE_VEC3, 4, ARRAY_LAYOUT_SOA));
+    assert(writer.Write(points, 3));
+    assert(!writer.EndSection());
+    assert(!writer.Close());
+
+    // The sections before it are still readable.
+    ArrayFileReader reader;
+    assert(reader.Open(g_PATH));
+    assert(reader.SectionCount() == 1 && reader.FindSection("short") == -1);
+    assert(reader.Stream(0, 2)[3] == points[3].z);
+    reader.Close();
+
+    assert(writer.Open(g_PATH));
+    assert(writer.BeginSection("short", ARRAY_TYPE_VEC3, 4, ARRAY_LAYOUT_SOA));
+    assert(writer.Write(points, 2));
+    assert(!writer.Close());
+
+    // Reopening starts clean.
+    assert(writer.Open(g_PATH));
+    assert(writer.Close());
+}
+
+// Testing matrices in both alignments and half precision.
+void TestArrayFile_MatricesAndHalf()
+{
+    Mat4x4 transforms[3] = {
+        Mat4x4::Identity(),
+        Mat4x4(Vec4(1, 2, 3, 4), Vec4(5, 6, 7, 8), Vec4(9, 10, 11, 12), Vec4(13, 14, 15, 16)),
+        Mat4x4(Vec4(0, 1, 0, 5), Vec4(-1, 0, 0, 6), Vec4(0, 0, 1, 7), Vec4(0, 0, 0, 1))};
+    Vec3 normals[5] = {Vec3::Up(), Vec3::Down(), Vec3(0.5f, 0.25f, -0.125f), Vec3::Left(), Vec3::Forward()};
+
+    ArrayFileWriter writer;
+    assert(writer.Open(g_PATH));
+    assert(writer.BeginSection("rows", ARRAY_TYPE_MAT4X4));
+    assert(writer.Write(transforms, 3));
+    assert(writer.EndSection());
+    assert(writer.BeginSection("cols", ARRAY_TYPE_MAT4X4, 0, ARRAY_LAYOUT_AOS, ARRAY_PRECISION_F32, MATRIX_ALLIGNMENT_COLUMN_MAJOR));
+    assert(writer.Write(transforms, 3));
+    assert(writer.EndSection());
+    assert(writer.BeginSection("normals", ARRAY_TYPE_VEC3, 0, ARRAY_LAYOUT_AOS, ARRAY_PRECISION_F16));
+    assert(writer.Write(normals, 5));
+    assert(writer.EndSection());
+    assert(writer.Close());
+
+    ArrayFileReader reader;
+    assert(reader.Open(g_PATH));
+
+    const Mat4x4* rows = reader.View<Mat4x4>(0);
+    assert(rows && IsAligned(rows));
+    for (int i = 0; i < 3; ++i)
+        for (int r = 0; r < 4; ++r)
+            assert(rows[i][r] == transforms[i][r]);
+
+    // Column major can't be viewed as Mat4x4 but the raw floats are there.
+    assert(reader.View<Mat4x4>(1) == nullptr);
+    const float* cols = static_cast<const float*>(reader.Data(1));
+    float        expected[16];
+    transforms[1].StoreColMajor(expected);
+    for (int i = 0; i < 16; ++i)
+        assert(cols[16 + i] == expected[i]);
+
+    assert(reader.Section(2).size == 5 * 3 * sizeof(unsigned short));
+    Vec3 unpacked[5];
+    UnpackHalf(static_cast<const unsigned short*>(reader.Data(2)), unpacked, 5);
+    for (int i = 0; i < 5; ++i)
+        assert(unpacked[i] == normals[i]);
+}
+
+// Testing invalid files are rejected.
+void TestArrayFile_Invalid()
+{
+    ArrayFileReader reader;
+    assert(!reader.Open("Test_ArrayFile_missing.dmaf"));
+
+    FILE* f = std::fopen(g_PATH, "wb");
+    char  garbage[128] = "definitely not an array file";
+    std::fwrite(garbage, 1, sizeof(garbage), f);
+    std::fclose(f);
+    assert(!reader.Open(g_PATH));
+    assert(!reader.IsOpen());
+
+    std::remove(g_PATH);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestArrayFile_AoS();
+    TestArrayFile_SoA();
+    TestArrayFile_ShortSection();
+    TestArrayFile_MatricesAndHalf();
+    TestArrayFile_Invalid();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test ArrayFile] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    bool NearlyEqual(const Mat4x4& a, const Mat4x4& b, float eps)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                if (Abs(a[i][j] - b[i][j]) > eps)
+                    return false;
+        return true;
+    }
+
+    bool NearlyEqual(const Vec3& a, const Vec3& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps; }
+
+    const Mat3x4 g_Affine(
+        Vec4(2.0f, 0.5f, -1.0f, 3.0f),
+        Vec4(0.0f, 1.5f, 0.25f, -2.0f),
+        Vec4(1.0f, -0.5f, 3.0f, 0.5f));
+} // namespace
+
+// Testing that the conversions to and from Mat4x4 keep every value.
+void TestMat3x4_Conversion()
+{
+    Mat4x4 full = g_Affine.ToMat4x4();
+    assert(full[3] == Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    Mat3x4 back(full);
+    for (int i = 0; i < 3; ++i)
+        assert(back[i] == g_Affine[i]);
+
+    assert(sizeof(Mat3x4) == 48);
+    assert(Mat3x4(Mat4x4::Identity()).ToMat4x4()[2] == Mat4x4::Identity()[2]);
+}
+
+// Testing composition and transforms against Mat4x4.
+void TestMat3x4_MultiplyAndTransform()
+{
+    Mat3x4 other = Mat3x4::TRS(Vec3(1.0f, -4.0f, 2.0f), Vec3(0.3f, -0.8f, 1.9f), Vec3(1.0f, 2.0f, 0.5f));
+    Mat3x4 c     = g_Affine * other;
+    assert(NearlyEqual(c.ToMat4x4(), g_Affine.ToMat4x4() * other.ToMat4x4(), 1e-5f));
+
+    Vec3 p(0.5f, -3.0f, 7.0f);
+    Vec4 expected = g_Affine.ToMat4x4() * Vec4(p, 1.0f);
+    assert(NearlyEqual(g_Affine.TransformPoint(p), Vec3(expected.x, expected.y, expected.z), 1e-5f));
+    expected = g_Affine.ToMat4x4() * Vec4(p, 0.0f);
+    assert(NearlyEqual(g_Affine.TransformVector(p), Vec3(expected.x, expected.y, expected.z), 1e-5f));
+
+    // The 4-wide overloads match the single ones lane by lane.
+    Vec3   points[4] = { p, Vec3(1.0f, 2.0f, 3.0f), Vec3(-1.0f, 0.0f, 4.0f), Vec3(0.0f, 0.0f, 0.0f) };
+    Vec3x4 batch     = Vec3x4::Load(points);
+    Vec3x4 moved     = g_Affine.TransformPoint(batch);
+    Vec3x4 turned    = g_Affine.TransformVector(batch);
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(NearlyEqual(moved.Get(i), g_Affine.TransformPoint(points[i]), 1e-5f));
+        assert(NearlyEqual(turned.Get(i), g_Affine.TransformVector(points[i]), 1e-5f));
+    }
+}
+
+// Testing the general and rigid inverses.
+void TestMat3x4_Inverse()
+{
+    assert(Abs(g_Affine.Determinant() - g_Affine.ToMat4x4().Determinant()) < 1e-4f);
+
+    Mat3x4 inverse = g_Affine.Inverse();
+    assert(NearlyEqual((g_Affine * inverse).ToMat4x4(), Mat4x4::Identity(), 1e-5f));
+    assert(NearlyEqual((inverse * g_Affine).ToMat4x4(), Mat4x4::Identity(), 1e-5f));
+    assert(NearlyEqual(inverse.ToMat4x4(), g_Affine.ToMat4x4().Inverse(), 1e-5f));
+
+    Mat3x4 rigid = Mat3x4::TRS(Vec3(5.0f, -1.0f, 2.0f), Vec3(1.2f, 0.4f, -2.2f), Vec3(1.0f, 1.0f, 1.0f));
+    assert(NearlyEqual(rigid.RigidInverse().ToMat4x4(), rigid.Inverse().ToMat4x4(), 1e-5f));
+    assert(NearlyEqual((rigid * rigid.RigidInverse()).ToMat4x4(), Mat4x4::Identity(), 1e-5f));
+
+    // Flattened scale has no inverse.
+    Mat3x4 out;
+    assert(!Mat3x4::TryInverse(Mat3x4::TRS(Vec3(1.0f, 2.0f, 3.0f), Vec3(0.5f, 0.5f, 0.5f), Vec3(1.0f, 0.0f, 1.0f)), out));
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestMat3x4_Conversion();
+    TestMat3x4_MultiplyAndTransform();
+    TestMat3x4_Inverse();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Mat3x4] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
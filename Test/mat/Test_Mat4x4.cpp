@@ -236,6 +236,127 @@ void TestMat4x4_TryInverse()
     assert(!success);
 }
 
+namespace
+{
+    bool NearlyEqual(const Mat4x4& a, const Mat4x4& b, float eps)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                if (Abs(a[i][j] - b[i][j]) > eps)
+                    return false;
+        return true;
+    }
+
+    bool NearlyEqual(const Vec4& a, const Vec4& b, float eps)
+    {
+        return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps && Abs(a.w - b.w) <= eps;
+    }
+
+    // Depth after the perspective divide of a view space point at distance z.
+    float ProjectedDepth(const Mat4x4& projection, float z)
+    {
+        Vec4 clip = projection * Vec4(0.0f, 0.0f, z, 1.0f);
+        return clip.z / clip.w;
+    }
+} // namespace
+
+// Testing translation, scale, rotation and the fused TRS builder.
+void TestMat4x4_TransformBuilders()
+{
+    Vec4 p(1.0f, 2.0f, 3.0f, 1.0f);
+    assert(Mat4x4::Translation(Vec3(1.0f, -2.0f, 0.5f)) * p == Vec4(2.0f, 0.0f, 3.5f, 1.0f));
+    assert(Mat4x4::Scale(Vec3(2.0f, 3.0f, -1.0f)) * p == Vec4(2.0f, 6.0f, -3.0f, 1.0f));
+
+    // Right-hand rule about each axis.
+    assert(NearlyEqual(Mat4x4::RotationX(F::HALF_PI) * Vec4(0.0f, 1.0f, 0.0f, 0.0f), Vec4(0.0f, 0.0f, 1.0f, 0.0f), 1e-6f));
+    assert(NearlyEqual(Mat4x4::RotationY(F::HALF_PI) * Vec4(0.0f, 0.0f, 1.0f, 0.0f), Vec4(1.0f, 0.0f, 0.0f, 0.0f), 1e-6f));
+    assert(NearlyEqual(Mat4x4::RotationZ(F::HALF_PI) * Vec4(1.0f, 0.0f, 0.0f, 0.0f), Vec4(0.0f, 1.0f, 0.0f, 0.0f), 1e-6f));
+
+    assert(NearlyEqual(Mat4x4::RotationAxis(Vec3(1.0f, 0.0f, 0.0f), 0.7f), Mat4x4::RotationX(0.7f), 1e-6f));
+    assert(NearlyEqual(Mat4x4::RotationAxis(Vec3(0.0f, 1.0f, 0.0f), -1.3f), Mat4x4::RotationY(-1.3f), 1e-6f));
+    assert(NearlyEqual(Mat4x4::RotationAxis(Vec3(0.0f, 0.0f, 1.0f), 2.9f), Mat4x4::RotationZ(2.9f), 1e-6f));
+
+    // An arbitrary axis stays fixed and the result is orthonormal.
+    Vec3 axis(1.0f, -2.0f, 0.5f);
+    axis.Normalize();
+    Mat4x4 r = Mat4x4::RotationAxis(axis, 1.1f);
+    assert(NearlyEqual(r * Vec4(axis, 0.0f), Vec4(axis, 0.0f), 1e-6f));
+    assert(NearlyEqual(r * r.Transposed(), Mat4x4::Identity(), 1e-6f));
+
+    Vec3   angles(0.4f, -1.2f, 2.5f);
+    Mat4x4 euler = Mat4x4::RotationEuler(angles);
+    assert(NearlyEqual(euler, Mat4x4::RotationY(angles.y) * Mat4x4::RotationX(angles.x) * Mat4x4::RotationZ(angles.z), 1e-6f));
+
+    Vec3   t(3.0f, -4.0f, 5.0f), s(0.5f, 2.0f, -1.5f);
+    Mat4x4 trs = Mat4x4::TRS(t, angles, s);
+    assert(NearlyEqual(trs, Mat4x4::Translation(t) * euler * Mat4x4::Scale(s), 1e-5f));
+}
+
+// Testing that LookAt moves the eye to the origin and the target onto +z.
+void TestMat4x4_LookAt()
+{
+    Vec3   eye(2.0f, 3.0f, -4.0f), target(-1.0f, 0.5f, 6.0f);
+    Mat4x4 view = Mat4x4::LookAt(eye, target, Vec3(0.0f, 1.0f, 0.0f));
+
+    assert(NearlyEqual(view * Vec4(eye, 1.0f), Vec4(0.0f, 0.0f, 0.0f, 1.0f), 1e-5f));
+    float distance = (target - eye).Length();
+    assert(NearlyEqual(view * Vec4(target, 1.0f), Vec4(0.0f, 0.0f, distance, 1.0f), 1e-5f));
+
+    // World up stays up, and +x is to the right of +z (left handed).
+    assert((view * Vec4(0.0f, 1.0f, 0.0f, 0.0f)).y > 0.0f);
+    Mat4x4 axes = Mat4x4::LookTo(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    assert(NearlyEqual(axes, Mat4x4::Identity(), 1e-6f));
+
+    Mat4x4 rotation(view[0], view[1], view[2], Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    for (int i = 0; i < 3; ++i)
+        rotation[i].w = 0.0f;
+    assert(NearlyEqual(rotation * rotation.Transposed(), Mat4x4::Identity(), 1e-6f));
+}
+
+// Testing depth ranges, reversed and infinite projections and their specialized inverses.
+void TestMat4x4_Projection()
+{
+    const float fov = ToRadians(60.0f), aspect = 16.0f / 9.0f, nearZ = 0.1f, farZ = 100.0f;
+
+    Mat4x4 standard = Mat4x4::Perspective(fov, aspect, nearZ, farZ);
+    assert(Abs(ProjectedDepth(standard, nearZ)) < 1e-6f && Abs(ProjectedDepth(standard, farZ) - 1.0f) < 1e-6f);
+    // The top edge of the frustum maps to y = 1, the right edge to x = 1.
+    float top  = farZ * Tan(0.5f * fov);
+    Vec4  edge = standard * Vec4(top * aspect, top, farZ, 1.0f);
+    assert(Abs(edge.x / edge.w - 1.0f) < 1e-5f && Abs(edge.y / edge.w - 1.0f) < 1e-5f);
+
+    Mat4x4 reversed = Mat4x4::PerspectiveReversedZ(fov, aspect, nearZ, farZ);
+    assert(Abs(ProjectedDepth(reversed, nearZ) - 1.0f) < 1e-6f && Abs(ProjectedDepth(reversed, farZ)) < 1e-6f);
+
+    Mat4x4 infinite = Mat4x4::Perspective(fov, aspect, nearZ, DM_INFINITY_F);
+    assert(Abs(ProjectedDepth(infinite, nearZ)) < 1e-6f && ProjectedDepth(infinite, 1e6f) > 0.9999f);
+
+    Mat4x4 infiniteReversed = Mat4x4::PerspectiveReversedZ(fov, aspect, nearZ, DM_INFINITY_F);
+    assert(Abs(ProjectedDepth(infiniteReversed, nearZ) - 1.0f) < 1e-6f && ProjectedDepth(infiniteReversed, 1e6f) < 1e-6f);
+    assert(infiniteReversed[2][2] == 0.0f && infiniteReversed[2][3] == nearZ);
+
+    // Depth decreases monotonically with distance under reversed Z.
+    for (float z = nearZ; z < farZ; z *= 1.5f)
+        assert(ProjectedDepth(reversed, z) > ProjectedDepth(reversed, z * 1.5f));
+
+    const Mat4x4 perspectives[4] = { standard, reversed, infinite, infiniteReversed };
+    for (int i = 0; i < 4; ++i)
+    {
+        Mat4x4 inverse = Mat4x4::PerspectiveInverse(perspectives[i]);
+        assert(NearlyEqual(perspectives[i] * inverse, Mat4x4::Identity(), 1e-5f));
+        assert(NearlyEqual(inverse * perspectives[i], Mat4x4::Identity(), 1e-5f));
+    }
+
+    Mat4x4 ortho = Mat4x4::OrthographicOffCenter(-2.0f, 6.0f, -1.0f, 3.0f, 1.0f, 9.0f);
+    assert(NearlyEqual(ortho * Vec4(-2.0f, -1.0f, 1.0f, 1.0f), Vec4(-1.0f, -1.0f, 0.0f, 1.0f), 1e-6f));
+    assert(NearlyEqual(ortho * Vec4(6.0f, 3.0f, 9.0f, 1.0f), Vec4(1.0f, 1.0f, 1.0f, 1.0f), 1e-6f));
+    assert(NearlyEqual(ortho * Mat4x4::OrthographicInverse(ortho), Mat4x4::Identity(), 1e-6f));
+
+    Mat4x4 centered = Mat4x4::Orthographic(8.0f, 4.0f, 9.0f, 1.0f); // Reversed depth by swapping the planes.
+    assert(NearlyEqual(centered * Vec4(4.0f, -2.0f, 1.0f, 1.0f), Vec4(1.0f, -1.0f, 1.0f, 1.0f), 1e-6f));
+    assert(NearlyEqual(Mat4x4::OrthographicInverse(centered) * centered, Mat4x4::Identity(), 1e-6f));
+}
+
 int main()
 {
     using Clock = std::chrono::high_resolution_clock;
@@ -253,6 +374,9 @@ int main()
 	TestMat4x4_Determinant();
 	TestMat4x4_Inverse();
 	TestMat4x4_TryInverse();
+	TestMat4x4_TransformBuilders();
+	TestMat4x4_LookAt();
+	TestMat4x4_Projection();
 
     auto                                      end     = Clock::now();
     std::chrono::duration<double, std::milli> elapsed = end - start;
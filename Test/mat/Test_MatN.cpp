@@ -0,0 +1,148 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    typedef Vec<double, 6>    Vec6;
+    typedef Mat<double, 6, 6> Mat6;
+
+    template <typename T, int R, int C>
+    bool NearlyEqual(const Mat<T, R, C>& a, const Mat<T, R, C>& b, T eps)
+    {
+        for (int i = 0; i < R; ++i)
+            for (int j = 0; j < C; ++j)
+                if (Abs(a[i][j] - b[i][j]) > eps)
+                    return false;
+        return true;
+    }
+
+    // Spatial inertia of a box of mass m and half sizes h, offset by c from the reference point: [I + m [c]x [c]x^T,
+    // m [c]x; m [c]x^T, m 1].
+    Mat6 SpatialInertia(double m, const Vec<double, 3>& h, const Vec<double, 3>& c)
+    {
+        Mat6   out = Mat6::Zero();
+        double d[3] = { m / 3.0 * (h[1] * h[1] + h[2] * h[2]), m / 3.0 * (h[0] * h[0] + h[2] * h[2]), m / 3.0 * (h[0] * h[0] + h[1] * h[1]) };
+        Mat<double, 3, 3> cx = { { { { 0.0, -c[2], c[1] } }, { { c[2], 0.0, -c[0] } }, { { -c[1], c[0], 0.0 } } } };
+        Mat<double, 3, 3> top = cx * Transpose(cx) * m;
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                out[i][j]         = top[i][j] + (i == j ? d[i] : 0.0);
+                out[i][j + 3]     = m * cx[i][j];
+                out[i + 3][j]     = m * cx[j][i];
+                out[i + 3][j + 3] = i == j ? m : 0.0;
+            }
+        }
+        return out;
+    }
+} // namespace
+
+// Testing the element-wise operations, including in constant expressions.
+void TestMatN_Vec()
+{
+    DM_CONSTEXPR Vec<int, 3> a = { { 1, 2, 3 } };
+    DM_CONSTEXPR Vec<int, 3> b = { { 4, -5, 6 } };
+    static_assert(Dot(a, b) == 12, "Dot must be constexpr.");
+    static_assert(Cross(a, b) == Vec<int, 3> { { 27, 6, -13 } }, "Cross must be constexpr.");
+    static_assert((a + b) * 2 == Vec<int, 3> { { 10, -6, 18 } }, "Operators must be constexpr.");
+    static_assert(-a != a && Dot(Vec<int, 3>::Filled(7), a) == 42, "Negation and Filled must be constexpr.");
+
+    Vec6 v = { { 1.0, 2.0, 2.0, 0.0, 0.0, 4.0 } };
+    assert(LengthSquared(v) == 25.0);
+    assert(Length(v) == 5.0);
+    assert(Abs(Length(Normalized(v)) - 1.0) < 1e-12);
+    assert(Scale(v, v)[5] == 16.0);
+    assert((v / 2.0)[1] == 1.0);
+
+    Vec4 simd(1.0f, -2.0f, 3.0f, 0.5f);
+    assert(ToSimd(ToVecN(simd)) == simd);
+    assert(ToSimd(ToVecN(Vec3(1.0f, 2.0f, 3.0f))) == Vec3(1.0f, 2.0f, 3.0f));
+    assert(ToVecN(Vec2(4.0f, 5.0f))[1] == 5.0f);
+}
+
+// Testing products and transposition, and that the SSE 4x4 overloads agree with Mat4x4.
+void TestMatN_Multiply()
+{
+    DM_CONSTEXPR Mat<int, 2, 3> a = { { { { 1, 2, 3 } }, { { 4, 5, 6 } } } };
+    DM_CONSTEXPR Mat<int, 3, 2> b = { { { { 7, 8 } }, { { 9, 10 } }, { { 11, 12 } } } };
+    static_assert(a * b == Mat<int, 2, 2> { { { { 58, 64 } }, { { 139, 154 } } } }, "Product must be constexpr.");
+    static_assert(Transpose(a) * Vec<int, 2> { { 1, -1 } } == Vec<int, 3> { { -3, -3, -3 } }, "Transpose must be constexpr.");
+    static_assert(Mat<int, 3, 3>::Identity() * b == b, "Identity must be constexpr.");
+    static_assert((a * b)[1][1] == 154 && Transpose(a)[2][0] == 3, "Indexing a temporary must be constexpr in C++11.");
+
+    Mat4x4 m(Vec4(2.0f, 0.5f, -1.0f, 3.0f), Vec4(0.0f, 1.5f, 0.25f, -2.0f), Vec4(1.0f, -0.5f, 3.0f, 0.5f), Vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    Mat4x4 n = Mat4x4::Identity();
+    n[0]     = Vec4(1.0f, 2.0f, 3.0f, 4.0f);
+    n[2]     = Vec4(-1.0f, 0.0f, 0.5f, 2.0f);
+    assert(NearlyEqual(ToMatN(m) * ToMatN(n), ToMatN(m * n), 1e-5f));
+    assert(NearlyEqual(ToMatN(m) + ToMatN(n) - ToMatN(n), ToMatN(m), 1e-6f));
+    assert(ToSimd(ToMatN(m) * ToVecN(Vec4(1.0f, -1.0f, 2.0f, 1.0f))) == m * Vec4(1.0f, -1.0f, 2.0f, 1.0f));
+
+    Mat<float, 3, 3> m3 = ToMatN(Mat3x3(Vec3(1.0f, 2.0f, 0.0f), Vec3(0.0f, 1.0f, 4.0f), Vec3(5.0f, 6.0f, 0.0f)));
+    assert(Abs(Determinant(m3) - ToSimd(m3).Determinant()) < 1e-5f);
+    assert(ToSimd(2.0f * ToMatN(Mat2x2::Identity()))[1] == Vec2(0.0f, 2.0f));
+}
+
+// Testing determinants and the 6x6 inverse of a spatial inertia.
+void TestMatN_Inverse()
+{
+    Mat<int, 4, 4> ints = { { { { 0, 2, 1, 3 } }, { { 1, 0, 2, 1 } }, { { 4, 1, 0, 2 } }, { { 2, 3, 1, 0 } } } };
+    Mat<double, 4, 4> doubles;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            doubles[i][j] = ints[i][j];
+    assert(Determinant(ints) == -79);
+    assert(Abs(Determinant(doubles) + 79.0) < 1e-12);
+    ints[3] = ints[0] + ints[1];
+    assert(Determinant(ints) == 0);
+    // The first elimination step makes a minor of 2^32, the determinant is only 65536.
+    Mat<int, 3, 3> wide = { { { { 65536, 0, 1 } }, { { 0, 65536, 0 } }, { { 65535, 0, 1 } } } };
+    assert(Determinant(wide) == 65536);
+
+#if __cplusplus >= 201402L
+    DM_CONSTEXPR Mat<double, 2, 2> small = { { { { 1.0, 2.0 } }, { { 4.0, 2.0 } } } };
+    static_assert(Determinant(small) == -6.0, "Determinant must be constexpr from C++14.");
+#endif // __cplusplus >= 201402L
+
+    Vec<double, 3> h = { { 0.5, 1.0, 0.25 } };
+    Vec<double, 3> c = { { 0.3, -0.2, 0.7 } };
+    Mat6           inertia = SpatialInertia(3.0, h, c);
+    Mat6           inverse;
+    assert(TryInverse(inertia, inverse));
+    assert(NearlyEqual(inertia * inverse, Mat6::Identity(), 1e-12));
+    assert(NearlyEqual(inverse * inertia, Mat6::Identity(), 1e-12));
+    assert(Transpose(inertia) == inertia);
+
+    // Acceleration from force and back.
+    Vec6 force = { { 0.1, -2.0, 0.5, 3.0, 1.0, -1.0 } };
+    Vec6 back  = inertia * (inverse * force);
+    for (int i = 0; i < 6; ++i)
+        assert(Abs(back[i] - force[i]) < 1e-12);
+
+    Mat6 singular = inertia;
+    singular[5]   = singular[4] * 2.0;
+    assert(!TryInverse(singular, inverse));
+    assert(Abs(Determinant(singular)) < 1e-9);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestMatN_Vec();
+    TestMatN_Multiply();
+    TestMatN_Inverse();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test MatN] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,304 @@
+#include "../Test_Common.h"
+
+#include <ext/mat/DM_MatX.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    MatX RandomMatX(size_t rows, size_t cols)
+    {
+        MatX m(rows, cols);
+        for (size_t i = 0; i < rows; ++i)
+            for (size_t j = 0; j < cols; ++j)
+                m(i, j) = Random(-1.0f, 1.0f);
+        return m;
+    }
+
+    // Largest difference between a * b, accumulated in double, and c.
+    double ProductError(const MatX& a, const MatX& b, const MatX& c)
+    {
+        double worst = 0.0;
+        for (size_t i = 0; i < a.Rows(); ++i)
+            for (size_t j = 0; j < b.Cols(); ++j)
+            {
+                double sum = 0.0;
+                for (size_t k = 0; k < a.Cols(); ++k)
+                    sum += (double) a(i, k) * b(k, j);
+                worst = Max(worst, Abs(sum - (double) c(i, j)));
+            }
+        return worst;
+    }
+
+    bool Identical(const MatX& a, const MatX& b)
+    {
+        if (a.Rows() != b.Rows() || a.Cols() != b.Cols())
+            return false;
+        for (size_t i = 0; i < a.Rows(); ++i)
+            for (size_t j = 0; j < a.Cols(); ++j)
+                if (a(i, j) != b(i, j))
+                    return false;
+        return true;
+    }
+} // namespace
+
+// Testing the storage, Identity and Transpose.
+void TestMatX_Basics()
+{
+    MatX m(3, 5);
+    assert(m.Rows() == 3 && m.Cols() == 5 && m.Stride() == 16);
+    assert(reinterpret_cast<size_t>(m.Row(1)) % 64 == 0);
+    assert(m(2, 4) == 0.0f);
+    m(2, 4) = 7.0f;
+    m(0, 1) = -2.0f;
+
+    MatX t = m.Transpose();
+    assert(t.Rows() == 5 && t.Cols() == 3 && t(4, 2) == 7.0f && t(1, 0) == -2.0f);
+    assert(Identical(t.Transpose(), m));
+
+    MatX big = RandomMatX(37, 21);
+    assert(Identical(big * MatX::Identity(21), big));
+    assert(Identical(MatX::Identity(37) * big, big));
+
+    m.Resize(2, 2);
+    assert(m(0, 1) == 0.0f && m.Stride() == 16);
+}
+
+// Testing the product against a double reference for every tail of the 4 x 8 register blocks, and that splitting it
+// across the pool gives the same bits.
+void TestMatX_Multiply()
+{
+    const size_t sizes[][3] = { { 1, 1, 1 }, { 4, 8, 8 }, { 3, 5, 7 }, { 13, 9, 4 }, { 70, 33, 29 }, { 65, 300, 17 }, { 129, 70, 131 } };
+    for (const auto& size : sizes)
+    {
+        MatX a = RandomMatX(size[0], size[1]);
+        MatX b = RandomMatX(size[1], size[2]);
+        MatX c;
+        Multiply(a, b, c);
+        assert(c.Rows() == size[0] && c.Cols() == size[2]);
+        assert(ProductError(a, b, c) < 1e-5 * (double) size[1]);
+
+        // Matrix x vector.
+        std::vector<float> x(size[1]), y(size[0]);
+        for (size_t k = 0; k < size[1]; ++k)
+            x[k] = b(k, 0);
+        Multiply(a, x.data(), y.data());
+        for (size_t i = 0; i < size[0]; ++i)
+            assert(Abs(y[i] - c(i, 0)) < 1e-5f * (float) size[1]);
+    }
+
+    ThreadPool   pool(3);
+    MatXSettings settings;
+    settings.parallelThreshold = 0;
+    settings.pool              = &pool;
+
+    MatX a = RandomMatX(150, 90);
+    MatX b = RandomMatX(90, 111);
+    MatX serial, parallel;
+    Multiply(a, b, serial);
+    Multiply(a, b, parallel, settings);
+    assert(Identical(serial, parallel));
+}
+
+// Testing the triangular solves with one and many right hand sides.
+void TestMatX_Triangular()
+{
+    const size_t n = 45;
+    MatX         l = RandomMatX(n, n);
+    for (size_t i = 0; i < n; ++i)
+        l(i, i) = 2.0f + Random(0.0f, 1.0f);
+    MatX lower(n, n), upper(n, n);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j <= i; ++j)
+        {
+            lower(i, j) = l(i, j);
+            upper(j, i) = l(i, j);
+        }
+
+    MatX x = RandomMatX(n, 10);
+    MatX b = lower * x;
+    MatX solved(b);
+    SolveLower(l, solved); // The upper triangle of l is ignored.
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < 10; ++j)
+            assert(Abs(solved(i, j) - x(i, j)) < 1e-4f);
+
+    b      = upper * x;
+    solved = b;
+    SolveLowerTransposed(l, solved);
+    MatX solvedUpper(b);
+    SolveUpper(upper, solvedUpper);
+    std::vector<float> column(n);
+    for (size_t i = 0; i < n; ++i)
+        column[i] = b(i, 3);
+    SolveUpper(upper, column.data());
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(Abs(solved(i, 3) - x(i, 3)) < 1e-4f);
+        assert(Abs(solvedUpper(i, 5) - x(i, 5)) < 1e-4f);
+        assert(Abs(column[i] - x(i, 3)) < 1e-4f);
+    }
+
+    // A unit diagonal isn't read.
+    MatX unit(lower);
+    for (size_t i = 0; i < n; ++i)
+        unit(i, i) = 1.0f;
+    std::vector<float> rhs(n);
+    for (size_t i = 0; i < n; ++i)
+        column[i] = x(i, 0);
+    Multiply(unit, column.data(), rhs.data());
+    SolveLower(l, rhs.data(), true);
+    for (size_t i = 0; i < n; ++i)
+        assert(Abs(rhs[i] - column[i]) < 1e-4f);
+}
+
+// Testing the LU solve against known solutions, the determinant, singular input and the parallel factorization.
+void TestMatX_LU()
+{
+    MatX small(3, 3);
+    const float values[3][3] = { { 0.0f, 2.0f, 1.0f }, { 1.0f, 1.0f, 0.0f }, { 3.0f, 0.0f, 1.0f } };
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            small(i, j) = values[i][j];
+    LUDecomposition lu;
+    assert(lu.Factor(small));
+    assert(Abs(lu.Determinant() - (-5.0f)) < 1e-5f);
+    assert(Abs(small(0, 0)) < 1e-9f); // The input stays untouched.
+
+    const size_t n = 150; // Several 32 column panels and a partial one.
+    MatX         a = RandomMatX(n, n);
+    MatX         x = RandomMatX(n, 4);
+    MatX         b = a * x;
+    assert(lu.Factor(a));
+
+    std::vector<float> column(n);
+    for (size_t i = 0; i < n; ++i)
+        column[i] = b(i, 1);
+    lu.Solve(column.data(), column.data());
+    MatX solved(b);
+    lu.Solve(solved);
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(Abs(column[i] - x(i, 1)) < 2e-3f);
+        for (size_t j = 0; j < 4; ++j)
+            assert(Abs(solved(i, j) - x(i, j)) < 2e-3f);
+    }
+
+    // p * a = l * u, rebuilt from the factors.
+    MatX l(n, n), u(n, n), pa(a);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = 0; j < n; ++j)
+        {
+            if (j < i)
+                l(i, j) = lu.Factors()(i, j);
+            else
+                u(i, j) = lu.Factors()(i, j);
+        }
+    for (size_t i = 0; i < n; ++i)
+    {
+        l(i, i)         = 1.0f;
+        const size_t pr = lu.Pivots()[i];
+        for (size_t j = 0; j < n; ++j)
+        {
+            float t   = pa(i, j);
+            pa(i, j)  = pa(pr, j);
+            pa(pr, j) = t;
+        }
+    }
+    assert(ProductError(l, u, pa) < 1e-4);
+
+    ThreadPool   pool(3);
+    MatXSettings settings;
+    settings.parallelThreshold = 0;
+    settings.pool              = &pool;
+    LUDecomposition parallel(settings);
+    assert(parallel.Factor(a));
+    assert(Identical(parallel.Factors(), lu.Factors()));
+
+    // A zero row stays zero through the elimination, and so does a row that is a multiple of another in exact math.
+    for (size_t j = 0; j < n; ++j)
+        a(77, j) = 0.0f;
+    assert(!lu.Factor(a));
+    small(0, 0) = 2.0f;
+    small(0, 1) = 2.0f;
+    small(0, 2) = 0.0f;
+    small(2, 0) = 4.0f; // Power of 2 multipliers, no rounding.
+    assert(!lu.Factor(small));
+    assert(!lu.Factor(MatX(4, 4)));
+}
+
+// Testing the Cholesky factor and solve on a symmetric positive definite matrix, and the rejection of others.
+void TestMatX_Cholesky()
+{
+    const size_t n = 97;
+    MatX         m = RandomMatX(n, n);
+    MatX         a = m * m.Transpose();
+    for (size_t i = 0; i < n; ++i)
+        a(i, i) += 1.0f;
+    MatX lowerOnly(a);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t j = i + 1; j < n; ++j)
+            lowerOnly(i, j) = 1000.0f; // Only the lower triangle is read.
+
+    CholeskyDecomposition cholesky;
+    assert(cholesky.Factor(lowerOnly));
+    const MatX& l = cholesky.L();
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(l(i, i) > 0.0f);
+        for (size_t j = i + 1; j < n; ++j)
+            assert(l(i, j) == 0.0f);
+    }
+    assert(ProductError(l, l.Transpose(), a) < 1e-3);
+
+    MatX x = RandomMatX(n, 3);
+    MatX b = a * x;
+    MatX solved(b);
+    cholesky.Solve(solved);
+    std::vector<float> column(n), result(n);
+    for (size_t i = 0; i < n; ++i)
+        column[i] = b(i, 2);
+    cholesky.Solve(column.data(), result.data());
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(Abs(result[i] - x(i, 2)) < 1e-3f);
+        for (size_t j = 0; j < 3; ++j)
+            assert(Abs(solved(i, j) - x(i, j)) < 1e-3f);
+    }
+
+    ThreadPool   pool(3);
+    MatXSettings settings;
+    settings.parallelThreshold = 0;
+    settings.pool              = &pool;
+    CholeskyDecomposition parallel(settings);
+    assert(parallel.Factor(a));
+    assert(Identical(parallel.L(), l));
+
+    a(50, 50) = -1.0f;
+    assert(!cholesky.Factor(a));
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(29);
+
+    TestMatX_Basics();
+    TestMatX_Multiply();
+    TestMatX_Triangular();
+    TestMatX_LU();
+    TestMatX_Cholesky();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test MatX] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
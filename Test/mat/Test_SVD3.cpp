@@ -0,0 +1,275 @@
+#include "../Test_Common.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    Mat3x3 RandomMat3x3()
+    {
+        Mat3x3 m;
+        float* d = m.Data();
+        for (int k = 0; k < 9; ++k)
+            d[k] = Random(-2.0f, 2.0f);
+        return m;
+    }
+
+    float At(const Mat3x3& m, int i, int j) { return m.Data()[3 * i + j]; }
+
+    // Largest difference between u * diag(d) * transpose(v) and a.
+    float ReconstructionError(const Mat3x3& a, const Mat3x3& u, const Vec3& d, const Mat3x3& v)
+    {
+        float worst = 0.0f;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+            {
+                float sum = 0.0f;
+                for (int k = 0; k < 3; ++k)
+                    sum += At(u, i, k) * Component(d, k) * At(v, j, k);
+                worst = Max(worst, Abs(sum - At(a, i, j)));
+            }
+        return worst;
+    }
+
+    // transpose(m) * m is the identity and the determinant is 1, within tolerance.
+    bool IsRotation(const Mat3x3& m, float tolerance)
+    {
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+            {
+                float dot = 0.0f;
+                for (int k = 0; k < 3; ++k)
+                    dot += At(m, k, i) * At(m, k, j);
+                if (Abs(dot - (i == j ? 1.0f : 0.0f)) > tolerance)
+                    return false;
+            }
+        return Abs(m.Determinant() - 1.0f) <= tolerance;
+    }
+
+    bool Identical(const Mat3x3& a, const Mat3x3& b)
+    {
+        for (int k = 0; k < 9; ++k)
+            if (a.Data()[k] != b.Data()[k])
+                return false;
+        return true;
+    }
+
+    void CheckSVD(const Mat3x3& a, const Mat3x3& u, const Vec3& sigma, const Mat3x3& v)
+    {
+        assert(ReconstructionError(a, u, sigma, v) < 1e-4f);
+        assert(IsRotation(u, 1e-5f) && IsRotation(v, 1e-5f));
+        assert(sigma.x >= sigma.y - 1e-5f && sigma.y >= Abs(sigma.z) - 1e-5f);
+        assert(sigma.y >= -1e-5f);
+        // The sign of the determinant lands on the smallest singular value.
+        const float det = a.Determinant();
+        if (Abs(det) > 1e-3f)
+            assert((sigma.z < 0.0f) == (det < 0.0f));
+    }
+} // namespace
+
+// Testing eigenvalues, eigenvectors and their order on random symmetric matrices and repeated eigenvalues.
+void TestSVD3_SymmetricEigen()
+{
+    std::vector<Mat3x3> matrices;
+    for (int n = 0; n < 103; ++n)
+    {
+        Mat3x3 m = RandomMat3x3();
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < i; ++j)
+                m.Data()[3 * i + j] = 100.0f; // Only the upper triangle is read.
+        matrices.push_back(m);
+    }
+    matrices.push_back(Mat3x3::Identity());
+    Mat3x3 repeated = Mat3x3::Identity();
+    repeated.Data()[8] = -3.0f;
+    matrices.push_back(repeated);
+    matrices.push_back(Mat3x3());
+
+    const size_t        count = matrices.size();
+    std::vector<Vec3>   values(count);
+    std::vector<Mat3x3> vectors(count);
+    SymmetricEigen(matrices.data(), count, values.data(), vectors.data());
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        Mat3x3 symmetric = matrices[n];
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < i; ++j)
+                symmetric.Data()[3 * i + j] = At(symmetric, j, i);
+        assert(ReconstructionError(symmetric, vectors[n], values[n], vectors[n]) < 1e-4f);
+        assert(IsRotation(vectors[n], 1e-5f));
+        assert(values[n].x >= values[n].y && values[n].y >= values[n].z);
+
+        Vec3   single;
+        Mat3x3 singleVectors;
+        SymmetricEigen(matrices[n], single, singleVectors);
+        assert(single == values[n]);
+    }
+    assert(values[count - 2].x == 1.0f && values[count - 2].y == 1.0f && values[count - 2].z == -3.0f);
+    assert(values[count - 1] == Vec3(0.0f, 0.0f, 0.0f) && Identical(vectors[count - 1], Mat3x3::Identity()));
+}
+
+// Testing the SVD of random matrices in every tail of the 4 matrix groups and of special input: rotations,
+// reflections, singular and zero matrices.
+void TestSVD3_SVD()
+{
+    for (size_t count = 1; count <= 9; ++count)
+    {
+        std::vector<Mat3x3> matrices(count), u(count), v(count);
+        std::vector<Vec3>   sigma(count);
+        for (auto& m : matrices)
+            m = RandomMat3x3();
+        SVD(matrices.data(), count, u.data(), sigma.data(), v.data());
+        for (size_t n = 0; n < count; ++n)
+            CheckSVD(matrices[n], u[n], sigma[n], v[n]);
+    }
+
+    Mat3x3 u, v;
+    Vec3   sigma;
+
+    SVD(Mat3x3::Identity(), u, sigma, v);
+    assert(sigma == Vec3(1.0f, 1.0f, 1.0f) && Identical(u, Mat3x3::Identity()) && Identical(v, Mat3x3::Identity()));
+
+    // A rotation has unit singular values and u * transpose(v) is the rotation.
+    const Mat3x3 rotation = ExactRotation();
+    SVD(rotation, u, sigma, v);
+    CheckSVD(rotation, u, sigma, v);
+    assert(Abs(sigma.x - 1.0f) < 1e-5f && Abs(sigma.y - 1.0f) < 1e-5f && Abs(sigma.z - 1.0f) < 1e-5f);
+
+    // A reflection with distinct scales: the negative singular value is the smallest.
+    Mat3x3 reflection;
+    reflection.Data()[0] = -2.0f;
+    reflection.Data()[4] = 3.0f;
+    reflection.Data()[8] = 0.5f;
+    SVD(reflection, u, sigma, v);
+    CheckSVD(reflection, u, sigma, v);
+    assert(Abs(sigma.x - 3.0f) < 1e-5f && Abs(sigma.y - 2.0f) < 1e-5f && Abs(sigma.z + 0.5f) < 1e-5f);
+
+    // Rank 1 and zero.
+    Mat3x3 rank1;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            rank1.Data()[3 * i + j] = (float) (i + 1) * (float) (j + 2);
+    SVD(rank1, u, sigma, v);
+    CheckSVD(rank1, u, sigma, v);
+    assert(Abs(sigma.y) < 1e-4f && Abs(sigma.z) < 1e-4f);
+
+    SVD(Mat3x3(), u, sigma, v);
+    assert(sigma == Vec3(0.0f, 0.0f, 0.0f) && IsRotation(u, 0.0f) && IsRotation(v, 0.0f));
+}
+
+// Testing rotation * stretch = a, a proper rotation and a symmetric stretch, also for inverted input.
+void TestSVD3_Polar()
+{
+    const size_t        count = 11;
+    std::vector<Mat3x3> matrices(count), rotations(count), stretches(count);
+    for (auto& m : matrices)
+        m = RandomMat3x3();
+    // Every other one inverted.
+    for (size_t n = 0; n < count; ++n)
+        if ((matrices[n].Determinant() < 0.0f) != (n % 2 == 1))
+            matrices[n][0] = matrices[n][0] * -1.0f;
+    PolarDecomposition(matrices.data(), count, rotations.data(), stretches.data());
+
+    std::vector<Mat3x3> rotationsOnly(count);
+    PolarDecomposition(matrices.data(), count, rotationsOnly.data(), nullptr);
+
+    for (size_t n = 0; n < count; ++n)
+    {
+        assert(IsRotation(rotations[n], 1e-5f));
+        assert(Identical(rotationsOnly[n], rotations[n]));
+        const Mat3x3 product = rotations[n] * stretches[n];
+        for (int k = 0; k < 9; ++k)
+            assert(Abs(product.Data()[k] - matrices[n].Data()[k]) < 1e-4f);
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                assert(Abs(At(stretches[n], i, j) - At(stretches[n], j, i)) < 1e-5f);
+    }
+
+    // The polar rotation of a rotation is itself, with an identity stretch.
+    Mat3x3       rotation, stretch;
+    const Mat3x3 a = ExactRotation();
+    PolarDecomposition(a, rotation, stretch);
+    for (int k = 0; k < 9; ++k)
+    {
+        assert(Abs(rotation.Data()[k] - a.Data()[k]) < 1e-5f);
+        assert(Abs(stretch.Data()[k] - Mat3x3::Identity().Data()[k]) < 1e-5f);
+    }
+}
+
+// Testing that the decompositions don't depend on the magnitude of the input: the squares inside the rotations
+// underflow for elements around 1e-12 and overflow around 1e10 unless the matrices are scaled first.
+void TestSVD3_Scale()
+{
+    const size_t        count = 9; // A group of 8 and a tail.
+    std::vector<Mat3x3> unit(count), scaled(count), u(count), v(count), unitU(count), unitV(count);
+    std::vector<Vec3>   sigma(count), unitSigma(count);
+    for (auto& m : unit)
+        m = RandomMat3x3();
+    SVD(unit.data(), count, unitU.data(), unitSigma.data(), unitV.data());
+
+    for (float scale : { 1e-12f, 1e10f })
+    {
+        for (size_t n = 0; n < count; ++n)
+            for (int k = 0; k < 9; ++k)
+                scaled[n].Data()[k] = unit[n].Data()[k] * scale;
+        SVD(scaled.data(), count, u.data(), sigma.data(), v.data());
+        for (size_t n = 0; n < count; ++n)
+        {
+            assert(ReconstructionError(scaled[n], u[n], sigma[n], v[n]) < 1e-4f * scale);
+            assert(IsRotation(u[n], 1e-5f) && IsRotation(v[n], 1e-5f));
+            for (int i = 0; i < 3; ++i)
+                assert(Abs(Component(sigma[n], i) / scale - Component(unitSigma[n], i)) < 1e-4f);
+        }
+
+        // The eigenvalues of the upper triangles scale with it.
+        for (size_t n = 0; n < count; ++n)
+        {
+            Mat3x3 symmetric = scaled[n];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < i; ++j)
+                    symmetric.Data()[3 * i + j] = At(symmetric, j, i);
+            Vec3   values, unitValues;
+            Mat3x3 vectors, unitVectors;
+            SymmetricEigen(scaled[n], values, vectors);
+            SymmetricEigen(unit[n], unitValues, unitVectors);
+            assert(ReconstructionError(symmetric, vectors, values, vectors) < 1e-4f * scale);
+            assert(IsRotation(vectors, 1e-5f));
+            for (int i = 0; i < 3; ++i)
+                assert(Abs(Component(values, i) / scale - Component(unitValues, i)) < 1e-4f);
+        }
+
+        // The polar rotation doesn't scale at all.
+        Mat3x3 rotation, stretch, unitRotation, unitStretch;
+        PolarDecomposition(scaled[0], rotation, stretch);
+        PolarDecomposition(unit[0], unitRotation, unitStretch);
+        for (int k = 0; k < 9; ++k)
+        {
+            assert(Abs(rotation.Data()[k] - unitRotation.Data()[k]) < 1e-4f);
+            assert(Abs(stretch.Data()[k] / scale - unitStretch.Data()[k]) < 1e-4f);
+        }
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(41);
+
+    TestSVD3_SymmetricEigen();
+    TestSVD3_SVD();
+    TestSVD3_Polar();
+    TestSVD3_Scale();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test SVD3] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "../Test_Common.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    bool NearlyEqual(const Mat4x4& a, const Mat4x4& b, float eps)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                if (Abs(a[i][j] - b[i][j]) > eps)
+                    return false;
+        return true;
+    }
+
+    bool NearlyEqual(const Vec3& a, const Vec3& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps; }
+
+    bool SameRotation(const Quat& a, const Quat& b, float eps) { return Abs(Abs(Quat::Dot(a, b)) - 1.0f) <= eps; }
+} // namespace
+
+// Testing the composed matrices and their cache.
+void TestTransform_Cache()
+{
+    Transform identity;
+    assert(NearlyEqual(identity.Matrix(), Mat4x4::Identity(), 0.0f) && NearlyEqual(identity.InverseMatrix(), Mat4x4::Identity(), 0.0f));
+
+    Vec3      euler(0.3f, -0.8f, 1.9f);
+    Transform transform(Vec3(1.0f, -4.0f, 2.0f), Quat::FromEuler(euler), Vec3(2.0f, 0.5f, 3.0f));
+    assert(NearlyEqual(transform.Matrix(), Mat4x4::TRS(Vec3(1.0f, -4.0f, 2.0f), euler, Vec3(2.0f, 0.5f, 3.0f)), 1e-5f));
+    assert(NearlyEqual(transform.InverseMatrix(), transform.Matrix().Inverse(), 1e-5f));
+
+    // Reads return the cached matrix until a setter bumps the version.
+    const Mat4x4* cached  = &transform.Matrix();
+    unsigned int  version = transform.Version();
+    assert(&transform.Matrix() == cached && transform.Version() == version);
+
+    transform.SetTranslation(Vec3(0.0f, 0.0f, 5.0f));
+    assert(transform.Version() != version);
+    assert(transform.Matrix()[2].w == 5.0f && transform.InverseMatrix()[2].w != 0.0f);
+    transform.SetScale(Vec3(1.0f, 1.0f, 1.0f));
+    transform.SetRotation(Quat::FromAxisAngle(Vec3(0.0f, 0.0f, 1.0f), F::HALF_PI));
+    assert(NearlyEqual(transform.Matrix(), Mat4x4::Translation(Vec3(0.0f, 0.0f, 5.0f)) * Mat4x4::RotationZ(F::HALF_PI), 1e-5f));
+    assert(NearlyEqual(transform.InverseMatrix() * transform.Matrix(), Mat4x4::Identity(), 1e-5f));
+
+    transform.Set(Vec3(1.0f, 2.0f, 3.0f), Quat(), Vec3(4.0f, 4.0f, 4.0f));
+    assert(NearlyEqual(transform.InverseMatrix(), Mat4x4::Scale(Vec3(0.25f, 0.25f, 0.25f)) * Mat4x4::Translation(Vec3(-1.0f, -2.0f, -3.0f)), 1e-6f));
+}
+
+// Testing decomposition round trips, batched and single, including reflections.
+void TestTransform_Decompose()
+{
+    std::vector<Mat4x4> matrices(23);
+    std::vector<Vec3>   t(matrices.size()), s(matrices.size());
+    std::vector<Quat>   r(matrices.size());
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        // Angles near pi and reflected scales take every branch of the rotation extraction.
+        t[i] = RandomVec3(-10.0f, 10.0f);
+        r[i] = Quat::FromEuler(i % 4 == 0 ? Vec3(F::PI - 0.01f, 0.0f, 0.0f) * (float) (i % 3) : RandomVec3(-3.0f, 3.0f));
+        s[i] = RandomVec3(0.2f, 4.0f);
+        if (i % 5 == 2)
+            s[i].x = -s[i].x;
+        matrices[i] = Transform(t[i], r[i], s[i]).Matrix();
+    }
+
+    std::vector<Vec3> translations(matrices.size()), scales(matrices.size());
+    std::vector<Quat> rotations(matrices.size());
+    Decompose(matrices.data(), matrices.size(), translations.data(), rotations.data(), scales.data());
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        assert(NearlyEqual(translations[i], t[i], 1e-5f));
+        assert(NearlyEqual(scales[i], s[i], 1e-4f));
+        assert(SameRotation(rotations[i], r[i], 1e-5f));
+        assert(Abs(rotations[i].Length() - 1.0f) < 1e-5f);
+
+        Transform single(matrices[i]);
+        assert(NearlyEqual(single.Matrix(), matrices[i], 1e-4f));
+        assert(single.Rotation() == rotations[i]);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(31);
+
+    TestTransform_Cache();
+    TestTransform_Decompose();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Transform] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <DropMath.h>
+#include <ext/DM_Memory.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+using namespace DropMath;
+
+// Testing allocation alignment.
+void TestMemory_AlignedAlloc()
+{
+    void* p = AlignedAlloc(100);
+    assert(p && ((uintptr_t) p % CACHE_LINE_SIZE) == 0);
+    AlignedFree(p);
+
+    p = AlignedAlloc(0, 16);
+    assert(p && ((uintptr_t) p % 16) == 0);
+    AlignedFree(p);
+}
+
+// Testing growth keeps elements and alignment, and copies are deep.
+void TestMemory_AlignedArray()
+{
+    AlignedArray<int> a;
+    assert(a.Empty());
+    for (int i = 0; i < 1000; ++i)
+        a.PushBack(i);
+    assert(a.Size() == 1000 && ((uintptr_t) a.Data() % CACHE_LINE_SIZE) == 0);
+    for (int i = 0; i < 1000; ++i)
+        assert(a[i] == i);
+
+    // Pushing an element of the array itself while it reallocates.
+    AlignedArray<int> b(16);
+    for (int i = 0; i < 16; ++i)
+        b[i] = i * 2;
+    b.PushBack(b[15]);
+    assert(b.Size() == 17 && b[16] == 30);
+
+    AlignedArray<int> c = a;
+    c[0]                = -1;
+    assert(a[0] == 0 && c.Size() == a.Size());
+
+    AlignedArray<int> d = std::move(c);
+    assert(c.Empty() && c.Data() == nullptr && d[0] == -1);
+    // Containers of arrays (per chunk lists) move them on reallocation instead of copying.
+    static_assert(std::is_nothrow_move_constructible<AlignedArray<int>>::value, "AlignedArray move must be noexcept");
+    static_assert(std::is_nothrow_move_assignable<AlignedArray<int>>::value, "AlignedArray move must be noexcept");
+
+    a.Resize(10);
+    assert(a.Size() == 10 && a[9] == 9);
+    a.Clear();
+    assert(a.Empty());
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestMemory_AlignedAlloc();
+    TestMemory_AlignedArray();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Memory] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    // Angle between two vectors, precise enough for the small errors checked here.
+    float AngleBetween(const Vec3& a, const Vec3& b)
+    {
+        float cross = Vec3::Cross(a, b).Length();
+        float dot   = Vec3::Dot(a, b);
+        return dot > 0.0f ? cross : F::PI - cross;
+    }
+
+    // Deterministic spread of unit normals over the whole sphere, including the axes.
+    void MakeNormals(Vec3* out, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            float z = 1.0f - 2.0f * (i + 0.5f) / count;
+            float r = Sqrt(1.0f - z * z);
+            float a = i * 2.39996323f;
+            out[i]  = Vec3(r * Cos(a), r * Sin(a), z);
+            out[i].Normalize();
+        }
+        out[0] = Vec3::Right();
+        out[1] = Vec3::Back();
+        out[2] = Vec3::Down();
+        out[3] = Vec3(-1, 0, 0);
+    }
+} // anonymous namespace
+
+// Testing 2x16 bit octahedral round trip.
+void TestNormalPack_Oct16()
+{
+    const int count = 1023;
+    Vec3      normals[count];
+    Vec3      decoded[count];
+    short     packed[count * 2];
+    MakeNormals(normals, count);
+
+    EncodeOct16(normals, packed, count);
+    DecodeOct16(packed, decoded, count);
+    for (int i = 0; i < count; ++i)
+    {
+        assert(IsZero(decoded[i].Length() - 1.0f));
+        assert(AngleBetween(normals[i], decoded[i]) <= PackError::OCT16);
+    }
+}
+
+// Testing 2x8 bit octahedral round trip.
+void TestNormalPack_Oct8()
+{
+    const int   count = 1023;
+    Vec3        normals[count];
+    Vec3        decoded[count];
+    signed char packed[count * 2];
+    MakeNormals(normals, count);
+
+    EncodeOct8(normals, packed, count);
+    DecodeOct8(packed, decoded, count);
+    for (int i = 0; i < count; ++i)
+        assert(AngleBetween(normals[i], decoded[i]) <= PackError::OCT8);
+}
+
+// Testing a zero normal doesn't produce NaN.
+void TestNormalPack_OctZero()
+{
+    Vec3  zero[1] = {Vec3()};
+    Vec3  decoded[1];
+    short packed[2];
+    EncodeOct16(zero, packed, 1);
+    DecodeOct16(packed, decoded, 1);
+    assert(decoded[0] == Vec3::Forward());
+}
+
+// Testing quaternion tangent frame round trip with both bitangent signs.
+void TestNormalPack_QTangent()
+{
+    const int count = 511;
+    Vec3      normals[count];
+    Vec4      tangents[count];
+    short     packed[count * 4];
+    Vec3      outNormals[count];
+    Vec4      outTangents[count];
+    MakeNormals(normals, count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        // Any vector not parallel to the normal, orthogonalized.
+        Vec3 helper = Abs(normals[i].y) < 0.9f ? Vec3::Up() : Vec3::Right();
+        Vec3 t      = Vec3::Cross(helper, normals[i]);
+        t.Normalize();
+        tangents[i] = Vec4(t, (i % 3 == 0) ? -1.0f : 1.0f);
+    }
+
+    EncodeQTangent(normals, tangents, packed, count);
+    DecodeQTangent(packed, outNormals, outTangents, count);
+    for (int i = 0; i < count; ++i)
+    {
+        Vec3 t(tangents[i].x, tangents[i].y, tangents[i].z);
+        Vec3 outT(outTangents[i].x, outTangents[i].y, outTangents[i].z);
+        assert(AngleBetween(normals[i], outNormals[i]) <= PackError::QTANGENT);
+        assert(AngleBetween(t, outT) <= PackError::QTANGENT);
+        assert(outTangents[i].w == tangents[i].w);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestNormalPack_Oct16();
+    TestNormalPack_Oct8();
+    TestNormalPack_OctZero();
+    TestNormalPack_QTangent();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test NormalPack] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
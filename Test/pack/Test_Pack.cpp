@@ -0,0 +1,165 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+// Testing scalar half conversion on exact values and specials.
+void TestPack_HalfScalar()
+{
+    assert(FloatToHalf(0.0f) == 0x0000);
+    assert(FloatToHalf(-0.0f) == 0x8000);
+    assert(FloatToHalf(1.0f) == 0x3C00);
+    assert(FloatToHalf(-2.0f) == 0xC000);
+    assert(FloatToHalf(65504.0f) == 0x7BFF);
+    assert(FloatToHalf(1e6f) == 0x7C00);              // Overflow becomes infinity.
+    assert(FloatToHalf(DM_INFINITY_F) == 0x7C00);
+    assert((FloatToHalf(-DM_INFINITY_F) & 0xFFFF) == 0xFC00);
+    assert(FloatToHalf(5.9604645e-8f) == 0x0001);     // Smallest subnormal half.
+    assert(FloatToHalf(1.0f + 1.0f / 4096.0f) == 0x3C00); // Tie rounds to even.
+
+    assert(HalfToFloat(0x3C00) == 1.0f);
+    assert(HalfToFloat(0xC000) == -2.0f);
+    assert(HalfToFloat(0x7BFF) == 65504.0f);
+    assert(HalfToFloat(0x0001) == 5.9604645e-8f);
+    assert(HalfToFloat(0x7C00) == DM_INFINITY_F);
+
+    float nan = HalfToFloat(FloatToHalf(FloatBits {0x7FC00000}.f));
+    assert(nan != nan);
+}
+
+// Testing every half converts back to itself through float.
+void TestPack_HalfRoundTripAll()
+{
+    for (unsigned int h = 0; h < 0x10000; ++h)
+    {
+        bool isNan = (h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0;
+        if (isNan)
+            continue;
+        assert(FloatToHalf(HalfToFloat((unsigned short) h)) == h);
+    }
+}
+
+// Testing batch half kernels against the scalar version and the documented error bound.
+void TestPack_HalfBatch()
+{
+    const int count = 37; // Not a multiple of the SIMD width to cover the tail.
+    Vec3      src[count];
+    for (int i = 0; i < count; ++i)
+        src[i] = Vec3(i * 0.731f - 13.0f, i * 17.25f, -i * 0.0013f);
+
+    unsigned short packed[count * 3];
+    PackHalf(src, packed, count);
+
+    for (int i = 0; i < count; ++i)
+        for (int j = 0; j < 3; ++j)
+            assert(packed[i * 3 + j] == FloatToHalf(src[i][j]));
+
+    Vec3 dst[count];
+    UnpackHalf(packed, dst, count);
+    for (int i = 0; i < count; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            float a     = src[i][j];
+            float bound = Max(Abs(a) * PackError::HALF_RELATIVE, PackError::HALF_SUBNORMAL);
+            assert(Abs(dst[i][j] - a) <= bound);
+        }
+    }
+
+    Vec4           v4[5] = {Vec4(1, 2, 3, 4), Vec4(-1, -2, -3, -4), Vec4(0.5f, 0.25f, 0.125f, 0), Vec4(), Vec4::One()};
+    unsigned short p4[20];
+    Vec4           r4[5];
+    PackHalf(v4, p4, 5);
+    UnpackHalf(p4, r4, 5);
+    for (int i = 0; i < 5; ++i)
+        assert(r4[i] == v4[i]);
+
+    Vec2           v2[3] = {Vec2(1, 2), Vec2(-3, 4), Vec2(0.75f, -0.5f)};
+    unsigned short p2[6];
+    Vec2           r2[3];
+    PackHalf(v2, p2, 3);
+    UnpackHalf(p2, r2, 3);
+    for (int i = 0; i < 3; ++i)
+        assert(r2[i] == v2[i]);
+}
+
+// Testing snorm16 round trip and clamping.
+void TestPack_Snorm16()
+{
+    const int count = 21;
+    Vec3      src[count];
+    for (int i = 0; i < count; ++i)
+    {
+        src[i] = Vec3((float) i - 10.0f, 0.37f * i, -0.11f * i);
+        src[i].Normalize();
+    }
+
+    short packed[count * 3];
+    Vec3  dst[count];
+    PackSnorm16(src, packed, count);
+    UnpackSnorm16(packed, dst, count);
+    for (int i = 0; i < count; ++i)
+        for (int j = 0; j < 3; ++j)
+            assert(Abs(dst[i][j] - src[i][j]) <= PackError::SNORM16 * 1.01f);
+
+    float clampSrc[9] = {-5.0f, 5.0f, -1.0f, 1.0f, 0.0f, 0.5f, -0.5f, 2.0f, -2.0f};
+    short q[9];
+    PackSnorm16(clampSrc, q, 9);
+    assert(q[0] == -32767 && q[1] == 32767 && q[2] == -32767 && q[3] == 32767 && q[4] == 0);
+    assert(q[7] == 32767 && q[8] == -32767);
+
+    short minShort[8] = {-32768, -32768, -32768, -32768, -32768, -32768, -32768, -32768};
+    float unpacked[8];
+    UnpackSnorm16(minShort, unpacked, 8);
+    for (int i = 0; i < 8; ++i)
+        assert(unpacked[i] == -1.0f);
+}
+
+// Testing unorm8 and RGBA8 color packing.
+void TestPack_Unorm8AndRGBA8()
+{
+    const int     count = 19;
+    Vec4          colors[count];
+    unsigned char bytes[count * 4];
+    Vec4          back[count];
+    for (int i = 0; i < count; ++i)
+        colors[i] = Vec4(i / 18.0f, 1.0f - i / 18.0f, 0.5f, i * 0.05f);
+
+    PackUnorm8(colors, bytes, count);
+    UnpackUnorm8(bytes, back, count);
+    for (int i = 0; i < count; ++i)
+        for (int j = 0; j < 4; ++j)
+            assert(Abs(back[i][j] - colors[i][j]) <= PackError::UNORM8 * 1.01f);
+
+    Vec4         rgba[2] = {Vec4(1.0f, 0.0f, 0.0f, 1.0f), Vec4(-1.0f, 2.0f, 0.0f, 0.0f)};
+    unsigned int packed[2];
+    PackRGBA8(rgba, packed, 2);
+    assert(packed[0] == 0xFF0000FF);
+    assert(packed[1] == 0x0000FF00); // Clamped.
+
+    Vec4 unpacked[2];
+    UnpackRGBA8(packed, unpacked, 2);
+    assert(unpacked[0] == Vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    assert(unpacked[1] == Vec4(0.0f, 1.0f, 0.0f, 0.0f));
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestPack_HalfScalar();
+    TestPack_HalfRoundTripAll();
+    TestPack_HalfBatch();
+    TestPack_Snorm16();
+    TestPack_Unorm8AndRGBA8();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Pack] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#ifndef DM_PROFILE
+#define DM_PROFILE
+#endif // DM_PROFILE
+
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace DropMath;
+
+// Testing calls, elements and failures are counted per operation.
+void TestProfile_Counts()
+{
+    ProfileReset();
+
+    Mat4x4 m = Mat4x4::Identity();
+    Mat4x4 inverse;
+    assert(Mat4x4::TryInverse(m, inverse));
+    assert(!Mat4x4::TryInverse(Mat4x4(), inverse)); // Singular.
+
+    float          src[100] = {};
+    unsigned short packed[100];
+    PackHalf(src, packed, 100);
+    PackHalf(src, packed, 28);
+
+    ProfileCounter counters[PROFILE_OP_COUNT];
+    ProfileReport(counters);
+
+    assert(counters[PROFILE_OP_MAT4X4_TRY_INVERSE].calls == 2);
+    assert(counters[PROFILE_OP_MAT4X4_TRY_INVERSE].failures == 1);
+    assert(counters[PROFILE_OP_PACK_HALF].calls == 2);
+    assert(counters[PROFILE_OP_PACK_HALF].elements == 128);
+    assert(counters[PROFILE_OP_PACK_HALF].failures == 0);
+    assert(counters[PROFILE_OP_UNPACK_HALF].calls == 0);
+}
+
+// Testing an instrumented operation built on another one is counted once.
+void TestProfile_Nested()
+{
+    ProfileReset();
+
+    Mat2x2 m2 = Mat2x2(Vec2(1.0f, 2.0f), Vec2(3.0f, 4.0f)) * Mat2x2(Vec2(0.0f, 1.0f), Vec2(1.0f, 0.0f));
+    Mat3x3 m3 = Mat3x3::Identity() * Mat3x3::Identity();
+    Mat4x4 m4 = Mat4x4::Identity() * Mat4x4::Identity();
+    assert(m2[0] == Vec2(2.0f, 1.0f) && m3[1] == Vec3(0.0f, 1.0f, 0.0f) && m4[2] == Vec4(0.0f, 0.0f, 1.0f, 0.0f));
+
+    Vec2 v2(3.0f, 4.0f);
+    Vec3 v3(0.0f, 3.0f, 4.0f);
+    Vec4 v4(0.0f, 0.0f, 3.0f, 4.0f);
+    v2.Normalize();
+    v3.Normalize();
+    v4.Normalize();
+    assert(v4 == Vec4(0.0f, 0.0f, 0.6f, 0.8f));
+    (void) Vec4::Dot(v4, v4);
+    (void) v4.LengthSquared();
+
+    ProfileCounter counters[PROFILE_OP_COUNT];
+    ProfileReport(counters);
+    assert(counters[PROFILE_OP_MAT2X2_MUL_MAT].calls == 1 && counters[PROFILE_OP_MAT2X2_TRANSPOSE].calls == 0);
+    assert(counters[PROFILE_OP_MAT3X3_MUL_MAT].calls == 1 && counters[PROFILE_OP_MAT3X3_TRANSPOSE].calls == 0);
+    assert(counters[PROFILE_OP_MAT4X4_MUL_MAT].calls == 1 && counters[PROFILE_OP_MAT4X4_TRANSPOSE].calls == 0);
+    assert(counters[PROFILE_OP_VEC2_NORMALIZE].calls == 1 && counters[PROFILE_OP_VEC2_LENGTH].calls == 0);
+    assert(counters[PROFILE_OP_VEC3_NORMALIZE].calls == 1 && counters[PROFILE_OP_VEC3_LENGTH].calls == 0);
+    assert(counters[PROFILE_OP_VEC4_NORMALIZE].calls == 1 && counters[PROFILE_OP_VEC4_LENGTH].calls == 0);
+}
+
+// Testing counters of every thread are merged, including threads that already exited.
+void TestProfile_Threads()
+{
+    ProfileReset();
+
+    const int   threadCount = 4;
+    const int   iterations  = 1000;
+    std::thread threads[threadCount];
+    for (int t = 0; t < threadCount; ++t)
+    {
+        threads[t] = std::thread(
+            [iterations]()
+            {
+                Vec4 v(1.0f, 2.0f, 3.0f, 4.0f);
+                for (int i = 0; i < iterations; ++i)
+                    v.Normalize();
+            });
+    }
+    for (int t = 0; t < threadCount; ++t)
+        threads[t].join();
+
+    Vec4 v(1.0f, 0.0f, 0.0f, 0.0f);
+    v.Normalize();
+
+    ProfileCounter counters[PROFILE_OP_COUNT];
+    ProfileReport(counters);
+    assert(counters[PROFILE_OP_VEC4_NORMALIZE].calls == threadCount * iterations + 1);
+    assert(counters[PROFILE_OP_VEC4_NORMALIZE].elements == threadCount * iterations + 1);
+}
+
+// Testing reset and names.
+void TestProfile_Reset()
+{
+    Mat3x3 m = Mat3x3::Identity();
+    (void) m.Determinant();
+    ProfileReset();
+
+    ProfileCounter counters[PROFILE_OP_COUNT];
+    ProfileReport(counters);
+    for (int i = 0; i < PROFILE_OP_COUNT; ++i)
+    {
+        assert(counters[i].calls == 0);
+        assert(counters[i].cycles == 0);
+        assert(ProfileOpName((PROFILE_OP) i)[0] != '\0');
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestProfile_Counts();
+    TestProfile_Nested();
+    TestProfile_Threads();
+    TestProfile_Reset();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Profile] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+namespace
+{
+    bool NearlyEqual(const Mat4x4& a, const Mat4x4& b, float eps)
+    {
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 4; ++j)
+                if (Abs(a[i][j] - b[i][j]) > eps)
+                    return false;
+        return true;
+    }
+
+    bool NearlyEqual(const Vec3& a, const Vec3& b, float eps) { return Abs(a.x - b.x) <= eps && Abs(a.y - b.y) <= eps && Abs(a.z - b.z) <= eps; }
+
+    // q and -q are the same rotation.
+    bool SameRotation(const Quat& a, const Quat& b, float eps) { return Abs(Abs(Quat::Dot(a, b)) - 1.0f) <= eps; }
+
+    Vec3 TransformPoint(const Mat4x4& m, const Vec3& p)
+    {
+        Vec4 r = m * Vec4(p, 1.0f);
+        return Vec3(r.x, r.y, r.z);
+    }
+} // namespace
+
+// Testing the quaternion against the rotation matrices.
+void TestQuat_Rotation()
+{
+    Vec3 axis(1.0f, -2.0f, 0.5f);
+    axis.Normalize();
+    Quat q    = Quat::FromAxisAngle(axis, 1.3f);
+    assert(Abs(q.Length() - 1.0f) < 1e-6f);
+    assert(NearlyEqual(q.ToMat3x4().ToMat4x4(), Mat4x4::RotationAxis(axis, 1.3f), 1e-5f));
+
+    Vec3 euler(0.4f, -1.1f, 2.7f);
+    Quat e = Quat::FromEuler(euler);
+    assert(NearlyEqual(e.ToMat3x4().ToMat4x4(), Mat4x4::RotationEuler(euler), 1e-5f));
+
+    // Products compose like the matrices, and Rotate matches them.
+    Vec3 p(3.0f, -1.0f, 0.25f);
+    assert(NearlyEqual((q * e).ToMat3x4().ToMat4x4(), Mat4x4::RotationAxis(axis, 1.3f) * Mat4x4::RotationEuler(euler), 1e-5f));
+    assert(NearlyEqual(q.Rotate(p), TransformPoint(Mat4x4::RotationAxis(axis, 1.3f), p), 1e-5f));
+    assert(NearlyEqual((q * q.Conjugate()).Rotate(p), p, 1e-5f));
+    assert(q * Quat::Identity() == q);
+
+    // Back from matrices, through every branch of the conversion.
+    const Vec3 angles[5] = { euler, Vec3(3.1f, 0.0f, 0.0f), Vec3(0.0f, 3.1f, 0.0f), Vec3(0.0f, 0.0f, 3.1f), Vec3(0.0f, 0.0f, 0.0f) };
+    for (int i = 0; i < 5; ++i)
+    {
+        Quat r = Quat::FromEuler(angles[i]);
+        assert(SameRotation(Quat::FromRotation(r.ToMat3x4()), r, 1e-5f));
+    }
+}
+
+// Testing the shortest arc blend.
+void TestQuat_Nlerp()
+{
+    Quat a = Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.2f);
+    Quat b = Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.6f);
+    assert(SameRotation(Quat::Nlerp(a, b, 0.5f), Quat::FromAxisAngle(Vec3(0.0f, 1.0f, 0.0f), 0.4f), 1e-6f));
+    assert(Quat::Nlerp(a, b, 0.0f) == a);
+
+    // -b is the same rotation and must give the same blend.
+    assert(SameRotation(Quat::Nlerp(a, b * -1.0f, 0.5f), Quat::Nlerp(a, b, 0.5f), 1e-6f));
+}
+
+// Testing the dual quaternion against the matrices.
+void TestDualQuat_Transform()
+{
+    Mat3x4   m  = Mat3x4::TRS(Vec3(1.0f, -4.0f, 2.0f), Vec3(0.3f, -0.8f, 1.9f), Vec3(1.0f, 1.0f, 1.0f));
+    DualQuat dq = DualQuat::FromMat3x4(m);
+    assert(NearlyEqual(dq.ToMat4x4(), m.ToMat4x4(), 1e-5f));
+    assert(NearlyEqual(dq.Translation(), Vec3(1.0f, -4.0f, 2.0f), 1e-5f));
+    assert(NearlyEqual(DualQuat::FromMat4x4(m.ToMat4x4()).ToMat4x4(), m.ToMat4x4(), 1e-5f));
+
+    Vec3 p(0.5f, -3.0f, 7.0f);
+    assert(NearlyEqual(dq.TransformPoint(p), m.TransformPoint(p), 1e-5f));
+    assert(NearlyEqual(dq.TransformVector(p), m.TransformVector(p), 1e-5f));
+
+    // Composition and inverse.
+    Mat3x4   other = Mat3x4::TRS(Vec3(-2.0f, 0.5f, 3.0f), Vec3(1.2f, 0.4f, -2.2f), Vec3(1.0f, 1.0f, 1.0f));
+    DualQuat both  = dq * DualQuat::FromMat3x4(other);
+    assert(NearlyEqual(both.ToMat4x4(), (m * other).ToMat4x4(), 1e-5f));
+    assert(NearlyEqual((dq * dq.Conjugate()).ToMat4x4(), Mat4x4::Identity(), 1e-5f));
+    assert(NearlyEqual(DualQuat::Identity().TransformPoint(p), p, 0.0f));
+
+    // A scaled dual quaternion normalizes back to the same transform.
+    DualQuat scaled = dq * 3.0f;
+    scaled.Normalize();
+    assert(scaled == dq);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestQuat_Rotation();
+    TestQuat_Nlerp();
+    TestDualQuat_Transform();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Quat] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "../Test_Common.h"
+
+#include <ext/sim/DM_Particles.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    struct Particles
+    {
+        explicit Particles(size_t count) : data(9, std::vector<float>(count)) { }
+
+        ParticleStreams Streams(bool withAcceleration)
+        {
+            ParticleStreams s;
+            s.x     = data[0].data();
+            s.y     = data[1].data();
+            s.z     = data[2].data();
+            s.vx    = data[3].data();
+            s.vy    = data[4].data();
+            s.vz    = data[5].data();
+            s.ax    = withAcceleration ? data[6].data() : nullptr;
+            s.ay    = withAcceleration ? data[7].data() : nullptr;
+            s.az    = withAcceleration ? data[8].data() : nullptr;
+            s.count = data[0].size();
+            return s;
+        }
+
+        std::vector<std::vector<float>> data;
+    };
+
+    Particles RandomParticles(size_t count)
+    {
+        Particles particles(count);
+        for (size_t k = 0; k < 9; ++k)
+        {
+            for (size_t i = 0; i < count; ++i)
+                particles.data[k][i] = Random(-5.0f, 5.0f);
+        }
+        return particles;
+    }
+
+    // Double precision scalar reference of the field acceleration.
+    void Acceleration(const ParticleForces& f, const double* p, const double* v, const double* extra, double* a)
+    {
+        for (int k = 0; k < 3; ++k)
+            a[k] = f.gravity[k] + extra[k] - f.drag * v[k];
+        for (size_t i = 0; i < f.attractorCount; ++i)
+        {
+            double d[3], r2 = (double) f.attractors[i].softening * f.attractors[i].softening;
+            for (int k = 0; k < 3; ++k)
+            {
+                d[k] = f.attractors[i].position[k] - p[k];
+                r2 += d[k] * d[k];
+            }
+            double scale = f.attractors[i].strength / (r2 * std::sqrt(r2));
+            for (int k = 0; k < 3; ++k)
+                a[k] += d[k] * scale;
+        }
+    }
+
+    void Reference(Particles& particles, bool withAcceleration, const ParticleForces& f, double dt, PARTICLE_INTEGRATOR integrator)
+    {
+        for (size_t i = 0; i < particles.data[0].size(); ++i)
+        {
+            double p[3], v[3], extra[3] = { 0.0, 0.0, 0.0 }, a[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                p[k] = particles.data[k][i];
+                v[k] = particles.data[3 + k][i];
+                if (withAcceleration)
+                    extra[k] = particles.data[6 + k][i];
+            }
+            Acceleration(f, p, v, extra, a);
+            for (int k = 0; k < 3; ++k)
+            {
+                if (integrator == PARTICLE_INTEGRATOR_EULER)
+                {
+                    particles.data[k][i]     = (float) (p[k] + v[k] * dt);
+                    particles.data[3 + k][i] = (float) (v[k] + a[k] * dt);
+                }
+                else if (integrator == PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER)
+                {
+                    particles.data[3 + k][i] = (float) (v[k] + a[k] * dt);
+                    particles.data[k][i]     = (float) (p[k] + (v[k] + a[k] * dt) * dt);
+                }
+            }
+            if (integrator == PARTICLE_INTEGRATOR_VERLET)
+            {
+                double p2[3], v2[3], a2[3];
+                for (int k = 0; k < 3; ++k)
+                {
+                    p2[k] = p[k] + v[k] * dt + a[k] * 0.5 * dt * dt;
+                    v2[k] = v[k] + a[k] * dt;
+                }
+                Acceleration(f, p2, v2, extra, a2);
+                for (int k = 0; k < 3; ++k)
+                {
+                    particles.data[k][i]     = (float) p2[k];
+                    particles.data[3 + k][i] = (float) (v[k] + (a[k] + a2[k]) * 0.5 * dt);
+                }
+            }
+        }
+    }
+
+    double OrbitRadiusAfter(PARTICLE_INTEGRATOR integrator, int steps, float dt)
+    {
+        Particles particles(1);
+        particles.data[0][0] = 1.0f;
+        particles.data[4][0] = 1.0f; // Circular orbit speed for strength 1 at radius 1.
+
+        ParticleAttractor sun(Vec3(0.0f, 0.0f, 0.0f), 1.0f, 0.0f);
+        ParticleForces    forces;
+        forces.attractors     = &sun;
+        forces.attractorCount = 1;
+        for (int i = 0; i < steps; ++i)
+            IntegrateParticles(particles.Streams(false), forces, dt, integrator);
+        return std::sqrt((double) particles.data[0][0] * particles.data[0][0] + (double) particles.data[1][0] * particles.data[1][0]);
+    }
+} // namespace
+
+// Testing every integrator against the double reference, for every tail length, with and without extra acceleration.
+void TestParticles_Reference()
+{
+    ParticleAttractor attractors[2] = { ParticleAttractor(Vec3(1.0f, 2.0f, -1.0f), 4.0f, 0.5f), ParticleAttractor(Vec3(-3.0f, 0.0f, 2.0f), -2.0f, 1.0f) };
+    ParticleForces    forces;
+    forces.gravity        = Vec3(0.0f, -9.81f, 0.0f);
+    forces.drag           = 0.3f;
+    forces.attractors     = attractors;
+    forces.attractorCount = 2;
+
+    const PARTICLE_INTEGRATOR integrators[3] = { PARTICLE_INTEGRATOR_EULER, PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER, PARTICLE_INTEGRATOR_VERLET };
+    const size_t              counts[8]      = { 0, 1, 3, 4, 7, 8, 13, 1001 };
+    for (int m = 0; m < 3; ++m)
+    {
+        for (int c = 0; c < 8; ++c)
+        {
+            for (int withAcceleration = 0; withAcceleration < 2; ++withAcceleration)
+            {
+                Particles particles = RandomParticles(counts[c]);
+                Particles expected  = particles;
+                IntegrateParticles(particles.Streams(withAcceleration != 0), forces, 0.01f, integrators[m]);
+                Reference(expected, withAcceleration != 0, forces, 0.01, integrators[m]);
+                for (size_t k = 0; k < 9; ++k)
+                {
+                    for (size_t i = 0; i < counts[c]; ++i)
+                        assert(Abs(particles.data[k][i] - expected.data[k][i]) <= 1e-5f * Max(1.0f, Abs(expected.data[k][i])));
+                }
+            }
+        }
+    }
+}
+
+// Testing that the pool splits the work without changing any result.
+void TestParticles_Parallel()
+{
+    ParticleAttractor attractor(Vec3(0.0f, 1.0f, 0.0f), 3.0f, 0.2f);
+    ParticleForces    forces;
+    forces.gravity        = Vec3(0.0f, -1.0f, 0.0f);
+    forces.attractors     = &attractor;
+    forces.attractorCount = 1;
+
+    Particles  serial   = RandomParticles(50003);
+    Particles  parallel = serial;
+    ThreadPool pool(3);
+    for (int step = 0; step < 3; ++step)
+    {
+        IntegrateParticles(serial.Streams(true), forces, 0.016f, PARTICLE_INTEGRATOR_VERLET);
+        IntegrateParticles(parallel.Streams(true), forces, 0.016f, PARTICLE_INTEGRATOR_VERLET, &pool);
+    }
+    assert(serial.data == parallel.data);
+}
+
+// Testing the expected physical behaviour of each scheme.
+void TestParticles_Physics()
+{
+    // Constant acceleration: Verlet integrates it exactly.
+    Particles      falling(4);
+    ParticleForces gravity;
+    gravity.gravity = Vec3(0.0f, -10.0f, 0.0f);
+    for (int i = 0; i < 100; ++i)
+        IntegrateParticles(falling.Streams(false), gravity, 0.01f, PARTICLE_INTEGRATOR_VERLET);
+    assert(Abs(falling.data[1][0] - -5.0f) < 1e-4f && Abs(falling.data[4][0] - -10.0f) < 1e-4f);
+
+    // Circular orbit over about 1.6 revolutions: the symplectic schemes keep the radius, explicit Euler spirals out.
+    double euler  = OrbitRadiusAfter(PARTICLE_INTEGRATOR_EULER, 1000, 0.01f);
+    double semi   = OrbitRadiusAfter(PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER, 1000, 0.01f);
+    double verlet = OrbitRadiusAfter(PARTICLE_INTEGRATOR_VERLET, 1000, 0.01f);
+    assert(euler > 1.05);
+    assert(Abs(semi - 1.0) < 0.01);
+    assert(Abs(verlet - 1.0) < 1e-3);
+
+    // Drag decays the velocity.
+    Particles      moving(1);
+    ParticleForces drag;
+    drag.drag         = 1.0f;
+    moving.data[3][0] = 1.0f;
+    for (int i = 0; i < 100; ++i)
+        IntegrateParticles(moving.Streams(false), drag, 0.01f, PARTICLE_INTEGRATOR_SEMI_IMPLICIT_EULER);
+    assert(Abs(moving.data[3][0] - std::exp(-1.0f)) < 0.01f);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(5);
+
+    TestParticles_Reference();
+    TestParticles_Parallel();
+    TestParticles_Physics();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Particles] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
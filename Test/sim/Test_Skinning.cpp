@@ -0,0 +1,166 @@
+#include "../Test_Common.h"
+
+#include <ext/sim/DM_Skinning.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    struct Mesh
+    {
+        explicit Mesh(size_t count) : data(12, std::vector<float>(count)), joints(4 * count), weights(4 * count) { }
+
+        SkinningStreams Streams(bool withNormals)
+        {
+            SkinningStreams s;
+            s.x       = data[0].data();
+            s.y       = data[1].data();
+            s.z       = data[2].data();
+            s.nx      = withNormals ? data[3].data() : nullptr;
+            s.ny      = withNormals ? data[4].data() : nullptr;
+            s.nz      = withNormals ? data[5].data() : nullptr;
+            s.joints  = joints.data();
+            s.weights = weights.data();
+            s.outX    = data[6].data();
+            s.outY    = data[7].data();
+            s.outZ    = data[8].data();
+            s.outNX   = data[9].data();
+            s.outNY   = data[10].data();
+            s.outNZ   = data[11].data();
+            s.count   = data[0].size();
+            return s;
+        }
+
+        std::vector<std::vector<float>> data;
+        std::vector<unsigned short>     joints;
+        std::vector<float>              weights;
+    };
+
+    // Vertices with 1 to 4 influences whose weights sum to 1.
+    Mesh RandomMesh(size_t count, size_t jointCount)
+    {
+        Mesh mesh(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (int k = 0; k < 6; ++k)
+                mesh.data[k][i] = Random(-2.0f, 2.0f);
+
+            size_t used = 1 + i % 4;
+            float  sum  = 0.0f;
+            for (size_t k = 0; k < 4; ++k)
+            {
+                mesh.joints[4 * i + k]  = (unsigned short) ((i * 7 + k * 3) % jointCount);
+                mesh.weights[4 * i + k] = k < used ? Random(0.1f, 1.0f) : 0.0f;
+                sum += mesh.weights[4 * i + k];
+            }
+            for (size_t k = 0; k < 4; ++k)
+                mesh.weights[4 * i + k] /= sum;
+        }
+        return mesh;
+    }
+
+    // Palette entries spread over both hemispheres so that the sign flip matters.
+    std::vector<DualQuat> RandomPalette(size_t count)
+    {
+        std::vector<DualQuat> palette(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vec3 axis = RandomVec3(-1.0f, 1.0f);
+            axis.Normalize();
+            Quat r     = Quat::FromAxisAngle(axis, Random(-0.8f, 0.8f));
+            palette[i] = DualQuat::FromRotationTranslation(i % 2 ? r * -1.0f : r, RandomVec3(-3.0f, 3.0f));
+        }
+        return palette;
+    }
+
+    // Scalar reference of the blend of vertex i.
+    DualQuat Blend(const std::vector<DualQuat>& palette, const Mesh& mesh, size_t i)
+    {
+        const DualQuat& first = palette[mesh.joints[4 * i]];
+        DualQuat        blend = first * mesh.weights[4 * i];
+        for (size_t k = 1; k < 4; ++k)
+        {
+            const DualQuat& q = palette[mesh.joints[4 * i + k]];
+            float           w = mesh.weights[4 * i + k];
+            blend             = blend + q * (Quat::Dot(q.real, first.real) < 0.0f ? -w : w);
+        }
+        return blend.Normalized();
+    }
+
+    bool NearlyEqual(const Vec3& a, float x, float y, float z, float eps) { return Abs(a.x - x) <= eps && Abs(a.y - y) <= eps && Abs(a.z - z) <= eps; }
+} // namespace
+
+// Testing the kernel against the scalar blend, with and without normals and for counts that leave a tail.
+void TestSkinning_Blend()
+{
+    std::vector<DualQuat> palette = RandomPalette(9);
+    const size_t          counts[4] = { 0, 3, 64, 1001 };
+    for (int c = 0; c < 4; ++c)
+    {
+        Mesh mesh = RandomMesh(counts[c], palette.size());
+        for (int normals = 0; normals < 2; ++normals)
+        {
+            SkinDualQuat(palette.data(), palette.size(), mesh.Streams(normals != 0));
+            for (size_t i = 0; i < counts[c]; ++i)
+            {
+                DualQuat blend = Blend(palette, mesh, i);
+                Vec3     p     = blend.TransformPoint(Vec3(mesh.data[0][i], mesh.data[1][i], mesh.data[2][i]));
+                assert(NearlyEqual(p, mesh.data[6][i], mesh.data[7][i], mesh.data[8][i], 1e-4f));
+                if (normals)
+                {
+                    Vec3 n = blend.TransformVector(Vec3(mesh.data[3][i], mesh.data[4][i], mesh.data[5][i]));
+                    assert(NearlyEqual(n, mesh.data[9][i], mesh.data[10][i], mesh.data[11][i], 1e-4f));
+                }
+            }
+        }
+    }
+
+    // A single joint moves the vertex rigidly.
+    Mesh one = RandomMesh(5, 1);
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (size_t k = 0; k < 4; ++k)
+            one.weights[4 * i + k] = k == 0 ? 1.0f : 0.0f;
+    }
+    SkinDualQuat(palette.data(), 1, one.Streams(false));
+    for (size_t i = 0; i < 5; ++i)
+    {
+        Vec3 p = palette[0].ToMat3x4().TransformPoint(Vec3(one.data[0][i], one.data[1][i], one.data[2][i]));
+        assert(NearlyEqual(p, one.data[6][i], one.data[7][i], one.data[8][i], 1e-4f));
+    }
+}
+
+// Testing that the pool changes nothing.
+void TestSkinning_Parallel()
+{
+    std::vector<DualQuat> palette = RandomPalette(32);
+    Mesh                  serial  = RandomMesh(20003, palette.size());
+    Mesh                  parallel = serial;
+    ThreadPool            pool(3);
+    SkinDualQuat(palette.data(), palette.size(), serial.Streams(true));
+    SkinDualQuat(palette.data(), palette.size(), parallel.Streams(true), &pool);
+    for (int k = 6; k < 12; ++k)
+        assert(serial.data[k] == parallel.data[k]);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(11);
+
+    TestSkinning_Blend();
+    TestSkinning_Parallel();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Skinning] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
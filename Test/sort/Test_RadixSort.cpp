@@ -0,0 +1,179 @@
+#include <DropMath.h>
+#include <ext/sort/DM_RadixSort.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace DropMath;
+
+namespace
+{
+    unsigned long long g_Seed = 88172645463325252ull;
+
+    unsigned long long Random()
+    {
+        g_Seed ^= g_Seed << 13;
+        g_Seed ^= g_Seed >> 7;
+        g_Seed ^= g_Seed << 17;
+        return g_Seed;
+    }
+
+    // Check keys against a stable sort of the original keys, with values[i] holding the original index of keys[i].
+    template <typename Key>
+    void CheckSorted(const std::vector<Key>& original, const std::vector<Key>& keys, const std::vector<unsigned int>& values)
+    {
+        std::vector<unsigned int> expected(original.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            expected[i] = (unsigned int) i;
+        std::stable_sort(expected.begin(), expected.end(), [&](unsigned int a, unsigned int b) { return original[a] < original[b]; });
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            assert(values[i] == expected[i]);
+            assert(keys[i] == original[expected[i]]);
+        }
+    }
+
+    template <typename Key>
+    void SortAndCheck(RadixSorter& sorter, const std::vector<Key>& original)
+    {
+        std::vector<Key>          keys = original;
+        std::vector<unsigned int> values(keys.size());
+        for (size_t i = 0; i < values.size(); ++i)
+            values[i] = (unsigned int) i;
+        sorter.Sort(keys.data(), values.data(), keys.size());
+        CheckSorted(original, keys, values);
+
+        // The order of the same keys, which stay untouched.
+        std::vector<unsigned int> order(keys.size());
+        keys = original;
+        sorter.SortOrder(keys.data(), keys.size(), order.data());
+        assert(keys == original);
+        std::vector<Key> gathered(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+            gathered[i] = keys[order[i]];
+        CheckSorted(original, gathered, order);
+
+        // Keys only.
+        sorter.Sort(keys.data(), nullptr, keys.size());
+        assert(keys == gathered);
+    }
+} // namespace
+
+// Testing the order preserving float and double keys and their inverse.
+void TestRadixSort_FloatKeys()
+{
+    const float values[] = { -std::numeric_limits<float>::infinity(), -3.0e38f, -2.0f, -1.0f, -1e-38f, -1e-45f, -0.0f, 0.0f, 1e-45f, 1e-38f,
+                             0.5f, 1.0f, 3.0e38f, std::numeric_limits<float>::infinity() };
+    const size_t n        = sizeof(values) / sizeof(values[0]);
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert(FloatFromSortKey(FloatSortKey(values[i])) == values[i]);
+        assert(DoubleFromSortKey(DoubleSortKey((double) values[i])) == (double) values[i]);
+        if (i > 0)
+        {
+            assert(FloatSortKey(values[i - 1]) < FloatSortKey(values[i]));
+            assert(DoubleSortKey((double) values[i - 1]) < DoubleSortKey((double) values[i]));
+        }
+    }
+    assert(FloatSortKey(std::numeric_limits<float>::quiet_NaN()) > FloatSortKey(std::numeric_limits<float>::infinity()));
+
+    // Sign of zero survives the round trip.
+    float negativeZero = FloatFromSortKey(FloatSortKey(-0.0f));
+    assert(FloatSortKey(negativeZero) < FloatSortKey(0.0f));
+}
+
+// Testing every key type on one thread, with repeated keys to check that the sort is stable.
+void TestRadixSort_Serial()
+{
+    RadixSorter sorter;
+
+    std::vector<unsigned int>       u32(5000);
+    std::vector<unsigned long long> u64(5000);
+    std::vector<float>              f32(5000);
+    std::vector<double>             f64(5000);
+    for (size_t i = 0; i < u32.size(); ++i)
+    {
+        u32[i] = (unsigned int) (Random() % 700) * 0x01010101u;
+        u64[i] = (Random() % 900) << (i % 3 * 20);
+        f32[i] = (float) ((int) (Random() % 2001) - 1000) * 0.25f;
+        f64[i] = (double) ((int) (Random() % 301) - 150) * 1e10;
+    }
+    SortAndCheck(sorter, u32);
+    SortAndCheck(sorter, u64);
+    SortAndCheck(sorter, f32);
+    SortAndCheck(sorter, f64);
+
+    // Keys that only differ in their low byte skip the other passes.
+    std::vector<unsigned int> small(777);
+    for (size_t i = 0; i < small.size(); ++i)
+        small[i] = 0xABCD0000u | (unsigned int) (Random() & 0xFF);
+    SortAndCheck(sorter, small);
+
+    // Empty and single key arrays.
+    SortAndCheck(sorter, std::vector<unsigned int>());
+    SortAndCheck(sorter, std::vector<double>(1, -4.0));
+
+    // Sorting in place without a payload.
+    std::vector<float> depths(f32);
+    sorter.Sort(depths.data(), nullptr, depths.size());
+    std::stable_sort(f32.begin(), f32.end());
+    assert(depths == f32);
+}
+
+// Testing the threaded histograms and the buffered scatter against the same results.
+void TestRadixSort_Parallel()
+{
+    ThreadPool        pool(3);
+    RadixSortSettings settings;
+    settings.parallelThreshold = 1000;
+    settings.pool              = &pool;
+    RadixSorter sorter(settings);
+
+    // Small slices scatter directly.
+    std::vector<unsigned int> u32(20000);
+    for (size_t i = 0; i < u32.size(); ++i)
+        u32[i] = (unsigned int) (Random() % 5000) * 104729u;
+    SortAndCheck(sorter, u32);
+
+    // Slices of more than 8K keys scatter through the buffers, into output arrays that are not cache line aligned.
+    std::vector<unsigned long long> u64(300001);
+    std::vector<float>              f32(300001);
+    for (size_t i = 0; i < u64.size(); ++i)
+    {
+        u64[i] = Random() >> (i % 40);
+        f32[i] = (float) ((long long) (Random() % 100000) - 50000) * 0.01f;
+    }
+    SortAndCheck(sorter, u64);
+    SortAndCheck(sorter, f32);
+
+    // A single thread with a large array uses the buffers too.
+    RadixSortSettings serialSettings;
+    serialSettings.parallelThreshold = (size_t) -1;
+    RadixSorter               serial(serialSettings);
+    std::vector<unsigned int> codes(100003);
+    for (size_t i = 0; i < codes.size(); ++i)
+        codes[i] = (unsigned int) (Random() & 0x3FFFFFFFu);
+    SortAndCheck(serial, codes);
+    serial.Clear();
+    SortAndCheck(serial, codes);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestRadixSort_FloatKeys();
+    TestRadixSort_Serial();
+    TestRadixSort_Parallel();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test RadixSort] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
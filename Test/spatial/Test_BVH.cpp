@@ -0,0 +1,270 @@
+#include "../Test_Common.h"
+
+#include <ext/spatial/DM_BVH.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    std::vector<AABB> RandomBoxes(size_t count)
+    {
+        std::vector<AABB> boxes(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vec3 c(Random(-100.0f, 100.0f), Random(-100.0f, 100.0f), Random(-100.0f, 100.0f));
+            Vec3 e(Random(0.0f, 2.0f), Random(0.0f, 2.0f), Random(0.0f, 2.0f));
+            boxes[i] = AABB(c - e, c + e);
+        }
+        return boxes;
+    }
+
+    // Scalar slab test, returns the entry distance or infinity.
+    float RayBox(const Vec3& o, const Vec3& d, const AABB& b)
+    {
+        float enter = 0.0f, exit = DM_INFINITY_F;
+        for (int a = 0; a < 3; ++a)
+        {
+            float inv = 1.0f / d[a];
+            float t1  = (b.min[a] - o[a]) * inv;
+            float t2  = (b.max[a] - o[a]) * inv;
+            enter     = Max(enter, Min(t1, t2));
+            exit      = Min(exit, Max(t1, t2));
+        }
+        return enter <= exit ? enter : DM_INFINITY_F;
+    }
+
+    float RayTriangle(const Vec3& o, const Vec3& d, const Vec3& v0, const Vec3& v1, const Vec3& v2)
+    {
+        Vec3  e1  = v1 - v0;
+        Vec3  e2  = v2 - v0;
+        Vec3  p   = Vec3::Cross(d, e2);
+        float det = Vec3::Dot(e1, p);
+        if (Abs(det) < 1e-12f)
+            return DM_INFINITY_F;
+        float inv = 1.0f / det;
+        Vec3  s   = o - v0;
+        float u   = Vec3::Dot(s, p) * inv;
+        Vec3  q   = Vec3::Cross(s, e1);
+        float v   = Vec3::Dot(d, q) * inv;
+        float t   = Vec3::Dot(e2, q) * inv;
+        return (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f) ? t : DM_INFINITY_F;
+    }
+
+    // Check bounds nesting, leaf sizes, sibling alignment and that every primitive is in exactly one leaf.
+    void CheckTree(const BVH& bvh, const std::vector<AABB>& boxes, int maxLeafSize)
+    {
+        const BVHNode* nodes = bvh.Nodes();
+        assert(((uintptr_t) nodes % 64) == 0);
+
+        std::vector<int> seen(boxes.size(), 0);
+        std::vector<int> stack(1, 0);
+        while (!stack.empty())
+        {
+            const BVHNode& node = nodes[stack.back()];
+            stack.pop_back();
+            AABB bounds = node.Bounds();
+            if (node.IsLeaf())
+            {
+                assert((int) node.count <= maxLeafSize);
+                for (unsigned int i = node.leftFirst; i < node.leftFirst + node.count; ++i)
+                {
+                    unsigned int p = bvh.Indices()[i];
+                    ++seen[p];
+                    assert(AABB::Union(bounds, boxes[p]).SurfaceArea() == bounds.SurfaceArea());
+                }
+                continue;
+            }
+            assert(node.leftFirst % 2 == 0 && node.leftFirst + 1 < bvh.NodeCount());
+            for (int c = 0; c < 2; ++c)
+            {
+                AABB child = nodes[node.leftFirst + c].Bounds();
+                assert(bounds.Contains(child.min) && bounds.Contains(child.max));
+                stack.push_back(node.leftFirst + c);
+            }
+        }
+        for (size_t i = 0; i < seen.size(); ++i)
+            assert(seen[i] == 1);
+
+        // Wide nodes reference every primitive exactly once too.
+        std::vector<int> wideSeen(boxes.size(), 0);
+        stack.assign(1, 0);
+        while (!stack.empty())
+        {
+            const BVH4Node& node = bvh.WideNodes()[stack.back()];
+            stack.pop_back();
+            for (int i = 0; i < 4; ++i)
+            {
+                if (node.count[i] == 0)
+                    stack.push_back(node.child[i]);
+                for (int p = node.child[i]; p < node.child[i] + node.count[i]; ++p)
+                    ++wideSeen[bvh.Indices()[p]];
+            }
+        }
+        assert(wideSeen == seen);
+    }
+} // namespace
+
+// Testing the tree structure for several sizes, including one that builds in parallel.
+void TestBVH_Build()
+{
+    ThreadPool pool(3);
+    for (size_t count : {(size_t) 1, (size_t) 3, (size_t) 100, (size_t) 30000})
+    {
+        std::vector<AABB> boxes = RandomBoxes(count);
+        BVHBuildSettings  settings;
+        settings.pool              = &pool;
+        settings.parallelThreshold = 1000;
+
+        BVH bvh;
+        bvh.Build(boxes.data(), boxes.size(), settings);
+        assert(bvh.PrimitiveCount() == count);
+        CheckTree(bvh, boxes, settings.maxLeafSize);
+
+        AABB all;
+        for (size_t i = 0; i < count; ++i)
+            all.Expand(boxes[i]);
+        assert(bvh.Bounds().min == all.min && bvh.Bounds().max == all.max);
+    }
+
+    // Every primitive at the same place: median splits keep leaves small.
+    std::vector<AABB> same(1000, AABB(Vec3(1.0f, 1.0f, 1.0f), Vec3(2.0f, 2.0f, 2.0f)));
+    BVH               degenerate;
+    degenerate.Build(same.data(), same.size());
+    CheckTree(degenerate, same, 4);
+
+    BVH empty;
+    empty.Build(same.data(), 0);
+    assert(empty.IsEmpty() && empty.WideNodeCount() == 0);
+    int calls = 0;
+    empty.QueryAABB(same[0], [&](unsigned int) { ++calls; });
+    assert(calls == 0);
+}
+
+// Testing box, sphere and ray queries against brute force.
+void TestBVH_Queries()
+{
+    std::vector<AABB> boxes = RandomBoxes(5000);
+    BVH               bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    for (int q = 0; q < 100; ++q)
+    {
+        Vec3 c(Random(-100.0f, 100.0f), Random(-100.0f, 100.0f), Random(-100.0f, 100.0f));
+        Vec3 e(Random(0.0f, 10.0f), Random(0.0f, 10.0f), Random(0.0f, 10.0f));
+        AABB query(c - e, c + e);
+
+        std::vector<int> found(boxes.size(), 0);
+        bvh.QueryAABB(query, [&](unsigned int p) { ++found[p]; });
+        for (size_t i = 0; i < boxes.size(); ++i)
+            assert(found[i] == (boxes[i].Overlaps(query) ? 1 : 0));
+
+        float radius = Random(0.0f, 15.0f);
+        found.assign(boxes.size(), 0);
+        bvh.QuerySphere(c, radius, [&](unsigned int p) { ++found[p]; });
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            Vec3  closest(Clamp(c.x, boxes[i].min.x, boxes[i].max.x), Clamp(c.y, boxes[i].min.y, boxes[i].max.y),
+                          Clamp(c.z, boxes[i].min.z, boxes[i].max.z));
+            float d2 = (closest - c).LengthSquared();
+            if (Abs(d2 - radius * radius) > 1e-2f)
+                assert(found[i] == (d2 <= radius * radius ? 1 : 0));
+        }
+
+        // Nearest box hit.
+        Vec3 origin(Random(-150.0f, 150.0f), Random(-150.0f, 150.0f), -150.0f);
+        Vec3 direction(Random(-0.5f, 0.5f), Random(-0.5f, 0.5f), 1.0f);
+        direction.Normalize();
+
+        float expected = DM_INFINITY_F;
+        for (size_t i = 0; i < boxes.size(); ++i)
+            expected = Min(expected, RayBox(origin, direction, boxes[i]));
+
+        float tMax = DM_INFINITY_F;
+        bool  hit  = bvh.Raycast(origin, direction, tMax,
+                                 [&](unsigned int p, float& t)
+                                 {
+                                     float d = RayBox(origin, direction, boxes[p]);
+                                     if (d >= t)
+                                         return false;
+                                     t = d;
+                                     return true;
+                                 });
+        assert(hit == (expected < DM_INFINITY_F));
+        assert(tMax == expected);
+    }
+}
+
+// Testing a triangle build with nearest hit raycasts.
+void TestBVH_Triangles()
+{
+    // Height field of 64 x 64 quads.
+    const int                 n = 64;
+    std::vector<Vec3>         vertices;
+    std::vector<unsigned int> indices;
+    for (int z = 0; z <= n; ++z)
+        for (int x = 0; x <= n; ++x)
+            vertices.push_back(Vec3((float) x, Sin((float) x * 0.3f) * Cos((float) z * 0.2f) * 3.0f, (float) z));
+    for (int z = 0; z < n; ++z)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            unsigned int i = z * (n + 1) + x;
+            unsigned int quad[6] = {i, i + n + 1, i + 1, i + 1, i + n + 1, i + n + 2};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+
+    BVH    bvh;
+    size_t triangleCount = indices.size() / 3;
+    bvh.Build(vertices.data(), indices.data(), triangleCount);
+    assert(bvh.PrimitiveCount() == triangleCount);
+
+    for (int r = 0; r < 200; ++r)
+    {
+        Vec3 origin(Random(0.0f, (float) n), 10.0f, Random(0.0f, (float) n));
+        Vec3 direction(Random(-0.3f, 0.3f), -1.0f, Random(-0.3f, 0.3f));
+
+        auto triangle = [&](unsigned int t)
+        { return RayTriangle(origin, direction, vertices[indices[t * 3]], vertices[indices[t * 3 + 1]], vertices[indices[t * 3 + 2]]); };
+
+        float expected = DM_INFINITY_F;
+        for (size_t t = 0; t < triangleCount; ++t)
+            expected = Min(expected, triangle((unsigned int) t));
+
+        float tMax = DM_INFINITY_F;
+        bvh.Raycast(origin, direction, tMax,
+                    [&](unsigned int t, float& tBest)
+                    {
+                        float d = triangle(t);
+                        if (d >= tBest)
+                            return false;
+                        tBest = d;
+                        return true;
+                    });
+        assert(tMax == expected);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(1);
+
+    TestBVH_Build();
+    TestBVH_Queries();
+    TestBVH_Triangles();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test BVH] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
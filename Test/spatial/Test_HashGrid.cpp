@@ -0,0 +1,211 @@
+#include "../Test_Common.h"
+
+#include <ext/spatial/DM_HashGrid.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    // Uniform background plus a dense cluster, so some cells hold hundreds of points.
+    std::vector<Vec3> RandomPoints(size_t count)
+    {
+        std::vector<Vec3> points(count);
+        for (size_t i = 0; i < count; ++i)
+            points[i] = i % 4 == 0 ? RandomVec3(10.0f, 12.0f) : RandomVec3(-50.0f, 50.0f);
+        return points;
+    }
+
+    void CheckRadius(const HashGrid& grid, const std::vector<Vec3>& points, const Vec3& center, float radius)
+    {
+        std::vector<unsigned int> found;
+        grid.QueryRadius(center, radius,
+                         [&](unsigned int i, float d2)
+                         {
+                             assert(SameDistanceSquared(d2, DistanceSquared(points[i], center)));
+                             found.push_back(i);
+                         });
+        std::vector<unsigned int> expected;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            if (DistanceSquared(points[i], center) <= radius * radius)
+                expected.push_back((unsigned int) i);
+        }
+        std::sort(found.begin(), found.end());
+        assert(found == expected); // Also catches points reported twice.
+    }
+
+    void CheckKNearest(const HashGrid& grid, const std::vector<Vec3>& points, const Vec3& center, size_t k, float maxRadius)
+    {
+        std::vector<unsigned int> indices(k);
+        std::vector<float>        distances(k);
+        size_t                    found = grid.QueryKNearest(center, k, indices.data(), distances.data(), maxRadius);
+
+        std::vector<float> expected;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            float d2 = DistanceSquared(points[i], center);
+            if (d2 <= maxRadius * maxRadius)
+                expected.push_back(d2);
+        }
+        std::sort(expected.begin(), expected.end());
+        if (expected.size() > k)
+            expected.resize(k);
+
+        assert(found == expected.size());
+        for (size_t i = 0; i < found; ++i)
+        {
+            assert(SameDistanceSquared(distances[i], expected[i]));
+            assert(SameDistanceSquared(distances[i], DistanceSquared(points[indices[i]], center)));
+        }
+    }
+} // namespace
+
+// Testing the cell sorted layout and that the parallel build matches the serial one.
+void TestHashGrid_Build()
+{
+    HashGrid grid;
+    assert(grid.IsEmpty());
+    grid.Build(nullptr, 0, 1.0f);
+    assert(grid.IsEmpty() && grid.QueryKNearest(Vec3(0.0f, 0.0f, 0.0f), 4, nullptr, nullptr) == 0);
+
+    std::vector<Vec3> points = RandomPoints(20000);
+
+    ThreadPool       serialPool(0), parallelPool(3);
+    HashGridSettings serial, parallel;
+    serial.pool                = &serialPool;
+    parallel.pool              = &parallelPool;
+    parallel.parallelThreshold = 1000;
+
+    HashGrid other;
+    grid.Build(points.data(), points.size(), 2.0f, serial);
+    other.Build(points.data(), points.size(), 2.0f, parallel);
+    assert(grid.Count() == points.size() && grid.CellSize() == 2.0f && grid.Slack() == 0.0f);
+
+    std::vector<bool> seen(points.size(), false);
+    for (size_t i = 0; i < grid.Count(); ++i)
+    {
+        // Both builds are stable counting sorts, so they agree slot for slot.
+        assert(grid.Indices()[i] == other.Indices()[i]);
+        unsigned int p = grid.Indices()[i];
+        assert(!seen[p]);
+        seen[p] = true;
+        assert(grid.X()[i] == points[p].x && grid.Y()[i] == points[p].y && grid.Z()[i] == points[p].z);
+    }
+
+    // A table smaller than the radix of the parallel build.
+    parallel.parallelThreshold = 0;
+    grid.Build(points.data(), 300, 2.0f, serial);
+    other.Build(points.data(), 300, 2.0f, parallel);
+    for (size_t i = 0; i < grid.Count(); ++i)
+        assert(grid.Indices()[i] == other.Indices()[i]);
+}
+
+// Testing radius and k nearest queries against brute force.
+void TestHashGrid_Queries()
+{
+    std::vector<Vec3> points = RandomPoints(5000);
+    HashGrid          grid;
+    grid.Build(points.data(), points.size(), 1.5f);
+
+    for (int iteration = 0; iteration < 200; ++iteration)
+    {
+        Vec3 center = iteration % 3 == 0 ? RandomVec3(9.0f, 13.0f) : RandomVec3(-60.0f, 60.0f);
+        CheckRadius(grid, points, center, Random(0.0f, 6.0f));
+        CheckKNearest(grid, points, center, 1 + iteration % 40, DM_INFINITY_F);
+        CheckKNearest(grid, points, center, 16, 3.0f);
+    }
+
+    // Radius covering every cell falls back to a linear scan; far away centers.
+    CheckRadius(grid, points, Vec3(0.0f, 0.0f, 0.0f), 1000.0f);
+    CheckRadius(grid, points, Vec3(1e6f, -1e6f, 0.0f), 10.0f);
+    CheckKNearest(grid, points, Vec3(1e4f, 0.0f, -1e4f), 5, DM_INFINITY_F);
+    CheckKNearest(grid, points, Vec3(0.0f, 0.0f, 0.0f), points.size() + 10, DM_INFINITY_F);
+
+    // Negative radius finds nothing.
+    int calls = 0;
+    grid.QueryRadius(Vec3(0.0f, 0.0f, 0.0f), -1.0f, [&](unsigned int, float) { ++calls; });
+    assert(calls == 0);
+}
+
+// Testing k nearest queries on sparse clouds spread over far more cells than points, which fall back to a scan of
+// every point instead of walking the empty cells.
+void TestHashGrid_Sparse()
+{
+    std::vector<Vec3> points = { Vec3(0.0f, 0.0f, 0.0f), Vec3(2000.0f, 2000.0f, 2000.0f) };
+    HashGrid          grid;
+    grid.Build(points.data(), points.size(), 1.0f);
+    CheckKNearest(grid, points, Vec3(0.0f, 0.0f, 0.0f), 2, DM_INFINITY_F);
+    CheckKNearest(grid, points, Vec3(1000.0f, 1000.0f, 999.0f), 1, DM_INFINITY_F);
+
+    points.resize(300);
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = RandomVec3(-1e5f, 1e5f);
+    grid.Build(points.data(), points.size(), 1.0f);
+    for (int iteration = 0; iteration < 50; ++iteration)
+    {
+        Vec3 center = iteration % 2 == 0 ? points[iteration] : RandomVec3(-1e5f, 1e5f);
+        CheckKNearest(grid, points, center, 1 + iteration % 8, DM_INFINITY_F);
+        CheckKNearest(grid, points, center, 4, 2e4f);
+    }
+}
+
+// Testing in place updates and the rebuild once points leave their cells.
+void TestHashGrid_Update()
+{
+    std::vector<Vec3> points = RandomPoints(4000);
+    HashGrid          grid;
+    grid.Build(points.data(), points.size(), 2.0f);
+
+    // Small steps stay within the slack.
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        for (size_t i = 0; i < points.size(); ++i)
+            points[i] = points[i] + RandomVec3(-0.05f, 0.05f);
+        assert(!grid.Update(points.data()));
+        assert(grid.Slack() <= 0.25f + 1e-4f);
+
+        for (int q = 0; q < 30; ++q)
+        {
+            Vec3 center = RandomVec3(-50.0f, 50.0f);
+            CheckRadius(grid, points, center, Random(0.0f, 5.0f));
+            CheckKNearest(grid, points, center, 10, DM_INFINITY_F);
+        }
+    }
+
+    // A large move rebuilds.
+    for (size_t i = 0; i < points.size(); ++i)
+        points[i] = points[i] + Vec3(5.0f, 0.0f, 0.0f);
+    assert(grid.Update(points.data()));
+    assert(grid.Slack() == 0.0f);
+    for (int q = 0; q < 30; ++q)
+    {
+        Vec3 center = RandomVec3(-50.0f, 50.0f);
+        CheckRadius(grid, points, center, Random(0.0f, 5.0f));
+        CheckKNearest(grid, points, center, 10, DM_INFINITY_F);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(3);
+
+    TestHashGrid_Build();
+    TestHashGrid_Queries();
+    TestHashGrid_Sparse();
+    TestHashGrid_Update();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test HashGrid] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "../Test_Common.h"
+
+#include <ext/spatial/DM_KDTree.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    // A scan-like cloud: points on a noisy sphere plus a flat floor, with some exact duplicates.
+    std::vector<Vec3> RandomCloud(size_t count)
+    {
+        std::vector<Vec3> points(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 10 == 9)
+                points[i] = points[i - 1];
+            else if (i % 2)
+                points[i] = Vec3(Random(-20.0f, 20.0f), 0.0f, Random(-20.0f, 20.0f));
+            else
+            {
+                Vec3 n = RandomVec3(-1.0f, 1.0f);
+                n.Normalize();
+                points[i] = n * Random(9.9f, 10.1f) + Vec3(0.0f, 10.0f, 0.0f);
+            }
+        }
+        return points;
+    }
+
+    std::vector<float> BruteKNearest(const std::vector<Vec3>& points, const Vec3& center, size_t k, float maxRadius)
+    {
+        std::vector<float> distances;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            float d2 = DistanceSquared(points[i], center);
+            if (d2 <= maxRadius * maxRadius)
+                distances.push_back(d2);
+        }
+        std::sort(distances.begin(), distances.end());
+        if (distances.size() > k)
+            distances.resize(k);
+        return distances;
+    }
+
+    // Every point of the subtree of node lies on the correct side of all its ancestors' splits.
+    void CheckSubtree(const KDTree& tree, unsigned int node, int level, const Vec3& lo, const Vec3& hi)
+    {
+        size_t firstLeaf = (size_t) (node - ((1u << level) - 1)) << (tree.Depth() - level);
+        size_t lastLeaf  = firstLeaf + ((size_t) 1 << (tree.Depth() - level));
+        for (unsigned int s = tree.LeafStarts()[firstLeaf]; s < tree.LeafStarts()[lastLeaf]; ++s)
+        {
+            Vec3 p(tree.X()[s], tree.Y()[s], tree.Z()[s]);
+            for (int a = 0; a < 3; ++a)
+                assert(p[a] >= lo[a] && p[a] <= hi[a]);
+        }
+        if (level == tree.Depth())
+            return;
+
+        const KDNode& inner = tree.Nodes()[node];
+        Vec3          leftHi = hi, rightLo = lo;
+        leftHi[inner.axis]  = inner.split;
+        rightLo[inner.axis] = inner.split;
+        CheckSubtree(tree, 2 * node + 1, level + 1, lo, leftHi);
+        CheckSubtree(tree, 2 * node + 2, level + 1, rightLo, hi);
+    }
+} // namespace
+
+// Testing the implicit layout, leaf sizes and that the parallel build matches the serial one.
+void TestKDTree_Build()
+{
+    KDTree tree;
+    assert(tree.IsEmpty());
+    tree.Build(nullptr, 0);
+    assert(tree.IsEmpty() && tree.QueryKNearest(Vec3(0.0f, 0.0f, 0.0f), 3, nullptr, nullptr) == 0);
+
+    std::vector<Vec3> points = RandomCloud(30000);
+
+    ThreadPool     serialPool(0), parallelPool(3);
+    KDTreeSettings serial, parallel;
+    serial.pool                = &serialPool;
+    parallel.pool              = &parallelPool;
+    parallel.parallelThreshold = 500;
+
+    KDTree other;
+    tree.Build(points.data(), points.size(), serial);
+    other.Build(points.data(), points.size(), parallel);
+    assert(tree.Count() == points.size() && tree.NodeCount() == ((size_t) 1 << tree.Depth()) - 1);
+
+    size_t leafCount = (size_t) 1 << tree.Depth();
+    assert(tree.LeafStarts()[0] == 0 && tree.LeafStarts()[leafCount] == points.size());
+    for (size_t leaf = 0; leaf < leafCount; ++leaf)
+        assert(tree.LeafStarts()[leaf + 1] - tree.LeafStarts()[leaf] <= 8);
+    // One level less would overflow some leaf.
+    assert((points.size() + leafCount / 2 - 1) / (leafCount / 2) > 8);
+
+    std::vector<bool> seen(points.size(), false);
+    for (size_t i = 0; i < tree.Count(); ++i)
+    {
+        assert(tree.Indices()[i] == other.Indices()[i]);
+        unsigned int p = tree.Indices()[i];
+        assert(!seen[p]);
+        seen[p] = true;
+        assert(tree.X()[i] == points[p].x && tree.Y()[i] == points[p].y && tree.Z()[i] == points[p].z);
+    }
+
+    Vec3 inf(DM_INFINITY_F, DM_INFINITY_F, DM_INFINITY_F);
+    Vec3 negInf(-DM_INFINITY_F, -DM_INFINITY_F, -DM_INFINITY_F);
+    CheckSubtree(tree, 0, 0, negInf, inf);
+
+    // Tiny trees, including empty leaves.
+    KDTreeSettings single;
+    single.leafSize = 1;
+    for (size_t count = 1; count < 8; ++count)
+    {
+        tree.Build(points.data(), count, single);
+        CheckSubtree(tree, 0, 0, negInf, inf);
+        unsigned int index;
+        float        d2;
+        assert(tree.QueryKNearest(points[count - 1], 1, &index, &d2) == 1 && d2 == 0.0f);
+    }
+}
+
+// Testing single and batched queries against brute force.
+void TestKDTree_Queries()
+{
+    std::vector<Vec3> points = RandomCloud(8000);
+    KDTree            tree;
+    tree.Build(points.data(), points.size());
+
+    std::vector<Vec3> centers(300);
+    for (size_t q = 0; q < centers.size(); ++q)
+        centers[q] = q % 2 ? points[q * 13] + RandomVec3(-0.5f, 0.5f) : RandomVec3(-30.0f, 30.0f);
+
+    for (size_t q = 0; q < centers.size(); ++q)
+    {
+        // Radius.
+        float                     radius = Random(0.0f, 4.0f);
+        std::vector<unsigned int> found, expected;
+        tree.QueryRadius(centers[q], radius,
+                         [&](unsigned int i, float d2)
+                         {
+                             assert(SameDistanceSquared(d2, DistanceSquared(points[i], centers[q])));
+                             found.push_back(i);
+                         });
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            if (DistanceSquared(points[i], centers[q]) <= radius * radius)
+                expected.push_back((unsigned int) i);
+        }
+        std::sort(found.begin(), found.end());
+        assert(found == expected);
+
+        // k nearest, unbounded and bounded.
+        size_t                    k = 1 + q % 20;
+        std::vector<unsigned int> indices(k);
+        std::vector<float>        distances(k);
+        float                     maxRadius = q % 3 ? DM_INFINITY_F : 2.0f;
+        std::vector<float>        brute     = BruteKNearest(points, centers[q], k, maxRadius);
+        assert(tree.QueryKNearest(centers[q], k, indices.data(), distances.data(), maxRadius) == brute.size());
+        for (size_t i = 0; i < brute.size(); ++i)
+        {
+            assert(SameDistanceSquared(distances[i], brute[i]));
+            assert(SameDistanceSquared(DistanceSquared(points[indices[i]], centers[q]), brute[i]));
+        }
+    }
+
+    // Batched kNN on a worker pool matches the single queries and pads missing results.
+    ThreadPool     pool(3);
+    KDTreeSettings settings;
+    settings.pool = &pool;
+    tree.Build(points.data(), points.size(), settings);
+
+    const size_t              k = 6;
+    std::vector<unsigned int> indices(centers.size() * k);
+    std::vector<float>        distances(centers.size() * k);
+    tree.QueryKNearest(centers.data(), centers.size(), k, indices.data(), distances.data(), 1.0f);
+    for (size_t q = 0; q < centers.size(); ++q)
+    {
+        std::vector<float> brute = BruteKNearest(points, centers[q], k, 1.0f);
+        for (size_t i = 0; i < k; ++i)
+        {
+            if (i < brute.size())
+                assert(SameDistanceSquared(distances[q * k + i], brute[i]));
+            else
+                assert(indices[q * k + i] == ~0u && distances[q * k + i] == DM_INFINITY_F);
+        }
+    }
+
+    // Batched radius: count hits per query from several threads.
+    std::vector<std::atomic<int>> hits(centers.size());
+    for (size_t q = 0; q < hits.size(); ++q)
+        hits[q] = 0;
+    tree.QueryRadius(centers.data(), centers.size(), 1.5f, [&](size_t q, unsigned int, float) { ++hits[q]; });
+    for (size_t q = 0; q < centers.size(); ++q)
+    {
+        int expected = 0;
+        for (size_t i = 0; i < points.size(); ++i)
+            expected += DistanceSquared(points[i], centers[q]) <= 1.5f * 1.5f;
+        assert(hits[q] == expected);
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(11);
+
+    TestKDTree_Build();
+    TestKDTree_Queries();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test KDTree] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "../Test_Common.h"
+
+#include <ext/spatial/DM_SweepAndPrune.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using namespace DropMath;
+using namespace Test;
+
+namespace
+{
+    // Boxes spread along x more than along y and z, some touching exactly and some repeated.
+    std::vector<AABB> RandomBoxes(size_t count, float worldSize)
+    {
+        std::vector<AABB> boxes(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i % 20 == 19)
+                boxes[i] = boxes[i - 1];
+            else if (i % 20 == 18)
+                boxes[i] = AABB(boxes[i - 1].max, boxes[i - 1].max + Vec3(1.0f, 1.0f, 1.0f));
+            else
+            {
+                Vec3 center = RandomVec3(-worldSize, worldSize);
+                center.x *= 2.0f;
+                Vec3 half = RandomVec3(0.1f, 1.5f);
+                boxes[i]  = AABB(center - half, center + half);
+            }
+        }
+        return boxes;
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> SortedPairs(const SweepAndPrune& sap)
+    {
+        std::vector<std::pair<unsigned int, unsigned int>> pairs;
+        for (size_t i = 0; i < sap.PairCount(); ++i)
+        {
+            assert(sap.Pairs()[i].a < sap.Pairs()[i].b);
+            pairs.push_back(std::make_pair(sap.Pairs()[i].a, sap.Pairs()[i].b));
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    std::vector<std::pair<unsigned int, unsigned int>> BrutePairs(const std::vector<AABB>& boxes)
+    {
+        std::vector<std::pair<unsigned int, unsigned int>> pairs;
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            for (size_t j = i + 1; j < boxes.size(); ++j)
+            {
+                if (boxes[i].Overlaps(boxes[j]))
+                    pairs.push_back(std::make_pair((unsigned int) i, (unsigned int) j));
+            }
+        }
+        return pairs;
+    }
+
+    void CheckOrder(const SweepAndPrune& sap, const std::vector<AABB>& boxes)
+    {
+        for (size_t i = 1; i < sap.Count(); ++i)
+            assert(boxes[sap.Order()[i - 1]].min[sap.Axis()] <= boxes[sap.Order()[i]].min[sap.Axis()]);
+    }
+} // namespace
+
+// Testing the pairs against brute force for several sizes, and the empty update.
+void TestSweepAndPrune_Pairs()
+{
+    SweepAndPrune sap;
+    sap.Update(nullptr, 0);
+    assert(sap.Count() == 0 && sap.PairCount() == 0);
+
+    const size_t counts[6] = { 1, 2, 5, 37, 1000, 3000 };
+    for (int c = 0; c < 6; ++c)
+    {
+        std::vector<AABB> boxes = RandomBoxes(counts[c], 20.0f);
+        sap.Update(boxes.data(), boxes.size());
+        assert(sap.Count() == boxes.size() && sap.Resorted() && sap.Axis() == 0);
+        CheckOrder(sap, boxes);
+        assert(SortedPairs(sap) == BrutePairs(boxes));
+    }
+
+    // A world spread along z moves the sweep axis there.
+    std::vector<AABB> boxes = RandomBoxes(500, 20.0f);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        std::swap(boxes[i].min.x, boxes[i].min.z);
+        std::swap(boxes[i].max.x, boxes[i].max.z);
+    }
+    sap.Update(boxes.data(), boxes.size());
+    assert(sap.Axis() == 2 && sap.Resorted());
+    CheckOrder(sap, boxes);
+    assert(SortedPairs(sap) == BrutePairs(boxes));
+}
+
+// Testing the incremental path: small moves keep the order, teleports and new bodies resort.
+void TestSweepAndPrune_Coherence()
+{
+    std::vector<AABB> boxes = RandomBoxes(2000, 30.0f);
+    SweepAndPrune     sap;
+    sap.Update(boxes.data(), boxes.size());
+
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            Vec3 move = RandomVec3(-0.05f, 0.05f);
+            boxes[i]  = AABB(boxes[i].min + move, boxes[i].max + move);
+        }
+        sap.Update(boxes.data(), boxes.size());
+        assert(!sap.Resorted());
+        CheckOrder(sap, boxes);
+        assert(SortedPairs(sap) == BrutePairs(boxes));
+    }
+
+    for (size_t i = 0; i < boxes.size(); i += 2)
+    {
+        Vec3 move(Random(-60.0f, 60.0f), 0.0f, 0.0f);
+        boxes[i] = AABB(boxes[i].min + move, boxes[i].max + move);
+    }
+    sap.Update(boxes.data(), boxes.size());
+    assert(sap.Resorted());
+    CheckOrder(sap, boxes);
+    assert(SortedPairs(sap) == BrutePairs(boxes));
+
+    boxes.pop_back();
+    sap.Update(boxes.data(), boxes.size());
+    assert(sap.Resorted() && sap.Count() == boxes.size());
+    assert(SortedPairs(sap) == BrutePairs(boxes));
+}
+
+// Testing that the pool changes neither the order nor the pair list.
+void TestSweepAndPrune_Parallel()
+{
+    ThreadPool            serialPool(0), parallelPool(3);
+    SweepAndPruneSettings serial, parallel;
+    serial.pool                = &serialPool;
+    parallel.pool              = &parallelPool;
+    parallel.parallelThreshold = 100;
+
+    std::vector<AABB> boxes = RandomBoxes(20000, 60.0f);
+    SweepAndPrune     a(serial), b(parallel);
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        a.Update(boxes.data(), boxes.size());
+        b.Update(boxes.data(), boxes.size());
+        assert(a.Resorted() == b.Resorted() && a.PairCount() == b.PairCount());
+        for (size_t i = 0; i < a.Count(); ++i)
+            assert(a.Order()[i] == b.Order()[i]);
+        for (size_t i = 0; i < a.PairCount(); ++i)
+            assert(a.Pairs()[i].a == b.Pairs()[i].a && a.Pairs()[i].b == b.Pairs()[i].b);
+        if (frame == 0)
+            assert(SortedPairs(b) == BrutePairs(boxes));
+
+        for (size_t i = 0; i < boxes.size(); ++i)
+        {
+            Vec3 move = RandomVec3(-0.2f, 0.2f);
+            boxes[i]  = AABB(boxes[i].min + move, boxes[i].max + move);
+        }
+    }
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+    SeedRandom(17);
+
+    TestSweepAndPrune_Pairs();
+    TestSweepAndPrune_Coherence();
+    TestSweepAndPrune_Parallel();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test SweepAndPrune] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
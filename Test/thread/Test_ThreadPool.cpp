@@ -0,0 +1,90 @@
+#include <ext/thread/DM_ThreadPool.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+// Testing ParallelFor covers every index exactly once, with and without workers.
+void TestThreadPool_ParallelFor()
+{
+    for (int threads = 0; threads < 4; threads += 3)
+    {
+        ThreadPool pool(threads);
+        assert(pool.ThreadCount() == threads + 1);
+
+        const size_t     count = 100003;
+        std::vector<int> hits(count, 0);
+        pool.ParallelFor(0, count, 1000,
+                         [&](size_t first, size_t last)
+                         {
+                             assert(last - first <= 1000);
+                             for (size_t i = first; i < last; ++i)
+                                 ++hits[i];
+                         });
+        for (size_t i = 0; i < count; ++i)
+            assert(hits[i] == 1);
+
+        int calls = 0;
+        pool.ParallelFor(5, 5, 10, [&](size_t, size_t) { ++calls; });
+        assert(calls == 0);
+    }
+}
+
+// Recursive sum: tasks add tasks to their own group, Wait must not deadlock.
+void RecursiveSum(TaskGroup& group, const std::vector<int>& values, size_t first, size_t last, std::atomic<long long>& sum)
+{
+    if (last - first <= 64)
+    {
+        long long local = 0;
+        for (size_t i = first; i < last; ++i)
+            local += values[i];
+        sum += local;
+        return;
+    }
+    size_t mid = (first + last) / 2;
+    group.Run([&group, &values, first, mid, &sum]() { RecursiveSum(group, values, first, mid, sum); });
+    RecursiveSum(group, values, mid, last, sum);
+}
+
+// Testing nested tasks in one group.
+void TestThreadPool_TaskGroup()
+{
+    std::vector<int> values(50000);
+    long long        expected = 0;
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = (int) (i % 97);
+        expected += values[i];
+    }
+
+    for (int threads = 0; threads < 4; threads += 3)
+    {
+        ThreadPool             pool(threads);
+        std::atomic<long long> sum(0);
+        {
+            TaskGroup group(pool);
+            RecursiveSum(group, values, 0, values.size(), sum);
+            group.Wait();
+        }
+        assert(sum.load() == expected);
+    }
+
+    assert(ThreadPool::Default().ThreadCount() >= 1);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestThreadPool_ParallelFor();
+    TestThreadPool_TaskGroup();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test ThreadPool] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <DropMath.h>
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
 
 using namespace DropMath;
@@ -143,6 +144,36 @@ void TestUtils_Trigonometry()
     assert(IsZero(Sin(0.0)));
     assert(IsZero(Cos(D::HALF_PI)));
     assert(IsZero(Tan(0.0)));
+
+    // Angles in (-pi, -pi/2) fold to [-pi/2, 0] without changing the sign of the sine.
+    assert(Abs(Sin(-2.0f) - -0.9092974f) < 1e-6f);
+    assert(Abs(Cos(-2.5f) - -0.8011436f) < 1e-6f);
+    assert(Abs(Sin(-2.0) - -0.90929742682568) < 1e-12);
+    assert(Abs(Tan(-2.0f) - 2.1850398f) < 1e-5f);
+}
+
+// Testing the 4-wide SinCos against the double precision library, including the quadrant edges.
+void TestUtils_SinCos()
+{
+    for (int i = -20000; i <= 20000; i += 4)
+    {
+        float  angles[4] = { i * 0.05f, (i + 1) * 0.05f, (i + 2) * 0.05f, (i + 3) * F::HALF_PI * 0.25f };
+        float4 sin, cos;
+        SinCos(_mm_loadu_ps(angles), sin, cos);
+
+        float sins[4], coss[4];
+        _mm_storeu_ps(sins, sin);
+        _mm_storeu_ps(coss, cos);
+        for (int k = 0; k < 4; ++k)
+        {
+            assert(Abs(sins[k] - (float) std::sin((double) angles[k])) < 1e-6f);
+            assert(Abs(coss[k] - (float) std::cos((double) angles[k])) < 1e-6f);
+        }
+    }
+
+    float s, c;
+    SinCos(-2.0f, s, c);
+    assert(Abs(s - -0.9092974f) < 1e-6f && Abs(c - -0.4161468f) < 1e-6f);
 }
 
 // Testing Determinant and Inverse.
@@ -203,6 +234,7 @@ int main()
 	TestUtils_WrapPi();
 	TestUtils_Sign();
 	TestUtils_Trigonometry();
+	TestUtils_SinCos();
 	TestUtils_DeterminantAndInverse();
 
     auto                                      end     = Clock::now();
@@ -0,0 +1,119 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+// Testing the arithmetic, bitwise and comparison operations for int and unsigned lanes.
+void TestIVec_Operations()
+{
+    IVec3 a(1, -2, 3);
+    IVec3 b(4, 5, -6);
+    assert(a + b == IVec3(5, 3, -3));
+    assert(a - b == IVec3(-3, -7, 9));
+    assert(a * b == IVec3(4, -10, -18));
+    assert(a * 3 == IVec3(3, -6, 9));
+    assert((a << 2) == IVec3(4, -8, 12));
+    assert((IVec3(-7, 7, -1) >> 1) == IVec3(-4, 3, -1)); // Arithmetic: a floor division.
+    assert((a & IVec3::Filled(1)) == IVec3(1, 0, 1));
+    assert((a | b) != (a ^ b) && (a ^ a) == IVec3());
+    assert(a[1] == -2 && b.z == -6);
+
+    assert(IVec3::Min(a, b) == IVec3(1, -2, -6));
+    assert(IVec3::Max(a, b) == IVec3(4, 5, 3));
+    assert(IVec3::Clamp(IVec3(-9, 0, 9), IVec3::Filled(-1), IVec3::Filled(2)) == IVec3(-1, 0, 2));
+    assert(IVec3::LessThan(a, b) == 0x3);
+    assert(IVec3::Equal(a, IVec3(1, 0, 3)) == 0x5);
+    assert(IVec2::LessThan(IVec2(0, 0), IVec2(1, 1)) == 0x3); // Only the used lanes.
+
+    // Unsigned lanes compare, shift and take the min of the full 32 bit range.
+    UVec2 big(0x80000000u, 1u);
+    UVec2 small(1u, 0xFFFFFFFFu);
+    assert(UVec2::LessThan(small, big) == 0x1);
+    assert(UVec2::Min(big, small) == UVec2(1u, 1u));
+    assert(UVec2::Max(big, small) == UVec2(0x80000000u, 0xFFFFFFFFu));
+    assert((small >> 28) == UVec2(0u, 0xFu));
+
+    UVec4 u = UVec4::Filled(7u);
+    assert(u.w == 7u && (u - UVec4(1u, 2u, 3u, 4u)) == UVec4(6u, 5u, 4u, 3u));
+}
+
+// Testing the float conversions against the scalar Floor and Round, and the batched WorldToCell.
+void TestIVec_Conversion()
+{
+    const float values[] = { -2.5f, -1.0f, -0.75f, -0.5f, -0.25f, 0.0f, 0.25f, 0.5f, 0.99f, 1.5f, 2.5f, 1000.49f, -65536.5f };
+    for (float f : values)
+    {
+        IVec3 floored = IVec3::Floor(Vec3(f, -f, f * 3.0f));
+        assert(floored == IVec3(Floor(f), Floor(-f), Floor(f * 3.0f)));
+        IVec4 rounded = IVec4::Round(Vec4(f, -f, f * 3.0f, 0.5f));
+        assert(rounded == IVec4(Round(f), Round(-f), Round(f * 3.0f), 1));
+    }
+    assert(IVec2::Floor(Vec2(-0.5f, 7.9f)) == IVec2(-1, 7));
+    assert(IVec3(1, -2, 3).ToFloat() == Vec3(1.0f, -2.0f, 3.0f));
+
+    UVec4 u = UVec4::Floor(Vec4(3000000000.0f, 0.0f, 65537.5f, 4294967040.0f));
+    assert(u == UVec4(3000000000u, 0u, 65537u, 4294967040u));
+    Vec4 back = u.ToFloat();
+    assert(back.x == 3000000000.0f && back.z == 65537.0f && back.w == 4294967040.0f);
+    assert(UVec2::Round(Vec2(2.5f, 2.49f)) == UVec2(3u, 2u));
+
+    // Same cells as the scalar formula, including the padded tail.
+    Vec3  origin(-10.0f, 0.5f, 3.0f);
+    float cellSize = 0.75f;
+    Vec3  positions[11];
+    IVec3 cells[11];
+    for (int i = 0; i < 11; ++i)
+        positions[i] = Vec3((float) i * 1.7f - 9.0f, (float) (i * i) * -0.3f, 3.0f + (float) i * 0.75f);
+    WorldToCell(positions, 11, origin, cellSize, cells);
+    for (int i = 0; i < 11; ++i)
+    {
+        Vec3 local = (positions[i] - origin) * (1.0f / cellSize);
+        assert(cells[i] == IVec3(Floor(local.x), Floor(local.y), Floor(local.z)));
+        assert(cells[i].w == 0);
+    }
+}
+
+// Testing that the hash matches the HashGrid formula and spreads neighbor cells.
+void TestIVec_Hash()
+{
+    IVec3        cell(12, -7, 300);
+    unsigned int expected = (12u * 73856093u) ^ ((unsigned int) -7 * 19349663u) ^ (300u * 83492791u);
+    assert(cell.Hash() == expected);
+    assert(IVec2(3, 4).Hash() == ((3u * 73856093u) ^ (4u * 19349663u)));
+
+    // Neighbors of a cell land in different buckets of a 256 entry table.
+    unsigned int buckets[27];
+    int          n = 0;
+    for (int z = -1; z <= 1; ++z)
+        for (int y = -1; y <= 1; ++y)
+            for (int x = -1; x <= 1; ++x)
+                buckets[n++] = (cell + IVec3(x, y, z)).Hash() & 255u;
+    int distinct = 0;
+    for (int i = 0; i < 27; ++i)
+    {
+        bool seen = false;
+        for (int j = 0; j < i; ++j)
+            seen |= buckets[j] == buckets[i];
+        distinct += seen ? 0 : 1;
+    }
+    assert(distinct >= 20);
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestIVec_Operations();
+    TestIVec_Conversion();
+    TestIVec_Hash();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test IVec] Passed. Time: " << elapsed.count() << "ms\n";
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <DropMath.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace DropMath;
+
+// Testing AoS load and store round trip.
+void TestVec3x4_LoadStore()
+{
+    Vec3   src[4] = {Vec3(1, 2, 3), Vec3(4, 5, 6), Vec3(7, 8, 9), Vec3(10, 11, 12)};
+    Vec3x4 v      = Vec3x4::Load(src);
+    for (int i = 0; i < 4; ++i)
+        assert(v.Get(i) == src[i]);
+
+    Vec3 dst[4];
+    v.Store(dst);
+    for (int i = 0; i < 4; ++i)
+        assert(dst[i] == src[i]);
+}
+
+// Testing SoA load and store round trip.
+void TestVec3x4_SoA()
+{
+    float  xs[4] = {1, 2, 3, 4}, ys[4] = {5, 6, 7, 8}, zs[4] = {9, 10, 11, 12};
+    Vec3x4 v     = Vec3x4::LoadSoA(xs, ys, zs);
+    assert(v.Get(2) == Vec3(3, 7, 11));
+
+    float ox[4], oy[4], oz[4];
+    v.StoreSoA(ox, oy, oz);
+    for (int i = 0; i < 4; ++i)
+        assert(ox[i] == xs[i] && oy[i] == ys[i] && oz[i] == zs[i]);
+}
+
+// Testing operators, dot and cross against the scalar Vec3.
+void TestVec3x4_Math()
+{
+    Vec3   a[4] = {Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(1, 2, 3), Vec3(-4, 5, -6)};
+    Vec3   b[4] = {Vec3(0, 1, 0), Vec3(0, 0, 1), Vec3(3, 2, 1), Vec3(7, -8, 9)};
+    Vec3x4 va   = Vec3x4::Load(a);
+    Vec3x4 vb   = Vec3x4::Load(b);
+
+    Vec3x4 sum   = va + vb;
+    Vec3x4 diff  = va - vb;
+    Vec3x4 scale = va * 2.0f;
+    Vec3x4 cross = Vec3x4::Cross(va, vb);
+
+    alignas(16) float dot[4];
+    _mm_store_ps(dot, Vec3x4::Dot(va, vb));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(sum.Get(i) == a[i] + b[i]);
+        assert(diff.Get(i) == a[i] - b[i]);
+        assert(scale.Get(i) == a[i] * 2.0f);
+        assert(cross.Get(i) == Vec3::Cross(a[i], b[i]));
+        assert(IsZero(dot[i] - Vec3::Dot(a[i], b[i])));
+    }
+}
+
+// Testing normalize, zero lanes stay zero.
+void TestVec3x4_Normalize()
+{
+    Vec3   src[4] = {Vec3(3, 0, 4), Vec3(), Vec3(0, -2, 0), Vec3(1, 1, 1)};
+    Vec3x4 v      = Vec3x4::Load(src);
+    v.Normalize();
+
+    assert(v.Get(0) == Vec3(0.6f, 0.0f, 0.8f));
+    assert(v.Get(1) == Vec3());
+    assert(v.Get(2) == Vec3(0, -1, 0));
+    assert(IsZero(v.Get(3).Length() - 1.0f));
+}
+
+// Testing lane select.
+void TestVec3x4_Select()
+{
+    Vec3x4 a(Vec3(1, 1, 1));
+    Vec3x4 b(Vec3(2, 2, 2));
+    Vec3x4 s = Vec3x4::Select(a, b, _mm_castsi128_ps(_mm_set_epi32(-1, 0, -1, 0)));
+    assert(s.Get(0) == Vec3(1, 1, 1));
+    assert(s.Get(1) == Vec3(2, 2, 2));
+    assert(s.Get(2) == Vec3(1, 1, 1));
+    assert(s.Get(3) == Vec3(2, 2, 2));
+}
+
+int main()
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto start  = Clock::now();
+
+    TestVec3x4_LoadStore();
+    TestVec3x4_SoA();
+    TestVec3x4_Math();
+    TestVec3x4_Normalize();
+    TestVec3x4_Select();
+
+    auto                                      end     = Clock::now();
+    std::chrono::duration<double, std::milli> elapsed = end - start;
+
+    std::cout << "[Test Vec3x4] Passed. Time: " << elapsed.count() << " ms\n";
+
+    return 0;
+}
@@ -3,7 +3,8 @@ workspace "DropMath"
 	configurations
 	{
 		"Debug",
-		"Release"
+		"Release",
+		"Profile"
 	}
 
 outdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
@@ -39,6 +40,11 @@ project "Lib"
 		optimize "On"
 		staticruntime "On"
 
+	filter "configurations:Profile"
+		defines { "DM_RELEASE", "DM_PROFILE" }
+		optimize "On"
+		staticruntime "On"
+
 project "Test"
 	location "Test"
 	kind "ConsoleApp"
@@ -70,3 +76,44 @@ project "Test"
 		optimize "On"
 		staticruntime "On"
 
+	filter "configurations:Profile"
+		defines { "DM_RELEASE", "DM_PROFILE" }
+		optimize "On"
+		staticruntime "On"
+
+
+project "Bench"
+	location "Bench"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("bin/" .. outdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/**.h",
+		"%{prj.name}/**.cpp",
+	}
+	includedirs
+	{
+		"Lib/include"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		defines "DM_DEBUG"
+		symbols "On"
+
+	filter "configurations:Release"
+		defines "DM_RELEASE"
+		optimize "On"
+		staticruntime "On"
+
+	filter "configurations:Profile"
+		defines { "DM_RELEASE", "DM_PROFILE" }
+		optimize "On"
+		staticruntime "On"